@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+// Fetch benchmarks for the accessor fast paths, each paired with the reference accessor
+// accessor_differential_test.cc checks it against. The argument picks the scenario:
+// column-wise with and without indicators, SQLGetData, or row-wise binding.
+
+#include "accessor_differential.h"
+#include <odbcabstraction/cpu_dispatch.h>
+
+#include <benchmark/benchmark.h>
+
+namespace driver {
+namespace flight_sql {
+
+namespace {
+
+std::string ScenarioLabel(const FetchScenario &scenario) {
+  std::string label = scenario.get_data ? "get_data" : scenario.row_stride ? "row-wise" : "column-wise";
+  if (!scenario.with_indicators) {
+    label += ", no indicators";
+  }
+  label += ", " + std::to_string(scenario.buffer_length) + " bytes";
+  return label + " (" + CpuDispatchLevelToString(GetCpuKernels().level) + ")";
+}
+
+/// Fetches every array through the scenario picked by the benchmark argument, with a
+/// fresh ACCESSOR for each array.
+template <typename ACCESSOR>
+void BenchmarkFetch(benchmark::State &state, const std::vector<std::shared_ptr<Array>> &arrays,
+                    const std::vector<FetchScenario> &scenarios) {
+  const FetchScenario &scenario = scenarios.at(static_cast<size_t>(state.range(0)));
+  std::mt19937_64 rng(kSeed);
+  std::vector<std::vector<int64_t>> blocks;
+  int64_t cells = 0;
+  for (const auto &array : arrays) {
+    blocks.push_back(RandomBlocks(rng, array->length()));
+    cells += array->length();
+  }
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < arrays.size(); ++i) {
+      benchmark::DoNotOptimize(Fetch<ACCESSOR>(arrays[i], scenario, blocks[i]));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * cells);
+  state.SetLabel(ScenarioLabel(scenario));
+}
+
+template <typename ARROW_ARRAY>
+const std::vector<std::shared_ptr<Array>> &PrimitiveArrays() {
+  typedef typename ARROW_ARRAY::TypeClass::c_type c_type;
+  static const std::vector<std::shared_ptr<Array>> arrays = [] {
+    std::mt19937_64 rng(kSeed);
+    std::uniform_int_distribution<int64_t> values(-1000000, 1000000);
+    return RandomArrays<typename ARROW_ARRAY::TypeClass, c_type>(
+        rng, [&values](std::mt19937_64 &engine) { return static_cast<c_type>(values(engine)); });
+  }();
+  return arrays;
+}
+
+template <typename ACCESSOR, typename ARROW_ARRAY, CDataType TARGET_TYPE>
+void BM_PrimitiveFetch(benchmark::State &state) {
+  BenchmarkFetch<ACCESSOR>(
+      state, PrimitiveArrays<ARROW_ARRAY>(),
+      FixedWidthScenarios(TARGET_TYPE, sizeof(typename ARROW_ARRAY::TypeClass::c_type)));
+}
+
+template <typename ACCESSOR>
+void BM_BooleanFetch(benchmark::State &state) {
+  static const std::vector<std::shared_ptr<Array>> arrays = [] {
+    std::mt19937_64 rng(kSeed);
+    std::bernoulli_distribution coin;
+    return RandomArrays<BooleanType, bool>(
+        rng, [&coin](std::mt19937_64 &engine) { return coin(engine); });
+  }();
+  BenchmarkFetch<ACCESSOR>(state, arrays, FixedWidthScenarios(CDataType_BIT, sizeof(unsigned char)));
+}
+
+template <typename ACCESSOR, typename CHAR_TYPE>
+void BM_WideStringFetch(benchmark::State &state) {
+  if (GetSqlWCharSize() != sizeof(CHAR_TYPE)) {
+    state.SkipWithError("SQLWCHAR has another size");
+    return;
+  }
+  static const std::vector<std::shared_ptr<Array>> arrays = [] {
+    std::mt19937_64 rng(kSeed);
+    return RandomArrays<StringType, std::string>(rng, RandomUtf8String);
+  }();
+  BenchmarkFetch<ACCESSOR>(state, arrays, TextScenarios(CDataType_WCHAR, sizeof(CHAR_TYPE), {16, 1024}));
+}
+
+template <typename ACCESSOR>
+void BM_Date32Fetch(benchmark::State &state) {
+  static const std::vector<std::shared_ptr<Array>> arrays = [] {
+    std::mt19937_64 rng(kSeed);
+    // 1400-01-01 to 9999-12-31.
+    return RandomTemporalArrays<Int32Type>(rng, date32(), -208188, 2932896);
+  }();
+  BenchmarkFetch<ACCESSOR>(state, arrays, FixedWidthScenarios(CDataType_DATE, sizeof(DATE_STRUCT)));
+}
+
+template <CDataType TARGET_TYPE, template <CDataType> class ACCESSOR>
+void BM_TimestampTextFetch(benchmark::State &state) {
+  static const std::vector<std::shared_ptr<Array>> arrays = [] {
+    std::mt19937_64 rng(kSeed);
+    // 1400-01-01 to 9999-12-31, in microseconds.
+    return RandomTemporalArrays<Int64Type>(rng, timestamp(TimeUnit::MICRO),
+                                           -208188LL * 86400 * 1000000,
+                                           (2932896LL * 86400 + 86399) * 1000000);
+  }();
+  const size_t char_size = TARGET_TYPE == CDataType_CHAR ? sizeof(char) : GetSqlWCharSize();
+  BenchmarkFetch<ACCESSOR<TARGET_TYPE>>(state, arrays, TextScenarios(TARGET_TYPE, char_size, {64}));
+}
+
+} // namespace
+
+// Fixed-width scenarios: column-wise, column-wise without indicators, SQLGetData, row-wise.
+BENCHMARK_TEMPLATE(BM_PrimitiveFetch,
+                   PerCellAccessor<PrimitiveArrayFlightSqlAccessor<Int32Array, CDataType_SLONG>>,
+                   Int32Array, CDataType_SLONG)->DenseRange(0, 3);
+BENCHMARK_TEMPLATE(BM_PrimitiveFetch, PrimitiveArrayFlightSqlAccessor<Int32Array, CDataType_SLONG>,
+                   Int32Array, CDataType_SLONG)->DenseRange(0, 3);
+BENCHMARK_TEMPLATE(BM_PrimitiveFetch,
+                   PerCellAccessor<PrimitiveArrayFlightSqlAccessor<DoubleArray, CDataType_DOUBLE>>,
+                   DoubleArray, CDataType_DOUBLE)->DenseRange(0, 3);
+BENCHMARK_TEMPLATE(BM_PrimitiveFetch, PrimitiveArrayFlightSqlAccessor<DoubleArray, CDataType_DOUBLE>,
+                   DoubleArray, CDataType_DOUBLE)->DenseRange(0, 3);
+
+BENCHMARK_TEMPLATE(BM_BooleanFetch, PerCellAccessor<BooleanArrayFlightSqlAccessor<CDataType_BIT>>)
+    ->DenseRange(0, 3);
+BENCHMARK_TEMPLATE(BM_BooleanFetch, BooleanArrayFlightSqlAccessor<CDataType_BIT>)->DenseRange(0, 3);
+
+BENCHMARK_TEMPLATE(BM_Date32Fetch,
+                   PerCellAccessor<DateArrayFlightSqlAccessor<CDataType_DATE, Date32Array>>)
+    ->DenseRange(0, 3);
+BENCHMARK_TEMPLATE(BM_Date32Fetch, DateArrayFlightSqlAccessor<CDataType_DATE, Date32Array>)
+    ->DenseRange(0, 3);
+
+// Text scenarios: column-wise, SQLGetData and row-wise for each buffer size.
+BENCHMARK_TEMPLATE(BM_WideStringFetch,
+                   PerCellAccessor<StringArrayFlightSqlAccessor<CDataType_WCHAR, char16_t>>,
+                   char16_t)->DenseRange(0, 5);
+BENCHMARK_TEMPLATE(BM_WideStringFetch, StringArrayFlightSqlAccessor<CDataType_WCHAR, char16_t>,
+                   char16_t)->DenseRange(0, 5);
+BENCHMARK_TEMPLATE(BM_WideStringFetch,
+                   PerCellAccessor<StringArrayFlightSqlAccessor<CDataType_WCHAR, char32_t>>,
+                   char32_t)->DenseRange(0, 5);
+BENCHMARK_TEMPLATE(BM_WideStringFetch, StringArrayFlightSqlAccessor<CDataType_WCHAR, char32_t>,
+                   char32_t)->DenseRange(0, 5);
+
+BENCHMARK_TEMPLATE(BM_TimestampTextFetch, CDataType_CHAR, CastToUtf8Accessor)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(BM_TimestampTextFetch, CDataType_CHAR, TemporalTextAccessor)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(BM_TimestampTextFetch, CDataType_WCHAR, CastToUtf8Accessor)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(BM_TimestampTextFetch, CDataType_WCHAR, TemporalTextAccessor)->DenseRange(0, 2);
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,402 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+// Differential harness for fetch fast paths, shared by the differential tests and the
+// fetch benchmarks.
+//
+// A reference accessor is a shipped accessor driven one cell at a time, or the
+// conversion a fast path replaces. Fetch runs an accessor over an array the way an
+// application would and records everything the application can observe, so the traces
+// of a reference and a candidate can be compared.
+
+#pragma once
+
+#include "arrow/compute/api.h"
+#include "arrow/testing/builder.h"
+#include "boolean_array_accessor.h"
+#include "date_array_accessor.h"
+#include "primitive_array_accessor.h"
+#include "string_array_accessor.h"
+#include "temporal_text_array_accessor.h"
+#include <odbcabstraction/diagnostics.h>
+#include <odbcabstraction/encoding.h>
+
+#include <cstring>
+#include <initializer_list>
+#include <random>
+
+namespace driver {
+namespace flight_sql {
+
+using namespace arrow;
+using namespace odbcabstraction;
+
+constexpr uint64_t kSeed = 0x0DBCF11E5EEDULL;
+constexpr uint8_t kPoisonByte = 0xAB;
+constexpr ssize_t kPoisonIndicator = -12345;
+
+// Reference accessors ---------------------------------------------------------
+
+/// The shipped ACCESSOR driven one cell at a time: every block is split into
+/// single-cell GetColumnarData calls, and row-wise bindings fall back to one call per
+/// row, as for accessors without a row-wise path.
+template <typename ACCESSOR>
+class PerCellAccessor : public ACCESSOR {
+public:
+  explicit PerCellAccessor(Array *array) : ACCESSOR(array) {}
+
+  size_t GetColumnarData(ColumnBinding *binding, int64_t starting_row, size_t cells,
+                         int64_t &value_offset, bool update_value_offset,
+                         odbcabstraction::Diagnostics &diagnostics,
+                         uint16_t *row_status_array) override {
+    const size_t cell_length = this->GetCellLength(binding);
+    size_t returned_cells = 0;
+    for (size_t i = 0; i < cells; ++i) {
+      ColumnBinding cell_binding = *binding;
+      cell_binding.buffer = static_cast<uint8_t *>(binding->buffer) + i * cell_length;
+      cell_binding.strlen_buffer = binding->strlen_buffer ? binding->strlen_buffer + i : nullptr;
+      returned_cells += ACCESSOR::GetColumnarData(
+          &cell_binding, starting_row + static_cast<int64_t>(i), 1, value_offset,
+          update_value_offset, diagnostics, row_status_array ? row_status_array + i : nullptr);
+    }
+    return returned_cells;
+  }
+
+  size_t GetRowWiseData(ColumnBinding *binding, int64_t starting_row, size_t cells,
+                        size_t row_size) override {
+    return 0;
+  }
+};
+
+/// Temporal values as text the way the driver formatted them before they had text
+/// accessors: an Arrow cast to utf8, read by the string accessor.
+template <CDataType TARGET_TYPE>
+class CastToUtf8Accessor : public Accessor {
+public:
+  explicit CastToUtf8Accessor(Array *array)
+      : Accessor(TARGET_TYPE),
+        utf8_array_(compute::Cast(*array, utf8()).ValueOrDie()),
+        accessor_(TARGET_TYPE == CDataType_CHAR
+                      ? new StringArrayFlightSqlAccessor<CDataType_CHAR, char>(utf8_array_.get())
+                      : CreateWCharStringArrayAccessor(utf8_array_.get())) {}
+
+  size_t GetColumnarData(ColumnBinding *binding, int64_t starting_row, size_t cells,
+                         int64_t &value_offset, bool update_value_offset,
+                         odbcabstraction::Diagnostics &diagnostics,
+                         uint16_t *row_status_array) override {
+    return accessor_->GetColumnarData(binding, starting_row, cells, value_offset,
+                                      update_value_offset, diagnostics, row_status_array);
+  }
+
+  size_t GetCellLength(ColumnBinding *binding) const override {
+    return accessor_->GetCellLength(binding);
+  }
+
+private:
+  std::shared_ptr<Array> utf8_array_;
+  std::unique_ptr<Accessor> accessor_;
+};
+
+/// The text accessor picked by CreateTemporalTextAccessor for the array's type and unit.
+template <CDataType TARGET_TYPE>
+class TemporalTextAccessor : public Accessor {
+public:
+  explicit TemporalTextAccessor(Array *array)
+      : Accessor(TARGET_TYPE), accessor_(CreateTemporalTextAccessor(array, TARGET_TYPE)) {}
+
+  size_t GetColumnarData(ColumnBinding *binding, int64_t starting_row, size_t cells,
+                         int64_t &value_offset, bool update_value_offset,
+                         odbcabstraction::Diagnostics &diagnostics,
+                         uint16_t *row_status_array) override {
+    return accessor_->GetColumnarData(binding, starting_row, cells, value_offset,
+                                      update_value_offset, diagnostics, row_status_array);
+  }
+
+  size_t GetCellLength(ColumnBinding *binding) const override {
+    return accessor_->GetCellLength(binding);
+  }
+
+private:
+  std::unique_ptr<Accessor> accessor_;
+};
+
+// Harness ---------------------------------------------------------------------
+
+/// How the application retrieves the column.
+struct FetchScenario {
+  CDataType target_type;
+  /// Bytes per cell, as given to SQLBindCol / SQLGetData.
+  size_t buffer_length;
+  bool with_indicators;
+  /// SQLGetData style: one cell per call, resuming through value_offset until the
+  /// value is exhausted. Otherwise rows are fetched in blocks of random size.
+  bool get_data;
+  /// Bytes between consecutive rows for row-wise binding, zero for column-wise binding.
+  /// Each row holds the value followed by its indicator, as in an application struct.
+  size_t row_stride;
+};
+
+inline size_t RowStride(size_t buffer_length) {
+  return (buffer_length + sizeof(ssize_t) - 1) / sizeof(ssize_t) * sizeof(ssize_t) + sizeof(ssize_t);
+}
+
+/// Everything an application can observe from a sequence of fetches.
+struct FetchTrace {
+  std::vector<uint8_t> buffer;
+  std::vector<ssize_t> indicators;
+  std::vector<uint16_t> row_status;
+  std::vector<int64_t> value_offsets;
+  std::vector<size_t> returned_cells;
+  std::vector<std::string> sql_states;
+  std::string exception;
+};
+
+/// The value of a NULL cell is undefined, so fast paths may write whatever is in the
+/// array's value buffer. Such cells are poisoned again before traces are compared.
+inline void PoisonNullCell(ssize_t indicator, uint8_t *cell, size_t buffer_length) {
+  if (indicator == odbcabstraction::NULL_DATA) {
+    std::fill(cell, cell + buffer_length, kPoisonByte);
+  }
+}
+
+inline std::vector<int64_t> RandomBlocks(std::mt19937_64 &rng, int64_t length) {
+  std::uniform_int_distribution<int64_t> block_size(1, 97);
+  std::vector<int64_t> blocks;
+  for (int64_t done = 0; done < length;) {
+    blocks.push_back(std::min(block_size(rng), length - done));
+    done += blocks.back();
+  }
+  return blocks;
+}
+
+/// Mirrors FlightSqlResultSet::Move for row-wise binding: all rows of a block at once
+/// when the accessor supports it, otherwise one accessor call per row, with the value
+/// and indicator pointers advanced by the row stride.
+inline void FetchRowWiseBlocks(Accessor &accessor, const FetchScenario &scenario,
+                        const std::vector<int64_t> &blocks, Diagnostics &diagnostics,
+                        FetchTrace &trace) {
+  const size_t indicator_offset = scenario.row_stride - sizeof(ssize_t);
+  int64_t starting_row = 0;
+  for (int64_t cells : blocks) {
+    std::vector<uint8_t> rows(cells * scenario.row_stride + 1, kPoisonByte);
+    std::vector<uint16_t> row_status(cells, odbcabstraction::RowStatus_SUCCESS);
+    ColumnBinding block_binding(scenario.target_type, 0, 0, rows.data(), scenario.buffer_length,
+                                scenario.with_indicators
+                                    ? reinterpret_cast<ssize_t *>(rows.data() + indicator_offset)
+                                    : nullptr);
+    size_t returned_cells = accessor.GetRowWiseData(&block_binding, starting_row,
+                                                    static_cast<size_t>(cells), scenario.row_stride);
+    if (returned_cells > 0) {
+      trace.value_offsets.insert(trace.value_offsets.end(), cells, 0);
+    } else {
+      for (int64_t i = 0; i < cells; ++i) {
+        uint8_t *row = rows.data() + i * scenario.row_stride;
+        ColumnBinding binding(scenario.target_type, 0, 0, row, scenario.buffer_length,
+                              scenario.with_indicators
+                                  ? reinterpret_cast<ssize_t *>(row + indicator_offset)
+                                  : nullptr);
+        int64_t value_offset = 0;
+        returned_cells += accessor.GetColumnarData(&binding, starting_row + i, 1, value_offset,
+                                                   false, diagnostics, &row_status[i]);
+        trace.value_offsets.push_back(value_offset);
+      }
+    }
+    if (scenario.with_indicators) {
+      for (int64_t i = 0; i < cells; ++i) {
+        uint8_t *row = rows.data() + i * scenario.row_stride;
+        ssize_t indicator;
+        memcpy(&indicator, row + indicator_offset, sizeof(indicator));
+        PoisonNullCell(indicator, row, scenario.buffer_length);
+      }
+    }
+    trace.returned_cells.push_back(returned_cells);
+    trace.buffer.insert(trace.buffer.end(), rows.begin(), rows.end());
+    trace.row_status.insert(trace.row_status.end(), row_status.begin(), row_status.end());
+    starting_row += cells;
+  }
+}
+
+inline void FetchBlocks(Accessor &accessor, const FetchScenario &scenario,
+                 const std::vector<int64_t> &blocks, Diagnostics &diagnostics,
+                 FetchTrace &trace) {
+  if (scenario.row_stride) {
+    FetchRowWiseBlocks(accessor, scenario, blocks, diagnostics, trace);
+    return;
+  }
+
+  int64_t starting_row = 0;
+  for (int64_t cells : blocks) {
+    std::vector<uint8_t> buffer(cells * scenario.buffer_length + 1, kPoisonByte);
+    std::vector<ssize_t> indicators(cells, kPoisonIndicator);
+    std::vector<uint16_t> row_status(cells, odbcabstraction::RowStatus_SUCCESS);
+    ColumnBinding binding(scenario.target_type, 0, 0, buffer.data(), scenario.buffer_length,
+                          scenario.with_indicators ? indicators.data() : nullptr);
+
+    int64_t value_offset = 0;
+    trace.returned_cells.push_back(
+        accessor.GetColumnarData(&binding, starting_row, static_cast<size_t>(cells),
+                                 value_offset, false, diagnostics, row_status.data()));
+    for (int64_t i = 0; scenario.with_indicators && i < cells; ++i) {
+      PoisonNullCell(indicators[i], buffer.data() + i * scenario.buffer_length, scenario.buffer_length);
+    }
+    trace.buffer.insert(trace.buffer.end(), buffer.begin(), buffer.end());
+    trace.indicators.insert(trace.indicators.end(), indicators.begin(), indicators.end());
+    trace.row_status.insert(trace.row_status.end(), row_status.begin(), row_status.end());
+    trace.value_offsets.push_back(value_offset);
+    starting_row += cells;
+  }
+}
+
+inline void FetchWithGetData(Accessor &accessor, const FetchScenario &scenario, int64_t length,
+                      Diagnostics &diagnostics, FetchTrace &trace) {
+  std::vector<uint8_t> buffer(scenario.buffer_length + 1);
+  for (int64_t row = 0; row < length; ++row) {
+    int64_t value_offset = 0;
+    for (;;) {
+      std::fill(buffer.begin(), buffer.end(), kPoisonByte);
+      ssize_t indicator = kPoisonIndicator;
+      uint16_t row_status = odbcabstraction::RowStatus_SUCCESS;
+      ColumnBinding binding(scenario.target_type, 0, 0, buffer.data(), scenario.buffer_length,
+                            scenario.with_indicators ? &indicator : nullptr);
+
+      const int64_t previous_offset = value_offset;
+      trace.returned_cells.push_back(
+          accessor.GetColumnarData(&binding, row, 1, value_offset, true, diagnostics, &row_status));
+      PoisonNullCell(indicator, buffer.data(), scenario.buffer_length);
+      trace.buffer.insert(trace.buffer.end(), buffer.begin(), buffer.end());
+      trace.indicators.push_back(indicator);
+      trace.row_status.push_back(row_status);
+      trace.value_offsets.push_back(value_offset);
+
+      // Stop once the value is exhausted, or when a call makes no progress (fixed-width
+      // values, NULLs, or a buffer too small to hold a single character).
+      if (value_offset == -1 || value_offset == previous_offset) {
+        break;
+      }
+    }
+  }
+}
+
+/// Fetches the whole array as scenario describes, with blocks as the sizes of the
+/// successive block fetches.
+template <typename ACCESSOR>
+FetchTrace Fetch(const std::shared_ptr<Array> &array, const FetchScenario &scenario,
+                 const std::vector<int64_t> &blocks) {
+  FetchTrace trace;
+  Diagnostics diagnostics("Dummy", "Dummy", OdbcVersion::V_3);
+  ACCESSOR accessor(array.get());
+  try {
+    if (scenario.get_data) {
+      FetchWithGetData(accessor, scenario, array->length(), diagnostics, trace);
+    } else {
+      FetchBlocks(accessor, scenario, blocks, diagnostics, trace);
+    }
+  } catch (const DriverException &e) {
+    trace.exception = e.GetMessageText();
+  }
+  for (uint32_t i = 0; i < diagnostics.GetRecordCount(); ++i) {
+    trace.sql_states.push_back(diagnostics.GetSQLState(i));
+  }
+  return trace;
+}
+
+// Random data -----------------------------------------------------------------
+
+inline std::vector<bool> RandomValidity(std::mt19937_64 &rng, int64_t length, double null_probability) {
+  std::bernoulli_distribution is_null(null_probability);
+  std::vector<bool> validity(length);
+  for (int64_t i = 0; i < length; ++i) {
+    validity[i] = !is_null(rng);
+  }
+  return validity;
+}
+
+/// Builds arrays of several lengths and null densities, plus slices of them starting at
+/// unaligned bit offsets.
+template <typename ARROW_TYPE, typename C_TYPE, typename GENERATOR>
+std::vector<std::shared_ptr<Array>> RandomArrays(std::mt19937_64 &rng, GENERATOR generate) {
+  std::vector<std::shared_ptr<Array>> arrays;
+  for (int64_t length : {1, 7, 64, 333, 4099}) {
+    for (double null_probability : {0.0, 0.1, 0.9}) {
+      std::vector<C_TYPE> values(length);
+      for (auto &value : values) {
+        value = generate(rng);
+      }
+      std::shared_ptr<Array> array;
+      ArrayFromVector<ARROW_TYPE, C_TYPE>(RandomValidity(rng, length, null_probability), values, &array);
+      arrays.push_back(array);
+
+      if (length > 2) {
+        std::uniform_int_distribution<int64_t> offset(1, std::min<int64_t>(length - 1, 67));
+        const int64_t slice_offset = offset(rng);
+        std::uniform_int_distribution<int64_t> slice_length(1, length - slice_offset);
+        arrays.push_back(array->Slice(slice_offset, slice_length(rng)));
+      }
+    }
+  }
+  return arrays;
+}
+
+inline std::string RandomUtf8String(std::mt19937_64 &rng) {
+  static const std::vector<std::string> pieces = {
+      "a", "Flight", "SQL ", "0123456789", "\t", "\xC3\xA9", "\xE6\xBC\xA2\xE5\xAD\x97",
+      "\xF0\x9F\x98\x80", "\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82"};
+  std::uniform_int_distribution<size_t> piece(0, pieces.size() - 1);
+  std::uniform_int_distribution<int> pieces_count(0, 40);
+  std::bernoulli_distribution ascii_only(0.6);
+
+  const bool only_ascii = ascii_only(rng);
+  std::string value;
+  for (int count = pieces_count(rng); count > 0; --count) {
+    const std::string &next = pieces[piece(rng)];
+    if (!only_ascii || static_cast<unsigned char>(next[0]) < 0x80) {
+      value += next;
+    }
+  }
+  return value;
+}
+
+inline std::vector<FetchScenario> FixedWidthScenarios(CDataType target_type, size_t width) {
+  return {{target_type, width, true, false},
+          {target_type, width, false, false},
+          {target_type, width, true, true},
+          {target_type, width, true, false, RowStride(width)}};
+}
+
+/// Random temporal arrays of type, whose values in [min, max] are generated as the
+/// STORAGE_TYPE integers they are laid out as.
+template <typename STORAGE_TYPE>
+std::vector<std::shared_ptr<Array>> RandomTemporalArrays(std::mt19937_64 &rng,
+                                                         const std::shared_ptr<DataType> &type,
+                                                         int64_t min, int64_t max,
+                                                         int64_t multiple = 1) {
+  typedef typename STORAGE_TYPE::c_type c_type;
+  std::uniform_int_distribution<int64_t> values(min / multiple, max / multiple);
+  auto arrays = RandomArrays<STORAGE_TYPE, c_type>(rng, [&](std::mt19937_64 &engine) {
+    return static_cast<c_type>(values(engine) * multiple);
+  });
+  for (auto &array : arrays) {
+    array = array->View(type).ValueOrDie();
+  }
+  return arrays;
+}
+
+/// Column-wise, SQLGetData and row-wise scenarios for text buffers of each size in
+/// characters.
+inline std::vector<FetchScenario> TextScenarios(CDataType target_type, size_t char_size,
+                                                std::initializer_list<size_t> sizes_in_chars) {
+  std::vector<FetchScenario> scenarios;
+  for (size_t chars : sizes_in_chars) {
+    const size_t buffer_length = chars * char_size;
+    scenarios.push_back({target_type, buffer_length, true, false});
+    scenarios.push_back({target_type, buffer_length, true, true});
+    scenarios.push_back({target_type, buffer_length, true, false, RowStride(buffer_length)});
+  }
+  return scenarios;
+}
+
+} // namespace flight_sql
+} // namespace driver
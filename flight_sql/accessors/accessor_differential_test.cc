@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+// Each case runs a reference accessor and a candidate accessor over the same randomised
+// arrays and bindings, then checks that buffers, indicators, row statuses, value_offset
+// progression and diagnostics are byte-identical. Their speed is compared by
+// accessor_benchmark.cc.
+
+#include "accessor_differential.h"
+#include "gtest/gtest.h"
+
+#include <limits>
+#include <sstream>
+
+namespace driver {
+namespace flight_sql {
+
+namespace {
+
+std::string ToText(const std::string &value) {
+  return value;
+}
+
+template <typename T>
+std::string ToText(T value) {
+  return std::to_string(+value);
+}
+
+template <typename T>
+std::string FirstDifference(const char *what, const std::vector<T> &reference,
+                            const std::vector<T> &candidate) {
+  std::stringstream ss;
+  if (reference.size() != candidate.size()) {
+    ss << what << " size " << reference.size() << " vs " << candidate.size();
+    return ss.str();
+  }
+  for (size_t i = 0; i < reference.size(); ++i) {
+    if (!(reference[i] == candidate[i])) {
+      ss << what << "[" << i << "] " << ToText(reference[i]) << " vs " << ToText(candidate[i]);
+      return ss.str();
+    }
+  }
+  return "";
+}
+
+/// Returns an empty string when both traces are identical.
+std::string Compare(const FetchTrace &reference, const FetchTrace &candidate) {
+  if (reference.exception != candidate.exception) {
+    return "exception '" + reference.exception + "' vs '" + candidate.exception + "'";
+  }
+  std::string difference = FirstDifference("sql_state", reference.sql_states, candidate.sql_states);
+  if (!reference.exception.empty() || !difference.empty()) {
+    // Bound buffers are undefined once the fetch fails, so only the error must match.
+    return difference;
+  }
+  if (!(difference = FirstDifference("returned_cells", reference.returned_cells, candidate.returned_cells)).empty() ||
+      !(difference = FirstDifference("value_offset", reference.value_offsets, candidate.value_offsets)).empty() ||
+      !(difference = FirstDifference("row_status", reference.row_status, candidate.row_status)).empty() ||
+      !(difference = FirstDifference("indicator", reference.indicators, candidate.indicators)).empty() ||
+      !(difference = FirstDifference("buffer", reference.buffer, candidate.buffer)).empty()) {
+    return difference;
+  }
+  return "";
+}
+
+struct DifferentialReport {
+  size_t runs = 0;
+  size_t mismatches = 0;
+  std::string first_mismatch;
+};
+
+/// Runs every scenario over every array with both accessors and compares their traces.
+template <typename REFERENCE, typename CANDIDATE>
+DifferentialReport RunDifferential(std::mt19937_64 &rng,
+                                   const std::vector<std::shared_ptr<Array>> &arrays,
+                                   const std::vector<FetchScenario> &scenarios) {
+  DifferentialReport report;
+  for (const auto &array : arrays) {
+    for (const auto &scenario : scenarios) {
+      const std::vector<int64_t> blocks = RandomBlocks(rng, array->length());
+      const std::string difference =
+          Compare(Fetch<REFERENCE>(array, scenario, blocks), Fetch<CANDIDATE>(array, scenario, blocks));
+      ++report.runs;
+      if (!difference.empty() && report.mismatches++ == 0) {
+        std::stringstream ss;
+        ss << "length=" << array->length() << " offset=" << array->offset()
+           << " nulls=" << array->null_count() << " buffer_length=" << scenario.buffer_length
+           << " indicators=" << scenario.with_indicators << " get_data=" << scenario.get_data
+           << " row_stride=" << scenario.row_stride
+           << ": " << difference;
+        report.first_mismatch = ss.str();
+      }
+    }
+  }
+  return report;
+}
+
+/// Runs ACCESSOR against itself driven one cell at a time.
+template <typename ACCESSOR>
+DifferentialReport RunPerCellDifferential(std::mt19937_64 &rng,
+                                          const std::vector<std::shared_ptr<Array>> &arrays,
+                                          const std::vector<FetchScenario> &scenarios) {
+  return RunDifferential<PerCellAccessor<ACCESSOR>, ACCESSOR>(rng, arrays, scenarios);
+}
+
+template <CDataType TARGET_TYPE>
+void TestTemporalTextDifferential(const std::string &name, std::mt19937_64 &rng,
+                                  const std::vector<std::shared_ptr<Array>> &arrays) {
+  const size_t char_size = TARGET_TYPE == CDataType_CHAR ? sizeof(char) : GetSqlWCharSize();
+  // Up to 20 characters truncate most values; 64 bytes and more are formatted in place
+  // for CHAR.
+  const auto report = RunDifferential<CastToUtf8Accessor<TARGET_TYPE>, TemporalTextAccessor<TARGET_TYPE>>(
+      rng, arrays, TextScenarios(TARGET_TYPE, char_size, {0, 1, 8, 20, 64}));
+  ASSERT_EQ(0, report.mismatches)
+      << name << (TARGET_TYPE == CDataType_CHAR ? " -> CHAR: " : " -> WCHAR: ") << report.first_mismatch;
+}
+
+template <typename ARROW_ARRAY, CDataType TARGET_TYPE>
+void TestPrimitiveDifferential(std::mt19937_64 &rng) {
+  typedef typename ARROW_ARRAY::TypeClass::c_type c_type;
+  std::uniform_int_distribution<uint64_t> bits;
+  const auto arrays = RandomArrays<typename ARROW_ARRAY::TypeClass, c_type>(
+      rng, [&bits](std::mt19937_64 &engine) {
+        const uint64_t raw = bits(engine);
+        c_type value;
+        memcpy(&value, &raw, sizeof(c_type));
+        return value;
+      });
+
+  const auto report = RunPerCellDifferential<PrimitiveArrayFlightSqlAccessor<ARROW_ARRAY, TARGET_TYPE>>(
+      rng, arrays, FixedWidthScenarios(TARGET_TYPE, sizeof(c_type)));
+  ASSERT_EQ(0, report.mismatches) << ARROW_ARRAY::TypeClass::type_name() << ": "
+                                  << report.first_mismatch;
+}
+
+} // namespace
+
+TEST(AccessorDifferential, PrimitiveArrays) {
+  std::mt19937_64 rng(kSeed);
+  TestPrimitiveDifferential<Int8Array, CDataType_STINYINT>(rng);
+  TestPrimitiveDifferential<Int16Array, CDataType_SSHORT>(rng);
+  TestPrimitiveDifferential<Int32Array, CDataType_SLONG>(rng);
+  TestPrimitiveDifferential<Int64Array, CDataType_SBIGINT>(rng);
+  TestPrimitiveDifferential<UInt8Array, CDataType_UTINYINT>(rng);
+  TestPrimitiveDifferential<UInt64Array, CDataType_UBIGINT>(rng);
+  TestPrimitiveDifferential<FloatArray, CDataType_FLOAT>(rng);
+  TestPrimitiveDifferential<DoubleArray, CDataType_DOUBLE>(rng);
+}
+
+TEST(AccessorDifferential, BooleanArrays) {
+  std::mt19937_64 rng(kSeed);
+  std::bernoulli_distribution coin;
+  const auto arrays = RandomArrays<BooleanType, bool>(
+      rng, [&coin](std::mt19937_64 &engine) { return coin(engine); });
+
+  const auto report = RunPerCellDifferential<BooleanArrayFlightSqlAccessor<CDataType_BIT>>(
+      rng, arrays, FixedWidthScenarios(CDataType_BIT, sizeof(unsigned char)));
+  ASSERT_EQ(0, report.mismatches) << report.first_mismatch;
+}
+
+template <typename CHAR_TYPE>
+void TestWideStringDifferential() {
+  std::mt19937_64 rng(kSeed);
+  const auto arrays = RandomArrays<StringType, std::string>(rng, RandomUtf8String);
+
+  std::vector<FetchScenario> scenarios =
+      TextScenarios(CDataType_WCHAR, sizeof(CHAR_TYPE), {0, 1, 2, 5, 16, 64, 1024});
+  // An odd byte count leaves a partial character at the end of the buffer.
+  scenarios.push_back({CDataType_WCHAR, 7, true, true});
+
+  const auto report = RunPerCellDifferential<StringArrayFlightSqlAccessor<CDataType_WCHAR, CHAR_TYPE>>(
+      rng, arrays, scenarios);
+  ASSERT_EQ(0, report.mismatches) << report.first_mismatch;
+}
+
+TEST(AccessorDifferential, StringArrays_WCHAR) {
+  if (GetSqlWCharSize() == sizeof(char16_t)) {
+    TestWideStringDifferential<char16_t>();
+  } else {
+    TestWideStringDifferential<char32_t>();
+  }
+}
+
+TEST(AccessorDifferential, Date32Arrays_ExtremeDates) {
+  std::mt19937_64 rng(kSeed);
+  // 1400-01-01 to 9999-12-31, the range supported by the calendar utilities.
+  std::uniform_int_distribution<int32_t> days(-208188, 2932896);
+  std::bernoulli_distribution pick_boundary(0.2);
+  const std::vector<int32_t> boundaries = {-208188, -1, 0, 1, 11016, 2932896};
+  std::uniform_int_distribution<size_t> boundary(0, boundaries.size() - 1);
+
+  const auto arrays = RandomArrays<Date32Type, int32_t>(rng, [&](std::mt19937_64 &engine) {
+    return pick_boundary(engine) ? boundaries[boundary(engine)] : days(engine);
+  });
+
+  const auto report = RunPerCellDifferential<DateArrayFlightSqlAccessor<CDataType_DATE, Date32Array>>(
+      rng, arrays, FixedWidthScenarios(CDataType_DATE, sizeof(DATE_STRUCT)));
+  ASSERT_EQ(0, report.mismatches) << report.first_mismatch;
+}
+
+TEST(AccessorDifferential, TemporalArrays_Text) {
+  std::mt19937_64 rng(kSeed);
+  // 1400-01-01 to 9999-12-31, in days and seconds.
+  const int64_t min_days = -208188, max_days = 2932896;
+  const int64_t min_seconds = min_days * 86400, max_seconds = max_days * 86400 + 86399;
+  const int64_t nanos_per_day = 86400LL * 1000000000;
+
+  const std::vector<std::pair<std::string, std::vector<std::shared_ptr<Array>>>> columns = {
+      {"date32", RandomTemporalArrays<Int32Type>(rng, date32(), min_days, max_days)},
+      {"date64", RandomTemporalArrays<Int64Type>(rng, date64(), min_days * 86400000,
+                                                 max_days * 86400000, 86400000)},
+      {"time32[s]", RandomTemporalArrays<Int32Type>(rng, time32(TimeUnit::SECOND), 0, 86399)},
+      {"time32[ms]", RandomTemporalArrays<Int32Type>(rng, time32(TimeUnit::MILLI), 0, 86399999)},
+      {"time64[us]", RandomTemporalArrays<Int64Type>(rng, time64(TimeUnit::MICRO), 0,
+                                                     86399999999LL)},
+      {"time64[ns]", RandomTemporalArrays<Int64Type>(rng, time64(TimeUnit::NANO), 0,
+                                                     nanos_per_day - 1)},
+      {"timestamp[s]", RandomTemporalArrays<Int64Type>(rng, timestamp(TimeUnit::SECOND),
+                                                       min_seconds, max_seconds)},
+      {"timestamp[ms]", RandomTemporalArrays<Int64Type>(rng, timestamp(TimeUnit::MILLI),
+                                                        min_seconds * 1000, max_seconds * 1000)},
+      {"timestamp[us]", RandomTemporalArrays<Int64Type>(rng, timestamp(TimeUnit::MICRO),
+                                                        min_seconds * 1000000,
+                                                        max_seconds * 1000000)},
+      // The whole range of nanosecond timestamps, 1677-09-21 to 2262-04-11.
+      {"timestamp[ns]", RandomTemporalArrays<Int64Type>(rng, timestamp(TimeUnit::NANO),
+                                                        std::numeric_limits<int64_t>::min(),
+                                                        std::numeric_limits<int64_t>::max())},
+  };
+
+  for (const auto &column : columns) {
+    TestTemporalTextDifferential<CDataType_CHAR>(column.first, rng, column.second);
+    TestTemporalTextDifferential<CDataType_WCHAR>(column.first, rng, column.second);
+  }
+}
+
+} // namespace flight_sql
+} // namespace driver
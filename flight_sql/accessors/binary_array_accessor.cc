@@ -7,6 +7,7 @@
 #include "binary_array_accessor.h"
 
 #include <arrow/array.h>
+#include <odbcabstraction/cpu_dispatch.h>
 #include <algorithm>
 #include <cstdint>
 
@@ -18,13 +19,60 @@ using namespace odbcabstraction;
 
 namespace {
 
-inline RowStatus MoveSingleCellToBinaryBuffer(ColumnBinding *binding,
-                                         BinaryArray *array, int64_t arrow_row, int64_t i,
-                                         int64_t &value_offset, bool update_value_offset, odbcabstraction::Diagnostics &diagnostics) {
-  RowStatus result = odbcabstraction::RowStatus_SUCCESS;
+const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+// Wide digits are produced through a small narrow buffer, so that both the hex and
+// the widening kernels stay vectorised.
+constexpr size_t HEX_CHUNK_BYTES = 256;
+
+inline void HexEncode(const uint8_t *bytes, size_t length, char *out) {
+  GetCpuKernels().hex_encode(bytes, length, out);
+}
+
+inline void WidenAscii(const char *digits, size_t length, char16_t *out) {
+  GetCpuKernels().ascii_to_utf16(digits, length, out);
+}
+
+inline void WidenAscii(const char *digits, size_t length, char32_t *out) {
+  GetCpuKernels().ascii_to_utf32(digits, length, out);
+}
+
+template <typename CHAR_TYPE>
+void HexEncode(const uint8_t *bytes, size_t length, CHAR_TYPE *out) {
+  char digits[2 * HEX_CHUNK_BYTES];
+  while (length > 0) {
+    const size_t chunk = std::min(length, HEX_CHUNK_BYTES);
+    GetCpuKernels().hex_encode(bytes, chunk, digits);
+    WidenAscii(digits, 2 * chunk, out);
+    bytes += chunk;
+    out += 2 * chunk;
+    length -= chunk;
+  }
+}
+
+/// Writes count digits of the hexadecimal text of bytes, starting at digit first,
+/// which may fall in the middle of a byte when resuming a truncated value.
+template <typename CHAR_TYPE>
+void WriteHexDigits(const uint8_t *bytes, size_t first, size_t count, CHAR_TYPE *out) {
+  if (count > 0 && first % 2 == 1) {
+    *out++ = static_cast<CHAR_TYPE>(HEX_DIGITS[bytes[first / 2] & 0xF]);
+    ++first;
+    --count;
+  }
+  const size_t whole_bytes = count / 2;
+  HexEncode(bytes + first / 2, whole_bytes, out);
+  if (count % 2 == 1) {
+    out[2 * whole_bytes] = static_cast<CHAR_TYPE>(HEX_DIGITS[bytes[first / 2 + whole_bytes] >> 4]);
+  }
+}
 
-  const char *value = array->Value(arrow_row).data();
-  size_t size_in_bytes = array->value_length(arrow_row);
+} // namespace
+
+RowStatus MoveSingleCellToBinaryBuffer(ColumnBinding *binding, const uint8_t *value,
+                                       size_t size_in_bytes, int64_t i, int64_t &value_offset,
+                                       bool update_value_offset,
+                                       odbcabstraction::Diagnostics &diagnostics) {
+  RowStatus result = odbcabstraction::RowStatus_SUCCESS;
 
   size_t remaining_length = static_cast<size_t>(size_in_bytes - value_offset);
   size_t value_length =
@@ -33,11 +81,11 @@ inline RowStatus MoveSingleCellToBinaryBuffer(ColumnBinding *binding,
 
   auto *byte_buffer = static_cast<unsigned char *>(binding->buffer) +
                       i * binding->buffer_length;
-  memcpy(byte_buffer, ((char *)value) + value_offset, value_length);
+  memcpy(byte_buffer, value + value_offset, value_length);
 
   if (remaining_length > binding->buffer_length) {
     result = odbcabstraction::RowStatus_SUCCESS_WITH_INFO;
-    diagnostics.AddTruncationWarning();
+    diagnostics.AddTruncationWarning(i);
     if (update_value_offset) {
       value_offset += value_length;
     }
@@ -52,28 +100,93 @@ inline RowStatus MoveSingleCellToBinaryBuffer(ColumnBinding *binding,
   return result;
 }
 
-} // namespace
+template <typename CHAR_TYPE>
+RowStatus MoveSingleCellToHexBuffer(ColumnBinding *binding, const uint8_t *value,
+                                    size_t size_in_bytes, int64_t i, int64_t &value_offset,
+                                    bool update_value_offset,
+                                    odbcabstraction::Diagnostics &diagnostics) {
+  RowStatus result = odbcabstraction::RowStatus_SUCCESS;
 
-template <CDataType TARGET_TYPE>
-BinaryArrayFlightSqlAccessor<TARGET_TYPE>::BinaryArrayFlightSqlAccessor(
+  const size_t first_char = static_cast<size_t>(value_offset) / sizeof(CHAR_TYPE);
+  const size_t remaining_chars = 2 * size_in_bytes - first_char;
+  const size_t remaining_length = remaining_chars * sizeof(CHAR_TYPE);
+
+  auto *char_buffer = reinterpret_cast<CHAR_TYPE *>(
+      static_cast<char *>(binding->buffer) + i * binding->buffer_length);
+
+  if (binding->buffer_length >= remaining_length + sizeof(CHAR_TYPE)) {
+    WriteHexDigits(value, first_char, remaining_chars, char_buffer);
+    char_buffer[remaining_chars] = '\0';
+    if (update_value_offset) {
+      value_offset = -1;
+    }
+  } else {
+    result = odbcabstraction::RowStatus_SUCCESS_WITH_INFO;
+    diagnostics.AddTruncationWarning(i);
+    size_t chars_written = binding->buffer_length / sizeof(CHAR_TYPE);
+    // If we failed to even write one char, the buffer is too small to hold a
+    // NUL-terminator.
+    if (chars_written > 0) {
+      WriteHexDigits(value, first_char, chars_written - 1, char_buffer);
+      char_buffer[chars_written - 1] = '\0';
+      if (update_value_offset) {
+        value_offset += (chars_written - 1) * sizeof(CHAR_TYPE);
+      }
+    }
+  }
+
+  if (binding->strlen_buffer) {
+    binding->strlen_buffer[i] = static_cast<ssize_t>(remaining_length);
+  }
+
+  return result;
+}
+
+template RowStatus MoveSingleCellToHexBuffer<char>(ColumnBinding *, const uint8_t *, size_t,
+                                                   int64_t, int64_t &, bool,
+                                                   odbcabstraction::Diagnostics &);
+template RowStatus MoveSingleCellToHexBuffer<char16_t>(ColumnBinding *, const uint8_t *, size_t,
+                                                       int64_t, int64_t &, bool,
+                                                       odbcabstraction::Diagnostics &);
+template RowStatus MoveSingleCellToHexBuffer<char32_t>(ColumnBinding *, const uint8_t *, size_t,
+                                                       int64_t, int64_t &, bool,
+                                                       odbcabstraction::Diagnostics &);
+
+template <CDataType TARGET_TYPE, typename CHAR_TYPE>
+BinaryArrayFlightSqlAccessor<TARGET_TYPE, CHAR_TYPE>::BinaryArrayFlightSqlAccessor(
     Array *array)
     : FlightSqlAccessor<BinaryArray, TARGET_TYPE,
-                        BinaryArrayFlightSqlAccessor<TARGET_TYPE>>(array) {}
+                        BinaryArrayFlightSqlAccessor<TARGET_TYPE, CHAR_TYPE>>(array) {}
+
+template <CDataType TARGET_TYPE, typename CHAR_TYPE>
+RowStatus BinaryArrayFlightSqlAccessor<TARGET_TYPE, CHAR_TYPE>::MoveSingleCell_impl(
+    ColumnBinding *binding, int64_t arrow_row, int64_t i, int64_t &value_offset,
+    bool update_value_offset, odbcabstraction::Diagnostics &diagnostics) {
+  int32_t size_in_bytes;
+  const uint8_t *value = this->GetArray()->GetValue(arrow_row, &size_in_bytes);
+  return MoveSingleCellToHexBuffer<CHAR_TYPE>(binding, value, size_in_bytes, i, value_offset,
+                                              update_value_offset, diagnostics);
+}
 
 template <>
 RowStatus BinaryArrayFlightSqlAccessor<CDataType_BINARY>::MoveSingleCell_impl(
     ColumnBinding *binding, int64_t arrow_row, int64_t i, int64_t &value_offset,
     bool update_value_offset, odbcabstraction::Diagnostics &diagnostics) {
-  return MoveSingleCellToBinaryBuffer(binding, this->GetArray(), arrow_row, i, value_offset,
+  int32_t size_in_bytes;
+  const uint8_t *value = this->GetArray()->GetValue(arrow_row, &size_in_bytes);
+  return MoveSingleCellToBinaryBuffer(binding, value, size_in_bytes, i, value_offset,
                                       update_value_offset, diagnostics);
 }
 
-template <CDataType TARGET_TYPE>
-size_t BinaryArrayFlightSqlAccessor<TARGET_TYPE>::GetCellLength_impl(ColumnBinding *binding) const {
+template <CDataType TARGET_TYPE, typename CHAR_TYPE>
+size_t BinaryArrayFlightSqlAccessor<TARGET_TYPE, CHAR_TYPE>::GetCellLength_impl(ColumnBinding *binding) const {
   return binding->buffer_length;
 }
 
 template class BinaryArrayFlightSqlAccessor<odbcabstraction::CDataType_BINARY>;
+template class BinaryArrayFlightSqlAccessor<odbcabstraction::CDataType_CHAR, char>;
+template class BinaryArrayFlightSqlAccessor<odbcabstraction::CDataType_WCHAR, char16_t>;
+template class BinaryArrayFlightSqlAccessor<odbcabstraction::CDataType_WCHAR, char32_t>;
 
 } // namespace flight_sql
 } // namespace driver
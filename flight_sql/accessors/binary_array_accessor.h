@@ -8,6 +8,7 @@
 
 #include "arrow/type_fwd.h"
 #include "types.h"
+#include <odbcabstraction/encoding.h>
 #include <odbcabstraction/types.h>
 
 namespace driver {
@@ -16,10 +17,25 @@ namespace flight_sql {
 using namespace arrow;
 using namespace odbcabstraction;
 
-template <CDataType TARGET_TYPE>
+/// \brief Copies the bytes of a value from value_offset on, truncating them to the
+/// bound buffer.
+RowStatus MoveSingleCellToBinaryBuffer(ColumnBinding *binding, const uint8_t *value,
+                                       size_t size_in_bytes, int64_t i, int64_t &value_offset,
+                                       bool update_value_offset,
+                                       odbcabstraction::Diagnostics &diagnostics);
+
+/// \brief Writes the upper-case hexadecimal text of a value, two characters per byte,
+/// NUL-terminated. value_offset counts bytes of that text, as for string columns.
+template <typename CHAR_TYPE>
+RowStatus MoveSingleCellToHexBuffer(ColumnBinding *binding, const uint8_t *value,
+                                    size_t size_in_bytes, int64_t i, int64_t &value_offset,
+                                    bool update_value_offset,
+                                    odbcabstraction::Diagnostics &diagnostics);
+
+template <CDataType TARGET_TYPE, typename CHAR_TYPE = char>
 class BinaryArrayFlightSqlAccessor
     : public FlightSqlAccessor<BinaryArray, TARGET_TYPE,
-                               BinaryArrayFlightSqlAccessor<TARGET_TYPE>> {
+                               BinaryArrayFlightSqlAccessor<TARGET_TYPE, CHAR_TYPE>> {
 public:
   explicit BinaryArrayFlightSqlAccessor(Array *array);
 
@@ -30,5 +46,17 @@ public:
   size_t GetCellLength_impl(ColumnBinding *binding) const;
 };
 
+inline Accessor* CreateWCharBinaryArrayAccessor(arrow::Array *array) {
+  switch(GetSqlWCharSize()) {
+    case sizeof(char16_t):
+      return new BinaryArrayFlightSqlAccessor<CDataType_WCHAR, char16_t>(array);
+    case sizeof(char32_t):
+      return new BinaryArrayFlightSqlAccessor<CDataType_WCHAR, char32_t>(array);
+    default:
+      assert(false);
+      throw DriverException("Encoding is unsupported, SQLWCHAR size: " + std::to_string(GetSqlWCharSize()));
+  }
+}
+
 } // namespace flight_sql
 } // namespace driver
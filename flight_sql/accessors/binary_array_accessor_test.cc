@@ -88,5 +88,102 @@ TEST(BinaryArrayAccessor, Test_CDataType_BINARY_Truncation) {
   ASSERT_EQ(values[0], ss.str());
 }
 
+TEST(BinaryArrayAccessor, Test_CDataType_CHAR_Hex) {
+  // Long enough for the vectorised kernels, with a tail they leave to the scalar loop.
+  std::string long_value;
+  std::string long_hex;
+  for (int b = 0; b < 256; ++b) {
+    long_value.push_back(static_cast<char>(b));
+    const char digits[] = "0123456789ABCDEF";
+    long_hex.push_back(digits[b >> 4]);
+    long_hex.push_back(digits[b & 0xF]);
+  }
+  std::vector<std::string> values = {std::string("\x00\x1f\xab\xff", 4), "", long_value.substr(3)};
+  std::vector<std::string> expected = {"001FABFF", "", long_hex.substr(6)};
+  std::shared_ptr<Array> array;
+  ArrayFromVector<BinaryType, std::string>(values, &array);
+
+  BinaryArrayFlightSqlAccessor<CDataType_CHAR, char> accessor(array.get());
+
+  size_t max_strlen = 1024;
+  std::vector<char> buffer(values.size() * max_strlen);
+  std::vector<ssize_t> strlen_buffer(values.size());
+
+  ColumnBinding binding(CDataType_CHAR, 0, 0, buffer.data(), max_strlen,
+                        strlen_buffer.data());
+
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  ASSERT_EQ(values.size(),
+            accessor.GetColumnarData(&binding, 0, values.size(), value_offset, false, diagnostics, nullptr));
+
+  for (int i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(expected[i].length(), strlen_buffer[i]);
+    ASSERT_EQ(expected[i], std::string(buffer.data() + i * max_strlen));
+  }
+}
+
+TEST(BinaryArrayAccessor, Test_CDataType_CHAR_Hex_Truncation) {
+  std::vector<std::string> values = {"\x01\x23\x45\x67\x89\xab\xcd\xef\x10"};
+  std::shared_ptr<Array> array;
+  ArrayFromVector<BinaryType, std::string>(values, &array);
+
+  BinaryArrayFlightSqlAccessor<CDataType_CHAR, char> accessor(array.get());
+
+  // Three digits per call, so every other chunk starts in the middle of a byte.
+  size_t max_strlen = 4;
+  std::vector<char> buffer(values.size() * max_strlen);
+  std::vector<ssize_t> strlen_buffer(values.size());
+
+  ColumnBinding binding(CDataType_CHAR, 0, 0, buffer.data(), max_strlen,
+                        strlen_buffer.data());
+
+  const std::string expected = "0123456789ABCDEF10";
+  std::stringstream ss;
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  do {
+    diagnostics.Clear();
+    int64_t original_value_offset = value_offset;
+    ASSERT_EQ(1, accessor.GetColumnarData(&binding, 0, 1, value_offset, true, diagnostics, nullptr));
+    ASSERT_EQ(expected.length() - original_value_offset, strlen_buffer[0]);
+
+    ss << buffer.data();
+  } while (value_offset != -1);
+
+  ASSERT_EQ(expected, ss.str());
+}
+
+TEST(BinaryArrayAccessor, Test_CDataType_WCHAR_Hex) {
+  std::vector<std::string> values = {"\x0f\xf0", "\xde\xad\xbe\xef"};
+  std::vector<std::string> expected = {"0FF0", "DEADBEEF"};
+  std::shared_ptr<Array> array;
+  ArrayFromVector<BinaryType, std::string>(values, &array);
+
+  auto accessor = CreateWCharBinaryArrayAccessor(array.get());
+
+  // Room for five wide characters: the second value is truncated.
+  size_t max_strlen = 5 * GetSqlWCharSize();
+  std::vector<uint8_t> buffer(values.size() * max_strlen);
+  std::vector<ssize_t> strlen_buffer(values.size());
+
+  ColumnBinding binding(CDataType_WCHAR, 0, 0, buffer.data(), max_strlen,
+                        strlen_buffer.data());
+
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  ASSERT_EQ(values.size(),
+            accessor->GetColumnarData(&binding, 0, values.size(), value_offset, false, diagnostics, nullptr));
+  ASSERT_EQ(1, diagnostics.GetRecordCount());
+
+  for (int i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(expected[i].length() * GetSqlWCharSize(), strlen_buffer[i]);
+    std::vector<uint8_t> expected_wcs;
+    Utf8ToWcs(expected[i].substr(0, 4).c_str(), &expected_wcs);
+    uint8_t *start = buffer.data() + i * max_strlen;
+    ASSERT_EQ(expected_wcs, std::vector<uint8_t>(start, start + 4 * GetSqlWCharSize()));
+  }
+}
+
 } // namespace flight_sql
 } // namespace driver
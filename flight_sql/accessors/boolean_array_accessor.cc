@@ -18,6 +18,35 @@ BooleanArrayFlightSqlAccessor<TARGET_TYPE>::BooleanArrayFlightSqlAccessor(
     : FlightSqlAccessor<BooleanArray, TARGET_TYPE,
                         BooleanArrayFlightSqlAccessor<TARGET_TYPE>>(array) {}
 
+template <CDataType TARGET_TYPE>
+size_t BooleanArrayFlightSqlAccessor<TARGET_TYPE>::GetColumnarData_impl(
+    ColumnBinding *binding, int64_t starting_row, int64_t cells,
+    int64_t &value_offset, bool update_value_offset,
+    odbcabstraction::Diagnostics &diagnostics, uint16_t* row_status_array) {
+  BooleanArray *array = this->GetArray();
+  const CpuKernels &kernels = GetCpuKernels();
+  const int64_t bit_offset = array->offset() + starting_row;
+  const uint8_t *validity = array->null_count() > 0 ? array->null_bitmap_data() : nullptr;
+
+  if (binding->strlen_buffer) {
+    kernels.expand_validity(validity, bit_offset, cells,
+                            static_cast<ssize_t>(GetCellLength_impl(binding)), binding->strlen_buffer);
+  } else if (validity) {
+    for (int64_t i = starting_row; i < starting_row + cells; ++i) {
+      if (array->IsNull(i)) {
+        throw odbcabstraction::NullWithoutIndicatorException();
+      }
+    }
+  }
+
+  // Unpack the value bits straight into the bound SQL_C_BIT buffer. Null rows get
+  // a value too, but the indicator marks them as NULL_DATA.
+  kernels.unpack_bits(array->values()->data(), bit_offset, cells,
+                      static_cast<uint8_t *>(binding->buffer));
+
+  return static_cast<size_t>(cells);
+}
+
 template <CDataType TARGET_TYPE>
 RowStatus BooleanArrayFlightSqlAccessor<TARGET_TYPE>::MoveSingleCell_impl(
     ColumnBinding *binding, int64_t arrow_row, int64_t i, int64_t &value_offset,
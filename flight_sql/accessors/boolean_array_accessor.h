@@ -24,6 +24,10 @@ class BooleanArrayFlightSqlAccessor
 public:
   explicit BooleanArrayFlightSqlAccessor(Array *array);
 
+  size_t GetColumnarData_impl(ColumnBinding *binding, int64_t starting_row, int64_t cells,
+                              int64_t &value_offset, bool update_value_offset,
+                              odbcabstraction::Diagnostics &diagnostics, uint16_t* row_status_array);
+
   RowStatus MoveSingleCell_impl(ColumnBinding *binding, int64_t arrow_row,
                                 int64_t i, int64_t &value_offset,
                                 bool update_value_offset,
@@ -10,9 +10,11 @@
 #include <arrow/array.h>
 #include <arrow/scalar.h>
 #include <odbcabstraction/types.h>
+#include <odbcabstraction/cpu_dispatch.h>
 #include <odbcabstraction/diagnostics.h>
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 
 namespace driver {
 namespace flight_sql {
@@ -20,22 +22,16 @@ namespace flight_sql {
 using namespace arrow;
 using namespace odbcabstraction;
 
-template <typename ARRAY_TYPE>
-inline size_t CopyFromArrayValuesToBinding(ARRAY_TYPE* array,
-                                           ColumnBinding *binding,
-                                           int64_t starting_row, int64_t cells) {
-  constexpr ssize_t element_size = sizeof(typename ARRAY_TYPE::value_type);
-
+/// \brief Writes the indicators of cells fixed-length values of element_size bytes,
+/// throwing if a null value has no indicator to be reported in.
+inline void WriteFixedLengthIndicators(const arrow::Array *array, ColumnBinding *binding,
+                                       int64_t starting_row, int64_t cells,
+                                       ssize_t element_size) {
   if (binding->strlen_buffer) {
-    for (int64_t i = 0; i < cells; ++i) {
-      int64_t current_row = starting_row + i;
-      if (array->IsNull(current_row)) {
-        binding->strlen_buffer[i] = NULL_DATA;
-      } else {
-        binding->strlen_buffer[i] = element_size;
-      }
-    }
-  } else {
+    const uint8_t *validity = array->null_count() > 0 ? array->null_bitmap_data() : nullptr;
+    GetCpuKernels().expand_validity(validity, array->offset() + starting_row, cells,
+                                    element_size, binding->strlen_buffer);
+  } else if (array->null_count() > 0) {
     // Duplicate this loop to avoid null checks within the loop.
     for (int64_t i = starting_row; i < starting_row + cells; ++i) {
       if (array->IsNull(i)) {
@@ -43,6 +39,15 @@ inline size_t CopyFromArrayValuesToBinding(ARRAY_TYPE* array,
       }
     }
   }
+}
+
+template <typename ARRAY_TYPE>
+inline size_t CopyFromArrayValuesToBinding(ARRAY_TYPE* array,
+                                           ColumnBinding *binding,
+                                           int64_t starting_row, int64_t cells) {
+  constexpr ssize_t element_size = sizeof(typename ARRAY_TYPE::value_type);
+
+  WriteFixedLengthIndicators(array, binding, starting_row, cells, element_size);
 
   // Copy the entire array to the bound ODBC buffers.
   // Note that the array should already have been sliced down to the same number
@@ -53,5 +58,36 @@ inline size_t CopyFromArrayValuesToBinding(ARRAY_TYPE* array,
   return cells;
 }
 
+/// \brief Row-wise counterpart of CopyFromArrayValuesToBinding, where consecutive rows
+/// are row_size bytes apart in the bound value and indicator buffers.
+template <typename ARRAY_TYPE>
+inline size_t CopyFromArrayValuesToRowWiseBinding(ARRAY_TYPE *array, ColumnBinding *binding,
+                                                  int64_t starting_row, int64_t cells,
+                                                  size_t row_size) {
+  constexpr ssize_t element_size = sizeof(typename ARRAY_TYPE::value_type);
+
+  if (binding->strlen_buffer) {
+    auto *indicator = reinterpret_cast<uint8_t *>(binding->strlen_buffer);
+    for (int64_t i = starting_row; i < starting_row + cells; ++i) {
+      const ssize_t length = array->IsNull(i) ? odbcabstraction::NULL_DATA : element_size;
+      memcpy(indicator, &length, sizeof(length));
+      indicator += row_size;
+    }
+  } else if (array->null_count() > 0) {
+    for (int64_t i = starting_row; i < starting_row + cells; ++i) {
+      if (array->IsNull(i)) {
+        throw odbcabstraction::NullWithoutIndicatorException();
+      }
+    }
+  }
+
+  if (binding->buffer) {
+    GetCpuKernels().strided_copy(reinterpret_cast<const uint8_t *>(&array->raw_values()[starting_row]),
+                                 element_size, static_cast<size_t>(cells),
+                                 static_cast<uint8_t *>(binding->buffer), row_size);
+  }
+  return cells;
+}
+
 } // namespace flight_sql
 } // namespace driver
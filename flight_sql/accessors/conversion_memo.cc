@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "conversion_memo.h"
+
+namespace driver {
+namespace flight_sql {
+
+constexpr int64_t ConversionMemo::SAMPLE_SIZE;
+constexpr int64_t ConversionMemo::WINDOW_SIZE;
+constexpr size_t ConversionMemo::MAX_ENTRIES;
+constexpr size_t ConversionMemo::MAX_VALUE_LENGTH;
+constexpr int64_t ConversionMemo::MIN_HIT_RATE_SIXTEENTHS;
+
+ConversionMemo::ConversionMemo() : state_(State_SAMPLING), lookups_(0), hits_(0) {}
+
+const std::vector<uint8_t> *ConversionMemo::Find(const char *value, size_t length) {
+  if (state_ == State_DISABLED || length > MAX_VALUE_LENGTH) {
+    return nullptr;
+  }
+
+  // Reusing the key keeps lookups free of allocations once it has grown.
+  lookup_key_.assign(value, length);
+  const auto &it = entries_.find(lookup_key_);
+  ++lookups_;
+  const std::vector<uint8_t> *result = nullptr;
+  if (it != entries_.end()) {
+    ++hits_;
+    result = &it->second;
+  }
+
+  Evaluate(state_ == State_SAMPLING ? SAMPLE_SIZE : WINDOW_SIZE);
+  return state_ == State_DISABLED ? nullptr : result;
+}
+
+void ConversionMemo::Insert(const char *value, size_t length,
+                            const std::vector<uint8_t> &converted) {
+  if (state_ == State_DISABLED || length > MAX_VALUE_LENGTH) {
+    return;
+  }
+  if (entries_.size() >= MAX_ENTRIES) {
+    Disable();
+    return;
+  }
+  entries_.emplace(std::string(value, length), converted);
+}
+
+void ConversionMemo::Evaluate(int64_t period) {
+  if (lookups_ < period) {
+    return;
+  }
+
+  if (hits_ * 16 < lookups_ * MIN_HIT_RATE_SIXTEENTHS) {
+    Disable();
+  } else {
+    state_ = State_ENABLED;
+  }
+  lookups_ = 0;
+  hits_ = 0;
+}
+
+void ConversionMemo::Disable() {
+  state_ = State_DISABLED;
+  std::unordered_map<std::string, std::vector<uint8_t>>().swap(entries_);
+  std::string().swap(lookup_key_);
+}
+
+} // namespace flight_sql
+} // namespace driver
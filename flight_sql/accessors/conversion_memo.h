@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace driver {
+namespace flight_sql {
+
+/// \brief Adaptive cache of converted string values for columns holding few distinct
+/// values, such as status codes or country names.
+///
+/// The memo starts by sampling: the first SAMPLE_SIZE lookups decide whether values
+/// repeat often enough for the memo to pay off. If not, it is disabled and frees its
+/// entries. While enabled, every WINDOW_SIZE lookups are checked again, and the memo
+/// also turns itself off when it outgrows MAX_ENTRIES. Values longer than
+/// MAX_VALUE_LENGTH are never memoised.
+class ConversionMemo {
+public:
+  static constexpr int64_t SAMPLE_SIZE = 256;
+  static constexpr int64_t WINDOW_SIZE = 4096;
+  static constexpr size_t MAX_ENTRIES = 4096;
+  static constexpr size_t MAX_VALUE_LENGTH = 256;
+
+  ConversionMemo();
+
+  /// \brief Looks up the converted bytes of a value.
+  /// \return the bytes stored by Insert for the same value, or nullptr if the caller
+  ///         must convert it. Returned pointers stay valid until the memo is disabled.
+  const std::vector<uint8_t> *Find(const char *value, size_t length);
+
+  /// \brief Stores the converted bytes of the value passed to the last missed Find.
+  void Insert(const char *value, size_t length, const std::vector<uint8_t> &converted);
+
+  bool IsEnabled() const { return state_ != State_DISABLED; }
+
+private:
+  enum State { State_SAMPLING, State_ENABLED, State_DISABLED };
+
+  /// Lookups must hit at least this often, in 1/16ths, for the memo to stay on.
+  static constexpr int64_t MIN_HIT_RATE_SIXTEENTHS = 8;
+
+  State state_;
+  std::unordered_map<std::string, std::vector<uint8_t>> entries_;
+  std::string lookup_key_;
+  int64_t lookups_;
+  int64_t hits_;
+
+  void Disable();
+  void Evaluate(int64_t period);
+};
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "conversion_memo.h"
+
+#include "gtest/gtest.h"
+#include <string>
+
+namespace driver {
+namespace flight_sql {
+
+namespace {
+std::vector<uint8_t> Convert(const std::string &value) {
+  std::vector<uint8_t> converted;
+  for (char c : value) {
+    converted.push_back(static_cast<uint8_t>(c));
+    converted.push_back(0);
+  }
+  return converted;
+}
+
+/// Looks value up, converting and inserting it on a miss. Returns true on a hit.
+bool Lookup(ConversionMemo &memo, const std::string &value) {
+  const std::vector<uint8_t> *memoized = memo.Find(value.data(), value.size());
+  if (memoized) {
+    EXPECT_EQ(Convert(value), *memoized);
+    return true;
+  }
+  memo.Insert(value.data(), value.size(), Convert(value));
+  return false;
+}
+}
+
+TEST(ConversionMemo, StaysEnabledForRepeatedValues) {
+  const std::vector<std::string> values{"ACTIVE", "INACTIVE", "PENDING", "DELETED"};
+  ConversionMemo memo;
+
+  int64_t hits = 0;
+  for (int64_t i = 0; i < 3 * ConversionMemo::WINDOW_SIZE; ++i) {
+    hits += Lookup(memo, values[i % values.size()]);
+  }
+
+  ASSERT_TRUE(memo.IsEnabled());
+  ASSERT_EQ(3 * ConversionMemo::WINDOW_SIZE - static_cast<int64_t>(values.size()), hits);
+}
+
+TEST(ConversionMemo, DisablesAfterSamplingDistinctValues) {
+  ConversionMemo memo;
+
+  for (int64_t i = 0; i < ConversionMemo::SAMPLE_SIZE; ++i) {
+    ASSERT_FALSE(Lookup(memo, std::to_string(i)));
+  }
+
+  ASSERT_FALSE(memo.IsEnabled());
+  ASSERT_FALSE(Lookup(memo, "0"));
+}
+
+TEST(ConversionMemo, DisablesWhenRepetitionStops) {
+  ConversionMemo memo;
+  for (int64_t i = 0; i < ConversionMemo::SAMPLE_SIZE; ++i) {
+    Lookup(memo, "constant");
+  }
+  ASSERT_TRUE(memo.IsEnabled());
+
+  for (int64_t i = 0; i < ConversionMemo::WINDOW_SIZE; ++i) {
+    Lookup(memo, "unique-" + std::to_string(i));
+  }
+  ASSERT_FALSE(memo.IsEnabled());
+}
+
+TEST(ConversionMemo, SkipsLongValues) {
+  const std::string long_value(ConversionMemo::MAX_VALUE_LENGTH + 1, 'x');
+  ConversionMemo memo;
+
+  ASSERT_FALSE(Lookup(memo, long_value));
+  ASSERT_FALSE(Lookup(memo, long_value));
+  ASSERT_TRUE(memo.IsEnabled());
+}
+
+} // namespace flight_sql
+} // namespace driver
@@ -8,6 +8,9 @@
 
 #include <arrow/array.h>
 #include <arrow/scalar.h>
+#include <odbcabstraction/encoding.h>
+#include <cstring>
+#include <type_traits>
 
 namespace driver {
 namespace flight_sql {
@@ -15,12 +18,99 @@ namespace flight_sql {
 using namespace arrow;
 using namespace odbcabstraction;
 
+namespace {
+
+template <typename ARROW_ARRAY>
+struct DecimalValueType {
+  typedef typename std::conditional<std::is_same<ARROW_ARRAY, Decimal256Array>::value,
+                                    Decimal256, Decimal128>::type type;
+};
+
+inline RowStatus MoveFormattedValueToCharBuffer(const std::vector<uint8_t> &value,
+                                                size_t char_size,
+                                                ColumnBinding *binding, int64_t i,
+                                                int64_t &value_offset,
+                                                bool update_value_offset,
+                                                odbcabstraction::Diagnostics &diagnostics) {
+  RowStatus result = odbcabstraction::RowStatus_SUCCESS;
+
+  size_t remaining_length = static_cast<size_t>(value.size() - value_offset);
+  size_t value_length = std::min(remaining_length, binding->buffer_length);
+
+  auto *byte_buffer =
+      static_cast<uint8_t *>(binding->buffer) + i * binding->buffer_length;
+  memcpy(byte_buffer, value.data() + value_offset, value_length);
+
+  // Write a NUL terminator
+  if (binding->buffer_length >= remaining_length + char_size) {
+    // The entire remainder of the data was consumed.
+    memset(byte_buffer + remaining_length, 0, char_size);
+    if (update_value_offset) {
+      // Mark that there's no data remaining.
+      value_offset = -1;
+    }
+  } else {
+    result = odbcabstraction::RowStatus_SUCCESS_WITH_INFO;
+    diagnostics.AddTruncationWarning(i);
+    size_t chars_written = binding->buffer_length / char_size;
+    // If we failed to even write one char, the buffer is too small to hold a
+    // NUL-terminator.
+    if (chars_written > 0) {
+      memset(byte_buffer + (chars_written - 1) * char_size, 0, char_size);
+      if (update_value_offset) {
+        value_offset += static_cast<int64_t>((chars_written - 1) * char_size);
+      }
+    }
+  }
+
+  if (binding->strlen_buffer) {
+    binding->strlen_buffer[i] = static_cast<ssize_t>(remaining_length);
+  }
+
+  return result;
+}
+
+} // namespace
+
 template <typename ARROW_ARRAY, CDataType TARGET_TYPE>
 DecimalArrayFlightSqlAccessor<ARROW_ARRAY, TARGET_TYPE>::DecimalArrayFlightSqlAccessor(
     Array *array)
     : FlightSqlAccessor<ARROW_ARRAY, TARGET_TYPE,
                         DecimalArrayFlightSqlAccessor<ARROW_ARRAY, TARGET_TYPE>>(array),
-      data_type_(static_cast<Decimal128Type*>(array->type().get())) {
+      data_type_(static_cast<DecimalType*>(array->type().get())),
+      last_arrow_row_(-1) {
+}
+
+template <typename ARROW_ARRAY, CDataType TARGET_TYPE>
+RowStatus DecimalArrayFlightSqlAccessor<ARROW_ARRAY, TARGET_TYPE>::MoveSingleCell_impl(
+    ColumnBinding *binding, int64_t arrow_row, int64_t i, int64_t &value_offset,
+    bool update_value_offset, odbcabstraction::Diagnostics &diagnostics) {
+  typedef typename DecimalValueType<ARROW_ARRAY>::type DecimalValue;
+  const DecimalValue value(this->GetArray()->Value(arrow_row));
+
+  if (TARGET_TYPE == odbcabstraction::CDataType_DOUBLE) {
+    static_cast<double *>(binding->buffer)[i] = value.ToDouble(data_type_->scale());
+    if (binding->strlen_buffer) {
+      binding->strlen_buffer[i] = static_cast<ssize_t>(GetCellLength_impl(binding));
+    }
+    return odbcabstraction::RowStatus_SUCCESS;
+  }
+
+  // Format the value straight from the decimal bytes. Only re-format when the row
+  // changes, so that SQLGetData calls retrieving the value in parts reuse it.
+  if (last_arrow_row_ != arrow_row) {
+    const std::string &formatted = value.ToString(data_type_->scale());
+    if (TARGET_TYPE == odbcabstraction::CDataType_WCHAR) {
+      Utf8ToWcs(formatted.data(), formatted.size(), &buffer_);
+    } else {
+      buffer_.assign(formatted.begin(), formatted.end());
+    }
+    last_arrow_row_ = arrow_row;
+  }
+
+  size_t char_size = TARGET_TYPE == odbcabstraction::CDataType_WCHAR ? GetSqlWCharSize() : sizeof(char);
+  return MoveFormattedValueToCharBuffer(buffer_, char_size, binding, i, value_offset,
+                                        update_value_offset, diagnostics);
 }
 
 template <>
@@ -62,12 +152,65 @@ RowStatus DecimalArrayFlightSqlAccessor<Decimal128Array, CDataType_NUMERIC>::Mov
   return odbcabstraction::RowStatus_SUCCESS;
 }
 
+template <>
+RowStatus DecimalArrayFlightSqlAccessor<Decimal256Array, CDataType_NUMERIC>::MoveSingleCell_impl(
+    ColumnBinding *binding, int64_t arrow_row, int64_t i, int64_t &value_offset,
+    bool update_value_offset, odbcabstraction::Diagnostics &diagnostics) {
+  auto result = &(static_cast<NUMERIC_STRUCT *>(binding->buffer)[i]);
+  int32_t original_scale = data_type_->scale();
+
+  const uint8_t* bytes = this->GetArray()->Value(arrow_row);
+  Decimal256 value(bytes);
+  if (original_scale != binding->scale) {
+    const Status &status = value.Rescale(original_scale, binding->scale).Value(&value);
+    ThrowIfNotOK(status);
+  }
+  if (!value.FitsInPrecision(binding->precision)) {
+    throw NumericValueOutOfRangeException();
+  }
+
+  // The ODBC SQL_NUMERIC_STRUCT holds a positive-only number of at most 16 bytes,
+  // so anything set in the upper half of the absolute value cannot be represented.
+  uint8_t abs_bytes[32];
+  Decimal256::Abs(value).ToBytes(abs_bytes);
+  for (size_t byte = sizeof(result->val); byte < sizeof(abs_bytes); ++byte) {
+    if (abs_bytes[byte] != 0) {
+      throw NumericValueOutOfRangeException();
+    }
+  }
+
+  result->sign = value.IsNegative() ? 0 : 1;
+  memcpy(result->val, abs_bytes, sizeof(result->val));
+  result->precision = static_cast<uint8_t>(binding->precision);
+  result->scale = static_cast<int8_t>(binding->scale);
+
+  if (binding->strlen_buffer) {
+    binding->strlen_buffer[i] = static_cast<ssize_t>(GetCellLength_impl(binding));
+  }
+
+  return odbcabstraction::RowStatus_SUCCESS;
+}
+
 template <typename ARROW_ARRAY, CDataType TARGET_TYPE>
 size_t DecimalArrayFlightSqlAccessor<ARROW_ARRAY, TARGET_TYPE>::GetCellLength_impl(ColumnBinding *binding) const {
-  return sizeof(NUMERIC_STRUCT);
+  switch (TARGET_TYPE) {
+    case odbcabstraction::CDataType_NUMERIC:
+      return sizeof(NUMERIC_STRUCT);
+    case odbcabstraction::CDataType_DOUBLE:
+      return sizeof(double);
+    default:
+      return binding->buffer_length;
+  }
 }
 
 template class DecimalArrayFlightSqlAccessor<Decimal128Array, odbcabstraction::CDataType_NUMERIC>;
+template class DecimalArrayFlightSqlAccessor<Decimal128Array, odbcabstraction::CDataType_CHAR>;
+template class DecimalArrayFlightSqlAccessor<Decimal128Array, odbcabstraction::CDataType_WCHAR>;
+template class DecimalArrayFlightSqlAccessor<Decimal128Array, odbcabstraction::CDataType_DOUBLE>;
+template class DecimalArrayFlightSqlAccessor<Decimal256Array, odbcabstraction::CDataType_NUMERIC>;
+template class DecimalArrayFlightSqlAccessor<Decimal256Array, odbcabstraction::CDataType_CHAR>;
+template class DecimalArrayFlightSqlAccessor<Decimal256Array, odbcabstraction::CDataType_WCHAR>;
+template class DecimalArrayFlightSqlAccessor<Decimal256Array, odbcabstraction::CDataType_DOUBLE>;
 
 } // namespace flight_sql
 } // namespace driver
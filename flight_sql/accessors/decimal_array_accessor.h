@@ -10,6 +10,7 @@
 #include "types.h"
 #include "utils.h"
 #include <locale>
+#include <vector>
 #include <odbcabstraction/types.h>
 
 namespace driver {
@@ -32,7 +33,9 @@ public:
   size_t GetCellLength_impl(ColumnBinding *binding) const;
 
 private:
-  Decimal128Type *data_type_;
+  DecimalType *data_type_;
+  std::vector<uint8_t> buffer_;
+  int64_t last_arrow_row_;
 };
 
 } // namespace flight_sql
@@ -9,6 +9,7 @@
 #include "arrow/testing/builder.h"
 #include "decimal_array_accessor.h"
 #include "gtest/gtest.h"
+#include <sstream>
 
 namespace {
 
@@ -37,6 +38,27 @@ std::vector <Decimal128> MakeDecimalVector(const std::vector <std::string> &valu
   return ret;
 }
 
+std::vector <Decimal256> MakeDecimal256Vector(const std::vector <std::string> &values,
+                                              int32_t scale) {
+  std::vector <arrow::Decimal256> ret;
+  for (const auto &str: values) {
+    Decimal256 str_value;
+    int32_t str_precision;
+    int32_t str_scale;
+
+    ThrowIfNotOK(Decimal256::FromString(str, &str_value, &str_precision, &str_scale));
+
+    Decimal256 scaled_value;
+    if (str_scale == scale) {
+      scaled_value = str_value;
+    } else {
+      scaled_value = str_value.Rescale(str_scale, scale).ValueOrDie();
+    }
+    ret.push_back(scaled_value);
+  }
+  return ret;
+}
+
 std::string ConvertNumericToString(NUMERIC_STRUCT &numeric) {
   auto v = reinterpret_cast<int64_t *>(numeric.val);
   auto decimal = Decimal128(v[1], v[0]);
@@ -95,5 +117,187 @@ TEST(DecimalArrayFlightSqlAccessor, Test_Decimal128Array_CDataType_NUMERIC_Incre
   AssertNumericOutput(38, 3, input_values, 38, 4, output_values);
 }
 
+TEST(DecimalArrayFlightSqlAccessor, Test_Decimal256Array_CDataType_NUMERIC) {
+  const std::vector <std::string> &input_values = {"25.212", "-25.212", "-123456789.123", "123456789.123"};
+  const std::vector <std::string> &output_values = {"25.2120", "-25.2120", "-123456789.1230", "123456789.1230"};
+
+  auto decimal_type = std::make_shared<arrow::Decimal256Type>(60, 3);
+  const std::vector <Decimal256> &values = MakeDecimal256Vector(input_values, decimal_type->scale());
+
+  std::shared_ptr <Array> array;
+  ArrayFromVector<Decimal256Type, Decimal256>(decimal_type, values, &array);
+
+  DecimalArrayFlightSqlAccessor <Decimal256Array, CDataType_NUMERIC> accessor(array.get());
+
+  std::vector <NUMERIC_STRUCT> buffer(values.size());
+  std::vector <ssize_t> strlen_buffer(values.size());
+
+  ColumnBinding binding(CDataType_NUMERIC, 38, 4, buffer.data(), 0, strlen_buffer.data());
+
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  ASSERT_EQ(values.size(),
+            accessor.GetColumnarData(&binding, 0, values.size(), value_offset, false, diagnostics, nullptr));
+
+  for (int i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(sizeof(NUMERIC_STRUCT), strlen_buffer[i]);
+
+    ASSERT_EQ(38, buffer[i].precision);
+    ASSERT_EQ(4, buffer[i].scale);
+    ASSERT_STREQ(output_values[i].c_str(), ConvertNumericToString(buffer[i]).c_str());
+  }
+}
+
+TEST(DecimalArrayFlightSqlAccessor, Test_Decimal256Array_CDataType_NUMERIC_Overflow) {
+  const std::vector <std::string> &input_values = {"1.5", "123456789012345678901234567890123456789012345.5", "-2.5"};
+
+  auto decimal_type = std::make_shared<arrow::Decimal256Type>(50, 1);
+  const std::vector <Decimal256> &values = MakeDecimal256Vector(input_values, decimal_type->scale());
+
+  std::shared_ptr <Array> array;
+  ArrayFromVector<Decimal256Type, Decimal256>(decimal_type, values, &array);
+
+  DecimalArrayFlightSqlAccessor <Decimal256Array, CDataType_NUMERIC> accessor(array.get());
+
+  std::vector <NUMERIC_STRUCT> buffer(values.size());
+  std::vector <ssize_t> strlen_buffer(values.size());
+  std::vector <uint16_t> row_status(values.size(), RowStatus_SUCCESS);
+
+  ColumnBinding binding(CDataType_NUMERIC, 38, 1, buffer.data(), 0, strlen_buffer.data());
+
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  ASSERT_EQ(values.size(),
+            accessor.GetColumnarData(&binding, 0, values.size(), value_offset, false, diagnostics, row_status.data()));
+
+  // Only the row that doesn't fit in the struct is reported.
+  ASSERT_EQ(RowStatus_SUCCESS, row_status[0]);
+  ASSERT_EQ(RowStatus_ERROR, row_status[1]);
+  ASSERT_EQ(RowStatus_SUCCESS, row_status[2]);
+  ASSERT_TRUE(diagnostics.HasError());
+  ASSERT_EQ(1, diagnostics.GetRecordCount());
+  ASSERT_EQ("22003", diagnostics.GetSQLState(0));
+
+  ASSERT_STREQ("1.5", ConvertNumericToString(buffer[0]).c_str());
+  ASSERT_STREQ("-2.5", ConvertNumericToString(buffer[2]).c_str());
+}
+
+TEST(DecimalArrayFlightSqlAccessor, Test_Decimal256Array_CDataType_NUMERIC_GetDataOverflow) {
+  auto decimal_type = std::make_shared<arrow::Decimal256Type>(50, 1);
+  const std::vector <Decimal256> &values =
+      MakeDecimal256Vector({"123456789012345678901234567890123456789012345.5"}, decimal_type->scale());
+
+  std::shared_ptr <Array> array;
+  ArrayFromVector<Decimal256Type, Decimal256>(decimal_type, values, &array);
+
+  DecimalArrayFlightSqlAccessor <Decimal256Array, CDataType_NUMERIC> accessor(array.get());
+
+  NUMERIC_STRUCT buffer;
+  ssize_t strlen_buffer;
+  ColumnBinding binding(CDataType_NUMERIC, 38, 1, &buffer, 0, &strlen_buffer);
+
+  // SQLGetData has no row status to report the error on, so the call fails.
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  try {
+    accessor.GetColumnarData(&binding, 0, 1, value_offset, true, diagnostics, nullptr);
+    FAIL() << "Expected the value to be out of range";
+  } catch (const DriverException &e) {
+    ASSERT_EQ("22003", e.GetSqlState());
+  }
+  ASSERT_EQ(0, diagnostics.GetRecordCount());
+}
+
+TEST(DecimalArrayFlightSqlAccessor, Test_Decimal256Array_CDataType_CHAR) {
+  const std::vector <std::string> &input_values = {"25.212", "-25.212", "123456789012345678901234567890123456789012345.123"};
+
+  auto decimal_type = std::make_shared<arrow::Decimal256Type>(60, 3);
+  const std::vector <Decimal256> &values = MakeDecimal256Vector(input_values, decimal_type->scale());
+
+  std::shared_ptr <Array> array;
+  ArrayFromVector<Decimal256Type, Decimal256>(decimal_type, values, &array);
+
+  DecimalArrayFlightSqlAccessor <Decimal256Array, CDataType_CHAR> accessor(array.get());
+
+  size_t max_strlen = 64;
+  std::vector <char> buffer(values.size() * max_strlen);
+  std::vector <ssize_t> strlen_buffer(values.size());
+
+  ColumnBinding binding(CDataType_CHAR, 0, 0, buffer.data(), max_strlen, strlen_buffer.data());
+
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  ASSERT_EQ(values.size(),
+            accessor.GetColumnarData(&binding, 0, values.size(), value_offset, false, diagnostics, nullptr));
+
+  for (int i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(input_values[i].length(), strlen_buffer[i]);
+    ASSERT_EQ(input_values[i], std::string(buffer.data() + i * max_strlen));
+  }
+}
+
+TEST(DecimalArrayFlightSqlAccessor, Test_Decimal256Array_CDataType_CHAR_Truncation) {
+  const std::vector <std::string> &input_values = {"-123456789.123"};
+
+  auto decimal_type = std::make_shared<arrow::Decimal256Type>(60, 3);
+  const std::vector <Decimal256> &values = MakeDecimal256Vector(input_values, decimal_type->scale());
+
+  std::shared_ptr <Array> array;
+  ArrayFromVector<Decimal256Type, Decimal256>(decimal_type, values, &array);
+
+  DecimalArrayFlightSqlAccessor <Decimal256Array, CDataType_CHAR> accessor(array.get());
+
+  size_t max_strlen = 8;
+  std::vector <char> buffer(values.size() * max_strlen);
+  std::vector <ssize_t> strlen_buffer(values.size());
+
+  ColumnBinding binding(CDataType_CHAR, 0, 0, buffer.data(), max_strlen, strlen_buffer.data());
+
+  std::stringstream ss;
+  int64_t value_offset = 0;
+
+  // Construct the whole string by concatenating smaller chunks from
+  // GetColumnarData
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  do {
+    diagnostics.Clear();
+    int64_t original_value_offset = value_offset;
+    ASSERT_EQ(1, accessor.GetColumnarData(&binding, 0, 1, value_offset, true, diagnostics, nullptr));
+    ASSERT_EQ(input_values[0].length() - original_value_offset, strlen_buffer[0]);
+
+    ss << buffer.data();
+  } while (value_offset < input_values[0].length() && value_offset != -1);
+
+  ASSERT_EQ(input_values[0], ss.str());
+}
+
+TEST(DecimalArrayFlightSqlAccessor, Test_Decimal256Array_CDataType_DOUBLE) {
+  const std::vector <std::string> &input_values = {"25.25", "-25.25", "0.5"};
+  const std::vector <double> &output_values = {25.25, -25.25, 0.5};
+
+  auto decimal_type = std::make_shared<arrow::Decimal256Type>(60, 2);
+  const std::vector <Decimal256> &values = MakeDecimal256Vector(input_values, decimal_type->scale());
+
+  std::shared_ptr <Array> array;
+  ArrayFromVector<Decimal256Type, Decimal256>(decimal_type, values, &array);
+
+  DecimalArrayFlightSqlAccessor <Decimal256Array, CDataType_DOUBLE> accessor(array.get());
+
+  std::vector <double> buffer(values.size());
+  std::vector <ssize_t> strlen_buffer(values.size());
+
+  ColumnBinding binding(CDataType_DOUBLE, 0, 0, buffer.data(), 0, strlen_buffer.data());
+
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  ASSERT_EQ(values.size(),
+            accessor.GetColumnarData(&binding, 0, values.size(), value_offset, false, diagnostics, nullptr));
+
+  for (int i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(sizeof(double), strlen_buffer[i]);
+    ASSERT_DOUBLE_EQ(output_values[i], buffer[i]);
+  }
+}
+
 } // namespace flight_sql
 } // namespace driver
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "fixed_size_binary_array_accessor.h"
+
+#include "binary_array_accessor.h"
+#include <arrow/array.h>
+#include <cstring>
+
+namespace driver {
+namespace flight_sql {
+
+using namespace arrow;
+using namespace odbcabstraction;
+
+namespace {
+
+constexpr int32_t GUID_BYTE_WIDTH = 16;
+
+inline uint32_t LoadBigEndian32(const uint8_t *bytes) {
+  return (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) |
+         (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]);
+}
+
+inline uint16_t LoadBigEndian16(const uint8_t *bytes) {
+  return static_cast<uint16_t>((bytes[0] << 8) | bytes[1]);
+}
+
+} // namespace
+
+template <CDataType TARGET_TYPE, typename CHAR_TYPE>
+FixedSizeBinaryArrayFlightSqlAccessor<TARGET_TYPE, CHAR_TYPE>::FixedSizeBinaryArrayFlightSqlAccessor(
+    Array *array)
+    : FlightSqlAccessor<FixedSizeBinaryArray, TARGET_TYPE,
+                        FixedSizeBinaryArrayFlightSqlAccessor<TARGET_TYPE, CHAR_TYPE>>(array) {
+  if (TARGET_TYPE == CDataType_GUID && this->GetArray()->byte_width() != GUID_BYTE_WIDTH) {
+    throw DriverException("Only 16 byte wide binary values can be converted to GUID, got " +
+                          std::to_string(this->GetArray()->byte_width()), "07006");
+  }
+}
+
+template <CDataType TARGET_TYPE, typename CHAR_TYPE>
+RowStatus FixedSizeBinaryArrayFlightSqlAccessor<TARGET_TYPE, CHAR_TYPE>::MoveSingleCell_impl(
+    ColumnBinding *binding, int64_t arrow_row, int64_t i, int64_t &value_offset,
+    bool update_value_offset, odbcabstraction::Diagnostics &diagnostics) {
+  FixedSizeBinaryArray *array = this->GetArray();
+  return MoveSingleCellToHexBuffer<CHAR_TYPE>(binding, array->GetValue(arrow_row),
+                                              array->byte_width(), i, value_offset,
+                                              update_value_offset, diagnostics);
+}
+
+template <>
+RowStatus FixedSizeBinaryArrayFlightSqlAccessor<CDataType_BINARY>::MoveSingleCell_impl(
+    ColumnBinding *binding, int64_t arrow_row, int64_t i, int64_t &value_offset,
+    bool update_value_offset, odbcabstraction::Diagnostics &diagnostics) {
+  FixedSizeBinaryArray *array = this->GetArray();
+  return MoveSingleCellToBinaryBuffer(binding, array->GetValue(arrow_row), array->byte_width(),
+                                      i, value_offset, update_value_offset, diagnostics);
+}
+
+template <>
+RowStatus FixedSizeBinaryArrayFlightSqlAccessor<CDataType_GUID>::MoveSingleCell_impl(
+    ColumnBinding *binding, int64_t arrow_row, int64_t i, int64_t &value_offset,
+    bool update_value_offset, odbcabstraction::Diagnostics &diagnostics) {
+  // UUIDs are stored in network byte order, while SQLGUID keeps its first three
+  // fields in host order.
+  const uint8_t *value = this->GetArray()->GetValue(arrow_row);
+  auto *buffer = static_cast<GUID_STRUCT *>(binding->buffer);
+  buffer[i].data1 = LoadBigEndian32(value);
+  buffer[i].data2 = LoadBigEndian16(value + 4);
+  buffer[i].data3 = LoadBigEndian16(value + 6);
+  std::memcpy(buffer[i].data4, value + 8, sizeof(buffer[i].data4));
+
+  if (binding->strlen_buffer) {
+    binding->strlen_buffer[i] = static_cast<ssize_t>(sizeof(GUID_STRUCT));
+  }
+
+  return odbcabstraction::RowStatus_SUCCESS;
+}
+
+template <CDataType TARGET_TYPE, typename CHAR_TYPE>
+size_t FixedSizeBinaryArrayFlightSqlAccessor<TARGET_TYPE, CHAR_TYPE>::GetCellLength_impl(
+    ColumnBinding *binding) const {
+  return binding->buffer_length;
+}
+
+template <>
+size_t FixedSizeBinaryArrayFlightSqlAccessor<CDataType_GUID>::GetCellLength_impl(
+    ColumnBinding *binding) const {
+  return sizeof(GUID_STRUCT);
+}
+
+template class FixedSizeBinaryArrayFlightSqlAccessor<odbcabstraction::CDataType_BINARY>;
+template class FixedSizeBinaryArrayFlightSqlAccessor<odbcabstraction::CDataType_CHAR, char>;
+template class FixedSizeBinaryArrayFlightSqlAccessor<odbcabstraction::CDataType_WCHAR, char16_t>;
+template class FixedSizeBinaryArrayFlightSqlAccessor<odbcabstraction::CDataType_WCHAR, char32_t>;
+template class FixedSizeBinaryArrayFlightSqlAccessor<odbcabstraction::CDataType_GUID>;
+
+} // namespace flight_sql
+} // namespace driver
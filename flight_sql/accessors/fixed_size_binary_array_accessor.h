@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#pragma once
+
+#include "arrow/type_fwd.h"
+#include "types.h"
+#include <odbcabstraction/encoding.h>
+#include <odbcabstraction/types.h>
+
+namespace driver {
+namespace flight_sql {
+
+using namespace arrow;
+using namespace odbcabstraction;
+
+/// \brief Reads FIXED_SIZE_BINARY values in place. Besides the BINARY and hexadecimal
+/// CHAR/WCHAR conversions of variable-length binaries, 16 byte wide columns such as
+/// UUIDs can be fetched as GUID_STRUCT.
+template <CDataType TARGET_TYPE, typename CHAR_TYPE = char>
+class FixedSizeBinaryArrayFlightSqlAccessor
+    : public FlightSqlAccessor<FixedSizeBinaryArray, TARGET_TYPE,
+                               FixedSizeBinaryArrayFlightSqlAccessor<TARGET_TYPE, CHAR_TYPE>> {
+public:
+  explicit FixedSizeBinaryArrayFlightSqlAccessor(Array *array);
+
+  RowStatus MoveSingleCell_impl(ColumnBinding *binding, int64_t arrow_row, int64_t i,
+                                int64_t &value_offset, bool update_value_offset,
+                                odbcabstraction::Diagnostics &diagnostics);
+
+  size_t GetCellLength_impl(ColumnBinding *binding) const;
+};
+
+inline Accessor* CreateWCharFixedSizeBinaryArrayAccessor(arrow::Array *array) {
+  switch(GetSqlWCharSize()) {
+    case sizeof(char16_t):
+      return new FixedSizeBinaryArrayFlightSqlAccessor<CDataType_WCHAR, char16_t>(array);
+    case sizeof(char32_t):
+      return new FixedSizeBinaryArrayFlightSqlAccessor<CDataType_WCHAR, char32_t>(array);
+    default:
+      assert(false);
+      throw DriverException("Encoding is unsupported, SQLWCHAR size: " + std::to_string(GetSqlWCharSize()));
+  }
+}
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "arrow/testing/gtest_util.h"
+#include "arrow/testing/builder.h"
+#include "fixed_size_binary_array_accessor.h"
+#include "gtest/gtest.h"
+
+namespace driver {
+namespace flight_sql {
+
+using namespace arrow;
+using namespace odbcabstraction;
+
+namespace {
+std::shared_ptr<Array> MakeFixedSizeBinaryArray(int32_t byte_width,
+                                                const std::vector<std::string> &values) {
+  FixedSizeBinaryBuilder builder(fixed_size_binary(byte_width));
+  for (const std::string &value : values) {
+    ARROW_EXPECT_OK(builder.Append(value));
+  }
+  ARROW_EXPECT_OK(builder.AppendNull());
+  std::shared_ptr<Array> array;
+  ARROW_EXPECT_OK(builder.Finish(&array));
+  return array;
+}
+}
+
+TEST(FixedSizeBinaryArrayAccessor, Test_CDataType_BINARY_Basic) {
+  std::vector<std::string> values = {"abc", std::string("d\0f", 3)};
+  std::shared_ptr<Array> array = MakeFixedSizeBinaryArray(3, values);
+
+  FixedSizeBinaryArrayFlightSqlAccessor<CDataType_BINARY> accessor(array.get());
+
+  size_t max_strlen = 8;
+  std::vector<char> buffer(array->length() * max_strlen);
+  std::vector<ssize_t> strlen_buffer(array->length());
+
+  ColumnBinding binding(CDataType_BINARY, 0, 0, buffer.data(), max_strlen,
+                        strlen_buffer.data());
+
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  ASSERT_EQ(array->length(),
+            accessor.GetColumnarData(&binding, 0, array->length(), value_offset, false, diagnostics, nullptr));
+
+  for (int i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(3, strlen_buffer[i]);
+    ASSERT_EQ(values[i], std::string(buffer.data() + i * max_strlen, 3));
+  }
+  ASSERT_EQ(odbcabstraction::NULL_DATA, strlen_buffer[values.size()]);
+}
+
+TEST(FixedSizeBinaryArrayAccessor, Test_CDataType_CHAR_Hex) {
+  std::vector<std::string> values = {std::string("\x00\x7f\x80\xff", 4), "\x12\x34\x56\x78"};
+  std::vector<std::string> expected = {"007F80FF", "12345678"};
+  std::shared_ptr<Array> array = MakeFixedSizeBinaryArray(4, values);
+
+  FixedSizeBinaryArrayFlightSqlAccessor<CDataType_CHAR, char> accessor(array.get());
+
+  size_t max_strlen = 16;
+  std::vector<char> buffer(array->length() * max_strlen);
+  std::vector<ssize_t> strlen_buffer(array->length());
+
+  ColumnBinding binding(CDataType_CHAR, 0, 0, buffer.data(), max_strlen,
+                        strlen_buffer.data());
+
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  ASSERT_EQ(array->length(),
+            accessor.GetColumnarData(&binding, 0, array->length(), value_offset, false, diagnostics, nullptr));
+
+  for (int i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(expected[i].length(), strlen_buffer[i]);
+    ASSERT_EQ(expected[i], std::string(buffer.data() + i * max_strlen));
+  }
+}
+
+TEST(FixedSizeBinaryArrayAccessor, Test_CDataType_GUID_ByteOrder) {
+  // 00112233-4455-6677-8899-aabbccddeeff in RFC 4122 byte order.
+  std::vector<std::string> values = {
+      std::string("\x00\x11\x22\x33\x44\x55\x66\x77\x88\x99\xaa\xbb\xcc\xdd\xee\xff", 16)};
+  std::shared_ptr<Array> array = MakeFixedSizeBinaryArray(16, values);
+
+  FixedSizeBinaryArrayFlightSqlAccessor<CDataType_GUID> accessor(array.get());
+
+  std::vector<GUID_STRUCT> buffer(array->length());
+  std::vector<ssize_t> strlen_buffer(array->length());
+
+  ColumnBinding binding(CDataType_GUID, 0, 0, buffer.data(), 0, strlen_buffer.data());
+
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  ASSERT_EQ(array->length(),
+            accessor.GetColumnarData(&binding, 0, array->length(), value_offset, false, diagnostics, nullptr));
+
+  ASSERT_EQ(sizeof(GUID_STRUCT), strlen_buffer[0]);
+  ASSERT_EQ(0x00112233u, buffer[0].data1);
+  ASSERT_EQ(0x4455u, buffer[0].data2);
+  ASSERT_EQ(0x6677u, buffer[0].data3);
+  const uint8_t data4[] = {0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+  ASSERT_EQ(0, memcmp(data4, buffer[0].data4, sizeof(data4)));
+  ASSERT_EQ(odbcabstraction::NULL_DATA, strlen_buffer[1]);
+}
+
+TEST(FixedSizeBinaryArrayAccessor, Test_CDataType_GUID_RejectsOtherWidths) {
+  std::shared_ptr<Array> array = MakeFixedSizeBinaryArray(8, {"01234567"});
+
+  ASSERT_THROW(FixedSizeBinaryArrayFlightSqlAccessor<CDataType_GUID> accessor(array.get()),
+               DriverException);
+}
+
+} // namespace flight_sql
+} // namespace driver
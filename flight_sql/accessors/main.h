@@ -12,5 +12,9 @@
 #include "time_array_accessor.h"
 #include "timestamp_array_accessor.h"
 #include "decimal_array_accessor.h"
+#include "fixed_size_binary_array_accessor.h"
+#include "numeric_conversion_array_accessor.h"
 #include "primitive_array_accessor.h"
 #include "string_array_accessor.h"
+#include "string_view_array_accessor.h"
+#include "temporal_text_array_accessor.h"
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "numeric_conversion_array_accessor.h"
+
+#include "common.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace driver {
+namespace flight_sql {
+
+using namespace arrow;
+using namespace odbcabstraction;
+
+namespace {
+
+enum ConversionStatus {
+  ConversionStatus_OK,
+  ConversionStatus_FRACTIONAL_TRUNCATION,
+  ConversionStatus_OUT_OF_RANGE
+};
+
+/// Whether every SOURCE value is representable as TARGET, possibly losing precision
+/// when converted to a floating point type, which ODBC doesn't report.
+template <typename SOURCE, typename TARGET>
+struct IsAlwaysInRange
+    : std::integral_constant<
+          bool, std::is_floating_point<TARGET>::value
+                    ? std::is_integral<SOURCE>::value || sizeof(TARGET) >= sizeof(SOURCE)
+                    : std::is_integral<SOURCE>::value &&
+                          (std::is_signed<SOURCE>::value == std::is_signed<TARGET>::value
+                               ? sizeof(TARGET) >= sizeof(SOURCE)
+                               : !std::is_signed<SOURCE>::value && sizeof(TARGET) > sizeof(SOURCE))> {};
+
+template <typename TARGET, typename SOURCE>
+typename std::enable_if<std::is_integral<SOURCE>::value && std::is_integral<TARGET>::value,
+                        ConversionStatus>::type
+ConvertNumber(SOURCE value, TARGET &out) {
+  bool in_range;
+  if (std::is_signed<SOURCE>::value) {
+    const intmax_t signed_value = static_cast<intmax_t>(value);
+    in_range = signed_value >= static_cast<intmax_t>(std::numeric_limits<TARGET>::min()) &&
+               (signed_value < 0 || static_cast<uintmax_t>(signed_value) <=
+                                        static_cast<uintmax_t>(std::numeric_limits<TARGET>::max()));
+  } else {
+    in_range = static_cast<uintmax_t>(value) <=
+               static_cast<uintmax_t>(std::numeric_limits<TARGET>::max());
+  }
+  if (!in_range) {
+    return ConversionStatus_OUT_OF_RANGE;
+  }
+  out = static_cast<TARGET>(value);
+  return ConversionStatus_OK;
+}
+
+template <typename TARGET, typename SOURCE>
+typename std::enable_if<std::is_floating_point<SOURCE>::value && std::is_integral<TARGET>::value,
+                        ConversionStatus>::type
+ConvertNumber(SOURCE value, TARGET &out) {
+  // The bounds are powers of two, hence exact as doubles, unlike the maximum of the
+  // 64-bit types. NaN fails both comparisons.
+  const double truncated = std::trunc(static_cast<double>(value));
+  const double upper = std::ldexp(1.0, std::numeric_limits<TARGET>::digits);
+  const double lower = std::is_signed<TARGET>::value ? -upper : 0.0;
+  if (!(truncated >= lower && truncated < upper)) {
+    return ConversionStatus_OUT_OF_RANGE;
+  }
+  out = static_cast<TARGET>(truncated);
+  return truncated == value ? ConversionStatus_OK : ConversionStatus_FRACTIONAL_TRUNCATION;
+}
+
+template <typename TARGET, typename SOURCE>
+typename std::enable_if<std::is_floating_point<TARGET>::value, ConversionStatus>::type
+ConvertNumber(SOURCE value, TARGET &out) {
+  // Only a double can exceed the range of a float, infinities and NaN carry over.
+  if (std::is_floating_point<SOURCE>::value && std::isfinite(value) &&
+      std::fabs(value) > std::numeric_limits<TARGET>::max()) {
+    return ConversionStatus_OUT_OF_RANGE;
+  }
+  out = static_cast<TARGET>(value);
+  return ConversionStatus_OK;
+}
+
+template <typename ARROW_ARRAY>
+Accessor *CreateSourceAccessor(arrow::Array *array, CDataType target_type) {
+  switch (target_type) {
+    case CDataType_STINYINT:
+      return new NumericConversionArrayFlightSqlAccessor<ARROW_ARRAY, CDataType_STINYINT>(array);
+    case CDataType_UTINYINT:
+      return new NumericConversionArrayFlightSqlAccessor<ARROW_ARRAY, CDataType_UTINYINT>(array);
+    case CDataType_SSHORT:
+      return new NumericConversionArrayFlightSqlAccessor<ARROW_ARRAY, CDataType_SSHORT>(array);
+    case CDataType_USHORT:
+      return new NumericConversionArrayFlightSqlAccessor<ARROW_ARRAY, CDataType_USHORT>(array);
+    case CDataType_SLONG:
+      return new NumericConversionArrayFlightSqlAccessor<ARROW_ARRAY, CDataType_SLONG>(array);
+    case CDataType_ULONG:
+      return new NumericConversionArrayFlightSqlAccessor<ARROW_ARRAY, CDataType_ULONG>(array);
+    case CDataType_SBIGINT:
+      return new NumericConversionArrayFlightSqlAccessor<ARROW_ARRAY, CDataType_SBIGINT>(array);
+    case CDataType_UBIGINT:
+      return new NumericConversionArrayFlightSqlAccessor<ARROW_ARRAY, CDataType_UBIGINT>(array);
+    case CDataType_FLOAT:
+      return new NumericConversionArrayFlightSqlAccessor<ARROW_ARRAY, CDataType_FLOAT>(array);
+    case CDataType_DOUBLE:
+      return new NumericConversionArrayFlightSqlAccessor<ARROW_ARRAY, CDataType_DOUBLE>(array);
+    default:
+      return nullptr;
+  }
+}
+
+} // namespace
+
+template <typename ARROW_ARRAY, CDataType TARGET_TYPE>
+NumericConversionArrayFlightSqlAccessor<
+    ARROW_ARRAY, TARGET_TYPE>::NumericConversionArrayFlightSqlAccessor(Array *array)
+    : FlightSqlAccessor<
+          ARROW_ARRAY, TARGET_TYPE,
+          NumericConversionArrayFlightSqlAccessor<ARROW_ARRAY, TARGET_TYPE>>(array) {}
+
+template <typename ARROW_ARRAY, CDataType TARGET_TYPE>
+size_t
+NumericConversionArrayFlightSqlAccessor<ARROW_ARRAY, TARGET_TYPE>::GetColumnarData_impl(
+    ColumnBinding *binding, int64_t starting_row,
+    int64_t cells, int64_t &value_offset, bool update_value_offset,
+    odbcabstraction::Diagnostics &diagnostics, uint16_t* row_status_array) {
+  typedef typename ARROW_ARRAY::value_type SourceType;
+  typedef typename NumericCType<TARGET_TYPE>::type TargetType;
+
+  ARROW_ARRAY *array = this->GetArray();
+  WriteFixedLengthIndicators(array, binding, starting_row, cells, sizeof(TargetType));
+
+  const SourceType *values = array->raw_values() + starting_row;
+  auto *buffer = static_cast<TargetType *>(binding->buffer);
+
+  if (IsAlwaysInRange<SourceType, TargetType>::value) {
+    // Null slots hold unspecified values, converting them anyway keeps the loop
+    // free of branches.
+    for (int64_t i = 0; i < cells; ++i) {
+      buffer[i] = static_cast<TargetType>(values[i]);
+    }
+    return static_cast<size_t>(cells);
+  }
+
+  const bool has_nulls = array->null_count() > 0;
+  for (int64_t i = 0; i < cells; ++i) {
+    if (has_nulls && array->IsNull(starting_row + i)) {
+      continue;
+    }
+
+    RowStatus row_status;
+    switch (ConvertNumber(values[i], buffer[i])) {
+      case ConversionStatus_OK:
+        continue;
+      case ConversionStatus_FRACTIONAL_TRUNCATION:
+        diagnostics.AddFractionalTruncationWarning(i);
+        row_status = odbcabstraction::RowStatus_SUCCESS_WITH_INFO;
+        break;
+      default:
+        // Without a row status array, as for SQLGetData, the call itself fails.
+        if (!row_status_array) {
+          throw NumericValueOutOfRangeException();
+        }
+        diagnostics.AddNumericOutOfRangeError(i);
+        row_status = odbcabstraction::RowStatus_ERROR;
+        break;
+    }
+    if (row_status_array && row_status_array[i] != odbcabstraction::RowStatus_ERROR) {
+      row_status_array[i] = row_status;
+    }
+  }
+
+  return static_cast<size_t>(cells);
+}
+
+template <typename ARROW_ARRAY, CDataType TARGET_TYPE>
+size_t NumericConversionArrayFlightSqlAccessor<ARROW_ARRAY, TARGET_TYPE>::GetCellLength_impl(
+    ColumnBinding *binding) const {
+  return sizeof(typename NumericCType<TARGET_TYPE>::type);
+}
+
+bool IsNumericCDataType(CDataType target_type) {
+  switch (target_type) {
+    case CDataType_STINYINT:
+    case CDataType_UTINYINT:
+    case CDataType_SSHORT:
+    case CDataType_USHORT:
+    case CDataType_SLONG:
+    case CDataType_ULONG:
+    case CDataType_SBIGINT:
+    case CDataType_UBIGINT:
+    case CDataType_FLOAT:
+    case CDataType_DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+Accessor *CreateNumericConversionAccessor(arrow::Array *array, CDataType target_type) {
+  switch (array->type_id()) {
+    case arrow::Type::INT8:
+      return CreateSourceAccessor<Int8Array>(array, target_type);
+    case arrow::Type::UINT8:
+      return CreateSourceAccessor<UInt8Array>(array, target_type);
+    case arrow::Type::INT16:
+      return CreateSourceAccessor<Int16Array>(array, target_type);
+    case arrow::Type::UINT16:
+      return CreateSourceAccessor<UInt16Array>(array, target_type);
+    case arrow::Type::INT32:
+      return CreateSourceAccessor<Int32Array>(array, target_type);
+    case arrow::Type::UINT32:
+      return CreateSourceAccessor<UInt32Array>(array, target_type);
+    case arrow::Type::INT64:
+      return CreateSourceAccessor<Int64Array>(array, target_type);
+    case arrow::Type::UINT64:
+      return CreateSourceAccessor<UInt64Array>(array, target_type);
+    case arrow::Type::FLOAT:
+      return CreateSourceAccessor<FloatArray>(array, target_type);
+    case arrow::Type::DOUBLE:
+      return CreateSourceAccessor<DoubleArray>(array, target_type);
+    default:
+      return nullptr;
+  }
+}
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#pragma once
+
+#include "types.h"
+#include <arrow/array.h>
+#include <odbcabstraction/types.h>
+
+namespace driver {
+namespace flight_sql {
+
+using namespace arrow;
+using namespace odbcabstraction;
+
+/// \brief C type written for each numeric CDataType.
+template <CDataType TARGET_TYPE>
+struct NumericCType;
+
+template <> struct NumericCType<CDataType_STINYINT> { typedef int8_t type; };
+template <> struct NumericCType<CDataType_UTINYINT> { typedef uint8_t type; };
+template <> struct NumericCType<CDataType_SSHORT> { typedef int16_t type; };
+template <> struct NumericCType<CDataType_USHORT> { typedef uint16_t type; };
+template <> struct NumericCType<CDataType_SLONG> { typedef int32_t type; };
+template <> struct NumericCType<CDataType_ULONG> { typedef uint32_t type; };
+template <> struct NumericCType<CDataType_SBIGINT> { typedef int64_t type; };
+template <> struct NumericCType<CDataType_UBIGINT> { typedef uint64_t type; };
+template <> struct NumericCType<CDataType_FLOAT> { typedef float type; };
+template <> struct NumericCType<CDataType_DOUBLE> { typedef double type; };
+
+/// \brief Converts integer and floating point columns to another numeric C type while
+/// writing them to the bound buffers, as opposed to casting the whole array first.
+///
+/// Following the ODBC conversion rules, a value that doesn't fit in the target type
+/// fails its own row with 22003, and a floating point value losing its fractional
+/// digits when converted to an integer is written with a 01S07 warning.
+template <typename ARROW_ARRAY, CDataType TARGET_TYPE>
+class NumericConversionArrayFlightSqlAccessor
+    : public FlightSqlAccessor<
+          ARROW_ARRAY, TARGET_TYPE,
+          NumericConversionArrayFlightSqlAccessor<ARROW_ARRAY, TARGET_TYPE>> {
+public:
+  explicit NumericConversionArrayFlightSqlAccessor(Array *array);
+
+  size_t GetColumnarData_impl(ColumnBinding *binding, int64_t starting_row, int64_t cells,
+                              int64_t &value_offset, bool update_value_offset,
+                              odbcabstraction::Diagnostics &diagnostics, uint16_t* row_status_array);
+
+  size_t GetCellLength_impl(ColumnBinding *binding) const;
+};
+
+/// \brief Whether the C type is one of the integer or floating point types above.
+bool IsNumericCDataType(CDataType target_type);
+
+/// \brief Creates a NumericConversionArrayFlightSqlAccessor for an integer or floating
+/// point array and a numeric target type.
+/// \return nullptr if either type is not numeric.
+Accessor *CreateNumericConversionAccessor(arrow::Array *array, CDataType target_type);
+
+} // namespace flight_sql
+} // namespace driver
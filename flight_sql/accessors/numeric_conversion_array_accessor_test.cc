@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "arrow/testing/builder.h"
+#include "numeric_conversion_array_accessor.h"
+#include <odbcabstraction/diagnostics.h>
+#include "gtest/gtest.h"
+#include <cmath>
+#include <limits>
+
+namespace driver {
+namespace flight_sql {
+
+using namespace arrow;
+using namespace odbcabstraction;
+
+TEST(NumericConversionArrayFlightSqlAccessor, Test_Int32Array_CDataType_SBIGINT_Widening) {
+  std::vector<int32_t> values = {std::numeric_limits<int32_t>::min(), -1, 0, 42,
+                                 std::numeric_limits<int32_t>::max()};
+  std::vector<bool> is_valid = {true, true, false, true, true};
+  std::shared_ptr<Array> array;
+  ArrayFromVector<Int32Type, int32_t>(is_valid, values, &array);
+
+  NumericConversionArrayFlightSqlAccessor<Int32Array, CDataType_SBIGINT> accessor(array.get());
+
+  std::vector<int64_t> buffer(values.size());
+  std::vector<ssize_t> strlen_buffer(values.size());
+  ColumnBinding binding(CDataType_SBIGINT, 0, 0, buffer.data(), 0, strlen_buffer.data());
+
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  ASSERT_EQ(values.size(),
+            accessor.GetColumnarData(&binding, 0, values.size(), value_offset, false, diagnostics, nullptr));
+
+  for (int i = 0; i < values.size(); ++i) {
+    if (is_valid[i]) {
+      ASSERT_EQ(sizeof(int64_t), strlen_buffer[i]);
+      ASSERT_EQ(values[i], buffer[i]);
+    } else {
+      ASSERT_EQ(odbcabstraction::NULL_DATA, strlen_buffer[i]);
+    }
+  }
+  ASSERT_EQ(0, diagnostics.GetRecordCount());
+}
+
+TEST(NumericConversionArrayFlightSqlAccessor, Test_DoubleArray_CDataType_SLONG_PerRowStatus) {
+  std::vector<double> values = {1.0, 2.75, 3e10, -4.5, std::nan(""), -2147483648.0};
+  std::shared_ptr<Array> array;
+  ArrayFromVector<DoubleType, double>(values, &array);
+
+  NumericConversionArrayFlightSqlAccessor<DoubleArray, CDataType_SLONG> accessor(array.get());
+
+  std::vector<int32_t> buffer(values.size());
+  std::vector<ssize_t> strlen_buffer(values.size());
+  std::vector<uint16_t> row_status(values.size(), RowStatus_SUCCESS);
+  ColumnBinding binding(CDataType_SLONG, 0, 0, buffer.data(), 0, strlen_buffer.data());
+
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  ASSERT_EQ(values.size(),
+            accessor.GetColumnarData(&binding, 0, values.size(), value_offset, false, diagnostics,
+                                     row_status.data()));
+
+  // Values out of range fail their own row only, fractions are truncated with a warning.
+  ASSERT_EQ(RowStatus_SUCCESS, row_status[0]);
+  ASSERT_EQ(RowStatus_SUCCESS_WITH_INFO, row_status[1]);
+  ASSERT_EQ(RowStatus_ERROR, row_status[2]);
+  ASSERT_EQ(RowStatus_SUCCESS_WITH_INFO, row_status[3]);
+  ASSERT_EQ(RowStatus_ERROR, row_status[4]);
+  ASSERT_EQ(RowStatus_SUCCESS, row_status[5]);
+  ASSERT_EQ(1, buffer[0]);
+  ASSERT_EQ(2, buffer[1]);
+  ASSERT_EQ(-4, buffer[3]);
+  ASSERT_EQ(std::numeric_limits<int32_t>::min(), buffer[5]);
+
+  ASSERT_EQ(2, diagnostics.GetRecordCount());
+  ASSERT_EQ("22003", diagnostics.GetSQLState(0));
+  ASSERT_EQ(2, diagnostics.GetRecordOccurrences(0).count_);
+  ASSERT_EQ("01S07", diagnostics.GetSQLState(1));
+  ASSERT_EQ(2, diagnostics.GetRecordOccurrences(1).count_);
+}
+
+TEST(NumericConversionArrayFlightSqlAccessor, Test_IntegerNarrowing_Overflow) {
+  std::vector<uint64_t> values = {0, static_cast<uint64_t>(std::numeric_limits<int64_t>::max()),
+                                  static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + 1};
+  std::shared_ptr<Array> array;
+  ArrayFromVector<UInt64Type, uint64_t>(values, &array);
+
+  NumericConversionArrayFlightSqlAccessor<UInt64Array, CDataType_SBIGINT> accessor(array.get());
+
+  std::vector<int64_t> buffer(values.size());
+  std::vector<uint16_t> row_status(values.size(), RowStatus_SUCCESS);
+  ColumnBinding binding(CDataType_SBIGINT, 0, 0, buffer.data(), 0, nullptr);
+
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  accessor.GetColumnarData(&binding, 0, values.size(), value_offset, false, diagnostics,
+                           row_status.data());
+
+  ASSERT_EQ(RowStatus_SUCCESS, row_status[0]);
+  ASSERT_EQ(RowStatus_SUCCESS, row_status[1]);
+  ASSERT_EQ(RowStatus_ERROR, row_status[2]);
+  ASSERT_EQ(std::numeric_limits<int64_t>::max(), buffer[1]);
+  ASSERT_EQ("22003", diagnostics.GetSQLState(0));
+}
+
+TEST(NumericConversionArrayFlightSqlAccessor, Test_GetData_Overflow) {
+  std::vector<int64_t> values = {1LL << 40};
+  std::shared_ptr<Array> array;
+  ArrayFromVector<Int64Type, int64_t>(values, &array);
+
+  NumericConversionArrayFlightSqlAccessor<Int64Array, CDataType_SLONG> accessor(array.get());
+
+  int32_t buffer = 0;
+  ssize_t strlen_buffer;
+  ColumnBinding binding(CDataType_SLONG, 0, 0, &buffer, 0, &strlen_buffer);
+
+  // SQLGetData has no row status to report the error on, so the call fails.
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  try {
+    accessor.GetColumnarData(&binding, 0, 1, value_offset, true, diagnostics, nullptr);
+    FAIL() << "Expected the value to be out of range";
+  } catch (const DriverException &e) {
+    ASSERT_EQ("22003", e.GetSqlState());
+  }
+  ASSERT_EQ(0, diagnostics.GetRecordCount());
+}
+
+TEST(NumericConversionArrayFlightSqlAccessor, Test_ToFloatingPoint) {
+  std::vector<int64_t> int_values = {-3, 1LL << 40};
+  std::shared_ptr<Array> int_array;
+  ArrayFromVector<Int64Type, int64_t>(int_values, &int_array);
+
+  NumericConversionArrayFlightSqlAccessor<Int64Array, CDataType_DOUBLE> to_double(int_array.get());
+  std::vector<double> double_buffer(int_values.size());
+  ColumnBinding double_binding(CDataType_DOUBLE, 0, 0, double_buffer.data(), 0, nullptr);
+
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  to_double.GetColumnarData(&double_binding, 0, int_values.size(), value_offset, false, diagnostics, nullptr);
+  ASSERT_EQ(-3.0, double_buffer[0]);
+  ASSERT_EQ(static_cast<double>(1LL << 40), double_buffer[1]);
+
+  std::vector<double> double_values = {0.5, 1e300};
+  std::shared_ptr<Array> double_array;
+  ArrayFromVector<DoubleType, double>(double_values, &double_array);
+
+  NumericConversionArrayFlightSqlAccessor<DoubleArray, CDataType_FLOAT> to_float(double_array.get());
+  std::vector<float> float_buffer(double_values.size());
+  std::vector<uint16_t> row_status(double_values.size(), RowStatus_SUCCESS);
+  ColumnBinding float_binding(CDataType_FLOAT, 0, 0, float_buffer.data(), 0, nullptr);
+  to_float.GetColumnarData(&float_binding, 0, double_values.size(), value_offset, false, diagnostics,
+                           row_status.data());
+  ASSERT_EQ(0.5f, float_buffer[0]);
+  ASSERT_EQ(RowStatus_SUCCESS, row_status[0]);
+  ASSERT_EQ(RowStatus_ERROR, row_status[1]);
+}
+
+TEST(NumericConversionArrayFlightSqlAccessor, Test_CreateOnlyForNumericTypes) {
+  std::vector<int16_t> values = {1};
+  std::shared_ptr<Array> array;
+  ArrayFromVector<Int16Type, int16_t>(values, &array);
+
+  std::unique_ptr<Accessor> accessor(CreateNumericConversionAccessor(array.get(), CDataType_DOUBLE));
+  ASSERT_NE(nullptr, accessor);
+  ASSERT_EQ(CDataType_DOUBLE, accessor->target_type_);
+  ASSERT_EQ(nullptr, CreateNumericConversionAccessor(array.get(), CDataType_CHAR));
+
+  std::vector<std::string> strings = {"1"};
+  std::shared_ptr<Array> string_array;
+  ArrayFromVector<StringType, std::string>(strings, &string_array);
+  ASSERT_EQ(nullptr, CreateNumericConversionAccessor(string_array.get(), CDataType_SLONG));
+}
+
+} // namespace flight_sql
+} // namespace driver
@@ -28,6 +28,13 @@ PrimitiveArrayFlightSqlAccessor<ARROW_ARRAY, TARGET_TYPE>::GetColumnarData_impl(
   return CopyFromArrayValuesToBinding<ARROW_ARRAY>(this->GetArray(), binding, starting_row, cells);
 }
 
+template <typename ARROW_ARRAY, CDataType TARGET_TYPE>
+size_t PrimitiveArrayFlightSqlAccessor<ARROW_ARRAY, TARGET_TYPE>::GetRowWiseData(
+    ColumnBinding *binding, int64_t starting_row, size_t cells, size_t row_size) {
+  return CopyFromArrayValuesToRowWiseBinding<ARROW_ARRAY>(this->GetArray(), binding, starting_row,
+                                                          static_cast<int64_t>(cells), row_size);
+}
+
 template <typename ARROW_ARRAY, CDataType TARGET_TYPE>
 size_t PrimitiveArrayFlightSqlAccessor<ARROW_ARRAY, TARGET_TYPE>::GetCellLength_impl(ColumnBinding *binding) const {
   return sizeof(typename ARROW_ARRAY::TypeClass::c_type);
@@ -31,6 +31,9 @@ public:
                               int64_t &value_offset, bool update_value_offset,
                               odbcabstraction::Diagnostics &diagnostics, uint16_t* row_status_array);
 
+  size_t GetRowWiseData(ColumnBinding *binding, int64_t starting_row, size_t cells,
+                        size_t row_size) override;
+
   size_t GetCellLength_impl(ColumnBinding *binding) const;
 };
 
@@ -84,5 +84,36 @@ TEST(PrimitiveArrayFlightSqlAccessor, Test_DoubleArray_CDataType_DOUBLE) {
   TestPrimitiveArraySqlAccessor<DoubleArray, CDataType_DOUBLE>();
 }
 
+TEST(PrimitiveArrayFlightSqlAccessor, Test_RowWiseData) {
+  // An application-side row: the value followed by its indicator.
+  struct Row {
+    int32_t value;
+    ssize_t indicator;
+  };
+
+  std::shared_ptr<Array> array;
+  ArrayFromVector<Int32Type>({true, false, true, true}, {10, 0, -7, 42}, &array);
+  PrimitiveArrayFlightSqlAccessor<Int32Array, CDataType_SLONG> accessor(array.get());
+
+  std::vector<Row> rows(3, Row{-1, -1});
+  ColumnBinding binding(CDataType_SLONG, 0, 0, &rows[0].value, sizeof(int32_t),
+                        &rows[0].indicator);
+  ASSERT_EQ(3, accessor.GetRowWiseData(&binding, 1, 3, sizeof(Row)));
+
+  ASSERT_EQ(odbcabstraction::NULL_DATA, rows[0].indicator);
+  ASSERT_EQ(sizeof(int32_t), rows[1].indicator);
+  ASSERT_EQ(-7, rows[1].value);
+  ASSERT_EQ(sizeof(int32_t), rows[2].indicator);
+  ASSERT_EQ(42, rows[2].value);
+
+  ColumnBinding without_indicators(CDataType_SLONG, 0, 0, &rows[0].value, sizeof(int32_t),
+                                   nullptr);
+  ASSERT_THROW(accessor.GetRowWiseData(&without_indicators, 0, 2, sizeof(Row)),
+               odbcabstraction::NullWithoutIndicatorException);
+  ASSERT_EQ(2, accessor.GetRowWiseData(&without_indicators, 2, 2, sizeof(Row)));
+  ASSERT_EQ(-7, rows[0].value);
+  ASSERT_EQ(42, rows[1].value);
+}
+
 } // namespace flight_sql
 } // namespace driver
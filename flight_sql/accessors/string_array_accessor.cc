@@ -30,6 +30,7 @@ std::string utf8_to_clocale(const char *utf8str, int len)
 
 template <typename CHAR_TYPE>
 inline RowStatus MoveSingleCellToCharBuffer(std::vector<uint8_t> &buffer,
+                                            ConversionMemo &memo,
                                             int64_t& last_retrieved_arrow_row,
 #if defined _WIN32 || defined _WIN64
                                             std::string &clocale_str,
@@ -49,7 +50,13 @@ inline RowStatus MoveSingleCellToCharBuffer(std::vector<uint8_t> &buffer,
   size_t size_in_bytes;
   if (sizeof(CHAR_TYPE) > sizeof(char)) {
     if (last_retrieved_arrow_row != arrow_row) {
-      Utf8ToWcs(raw_value, raw_value_length, &buffer);
+      const std::vector<uint8_t> *memoized = memo.Find(raw_value, raw_value_length);
+      if (memoized) {
+        buffer = *memoized;
+      } else {
+        Utf8ToWcs(raw_value, raw_value_length, &buffer);
+        memo.Insert(raw_value, raw_value_length, buffer);
+      }
       last_retrieved_arrow_row = arrow_row;
     }
     value = buffer.data();
@@ -58,7 +65,14 @@ inline RowStatus MoveSingleCellToCharBuffer(std::vector<uint8_t> &buffer,
 #if defined _WIN32 || defined _WIN64
     // Convert to C locale string
     if (last_retrieved_arrow_row != arrow_row) {
-      clocale_str = utf8_to_clocale(raw_value, raw_value_length);
+      const std::vector<uint8_t> *memoized = memo.Find(raw_value, raw_value_length);
+      if (memoized) {
+        clocale_str.assign(memoized->begin(), memoized->end());
+      } else {
+        clocale_str = utf8_to_clocale(raw_value, raw_value_length);
+        memo.Insert(raw_value, raw_value_length,
+                    std::vector<uint8_t>(clocale_str.begin(), clocale_str.end()));
+      }
       last_retrieved_arrow_row = arrow_row;
     }
     const char* clocale_data = clocale_str.data();
@@ -92,7 +106,7 @@ inline RowStatus MoveSingleCellToCharBuffer(std::vector<uint8_t> &buffer,
     }
   } else {
     result = odbcabstraction::RowStatus_SUCCESS_WITH_INFO;
-    diagnostics.AddTruncationWarning();
+    diagnostics.AddTruncationWarning(i);
     size_t chars_written = binding->buffer_length / sizeof(CHAR_TYPE);
     // If we failed to even write one char, the buffer is too small to hold a
     // NUL-terminator.
@@ -115,16 +129,17 @@ inline RowStatus MoveSingleCellToCharBuffer(std::vector<uint8_t> &buffer,
 
 template <CDataType TARGET_TYPE, typename CHAR_TYPE>
 StringArrayFlightSqlAccessor<TARGET_TYPE, CHAR_TYPE>::StringArrayFlightSqlAccessor(
-    Array *array)
+    Array *array, ConversionMemo *memo)
     : FlightSqlAccessor<StringArray, TARGET_TYPE,
                         StringArrayFlightSqlAccessor<TARGET_TYPE, CHAR_TYPE>>(array),
+      memo_(memo ? memo : &own_memo_),
       last_arrow_row_(-1){}
 
 template <CDataType TARGET_TYPE, typename CHAR_TYPE>
 RowStatus StringArrayFlightSqlAccessor<TARGET_TYPE, CHAR_TYPE>::MoveSingleCell_impl(
         ColumnBinding *binding, int64_t arrow_row, int64_t i, int64_t &value_offset,
         bool update_value_offset, odbcabstraction::Diagnostics &diagnostics) {
-    return MoveSingleCellToCharBuffer<CHAR_TYPE>(buffer_, last_arrow_row_,
+    return MoveSingleCellToCharBuffer<CHAR_TYPE>(buffer_, *memo_, last_arrow_row_,
 #if defined _WIN32 || defined _WIN64
                                                clocale_str_,
 #endif
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "arrow/type_fwd.h"
+#include "conversion_memo.h"
 #include "types.h"
 #include "utils.h"
 #include <locale>
@@ -24,7 +25,9 @@ class StringArrayFlightSqlAccessor
     : public FlightSqlAccessor<StringArray, TARGET_TYPE,
                                StringArrayFlightSqlAccessor<TARGET_TYPE, CHAR_TYPE>> {
 public:
-  explicit StringArrayFlightSqlAccessor(Array *array);
+  /// \param memo memo shared with the accessors of the column's other chunks, may be
+  ///        null for the accessor to keep its own.
+  explicit StringArrayFlightSqlAccessor(Array *array, ConversionMemo *memo = nullptr);
 
   RowStatus MoveSingleCell_impl(
       ColumnBinding *binding, int64_t arrow_row, int64_t i, int64_t &value_offset,
@@ -34,18 +37,20 @@ public:
 
 private:
   std::vector<uint8_t> buffer_;
+  ConversionMemo own_memo_;
+  ConversionMemo *memo_;
 #if defined _WIN32 || defined _WIN64
   std::string clocale_str_;
 #endif
   int64_t last_arrow_row_;
 };
 
-inline Accessor* CreateWCharStringArrayAccessor(arrow::Array *array) {
+inline Accessor* CreateWCharStringArrayAccessor(arrow::Array *array, ConversionMemo *memo = nullptr) {
   switch(GetSqlWCharSize()) {
     case sizeof(char16_t):
-      return new StringArrayFlightSqlAccessor<CDataType_WCHAR, char16_t>(array);
+      return new StringArrayFlightSqlAccessor<CDataType_WCHAR, char16_t>(array, memo);
     case sizeof(char32_t):
-      return new StringArrayFlightSqlAccessor<CDataType_WCHAR, char32_t>(array);
+      return new StringArrayFlightSqlAccessor<CDataType_WCHAR, char32_t>(array, memo);
     default:
       assert(false);
       throw DriverException("Encoding is unsupported, SQLWCHAR size: " + std::to_string(GetSqlWCharSize()));
@@ -73,6 +73,77 @@ TEST(StringArrayAccessor, Test_CDataType_CHAR_Truncation) {
   ASSERT_EQ(values[0], ss.str());
 }
 
+TEST(StringArrayAccessor, Test_CDataType_CHAR_Truncation_Aggregated) {
+  std::vector<std::string> values = {"ABCDEFGHIJ", "short", "KLMNOPQRST", "UVWXYZ0123"};
+  std::shared_ptr<Array> array;
+  ArrayFromVector<StringType, std::string>(values, &array);
+
+  StringArrayFlightSqlAccessor<CDataType_CHAR, char> accessor(array.get());
+
+  size_t max_strlen = 8;
+  std::vector<char> buffer(values.size() * max_strlen);
+  std::vector<ssize_t> strlen_buffer(values.size());
+  std::vector<uint16_t> row_status(values.size(), RowStatus_SUCCESS);
+
+  ColumnBinding binding(CDataType_CHAR, 0, 0, buffer.data(), max_strlen,
+                        strlen_buffer.data());
+
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  diagnostics.SetRecordPosition(1, 3);
+  ASSERT_EQ(values.size(),
+            accessor.GetColumnarData(&binding, 0, values.size(), value_offset, false,
+                                     diagnostics, row_status.data()));
+
+  // Every truncated cell keeps its row status, but only one record is kept.
+  ASSERT_EQ(RowStatus_SUCCESS_WITH_INFO, row_status[0]);
+  ASSERT_EQ(RowStatus_SUCCESS, row_status[1]);
+  ASSERT_EQ(RowStatus_SUCCESS_WITH_INFO, row_status[2]);
+  ASSERT_EQ(RowStatus_SUCCESS_WITH_INFO, row_status[3]);
+
+  ASSERT_EQ(1, diagnostics.GetRecordCount());
+  ASSERT_EQ("01004", diagnostics.GetSQLState(0));
+  const Diagnostics::RecordOccurrences &occurrences = diagnostics.GetRecordOccurrences(0);
+  ASSERT_EQ(3, occurrences.count_);
+  ASSERT_EQ(1, occurrences.first_row_number_);
+  ASSERT_EQ(3, occurrences.first_column_number_);
+}
+
+TEST(StringArrayAccessor, Test_CDataType_CHAR_Truncation_AggregatedPerFetch) {
+  std::vector<std::string> values = {"short", "ABCDEFGHIJ", "KLMNOPQRST"};
+  std::shared_ptr<Array> array;
+  ArrayFromVector<StringType, std::string>(values, &array);
+
+  StringArrayFlightSqlAccessor<CDataType_CHAR, char> accessor(array.get());
+
+  size_t max_strlen = 8;
+  std::vector<char> buffer(values.size() * max_strlen);
+  std::vector<ssize_t> strlen_buffer(values.size());
+  ColumnBinding binding(CDataType_CHAR, 0, 0, buffer.data(), max_strlen,
+                        strlen_buffer.data());
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+
+  // Two fetches of the same rows without clearing the diagnostics in between.
+  for (int32_t column = 1; column <= 2; ++column) {
+    int64_t value_offset = 0;
+    diagnostics.StartAggregation();
+    diagnostics.SetRecordPosition(1, column);
+    ASSERT_EQ(values.size(),
+              accessor.GetColumnarData(&binding, 0, values.size(), value_offset, false,
+                                       diagnostics, nullptr));
+    diagnostics.ClearRecordPosition();
+  }
+
+  // Each fetch reports its own record, with the position of its first truncation.
+  ASSERT_EQ(2, diagnostics.GetRecordCount());
+  for (uint32_t record = 0; record < 2; ++record) {
+    ASSERT_EQ("01004", diagnostics.GetSQLState(record));
+    ASSERT_EQ(2, diagnostics.GetRecordOccurrences(record).count_);
+    ASSERT_EQ(2, diagnostics.GetRowNumber(record));
+    ASSERT_EQ(static_cast<int32_t>(record + 1), diagnostics.GetColumnNumber(record));
+  }
+}
+
 TEST(StringArrayAccessor, Test_CDataType_WCHAR_Basic) {
   std::vector<std::string> values = {"foo", "barx", "baz123"};
   std::shared_ptr<Array> array;
@@ -145,5 +216,38 @@ TEST(StringArrayAccessor, Test_CDataType_WCHAR_Truncation) {
   ASSERT_EQ(expected, finalStr);
 }
 
+TEST(StringArrayAccessor, Test_CDataType_WCHAR_SharedMemo) {
+  // A memo shared by the accessors of two chunks, as a result set column keeps it.
+  ConversionMemo memo;
+  const size_t max_strlen = 64;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+
+  for (bool distinct_values : {true, false}) {
+    std::vector<std::string> values;
+    for (int64_t i = 0; i < ConversionMemo::SAMPLE_SIZE; ++i) {
+      values.push_back(distinct_values ? "value" + std::to_string(i) : "constant");
+    }
+    std::shared_ptr<Array> array;
+    ArrayFromVector<StringType, std::string>(values, &array);
+    std::unique_ptr<Accessor> accessor(CreateWCharStringArrayAccessor(array.get(), &memo));
+
+    std::vector<uint8_t> buffer(values.size() * max_strlen);
+    std::vector<ssize_t> strlen_buffer(values.size());
+    ColumnBinding binding(CDataType_WCHAR, 0, 0, buffer.data(), max_strlen, strlen_buffer.data());
+    int64_t value_offset = 0;
+    ASSERT_EQ(values.size(),
+              accessor->GetColumnarData(&binding, 0, values.size(), value_offset, false, diagnostics, nullptr));
+
+    for (size_t i = 0; i < values.size(); ++i) {
+      std::vector<uint8_t> expected;
+      Utf8ToWcs(values[i].c_str(), &expected);
+      uint8_t *start = buffer.data() + i * max_strlen;
+      ASSERT_EQ(expected, std::vector<uint8_t>(start, start + strlen_buffer[i]));
+    }
+    // The first chunk turned the memo off, and the second one doesn't sample it again.
+    ASSERT_FALSE(memo.IsEnabled());
+  }
+}
+
 } // namespace flight_sql
 } // namespace driver
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "string_view_array_accessor.h"
+
+#include <arrow/array.h>
+#include <cstdint>
+
+namespace driver {
+namespace flight_sql {
+
+using namespace arrow;
+using namespace odbcabstraction;
+
+template <typename ARROW_ARRAY>
+StringViewArrayFlightSqlAccessor<ARROW_ARRAY>::StringViewArrayFlightSqlAccessor(
+    Array *array)
+    : FlightSqlAccessor<ARROW_ARRAY, CDataType_STRING_VIEW,
+                        StringViewArrayFlightSqlAccessor<ARROW_ARRAY>>(array) {}
+
+template <typename ARROW_ARRAY>
+size_t StringViewArrayFlightSqlAccessor<ARROW_ARRAY>::GetColumnarData_impl(
+    ColumnBinding *binding, int64_t starting_row, int64_t cells,
+    int64_t &value_offset, bool update_value_offset,
+    odbcabstraction::Diagnostics &diagnostics, uint16_t* row_status_array) {
+  ARROW_ARRAY *array = this->GetArray();
+  auto *views = static_cast<STRING_VIEW_STRUCT *>(binding->buffer);
+  const bool has_nulls = array->null_count() > 0;
+
+  for (int64_t i = 0; i < cells; ++i) {
+    const int64_t arrow_row = starting_row + i;
+    if (has_nulls && array->IsNull(arrow_row)) {
+      if (!binding->strlen_buffer) {
+        throw odbcabstraction::NullWithoutIndicatorException();
+      }
+      binding->strlen_buffer[i] = odbcabstraction::NULL_DATA;
+      continue;
+    }
+
+    int32_t length;
+    views[i].data = array->GetValue(arrow_row, &length);
+    views[i].length = length;
+    if (binding->strlen_buffer) {
+      binding->strlen_buffer[i] = static_cast<ssize_t>(sizeof(STRING_VIEW_STRUCT));
+    }
+    if (update_value_offset) {
+      // The whole value is handed out at once, a following SQLGetData has no data left.
+      value_offset = -1;
+    }
+  }
+
+  return static_cast<size_t>(cells);
+}
+
+template <typename ARROW_ARRAY>
+size_t StringViewArrayFlightSqlAccessor<ARROW_ARRAY>::GetCellLength_impl(ColumnBinding *binding) const {
+  return sizeof(STRING_VIEW_STRUCT);
+}
+
+template class StringViewArrayFlightSqlAccessor<StringArray>;
+template class StringViewArrayFlightSqlAccessor<BinaryArray>;
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#pragma once
+
+#include "arrow/type_fwd.h"
+#include "types.h"
+#include <odbcabstraction/types.h>
+
+namespace driver {
+namespace flight_sql {
+
+using namespace arrow;
+using namespace odbcabstraction;
+
+/// \brief Exposes string and binary values as STRING_VIEW_STRUCT cells pointing into
+/// the Arrow value buffer, without copying any bytes.
+///
+/// The pointers stay valid as long as the result set keeps the batch alive, which is
+/// until the next fetch.
+template <typename ARROW_ARRAY>
+class StringViewArrayFlightSqlAccessor
+    : public FlightSqlAccessor<ARROW_ARRAY, CDataType_STRING_VIEW,
+                               StringViewArrayFlightSqlAccessor<ARROW_ARRAY>> {
+public:
+  explicit StringViewArrayFlightSqlAccessor(Array *array);
+
+  size_t GetColumnarData_impl(ColumnBinding *binding, int64_t starting_row, int64_t cells,
+                              int64_t &value_offset, bool update_value_offset,
+                              odbcabstraction::Diagnostics &diagnostics, uint16_t* row_status_array);
+
+  size_t GetCellLength_impl(ColumnBinding *binding) const;
+};
+
+} // namespace flight_sql
+} // namespace driver
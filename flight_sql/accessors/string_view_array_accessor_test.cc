@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "arrow/testing/builder.h"
+#include "string_view_array_accessor.h"
+#include "gtest/gtest.h"
+
+namespace driver {
+namespace flight_sql {
+
+using namespace arrow;
+using namespace odbcabstraction;
+
+TEST(StringViewArrayAccessor, Test_StringArray_PointsIntoValueBuffer) {
+  std::vector<std::string> values = {"foo", "", "a much longer value than the others"};
+  std::vector<bool> is_valid = {true, true, false};
+  std::shared_ptr<Array> array;
+  ArrayFromVector<StringType, std::string>(is_valid, values, &array);
+
+  StringViewArrayFlightSqlAccessor<StringArray> accessor(array.get());
+
+  std::vector<STRING_VIEW_STRUCT> buffer(values.size());
+  std::vector<ssize_t> strlen_buffer(values.size());
+
+  ColumnBinding binding(CDataType_STRING_VIEW, 0, 0, buffer.data(), 0, strlen_buffer.data());
+
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  ASSERT_EQ(values.size(),
+            accessor.GetColumnarData(&binding, 0, values.size(), value_offset, false, diagnostics, nullptr));
+
+  const auto *string_array = static_cast<StringArray *>(array.get());
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_EQ(sizeof(STRING_VIEW_STRUCT), strlen_buffer[i]);
+    ASSERT_EQ(string_array->raw_data() + string_array->value_offset(i), buffer[i].data);
+    ASSERT_EQ(values[i], std::string(reinterpret_cast<const char *>(buffer[i].data), buffer[i].length));
+  }
+  ASSERT_EQ(NULL_DATA, strlen_buffer[2]);
+  ASSERT_EQ(0, diagnostics.GetRecordCount());
+}
+
+TEST(StringViewArrayAccessor, Test_BinaryArray_GetData) {
+  std::vector<std::string> values = {std::string("\x00\x01\x02", 3), "xyz"};
+  std::shared_ptr<Array> array;
+  ArrayFromVector<BinaryType, std::string>(values, &array);
+
+  // Reading from a slice must still point at the right value.
+  std::shared_ptr<Array> sliced_array = array->Slice(1);
+  StringViewArrayFlightSqlAccessor<BinaryArray> accessor(sliced_array.get());
+
+  STRING_VIEW_STRUCT view{};
+  ssize_t strlen = 0;
+  ColumnBinding binding(CDataType_STRING_VIEW, 0, 0, &view, sizeof(view), &strlen);
+
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  ASSERT_EQ(1, accessor.GetColumnarData(&binding, 0, 1, value_offset, true, diagnostics, nullptr));
+
+  ASSERT_EQ(-1, value_offset);
+  ASSERT_EQ(sizeof(STRING_VIEW_STRUCT), strlen);
+  ASSERT_EQ(values[1], std::string(reinterpret_cast<const char *>(view.data), view.length));
+}
+
+} // namespace flight_sql
+} // namespace driver
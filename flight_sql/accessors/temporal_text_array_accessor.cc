@@ -0,0 +1,364 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "temporal_text_array_accessor.h"
+
+#include <arrow/array.h>
+#include <arrow/util/checked_cast.h>
+#include <odbcabstraction/encoding.h>
+#include <cstring>
+
+namespace driver {
+namespace flight_sql {
+
+using namespace arrow;
+using namespace odbcabstraction;
+
+namespace {
+
+// Enough for a timestamp in seconds, whose year can take up to 12 digits.
+constexpr size_t MAX_TEXT_LENGTH = 48;
+
+struct DigitPairTable {
+  char pairs[100][2];
+
+  DigitPairTable() {
+    for (int i = 0; i < 100; ++i) {
+      pairs[i][0] = static_cast<char>('0' + i / 10);
+      pairs[i][1] = static_cast<char>('0' + i % 10);
+    }
+  }
+};
+
+const DigitPairTable DIGIT_PAIRS;
+
+template <TimeUnit::type UNIT>
+struct TimeUnitTraits;
+
+template <>
+struct TimeUnitTraits<TimeUnit::SECOND> {
+  static constexpr int64_t UNITS_PER_SECOND = 1;
+  static constexpr int FRACTION_DIGITS = 0;
+};
+
+template <>
+struct TimeUnitTraits<TimeUnit::MILLI> {
+  static constexpr int64_t UNITS_PER_SECOND = MILLI_TO_SECONDS_DIVISOR;
+  static constexpr int FRACTION_DIGITS = 3;
+};
+
+template <>
+struct TimeUnitTraits<TimeUnit::MICRO> {
+  static constexpr int64_t UNITS_PER_SECOND = MICRO_TO_SECONDS_DIVISOR;
+  static constexpr int FRACTION_DIGITS = 6;
+};
+
+template <>
+struct TimeUnitTraits<TimeUnit::NANO> {
+  static constexpr int64_t UNITS_PER_SECOND = NANO_TO_SECONDS_DIVISOR;
+  static constexpr int FRACTION_DIGITS = 9;
+};
+
+/// Divides rounding towards negative infinity, so that values before the epoch
+/// still get a remainder in [0, divisor).
+inline int64_t FloorDivide(int64_t value, int64_t divisor, int64_t &remainder) {
+  int64_t quotient = value / divisor;
+  remainder = value % divisor;
+  if (remainder < 0) {
+    remainder += divisor;
+    --quotient;
+  }
+  return quotient;
+}
+
+inline char *WriteTwoDigits(char *out, unsigned value) {
+  memcpy(out, DIGIT_PAIRS.pairs[value], 2);
+  return out + 2;
+}
+
+/// Writes the last digits decimal digits of value, zero-padded.
+inline char *WriteFixedDigits(char *out, uint64_t value, int digits) {
+  char *end = out + digits;
+  char *pos = end;
+  while (pos - out >= 2) {
+    pos -= 2;
+    memcpy(pos, DIGIT_PAIRS.pairs[value % 100], 2);
+    value /= 100;
+  }
+  if (pos > out) {
+    *--pos = static_cast<char>('0' + value % 10);
+  }
+  return end;
+}
+
+/// Writes at least four digits, preceded by a minus sign for years before 0000.
+char *WriteYear(char *out, int64_t year) {
+  if (year >= 0 && year <= 9999) {
+    return WriteFixedDigits(out, static_cast<uint64_t>(year), 4);
+  }
+  uint64_t magnitude = static_cast<uint64_t>(year);
+  if (year < 0) {
+    *out++ = '-';
+    magnitude = 0 - magnitude;
+  }
+  int digits = 4;
+  for (uint64_t rest = magnitude / 10000; rest > 0; rest /= 10) {
+    ++digits;
+  }
+  return WriteFixedDigits(out, magnitude, digits);
+}
+
+/// Proleptic Gregorian civil date from days since the epoch.
+void CivilFromDays(int64_t days, int64_t &year, unsigned &month, unsigned &day) {
+  days += 719468;
+  const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  const auto day_of_era = static_cast<unsigned>(days - era * 146097);
+  const unsigned year_of_era =
+      (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+  const unsigned day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+  const unsigned shifted_month = (5 * day_of_year + 2) / 153;
+  day = day_of_year - (153 * shifted_month + 2) / 5 + 1;
+  month = shifted_month < 10 ? shifted_month + 3 : shifted_month - 9;
+  year = static_cast<int64_t>(year_of_era) + era * 400 + (month <= 2 ? 1 : 0);
+}
+
+char *WriteDate(char *out, int64_t days) {
+  int64_t year;
+  unsigned month, day;
+  CivilFromDays(days, year, month, day);
+  out = WriteYear(out, year);
+  *out++ = '-';
+  out = WriteTwoDigits(out, month);
+  *out++ = '-';
+  return WriteTwoDigits(out, day);
+}
+
+char *WriteTimeOfDay(char *out, int64_t seconds_of_day) {
+  const auto seconds = static_cast<unsigned>(seconds_of_day);
+  out = WriteTwoDigits(out, seconds / 3600);
+  *out++ = ':';
+  out = WriteTwoDigits(out, seconds / 60 % 60);
+  *out++ = ':';
+  return WriteTwoDigits(out, seconds % 60);
+}
+
+template <TimeUnit::type UNIT>
+char *WriteFraction(char *out, int64_t fraction) {
+  if (TimeUnitTraits<UNIT>::FRACTION_DIGITS == 0) {
+    return out;
+  }
+  *out++ = '.';
+  return WriteFixedDigits(out, static_cast<uint64_t>(fraction),
+                          TimeUnitTraits<UNIT>::FRACTION_DIGITS);
+}
+
+template <TimeUnit::type UNIT>
+char *WriteTime(char *out, int64_t value) {
+  int64_t fraction, seconds_of_day;
+  const int64_t seconds = FloorDivide(value, TimeUnitTraits<UNIT>::UNITS_PER_SECOND, fraction);
+  FloorDivide(seconds, DAYS_TO_SECONDS_MULTIPLIER, seconds_of_day);
+  out = WriteTimeOfDay(out, seconds_of_day);
+  return WriteFraction<UNIT>(out, fraction);
+}
+
+// The array argument only selects the layout of the text, values being read by the
+// caller.
+
+template <TimeUnit::type UNIT>
+char *FormatValue(const Date32Array *, int64_t value, char *out) {
+  return WriteDate(out, value);
+}
+
+template <TimeUnit::type UNIT>
+char *FormatValue(const Date64Array *, int64_t value, char *out) {
+  int64_t milliseconds_of_day;
+  return WriteDate(out, FloorDivide(value, DAYS_TO_SECONDS_MULTIPLIER * MILLI_TO_SECONDS_DIVISOR,
+                                    milliseconds_of_day));
+}
+
+template <TimeUnit::type UNIT>
+char *FormatValue(const Time32Array *, int64_t value, char *out) {
+  return WriteTime<UNIT>(out, value);
+}
+
+template <TimeUnit::type UNIT>
+char *FormatValue(const Time64Array *, int64_t value, char *out) {
+  return WriteTime<UNIT>(out, value);
+}
+
+template <TimeUnit::type UNIT>
+char *FormatValue(const TimestampArray *, int64_t value, char *out) {
+  int64_t fraction, seconds_of_day;
+  const int64_t seconds = FloorDivide(value, TimeUnitTraits<UNIT>::UNITS_PER_SECOND, fraction);
+  const int64_t days = FloorDivide(seconds, DAYS_TO_SECONDS_MULTIPLIER, seconds_of_day);
+  out = WriteDate(out, days);
+  *out++ = ' ';
+  out = WriteTimeOfDay(out, seconds_of_day);
+  return WriteFraction<UNIT>(out, fraction);
+}
+
+inline void CopyText(const char *text, size_t length, char *out) {
+  memcpy(out, text, length);
+}
+
+template <typename CHAR_TYPE>
+void CopyText(const char *text, size_t length, CHAR_TYPE *out) {
+  for (size_t i = 0; i < length; ++i) {
+    out[i] = static_cast<CHAR_TYPE>(text[i]);
+  }
+}
+
+/// Writes ASCII text to a character buffer, from value_offset on, with the same
+/// truncation rules as string columns.
+template <typename CHAR_TYPE>
+RowStatus MoveTextToCharBuffer(const char *text, size_t length, ColumnBinding *binding,
+                               int64_t i, int64_t &value_offset, bool update_value_offset,
+                               odbcabstraction::Diagnostics &diagnostics) {
+  RowStatus result = odbcabstraction::RowStatus_SUCCESS;
+
+  const size_t first_char = static_cast<size_t>(value_offset) / sizeof(CHAR_TYPE);
+  const size_t remaining_chars = length - first_char;
+  const size_t remaining_length = remaining_chars * sizeof(CHAR_TYPE);
+
+  auto *char_buffer = reinterpret_cast<CHAR_TYPE *>(
+      static_cast<char *>(binding->buffer) + i * binding->buffer_length);
+
+  if (binding->buffer_length >= remaining_length + sizeof(CHAR_TYPE)) {
+    CopyText(text + first_char, remaining_chars, char_buffer);
+    char_buffer[remaining_chars] = '\0';
+    if (update_value_offset) {
+      value_offset = -1;
+    }
+  } else {
+    result = odbcabstraction::RowStatus_SUCCESS_WITH_INFO;
+    diagnostics.AddTruncationWarning(i);
+    size_t chars_written = binding->buffer_length / sizeof(CHAR_TYPE);
+    // If we failed to even write one char, the buffer is too small to hold a
+    // NUL-terminator.
+    if (chars_written > 0) {
+      CopyText(text + first_char, chars_written - 1, char_buffer);
+      char_buffer[chars_written - 1] = '\0';
+      if (update_value_offset) {
+        value_offset += (chars_written - 1) * sizeof(CHAR_TYPE);
+      }
+    }
+  }
+
+  if (binding->strlen_buffer) {
+    binding->strlen_buffer[i] = static_cast<ssize_t>(remaining_length);
+  }
+
+  return result;
+}
+
+} // namespace
+
+template <CDataType TARGET_TYPE, typename ARROW_ARRAY, TimeUnit::type UNIT, typename CHAR_TYPE>
+TemporalTextArrayFlightSqlAccessor<TARGET_TYPE, ARROW_ARRAY, UNIT, CHAR_TYPE>::
+    TemporalTextArrayFlightSqlAccessor(Array *array)
+    : FlightSqlAccessor<ARROW_ARRAY, TARGET_TYPE,
+                        TemporalTextArrayFlightSqlAccessor<TARGET_TYPE, ARROW_ARRAY, UNIT,
+                                                           CHAR_TYPE>>(array) {}
+
+template <CDataType TARGET_TYPE, typename ARROW_ARRAY, TimeUnit::type UNIT, typename CHAR_TYPE>
+RowStatus
+TemporalTextArrayFlightSqlAccessor<TARGET_TYPE, ARROW_ARRAY, UNIT, CHAR_TYPE>::MoveSingleCell_impl(
+    ColumnBinding *binding, int64_t arrow_row, int64_t i, int64_t &value_offset,
+    bool update_value_offset, odbcabstraction::Diagnostics &diagnostics) {
+  const int64_t value = this->GetArray()->Value(arrow_row);
+
+  if (sizeof(CHAR_TYPE) == sizeof(char) && value_offset == 0 &&
+      binding->buffer_length > MAX_TEXT_LENGTH) {
+    // The text always fits, so it is formatted in place.
+    char *out = static_cast<char *>(binding->buffer) + i * binding->buffer_length;
+    char *end = FormatValue<UNIT>(this->GetArray(), value, out);
+    *end = '\0';
+    if (update_value_offset) {
+      value_offset = -1;
+    }
+    if (binding->strlen_buffer) {
+      binding->strlen_buffer[i] = static_cast<ssize_t>(end - out);
+    }
+    return odbcabstraction::RowStatus_SUCCESS;
+  }
+
+  char text[MAX_TEXT_LENGTH];
+  const char *end = FormatValue<UNIT>(this->GetArray(), value, text);
+  return MoveTextToCharBuffer<CHAR_TYPE>(text, static_cast<size_t>(end - text), binding, i,
+                                         value_offset, update_value_offset, diagnostics);
+}
+
+template <CDataType TARGET_TYPE, typename ARROW_ARRAY, TimeUnit::type UNIT, typename CHAR_TYPE>
+size_t TemporalTextArrayFlightSqlAccessor<TARGET_TYPE, ARROW_ARRAY, UNIT, CHAR_TYPE>::
+    GetCellLength_impl(ColumnBinding *binding) const {
+  return binding->buffer_length;
+}
+
+namespace {
+
+template <CDataType TARGET_TYPE, typename ARROW_ARRAY, typename CHAR_TYPE>
+Accessor *CreateAccessorForUnit(arrow::Array *array, TimeUnit::type unit) {
+  switch (unit) {
+    case TimeUnit::SECOND:
+      return new TemporalTextArrayFlightSqlAccessor<TARGET_TYPE, ARROW_ARRAY,
+                                                    TimeUnit::SECOND, CHAR_TYPE>(array);
+    case TimeUnit::MILLI:
+      return new TemporalTextArrayFlightSqlAccessor<TARGET_TYPE, ARROW_ARRAY,
+                                                    TimeUnit::MILLI, CHAR_TYPE>(array);
+    case TimeUnit::MICRO:
+      return new TemporalTextArrayFlightSqlAccessor<TARGET_TYPE, ARROW_ARRAY,
+                                                    TimeUnit::MICRO, CHAR_TYPE>(array);
+    case TimeUnit::NANO:
+      return new TemporalTextArrayFlightSqlAccessor<TARGET_TYPE, ARROW_ARRAY,
+                                                    TimeUnit::NANO, CHAR_TYPE>(array);
+  }
+  assert(false);
+  throw DriverException("Unrecognized time unit " + std::to_string(unit));
+}
+
+template <CDataType TARGET_TYPE, typename CHAR_TYPE>
+Accessor *CreateAccessor(arrow::Array *array) {
+  switch (array->type_id()) {
+    case arrow::Type::DATE32:
+      return new TemporalTextArrayFlightSqlAccessor<TARGET_TYPE, Date32Array,
+                                                    TimeUnit::SECOND, CHAR_TYPE>(array);
+    case arrow::Type::DATE64:
+      return new TemporalTextArrayFlightSqlAccessor<TARGET_TYPE, Date64Array,
+                                                    TimeUnit::MILLI, CHAR_TYPE>(array);
+    case arrow::Type::TIME32:
+      return CreateAccessorForUnit<TARGET_TYPE, Time32Array, CHAR_TYPE>(
+          array, arrow::internal::checked_pointer_cast<TimeType>(array->type())->unit());
+    case arrow::Type::TIME64:
+      return CreateAccessorForUnit<TARGET_TYPE, Time64Array, CHAR_TYPE>(
+          array, arrow::internal::checked_pointer_cast<TimeType>(array->type())->unit());
+    case arrow::Type::TIMESTAMP:
+      return CreateAccessorForUnit<TARGET_TYPE, TimestampArray, CHAR_TYPE>(
+          array, arrow::internal::checked_pointer_cast<TimestampType>(array->type())->unit());
+    default:
+      assert(false);
+      throw DriverException("Unsupported input supplied to CreateTemporalTextAccessor");
+  }
+}
+
+} // namespace
+
+Accessor* CreateTemporalTextAccessor(arrow::Array *array, CDataType target_type) {
+  if (target_type == CDataType_CHAR) {
+    return CreateAccessor<CDataType_CHAR, char>(array);
+  }
+  switch (GetSqlWCharSize()) {
+    case sizeof(char16_t):
+      return CreateAccessor<CDataType_WCHAR, char16_t>(array);
+    case sizeof(char32_t):
+      return CreateAccessor<CDataType_WCHAR, char32_t>(array);
+    default:
+      assert(false);
+      throw DriverException("Encoding is unsupported, SQLWCHAR size: " + std::to_string(GetSqlWCharSize()));
+  }
+}
+
+} // namespace flight_sql
+} // namespace driver
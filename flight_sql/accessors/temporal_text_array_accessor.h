@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#pragma once
+
+#include "arrow/type_fwd.h"
+#include "types.h"
+#include <odbcabstraction/types.h>
+
+namespace driver {
+namespace flight_sql {
+
+using namespace arrow;
+using namespace odbcabstraction;
+
+/// \brief Writes DATE, TIME and TIMESTAMP values as ISO 8601 text, without casting
+/// the array to utf8 first.
+///
+/// Dates are written as "YYYY-MM-DD", times as "HH:MM:SS" and timestamps as
+/// "YYYY-MM-DD HH:MM:SS", followed by 3, 6 or 9 fractional digits for millisecond,
+/// microsecond and nanosecond units. Date32 arrays use UNIT SECOND and Date64 arrays
+/// use UNIT MILLI, the fraction being dropped for dates. Timestamps are written in
+/// UTC, as for TIMESTAMP_STRUCT buffers.
+template <CDataType TARGET_TYPE, typename ARROW_ARRAY, TimeUnit::type UNIT,
+          typename CHAR_TYPE = char>
+class TemporalTextArrayFlightSqlAccessor
+    : public FlightSqlAccessor<
+          ARROW_ARRAY, TARGET_TYPE,
+          TemporalTextArrayFlightSqlAccessor<TARGET_TYPE, ARROW_ARRAY, UNIT, CHAR_TYPE>> {
+public:
+  explicit TemporalTextArrayFlightSqlAccessor(Array *array);
+
+  RowStatus MoveSingleCell_impl(ColumnBinding *binding, int64_t arrow_row, int64_t i,
+                                int64_t &value_offset, bool update_value_offset,
+                                odbcabstraction::Diagnostics &diagnostics);
+
+  size_t GetCellLength_impl(ColumnBinding *binding) const;
+};
+
+/// \brief Creates the text accessor for a DATE32, DATE64, TIME32, TIME64 or TIMESTAMP
+/// array, target_type being CDataType_CHAR or CDataType_WCHAR.
+Accessor* CreateTemporalTextAccessor(arrow::Array *array, CDataType target_type);
+
+} // namespace flight_sql
+} // namespace driver
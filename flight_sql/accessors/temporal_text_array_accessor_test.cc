@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "arrow/testing/builder.h"
+#include "temporal_text_array_accessor.h"
+#include "gtest/gtest.h"
+#include <odbcabstraction/encoding.h>
+
+namespace driver {
+namespace flight_sql {
+
+using namespace arrow;
+using namespace odbcabstraction;
+
+namespace {
+/// Fetches every value of array as CHAR, with max_strlen bytes per cell.
+std::vector<std::string> FetchAsChar(const std::shared_ptr<Array> &array, size_t max_strlen) {
+  std::unique_ptr<Accessor> accessor(CreateTemporalTextAccessor(array.get(), CDataType_CHAR));
+
+  std::vector<char> buffer(array->length() * max_strlen);
+  std::vector<ssize_t> strlen_buffer(array->length());
+  ColumnBinding binding(CDataType_CHAR, 0, 0, buffer.data(), max_strlen, strlen_buffer.data());
+
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  EXPECT_EQ(array->length(),
+            accessor->GetColumnarData(&binding, 0, array->length(), value_offset, false,
+                                      diagnostics, nullptr));
+
+  std::vector<std::string> result;
+  for (int64_t i = 0; i < array->length(); ++i) {
+    const std::string value(buffer.data() + i * max_strlen);
+    EXPECT_EQ(value.length(), strlen_buffer[i]);
+    result.push_back(value);
+  }
+  return result;
+}
+} // namespace
+
+TEST(TemporalTextArrayAccessor, Test_Date_CDataType_CHAR) {
+  std::shared_ptr<Array> date32_array;
+  ArrayFromVector<Date32Type, int32_t>({0, 19094, -1, -719528, 2932896}, &date32_array);
+  ASSERT_EQ(std::vector<std::string>(
+                {"1970-01-01", "2022-04-12", "1969-12-31", "0000-01-01", "9999-12-31"}),
+            FetchAsChar(date32_array, 64));
+
+  std::shared_ptr<Array> date64_array;
+  ArrayFromVector<Date64Type, int64_t>({86400000, -1, 1649793238110LL}, &date64_array);
+  ASSERT_EQ(std::vector<std::string>({"1970-01-02", "1969-12-31", "2022-04-12"}),
+            FetchAsChar(date64_array, 64));
+}
+
+TEST(TemporalTextArrayAccessor, Test_Time_CDataType_CHAR) {
+  std::shared_ptr<Array> seconds_array;
+  ArrayFromVector<Time32Type, int32_t>(time32(TimeUnit::SECOND), {0, 45296, 86399},
+                                       &seconds_array);
+  ASSERT_EQ(std::vector<std::string>({"00:00:00", "12:34:56", "23:59:59"}),
+            FetchAsChar(seconds_array, 64));
+
+  std::shared_ptr<Array> milli_array;
+  ArrayFromVector<Time32Type, int32_t>(time32(TimeUnit::MILLI), {45296789, 1}, &milli_array);
+  ASSERT_EQ(std::vector<std::string>({"12:34:56.789", "00:00:00.001"}),
+            FetchAsChar(milli_array, 64));
+
+  std::shared_ptr<Array> micro_array;
+  ArrayFromVector<Time64Type, int64_t>(time64(TimeUnit::MICRO), {45296000007LL}, &micro_array);
+  ASSERT_EQ(std::vector<std::string>({"12:34:56.000007"}), FetchAsChar(micro_array, 64));
+
+  std::shared_ptr<Array> nano_array;
+  ArrayFromVector<Time64Type, int64_t>(time64(TimeUnit::NANO), {86399999999999LL}, &nano_array);
+  ASSERT_EQ(std::vector<std::string>({"23:59:59.999999999"}), FetchAsChar(nano_array, 64));
+}
+
+TEST(TemporalTextArrayAccessor, Test_Timestamp_CDataType_CHAR) {
+  std::shared_ptr<Array> milli_array;
+  ArrayFromVector<TimestampType, int64_t>(timestamp(TimeUnit::MILLI),
+                                          {1649793238110LL, 0, -86399999, -1}, &milli_array);
+  ASSERT_EQ(std::vector<std::string>({"2022-04-12 19:53:58.110", "1970-01-01 00:00:00.000",
+                                      "1969-12-31 00:00:00.001", "1969-12-31 23:59:59.999"}),
+            FetchAsChar(milli_array, 64));
+
+  std::shared_ptr<Array> seconds_array;
+  ArrayFromVector<TimestampType, int64_t>(timestamp(TimeUnit::SECOND),
+                                          {-62167219201LL, 253402300799LL}, &seconds_array);
+  ASSERT_EQ(std::vector<std::string>({"-0001-12-31 23:59:59", "9999-12-31 23:59:59"}),
+            FetchAsChar(seconds_array, 64));
+
+  // Short buffers go through the same formatting as the in-place path.
+  std::shared_ptr<Array> nano_array;
+  ArrayFromVector<TimestampType, int64_t>(timestamp(TimeUnit::NANO, "UTC"),
+                                          {1649793238110000001LL}, &nano_array);
+  ASSERT_EQ(std::vector<std::string>({"2022-04-12 19:53:58.110000001"}),
+            FetchAsChar(nano_array, 30));
+}
+
+TEST(TemporalTextArrayAccessor, Test_Timestamp_CDataType_CHAR_Truncation) {
+  std::shared_ptr<Array> array;
+  ArrayFromVector<TimestampType, int64_t>(timestamp(TimeUnit::MICRO), {1649793238110011LL},
+                                          &array);
+  std::unique_ptr<Accessor> accessor(CreateTemporalTextAccessor(array.get(), CDataType_CHAR));
+
+  size_t max_strlen = 8;
+  std::vector<char> buffer(max_strlen);
+  std::vector<ssize_t> strlen_buffer(1);
+  ColumnBinding binding(CDataType_CHAR, 0, 0, buffer.data(), max_strlen, strlen_buffer.data());
+
+  const std::string expected = "2022-04-12 19:53:58.110011";
+  std::stringstream ss;
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  do {
+    diagnostics.Clear();
+    int64_t original_value_offset = value_offset;
+    ASSERT_EQ(1, accessor->GetColumnarData(&binding, 0, 1, value_offset, true, diagnostics, nullptr));
+    ASSERT_EQ(expected.length() - original_value_offset, strlen_buffer[0]);
+    ASSERT_EQ(value_offset == -1 ? 0 : 1, diagnostics.GetRecordCount());
+
+    ss << buffer.data();
+  } while (value_offset != -1);
+
+  ASSERT_EQ(expected, ss.str());
+}
+
+TEST(TemporalTextArrayAccessor, Test_Timestamp_CDataType_WCHAR) {
+  std::shared_ptr<Array> array;
+  ArrayFromVector<TimestampType, int64_t>(timestamp(TimeUnit::SECOND), {1649793238LL, 0},
+                                          &array);
+  std::unique_ptr<Accessor> accessor(CreateTemporalTextAccessor(array.get(), CDataType_WCHAR));
+  std::vector<std::string> expected = {"2022-04-12 19:53:58", "1970-01-01 00:00:00"};
+
+  size_t max_strlen = 32 * GetSqlWCharSize();
+  std::vector<uint8_t> buffer(array->length() * max_strlen);
+  std::vector<ssize_t> strlen_buffer(array->length());
+  ColumnBinding binding(CDataType_WCHAR, 0, 0, buffer.data(), max_strlen, strlen_buffer.data());
+
+  int64_t value_offset = 0;
+  odbcabstraction::Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  ASSERT_EQ(array->length(),
+            accessor->GetColumnarData(&binding, 0, array->length(), value_offset, false,
+                                      diagnostics, nullptr));
+
+  for (int i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(expected[i].length() * GetSqlWCharSize(), strlen_buffer[i]);
+    std::vector<uint8_t> expected_wcs;
+    Utf8ToWcs(expected[i].c_str(), &expected_wcs);
+    uint8_t *start = buffer.data() + i * max_strlen;
+    ASSERT_EQ(expected_wcs, std::vector<uint8_t>(start, start + expected_wcs.size()));
+  }
+}
+
+} // namespace flight_sql
+} // namespace driver
@@ -56,6 +56,15 @@ public:
                                  size_t cells, int64_t &value_offset, bool update_value_offset,
                                  odbcabstraction::Diagnostics &diagnostics, uint16_t* row_status_array) = 0;
 
+  /// \brief Populates cells rows of a row-wise binding at once, where consecutive rows
+  /// are row_size bytes apart in both the value and the indicator buffers.
+  /// \return the number of cells populated, or 0 if the rows have to be populated one
+  /// at a time through GetColumnarData.
+  virtual size_t GetRowWiseData(ColumnBinding *binding, int64_t starting_row, size_t cells,
+                                size_t row_size) {
+    return 0;
+  }
+
   virtual size_t GetCellLength(ColumnBinding *binding) const = 0;
 };
 
@@ -93,10 +102,20 @@ protected:
       } else {
         // TODO: Optimize this by creating different versions of MoveSingleCell
         // depending on if strlen_buffer is null.
-        auto row_status = MoveSingleCell(
-            binding, current_arrow_row, i, value_offset, update_value_offset,
-            diagnostics);
-        if (row_status_array) {
+        odbcabstraction::RowStatus row_status;
+        try {
+          row_status = MoveSingleCell(binding, current_arrow_row, i, value_offset,
+                                      update_value_offset, diagnostics);
+        } catch (const odbcabstraction::NumericValueOutOfRangeException &) {
+          // Without a row status array, as for SQLGetData, the call itself fails.
+          if (!row_status_array) {
+            throw;
+          }
+          diagnostics.AddNumericOutOfRangeError(i);
+          row_status = odbcabstraction::RowStatus_ERROR;
+        }
+        if (row_status_array && row_status != odbcabstraction::RowStatus_SUCCESS &&
+            row_status_array[i] != odbcabstraction::RowStatus_ERROR) {
           row_status_array[i] = row_status;
         }
       }
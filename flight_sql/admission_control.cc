@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "admission_control.h"
+
+#include <algorithm>
+#include <map>
+
+namespace driver {
+namespace flight_sql {
+
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+HostAdmission::HostAdmission(size_t max_in_flight)
+    : max_in_flight_(max_in_flight), next_waiter_(0) {}
+
+std::shared_ptr<HostAdmission> HostAdmission::ForHost(const std::string &host, size_t max_in_flight) {
+  static std::mutex hosts_mutex;
+  static std::map<std::string, std::shared_ptr<HostAdmission>> hosts;
+
+  std::unique_lock<std::mutex> lock(hosts_mutex);
+  auto &admission = hosts[host];
+  if (!admission) {
+    admission = std::make_shared<HostAdmission>(max_in_flight);
+  } else {
+    admission->SetMaxInFlight(max_in_flight);
+  }
+  return admission;
+}
+
+bool HostAdmission::Acquire(std::chrono::milliseconds timeout) {
+  const auto start = steady_clock::now();
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  const uint64_t waiter = next_waiter_++;
+  waiters_.push_back(waiter);
+  statistics_.waiting++;
+
+  const auto can_admit = [this, waiter] { return CanAdmit(waiter); };
+  bool admitted;
+  if (timeout.count() < 0) {
+    changed_.wait(lock, can_admit);
+    admitted = true;
+  } else {
+    admitted = changed_.wait_for(lock, timeout, can_admit);
+  }
+
+  waiters_.erase(std::find(waiters_.begin(), waiters_.end(), waiter));
+  statistics_.waiting--;
+  const auto wait_time = duration_cast<microseconds>(steady_clock::now() - start);
+  statistics_.total_wait_time += wait_time;
+  statistics_.max_wait_time = std::max(statistics_.max_wait_time, wait_time);
+
+  if (admitted) {
+    statistics_.in_flight++;
+    statistics_.admitted++;
+  } else {
+    statistics_.timed_out++;
+  }
+  lock.unlock();
+
+  // Either the next waiter moved to the front of the queue or, after a timeout,
+  // a later one may now fit.
+  changed_.notify_all();
+  return admitted;
+}
+
+void HostAdmission::Release() {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    statistics_.in_flight--;
+  }
+  changed_.notify_all();
+}
+
+void HostAdmission::SetMaxInFlight(size_t max_in_flight) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    max_in_flight_ = max_in_flight;
+  }
+  changed_.notify_all();
+}
+
+AdmissionStatistics HostAdmission::GetStatistics() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return statistics_;
+}
+
+bool HostAdmission::CanAdmit(uint64_t waiter) const {
+  return waiters_.front() == waiter && statistics_.in_flight < max_in_flight_;
+}
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace driver {
+namespace flight_sql {
+
+/// \brief Counters of one host's admission queue.
+struct AdmissionStatistics {
+  size_t in_flight = 0;
+  size_t waiting = 0;
+  int64_t admitted = 0;
+  int64_t timed_out = 0;
+  std::chrono::microseconds total_wait_time{0};
+  std::chrono::microseconds max_wait_time{0};
+};
+
+/// \brief Fair semaphore bounding the queries a process runs against one host.
+///
+/// Callers are admitted strictly in arrival order, so a burst of new statements
+/// can't overtake the ones already queued. Callers that time out leave the queue.
+class HostAdmission {
+public:
+  explicit HostAdmission(size_t max_in_flight);
+
+  /// \brief Returns the limiter shared by every connection to host, allowing
+  /// max_in_flight concurrent queries. The limit of the most recent call applies.
+  static std::shared_ptr<HostAdmission> ForHost(const std::string &host, size_t max_in_flight);
+
+  /// \brief Waits for a query slot.
+  /// \param timeout how long to wait, negative to wait indefinitely.
+  /// \return false if no slot became available in time.
+  bool Acquire(std::chrono::milliseconds timeout);
+
+  void Release();
+
+  void SetMaxInFlight(size_t max_in_flight);
+
+  AdmissionStatistics GetStatistics();
+
+private:
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  size_t max_in_flight_;
+  std::deque<uint64_t> waiters_;
+  uint64_t next_waiter_;
+  AdmissionStatistics statistics_;
+
+  bool CanAdmit(uint64_t waiter) const;
+};
+
+/// \brief Query slot held from execution until the result is fully read or closed.
+class AdmissionPermit {
+public:
+  explicit AdmissionPermit(std::shared_ptr<HostAdmission> admission)
+      : admission_(std::move(admission)) {}
+
+  ~AdmissionPermit() { admission_->Release(); }
+
+  AdmissionPermit(const AdmissionPermit &) = delete;
+  AdmissionPermit &operator=(const AdmissionPermit &) = delete;
+
+private:
+  std::shared_ptr<HostAdmission> admission_;
+};
+
+} // namespace flight_sql
+} // namespace driver
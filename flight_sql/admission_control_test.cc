@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "admission_control.h"
+
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+
+namespace driver {
+namespace flight_sql {
+
+using std::chrono::milliseconds;
+
+namespace {
+void WaitForWaiters(HostAdmission &admission, size_t waiting) {
+  while (admission.GetStatistics().waiting != waiting) {
+    std::this_thread::yield();
+  }
+}
+}
+
+TEST(HostAdmission, TimesOutWhenFull) {
+  HostAdmission admission(1);
+  ASSERT_TRUE(admission.Acquire(milliseconds(0)));
+  ASSERT_FALSE(admission.Acquire(milliseconds(10)));
+
+  auto statistics = admission.GetStatistics();
+  ASSERT_EQ(1, statistics.in_flight);
+  ASSERT_EQ(0, statistics.waiting);
+  ASSERT_EQ(1, statistics.admitted);
+  ASSERT_EQ(1, statistics.timed_out);
+  ASSERT_GE(statistics.max_wait_time.count(), 10000);
+
+  admission.Release();
+  ASSERT_TRUE(admission.Acquire(milliseconds(0)));
+  admission.Release();
+}
+
+TEST(HostAdmission, AdmitsInArrivalOrder) {
+  HostAdmission admission(1);
+  ASSERT_TRUE(admission.Acquire(milliseconds(-1)));
+
+  std::mutex mutex;
+  std::vector<int> order;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&, i] {
+      ASSERT_TRUE(admission.Acquire(milliseconds(-1)));
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        order.push_back(i);
+      }
+      admission.Release();
+    });
+    // Queue the threads one after the other.
+    WaitForWaiters(admission, i + 1);
+  }
+
+  admission.Release();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(std::vector<int>({0, 1, 2, 3}), order);
+  ASSERT_EQ(0, admission.GetStatistics().in_flight);
+}
+
+TEST(HostAdmission, TimedOutWaiterDoesNotBlockTheQueue) {
+  HostAdmission admission(1);
+  ASSERT_TRUE(admission.Acquire(milliseconds(-1)));
+
+  std::thread first([&] { ASSERT_FALSE(admission.Acquire(milliseconds(20))); });
+  WaitForWaiters(admission, 1);
+  bool second_admitted = false;
+  std::thread second([&] {
+    second_admitted = admission.Acquire(milliseconds(-1));
+    admission.Release();
+  });
+
+  first.join();
+  admission.Release();
+  second.join();
+  ASSERT_TRUE(second_admitted);
+}
+
+TEST(HostAdmission, ForHostSharesLimiter) {
+  const auto &first = HostAdmission::ForHost("localhost:32010", 1);
+  const auto &second = HostAdmission::ForHost("localhost:32010", 2);
+  ASSERT_EQ(first, second);
+  ASSERT_NE(first, HostAdmission::ForHost("otherhost:32010", 1));
+
+  ASSERT_TRUE(first->Acquire(milliseconds(0)));
+  ASSERT_TRUE(first->Acquire(milliseconds(0)));
+  ASSERT_FALSE(first->Acquire(milliseconds(0)));
+  first->Release();
+  first->Release();
+}
+
+} // namespace flight_sql
+} // namespace driver
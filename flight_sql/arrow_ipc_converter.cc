@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "arrow_ipc_converter.h"
+
+#include <arrow/builder.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/record_batch.h>
+
+namespace driver {
+namespace flight_sql {
+
+using namespace arrow;
+
+namespace {
+// Continuation marker followed by a zero metadata length, as written by
+// RecordBatchStreamWriter::Close().
+const int64_t END_OF_STREAM_SIZE = 8;
+
+std::shared_ptr<Schema> ValueSchema(const std::shared_ptr<DataType> &type) {
+  return schema({field("value", type)});
+}
+
+bool HasDictionary(const DataType &type) {
+  if (type.id() == Type::DICTIONARY) {
+    return true;
+  }
+  for (const auto &field : type.fields()) {
+    if (HasDictionary(*field->type())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Dictionary batches have to precede each row's record batch, so such arrays go
+// through a stream writer per row, keeping what it writes between the schema and
+// the end of stream.
+Status AppendRowWithWriter(BinaryBuilder &builder, const Buffer &schema_message,
+                           const RecordBatch &batch) {
+  ARROW_ASSIGN_OR_RAISE(auto stream, io::BufferOutputStream::Create());
+  ARROW_ASSIGN_OR_RAISE(auto writer, ipc::MakeStreamWriter(stream, batch.schema()));
+  RETURN_NOT_OK(writer->WriteRecordBatch(batch));
+  RETURN_NOT_OK(writer->Close());
+  ARROW_ASSIGN_OR_RAISE(auto buffer, stream->Finish());
+
+  const int64_t messages_size = buffer->size() - schema_message.size() - END_OF_STREAM_SIZE;
+  if (messages_size < 0 ||
+      !Buffer(buffer->data(), schema_message.size()).Equals(schema_message)) {
+    return Status::Invalid("Unexpected schema message written for ", batch.schema()->ToString());
+  }
+  return builder.Append(buffer->data() + schema_message.size(), messages_size);
+}
+}
+
+Result<std::shared_ptr<Buffer>> SerializeArrowIpcSchema(const std::shared_ptr<DataType>& type) {
+  return ipc::SerializeSchema(*ValueSchema(type));
+}
+
+Result<std::shared_ptr<Array>> ConvertToArrowIpc(const std::shared_ptr<Array>& input) {
+  const auto &value_schema = ValueSchema(input->type());
+  const bool has_dictionary = HasDictionary(*input->type());
+  int64_t length = input->length();
+
+  std::shared_ptr<Buffer> schema_message;
+  if (has_dictionary) {
+    ARROW_ASSIGN_OR_RAISE(schema_message, ipc::SerializeSchema(*value_schema));
+  }
+  const auto &options = ipc::IpcWriteOptions::Defaults();
+
+  BinaryBuilder builder;
+  RETURN_NOT_OK(builder.Reserve(length));
+
+  for (int64_t i = 0; i < length; ++i) {
+    if (input->IsNull(i)) {
+      RETURN_NOT_OK(builder.AppendNull());
+      continue;
+    }
+
+    // The IPC writer truncates sliced buffers, so a one-row slice only carries the
+    // child values belonging to this row.
+    const auto &batch = RecordBatch::Make(value_schema, 1, {input->Slice(i, 1)});
+    if (has_dictionary) {
+      RETURN_NOT_OK(AppendRowWithWriter(builder, *schema_message, *batch));
+      continue;
+    }
+
+    ARROW_ASSIGN_OR_RAISE(auto batch_message, ipc::SerializeRecordBatch(*batch, options));
+    RETURN_NOT_OK(builder.Append(batch_message->data(), batch_message->size()));
+  }
+
+  return builder.Finish();
+}
+
+} // namespace flight_sql
+} // namespace driver
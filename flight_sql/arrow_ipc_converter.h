@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#pragma once
+
+#include <arrow/type_fwd.h>
+#include <memory>
+
+namespace driver {
+namespace flight_sql {
+
+/// \brief Serializes the IPC schema message shared by every cell ConvertToArrowIpc
+/// produces for arrays of the given type: a single column named "value".
+/// \param type the type of the encoded array.
+/// \return the encapsulated schema message, as it starts an IPC stream.
+arrow::Result<std::shared_ptr<arrow::Buffer>> SerializeArrowIpcSchema(const std::shared_ptr<arrow::DataType>& type);
+
+/// \brief Encodes each row of a (usually nested) array as Arrow IPC messages.
+/// \param input the array to be encoded.
+/// \return a BinaryArray with the same length and nulls as the input, where every non-null
+///         cell holds the dictionary batches of the row, if any, followed by a record batch of
+///         one row. The schema is left out of the cells: prepending the message from
+///         SerializeArrowIpcSchema to a cell gives an IPC stream. Only the buffer ranges
+///         referenced by the row are written.
+arrow::Result<std::shared_ptr<arrow::Array>> ConvertToArrowIpc(const std::shared_ptr<arrow::Array>& input);
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "arrow_ipc_converter.h"
+
+#include "gtest/gtest.h"
+#include "arrow/testing/gtest_util.h"
+#include <arrow/array.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/message.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/record_batch.h>
+
+namespace driver {
+namespace flight_sql {
+
+using namespace arrow;
+
+namespace {
+/// Reads a cell the way a consumer does, behind the schema message of the column.
+std::shared_ptr<Array> ReadCell(const Buffer &schema_message, const BinaryArray &array, int64_t i) {
+  const auto &cell = array.GetView(i);
+  std::string stream(reinterpret_cast<const char *>(schema_message.data()), schema_message.size());
+  stream.append(cell.data(), cell.size());
+  auto input = std::make_shared<io::BufferReader>(Buffer::FromString(std::move(stream)));
+  auto reader = ipc::RecordBatchStreamReader::Open(input).ValueOrDie();
+
+  std::shared_ptr<RecordBatch> batch;
+  EXPECT_OK(reader->ReadNext(&batch));
+  EXPECT_EQ(1, batch->num_columns());
+  EXPECT_EQ(1, batch->num_rows());
+  return batch->column(0);
+}
+
+void AssertCellsRoundTrip(const std::shared_ptr<Array> &input) {
+  ASSERT_OK_AND_ASSIGN(auto schema_message, SerializeArrowIpcSchema(input->type()));
+  ASSERT_OK_AND_ASSIGN(auto result, ConvertToArrowIpc(input));
+  const auto &output = std::static_pointer_cast<BinaryArray>(result);
+
+  ASSERT_EQ(input->length(), output->length());
+  for (int64_t i = 0; i < input->length(); ++i) {
+    ASSERT_EQ(input->IsNull(i), output->IsNull(i));
+    if (input->IsValid(i)) {
+      const auto &value = ReadCell(*schema_message, *output, i);
+      ASSERT_TRUE(value->Equals(input->Slice(i, 1))) << value->ToString();
+    }
+  }
+}
+}
+
+TEST(ConvertToArrowIpc, List) {
+  AssertCellsRoundTrip(ArrayFromJSON(list(int32()), "[[1, 2], null, [], [3]]"));
+}
+
+TEST(ConvertToArrowIpc, Struct) {
+  auto type = struct_({field("a", int64()), field("b", utf8())});
+  AssertCellsRoundTrip(ArrayFromJSON(type, R"([{"a": 1, "b": "x"}, {"a": null, "b": "yz"}])"));
+}
+
+TEST(ConvertToArrowIpc, NestedDictionary) {
+  const auto &values = DictArrayFromJSON(dictionary(int8(), utf8()), "[0, 1, null, 0]", R"(["x", "yz"])");
+  ASSERT_OK_AND_ASSIGN(auto input, StructArray::Make({values}, {field("d", values->type())}));
+  AssertCellsRoundTrip(input);
+}
+
+TEST(ConvertToArrowIpc, CellHoldsOnlyTheRecordBatch) {
+  const auto &input = ArrayFromJSON(list(int32()), "[[1, 2], [3]]");
+
+  ASSERT_OK_AND_ASSIGN(auto result, ConvertToArrowIpc(input));
+  const auto &cell = std::static_pointer_cast<BinaryArray>(result)->GetView(0);
+
+  io::BufferReader reader(reinterpret_cast<const uint8_t *>(cell.data()), cell.size());
+  ASSERT_OK_AND_ASSIGN(auto message, ipc::ReadMessage(&reader));
+  ASSERT_EQ(ipc::MessageType::RECORD_BATCH, message->type());
+  ASSERT_OK_AND_ASSIGN(auto position, reader.Tell());
+  ASSERT_EQ(static_cast<int64_t>(cell.size()), position);
+}
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "mock_spi.h"
+
+#include <odbcabstraction/odbc_impl/ODBCConnection.h>
+#include <odbcabstraction/odbc_impl/ODBCDescriptor.h>
+#include <odbcabstraction/odbc_impl/ODBCEnvironment.h>
+#include <odbcabstraction/odbc_impl/ODBCStatement.h>
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <future>
+#include <sqlext.h>
+#include <thread>
+
+namespace driver {
+namespace flight_sql {
+
+using odbcabstraction::Connection;
+using odbcabstraction::DriverException;
+using ODBC::ODBCConnection;
+using ODBC::ODBCDescriptor;
+using ODBC::ODBCEnvironment;
+using ODBC::ODBCStatement;
+
+namespace {
+// Bounds the polling loops; reaching it means the background operation never finished.
+const std::chrono::seconds POLL_TIMEOUT(30);
+
+class AsyncConnectionTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    driver_ = std::make_shared<MockDriver>();
+    environment_.reset(new ODBCEnvironment(driver_));
+    environment_->setODBCVersion(SQL_OV_ODBC3);
+    connection_ = environment_->CreateConnection();
+    // Connect and Close block until the test opens the gate.
+    driver_->last_connection->gate = gate_.get_future().share();
+  }
+
+  void TearDown() override {
+    if (!gate_opened_) {
+      OpenGate();
+    }
+  }
+
+  void EnableAsync() {
+    connection_->SetConnectAttr(SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE,
+                                reinterpret_cast<SQLPOINTER>(SQL_ASYNC_DBC_ENABLE_ON), 0, false);
+  }
+
+  void OpenGate() {
+    gate_.set_value();
+    gate_opened_ = true;
+  }
+
+  /// Calls poll until it stops returning SQL_STILL_EXECUTING or POLL_TIMEOUT passes.
+  template <typename POLL>
+  SQLRETURN PollUntilDone(POLL poll) {
+    const auto deadline = std::chrono::steady_clock::now() + POLL_TIMEOUT;
+    SQLRETURN rc;
+    while ((rc = poll()) == SQL_STILL_EXECUTING && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    return rc;
+  }
+
+  SQLRETURN PollConnect(const Connection::ConnPropertyMap &properties,
+                        std::vector<std::string> &missing_properties) {
+    return PollUntilDone([&]() { return connection_->connectAsync("", properties, missing_properties); });
+  }
+
+  SQLRETURN PollDisconnect() {
+    return PollUntilDone([this]() { return connection_->disconnectAsync(); });
+  }
+
+  std::shared_ptr<MockDriver> driver_;
+  std::unique_ptr<ODBCEnvironment> environment_;
+  std::shared_ptr<ODBCConnection> connection_;
+  std::promise<void> gate_;
+  bool gate_opened_ = false;
+};
+}
+
+TEST_F(AsyncConnectionTest, ReportsAsyncCapability) {
+  SQLUINTEGER value = 0;
+  connection_->GetInfo(SQL_ASYNC_DBC_FUNCTIONS, &value, sizeof(value), nullptr, false);
+  ASSERT_EQ(SQL_ASYNC_DBC_CAPABLE, value);
+
+  EnableAsync();
+  connection_->GetConnectAttr(SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE, &value, sizeof(value), nullptr, false);
+  ASSERT_EQ(SQL_ASYNC_DBC_ENABLE_ON, value);
+}
+
+TEST_F(AsyncConnectionTest, ConnectsInBackground) {
+  EnableAsync();
+  std::vector<std::string> missing_properties;
+
+  ASSERT_EQ(SQL_STILL_EXECUTING,
+            connection_->connectAsync("", Connection::ConnPropertyMap(), missing_properties));
+  ASSERT_EQ(SQL_STILL_EXECUTING,
+            connection_->connectAsync("", Connection::ConnPropertyMap(), missing_properties));
+
+  // Other functions are rejected until the connect completes.
+  SQLUINTEGER value;
+  try {
+    connection_->GetInfo(SQL_ASYNC_DBC_FUNCTIONS, &value, sizeof(value), nullptr, false);
+    FAIL() << "GetInfo should fail while connecting";
+  } catch (const DriverException &e) {
+    ASSERT_EQ("HY010", e.GetSqlState());
+  }
+  ASSERT_THROW(connection_->disconnectAsync(), DriverException);
+  ASSERT_EQ(0, driver_->last_connection->connects);
+
+  OpenGate();
+  ASSERT_EQ(SQL_SUCCESS, PollConnect(Connection::ConnPropertyMap(), missing_properties));
+  ASSERT_TRUE(connection_->isConnected());
+  ASSERT_EQ(1, driver_->last_connection->connects);
+
+  ASSERT_EQ(SQL_STILL_EXECUTING, connection_->disconnectAsync());
+  ASSERT_EQ(SQL_SUCCESS, PollDisconnect());
+  ASSERT_FALSE(connection_->isConnected());
+  ASSERT_EQ(1, driver_->last_connection->closes);
+  // Both ran on the driver's threads.
+  ASSERT_EQ(2, driver_->submitted_tasks);
+}
+
+TEST_F(AsyncConnectionTest, RejectsFreeingHandlesWhileDisconnecting) {
+  OpenGate();
+  std::vector<std::string> missing_properties;
+  connection_->connect("", Connection::ConnPropertyMap(), missing_properties);
+  std::shared_ptr<ODBCStatement> statement = connection_->createStatement();
+  std::shared_ptr<ODBCDescriptor> descriptor = connection_->createDescriptor();
+
+  std::promise<void> close_gate;
+  driver_->last_connection->gate = close_gate.get_future().share();
+  EnableAsync();
+  ASSERT_EQ(SQL_STILL_EXECUTING, connection_->disconnectAsync());
+
+  try {
+    statement->releaseStatement();
+    FAIL() << "Freeing a statement should fail while disconnecting";
+  } catch (const DriverException &e) {
+    ASSERT_EQ("HY010", e.GetSqlState());
+  }
+  try {
+    descriptor->ReleaseDescriptor();
+    FAIL() << "Freeing a descriptor should fail while disconnecting";
+  } catch (const DriverException &e) {
+    ASSERT_EQ("HY010", e.GetSqlState());
+  }
+
+  close_gate.set_value();
+  ASSERT_EQ(SQL_SUCCESS, PollDisconnect());
+  ASSERT_FALSE(connection_->isConnected());
+  ASSERT_EQ(1, driver_->last_connection->closes);
+}
+
+TEST_F(AsyncConnectionTest, ReportsConnectFailureWhenPolled) {
+  EnableAsync();
+  Connection::ConnPropertyMap properties;
+  properties["missing"] = "PWD";
+  std::vector<std::string> missing_properties;
+
+  ASSERT_EQ(SQL_STILL_EXECUTING, connection_->connectAsync("", properties, missing_properties));
+  OpenGate();
+  ASSERT_THROW(PollConnect(properties, missing_properties), DriverException);
+  ASSERT_EQ(std::vector<std::string>{"PWD"}, missing_properties);
+  ASSERT_FALSE(connection_->isConnected());
+
+  // The connection can be used again once the failure was reported.
+  connection_->releaseConnection();
+}
+
+TEST_F(AsyncConnectionTest, RunsInlineWhenDisabled) {
+  OpenGate();
+  std::vector<std::string> missing_properties;
+  ASSERT_EQ(SQL_SUCCESS,
+            connection_->connectAsync("", Connection::ConnPropertyMap(), missing_properties));
+  ASSERT_TRUE(connection_->isConnected());
+  ASSERT_EQ(SQL_SUCCESS, connection_->disconnectAsync());
+  ASSERT_FALSE(connection_->isConnected());
+  ASSERT_EQ(0, driver_->submitted_tasks);
+}
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,304 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "mock_spi.h"
+
+#include <odbcabstraction/connection_pool.h>
+#include <odbcabstraction/odbc_impl/ODBCConnection.h>
+#include <odbcabstraction/odbc_impl/ODBCEnvironment.h>
+
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <sqlext.h>
+
+namespace driver {
+namespace flight_sql {
+
+using odbcabstraction::Connection;
+using odbcabstraction::ConnectionPool;
+using odbcabstraction::ConnectionPoolSettings;
+using odbcabstraction::ConnectionPoolStatistics;
+using ODBC::ODBCConnection;
+using ODBC::ODBCEnvironment;
+
+namespace {
+const std::chrono::milliseconds SHORT_INTERVAL(20);
+
+/// Time of a pool under test, which only passes when the test advances it.
+class ManualClock {
+public:
+  ManualClock() : start_(ConnectionPool::Clock::now()), elapsed_(0) {}
+
+  ConnectionPool::Clock::time_point Now() const {
+    return start_ + ConnectionPool::Clock::duration(elapsed_.load());
+  }
+
+  void Advance(ConnectionPool::Clock::duration duration) {
+    elapsed_ += duration.count();
+  }
+
+  /// Read by the maintenance thread as well.
+  ConnectionPool::TimeSource Source() {
+    return [this] { return Now(); };
+  }
+
+private:
+  const ConnectionPool::Clock::time_point start_;
+  std::atomic<ConnectionPool::Clock::rep> elapsed_;
+};
+
+std::shared_ptr<MockConnection> ConnectedConnection() {
+  auto connection = std::make_shared<MockConnection>();
+  std::vector<std::string> missing_properties;
+  connection->Connect(Connection::ConnPropertyMap(), missing_properties);
+  return connection;
+}
+}
+
+TEST(ConnectionPoolTest, CountsHitsAndMisses) {
+  ConnectionPool pool;
+  ConnectionPool::Clock::time_point connected_at;
+  ASSERT_EQ(nullptr, pool.Acquire("key", &connected_at));
+
+  const auto connection = ConnectedConnection();
+  const auto created = ConnectionPool::Clock::now();
+  pool.Release("key", connection, created);
+  ASSERT_EQ(1, connection->resets);
+  ASSERT_EQ(1u, pool.GetStatistics().idle);
+
+  ASSERT_EQ(nullptr, pool.Acquire("other", &connected_at));
+  ASSERT_EQ(connection, pool.Acquire("key", &connected_at));
+  ASSERT_EQ(created, connected_at);
+
+  const ConnectionPoolStatistics statistics = pool.GetStatistics();
+  ASSERT_EQ(1, statistics.hits);
+  ASSERT_EQ(2, statistics.misses);
+  ASSERT_EQ(0u, statistics.idle);
+  ASSERT_EQ(0, connection->closes);
+}
+
+TEST(ConnectionPoolTest, ReusesMostRecentlyReleasedConnection) {
+  ConnectionPool pool;
+  const auto first = ConnectedConnection();
+  const auto second = ConnectedConnection();
+  pool.Release("key", first, ConnectionPool::Clock::now());
+  pool.Release("key", second, ConnectionPool::Clock::now());
+
+  ConnectionPool::Clock::time_point connected_at;
+  ASSERT_EQ(second, pool.Acquire("key", &connected_at));
+  ASSERT_EQ(first, pool.Acquire("key", &connected_at));
+}
+
+TEST(ConnectionPoolTest, ClosesConnectionsPastMaxIdlePerKey) {
+  ConnectionPoolSettings settings;
+  settings.max_idle_per_key = 2;
+  ConnectionPool pool(settings);
+
+  std::vector<std::shared_ptr<MockConnection>> connections;
+  for (int i = 0; i < 3; ++i) {
+    connections.push_back(ConnectedConnection());
+    pool.Release("key", connections.back(), ConnectionPool::Clock::now());
+  }
+  pool.Release("other", ConnectedConnection(), ConnectionPool::Clock::now());
+
+  ASSERT_EQ(0, connections[0]->closes);
+  ASSERT_EQ(0, connections[1]->closes);
+  ASSERT_EQ(1, connections[2]->closes);
+  ASSERT_EQ(3u, pool.GetStatistics().idle);
+}
+
+TEST(ConnectionPoolTest, ClosesConnectionsThatCantBeReset) {
+  ConnectionPool pool;
+  const auto connection = ConnectedConnection();
+  connection->reusable = false;
+  pool.Release("key", connection, ConnectionPool::Clock::now());
+
+  const ConnectionPoolStatistics statistics = pool.GetStatistics();
+  ASSERT_EQ(1, statistics.broken);
+  ASSERT_EQ(0u, statistics.idle);
+  ASSERT_EQ(1, connection->closes);
+}
+
+TEST(ConnectionPoolTest, ClosesConnectionsPastMaxLifetime) {
+  ConnectionPoolSettings settings;
+  settings.max_lifetime = SHORT_INTERVAL;
+  ManualClock clock;
+  ConnectionPool pool(settings, clock.Source());
+
+  const auto old_connection = ConnectedConnection();
+  pool.Release("key", old_connection, clock.Now() - SHORT_INTERVAL);
+  ASSERT_EQ(1, old_connection->closes);
+
+  // A connection that ages while idle expires when it is next acquired.
+  const auto connection = ConnectedConnection();
+  pool.Release("key", connection, clock.Now());
+  clock.Advance(SHORT_INTERVAL);
+  ConnectionPool::Clock::time_point connected_at;
+  ASSERT_EQ(nullptr, pool.Acquire("key", &connected_at));
+  ASSERT_EQ(1, connection->closes);
+
+  const ConnectionPoolStatistics statistics = pool.GetStatistics();
+  ASSERT_EQ(2, statistics.expired);
+  ASSERT_EQ(0, statistics.hits);
+  ASSERT_EQ(0u, statistics.idle);
+}
+
+TEST(ConnectionPoolTest, MaintenanceClosesIdleConnections) {
+  ConnectionPoolSettings settings;
+  settings.max_idle_time = SHORT_INTERVAL;
+  ManualClock clock;
+  ConnectionPool pool(settings, clock.Source());
+
+  const auto connection = ConnectedConnection();
+  pool.Release("key", connection, clock.Now());
+  pool.Maintain();
+  ASSERT_EQ(1u, pool.GetStatistics().idle);
+
+  clock.Advance(SHORT_INTERVAL);
+  pool.Maintain();
+  const ConnectionPoolStatistics statistics = pool.GetStatistics();
+  ASSERT_EQ(1, statistics.expired);
+  ASSERT_EQ(0u, statistics.idle);
+  ASSERT_EQ(1, connection->closes);
+}
+
+TEST(ConnectionPoolTest, MaintenanceChecksIdleConnections) {
+  ConnectionPoolSettings settings;
+  settings.keepalive_interval = SHORT_INTERVAL;
+  ManualClock clock;
+  ConnectionPool pool(settings, clock.Source());
+
+  const auto connection = ConnectedConnection();
+  pool.Release("key", connection, clock.Now());
+  pool.Maintain();
+  ASSERT_EQ(0, connection->health_checks);
+
+  clock.Advance(SHORT_INTERVAL);
+  pool.Maintain();
+  ASSERT_EQ(1, connection->health_checks);
+  ASSERT_EQ(1u, pool.GetStatistics().idle);
+
+  // The check was just done, so the connection isn't checked again yet.
+  pool.Maintain();
+  ASSERT_EQ(1, connection->health_checks);
+
+  connection->alive = false;
+  clock.Advance(SHORT_INTERVAL);
+  pool.Maintain();
+  ASSERT_EQ(2, connection->health_checks);
+  ASSERT_EQ(1, connection->closes);
+
+  const ConnectionPoolStatistics statistics = pool.GetStatistics();
+  ASSERT_EQ(1, statistics.broken);
+  ASSERT_EQ(0u, statistics.idle);
+  ConnectionPool::Clock::time_point connected_at;
+  ASSERT_EQ(nullptr, pool.Acquire("key", &connected_at));
+}
+
+TEST(ConnectionPoolTest, ClosesIdleConnectionsWhenDestroyed) {
+  const auto connection = ConnectedConnection();
+  {
+    ConnectionPool pool;
+    pool.Release("key", connection, ConnectionPool::Clock::now());
+    ASSERT_EQ(0, connection->closes);
+  }
+  ASSERT_EQ(1, connection->closes);
+}
+
+TEST(ConnectionPoolTest, MakeKey) {
+  Connection::ConnPropertyMap properties;
+  properties["UID"] = "user";
+  properties["Host"] = "localhost";
+
+  Connection::ConnPropertyMap renamed;
+  renamed["uid"] = "user";
+  renamed["HOST"] = "localhost";
+  ASSERT_EQ(ConnectionPool::MakeKey("dsn", properties, odbcabstraction::V_3),
+            ConnectionPool::MakeKey("DSN", renamed, odbcabstraction::V_3));
+
+  ASSERT_NE(ConnectionPool::MakeKey("dsn", properties, odbcabstraction::V_3),
+            ConnectionPool::MakeKey("dsn", properties, odbcabstraction::V_2));
+
+  Connection::ConnPropertyMap other_user = properties;
+  other_user["UID"] = "USER";
+  ASSERT_NE(ConnectionPool::MakeKey("dsn", properties, odbcabstraction::V_3),
+            ConnectionPool::MakeKey("dsn", other_user, odbcabstraction::V_3));
+}
+
+namespace {
+class PooledConnectionTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    driver_ = std::make_shared<MockDriver>();
+  }
+
+  std::unique_ptr<ODBCEnvironment> CreateEnvironment(SQLINTEGER odbc_version, SQLINTEGER pooling) {
+    std::unique_ptr<ODBCEnvironment> environment(new ODBCEnvironment(driver_));
+    environment->setODBCVersion(odbc_version);
+    environment->setConnectionPooling(pooling);
+    return environment;
+  }
+
+  /// Connects and disconnects a connection of environment, returning the SPI
+  /// connection handed to the pool.
+  std::shared_ptr<MockConnection> ConnectAndDisconnect(ODBCEnvironment &environment,
+                                                       const std::string &dsn) {
+    const std::shared_ptr<ODBCConnection> connection = environment.CreateConnection();
+    const std::shared_ptr<MockConnection> spi_connection = driver_->last_connection;
+    std::vector<std::string> missing_properties;
+    connection->connect(dsn, Connection::ConnPropertyMap(), missing_properties);
+    connection->releaseConnection();
+    return spi_connection;
+  }
+
+  std::shared_ptr<MockDriver> driver_;
+};
+}
+
+TEST_F(PooledConnectionTest, ReusesConnectionWithAttributesSetBeforeConnect) {
+  const auto environment = CreateEnvironment(SQL_OV_ODBC3, SQL_CP_ONE_PER_HENV);
+  const std::shared_ptr<MockConnection> pooled = ConnectAndDisconnect(*environment, "dsn");
+  ASSERT_EQ(1, pooled->resets);
+
+  const std::shared_ptr<ODBCConnection> connection = environment->CreateConnection();
+  const std::shared_ptr<MockConnection> unused = driver_->last_connection;
+  connection->SetConnectAttr(SQL_ATTR_CONNECTION_TIMEOUT, reinterpret_cast<SQLPOINTER>(30), 0, false);
+
+  std::vector<std::string> missing_properties;
+  connection->connect("dsn", Connection::ConnPropertyMap(), missing_properties);
+  ASSERT_EQ(0, unused->connects);
+  ASSERT_EQ(1, pooled->connects);
+
+  SQLUINTEGER timeout = 0;
+  connection->GetConnectAttr(SQL_ATTR_CONNECTION_TIMEOUT, &timeout, sizeof(timeout), nullptr, false);
+  ASSERT_EQ(30u, timeout);
+  ASSERT_EQ(1, environment->getConnectionPool()->GetStatistics().hits);
+
+  connection->releaseConnection();
+}
+
+TEST_F(PooledConnectionTest, DoesNotShareConnectionsAcrossOdbcVersions) {
+  // The driver-wide pool outlives the test, so the DSN is unique to it.
+  const std::string dsn = "PooledConnectionTest.DoesNotShareConnectionsAcrossOdbcVersions";
+  const auto odbc3 = CreateEnvironment(SQL_OV_ODBC3, SQL_CP_ONE_PER_DRIVER);
+  const auto odbc2 = CreateEnvironment(SQL_OV_ODBC2, SQL_CP_ONE_PER_DRIVER);
+  const std::shared_ptr<MockConnection> pooled = ConnectAndDisconnect(*odbc3, dsn);
+
+  const std::shared_ptr<MockConnection> odbc2_connection = ConnectAndDisconnect(*odbc2, dsn);
+  ASSERT_NE(pooled, odbc2_connection);
+  ASSERT_EQ(1, odbc2_connection->connects);
+  ASSERT_EQ(odbcabstraction::V_2, odbc2_connection->GetDiagnostics().GetOdbcVersion());
+
+  const std::shared_ptr<ODBCConnection> connection = odbc3->CreateConnection();
+  std::vector<std::string> missing_properties;
+  connection->connect(dsn, Connection::ConnPropertyMap(), missing_properties);
+  ASSERT_EQ(0, driver_->last_connection->connects);
+  connection->releaseConnection();
+}
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include <odbcabstraction/connection_string.h>
+
+#include "gtest/gtest.h"
+
+namespace driver {
+namespace flight_sql {
+
+using odbcabstraction::ConnectionString;
+using odbcabstraction::ConnectionStringCache;
+using odbcabstraction::ParseConnectionString;
+
+namespace {
+typedef std::vector<std::pair<std::string, std::string>> Attributes;
+}
+
+TEST(ParseConnectionStringTest, SplitsPairs) {
+  const ConnectionString parsed = ParseConnectionString("HOST=localhost;port=32010;UID=user");
+  ASSERT_EQ("", parsed.dsn);
+  ASSERT_EQ((Attributes{{"HOST", "localhost"}, {"port", "32010"}, {"UID", "user"}}),
+            parsed.attributes);
+}
+
+TEST(ParseConnectionStringTest, KeepsRepeatedKeysInOrder) {
+  const ConnectionString parsed = ParseConnectionString("UID=first;uid=second;");
+  ASSERT_EQ((Attributes{{"UID", "first"}, {"uid", "second"}}), parsed.attributes);
+}
+
+TEST(ParseConnectionStringTest, StripsBraces) {
+  const ConnectionString parsed = ParseConnectionString("PWD={secret};UID= {user} ");
+  ASSERT_EQ((Attributes{{"PWD", "secret"}, {"UID", "user"}}), parsed.attributes);
+}
+
+TEST(ParseConnectionStringTest, BracedValuesContainSeparators) {
+  const ConnectionString parsed = ParseConnectionString("PWD={a;b=c};UID=user");
+  ASSERT_EQ((Attributes{{"PWD", "a;b=c"}, {"UID", "user"}}), parsed.attributes);
+}
+
+TEST(ParseConnectionStringTest, BracedValuesEndAtBraceFollowedBySemicolon) {
+  const ConnectionString parsed = ParseConnectionString("PWD={a}b}c};UID={u}}");
+  ASSERT_EQ((Attributes{{"PWD", "a}b}c"}, {"UID", "u}"}}), parsed.attributes);
+}
+
+TEST(ParseConnectionStringTest, UnclosedBraceEndsAtSemicolon) {
+  const ConnectionString parsed = ParseConnectionString("PWD={abc;UID=user");
+  ASSERT_EQ((Attributes{{"PWD", "{abc"}, {"UID", "user"}}), parsed.attributes);
+}
+
+TEST(ParseConnectionStringTest, UnbracedValuesContainEquals) {
+  const ConnectionString parsed = ParseConnectionString("token=abc==;HOST=localhost");
+  ASSERT_EQ((Attributes{{"token", "abc=="}, {"HOST", "localhost"}}), parsed.attributes);
+}
+
+TEST(ParseConnectionStringTest, TrimsKeys) {
+  const ConnectionString parsed = ParseConnectionString(" UID\t= user; DSN =dsn");
+  ASSERT_EQ("dsn", parsed.dsn);
+  // Unbraced values keep their spaces.
+  ASSERT_EQ((Attributes{{"UID", " user"}}), parsed.attributes);
+}
+
+TEST(ParseConnectionStringTest, SkipsIncompletePairs) {
+  const ConnectionString parsed = ParseConnectionString(";HOST;=value;UID=;PORT=32010;;");
+  ASSERT_EQ((Attributes{{"PORT", "32010"}}), parsed.attributes);
+}
+
+TEST(ParseConnectionStringTest, DsnBeforeDriver) {
+  const ConnectionString parsed = ParseConnectionString("DSN=first;Driver={Flight SQL};dsn=second");
+  ASSERT_EQ("first", parsed.dsn);
+  ASSERT_TRUE(parsed.attributes.empty());
+}
+
+TEST(ParseConnectionStringTest, DriverBeforeDsn) {
+  const ConnectionString parsed = ParseConnectionString("DRIVER={Flight SQL};DSN=dsn;UID=user");
+  ASSERT_EQ("", parsed.dsn);
+  ASSERT_EQ((Attributes{{"UID", "user"}}), parsed.attributes);
+}
+
+TEST(ConnectionStringCacheTest, ReusesParsedConnectionStrings) {
+  ConnectionStringCache &cache = ConnectionStringCache::GetInstance();
+  const std::string conn_str = "DSN=ConnectionStringCacheTest;UID=user";
+  const auto parsed = cache.Parse(conn_str);
+  ASSERT_EQ("ConnectionStringCacheTest", parsed->dsn);
+  ASSERT_EQ(parsed, cache.Parse(conn_str));
+}
+
+TEST(ConnectionStringCacheTest, DoesNotKeepCredentials) {
+  ConnectionStringCache &cache = ConnectionStringCache::GetInstance();
+  for (const std::string conn_str : {"DSN=ConnectionStringCacheTest;PWD=secret",
+                                     "DSN=ConnectionStringCacheTest;password={secret}",
+                                     "DSN=ConnectionStringCacheTest;Token=secret"}) {
+    const auto parsed = cache.Parse(conn_str);
+    ASSERT_EQ("secret", parsed->attributes.at(0).second);
+    ASSERT_NE(parsed, cache.Parse(conn_str));
+  }
+}
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include <odbcabstraction/cpu_dispatch.h>
+#include <odbcabstraction/types.h>
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace driver {
+namespace flight_sql {
+
+using namespace odbcabstraction;
+
+namespace {
+const uint64_t SEED = 0x0DBCF11E5EEDULL;
+
+// Lengths around the 16, 32 and 64 byte blocks of the SIMD variants.
+const std::vector<size_t> LENGTHS = {0, 1, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 200, 1000};
+
+/// The levels other than scalar that the running CPU can execute.
+std::vector<CpuDispatchLevel> SupportedLevels() {
+  const CpuDispatchLevel detected = DetectCpuDispatchLevel();
+  if (detected == CpuDispatchLevel_NEON) {
+    return {CpuDispatchLevel_NEON};
+  }
+  std::vector<CpuDispatchLevel> levels;
+  for (int level = CpuDispatchLevel_SSE4_2; level <= detected; ++level) {
+    levels.push_back(static_cast<CpuDispatchLevel>(level));
+  }
+  return levels;
+}
+
+std::vector<uint8_t> RandomBytes(std::mt19937_64 &rng, size_t length) {
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::vector<uint8_t> bytes(length);
+  for (auto &b : bytes) {
+    b = static_cast<uint8_t>(byte(rng));
+  }
+  return bytes;
+}
+
+/// ASCII text with a non-ASCII byte at a random position, or none.
+std::string RandomText(std::mt19937_64 &rng, size_t length) {
+  std::uniform_int_distribution<int> ascii(0, 127);
+  std::string text(length, ' ');
+  for (auto &c : text) {
+    c = static_cast<char>(ascii(rng));
+  }
+  std::uniform_int_distribution<size_t> position(0, length);
+  const size_t non_ascii = position(rng);
+  if (non_ascii < length) {
+    text[non_ascii] = static_cast<char>(0xC3);
+  }
+  return text;
+}
+
+class CpuKernelsTest : public ::testing::TestWithParam<CpuDispatchLevel> {
+protected:
+  CpuKernelsTest()
+      : scalar_(MakeCpuKernels(CpuDispatchLevel_SCALAR)), kernels_(MakeCpuKernels(GetParam())),
+        rng_(SEED) {}
+
+  const CpuKernels scalar_;
+  const CpuKernels kernels_;
+  std::mt19937_64 rng_;
+};
+}
+
+TEST(CpuDispatch, MakeCpuKernelsBindsLevel) {
+  ASSERT_EQ(CpuDispatchLevel_SCALAR, MakeCpuKernels(CpuDispatchLevel_SCALAR).level);
+  for (const auto level : SupportedLevels()) {
+    ASSERT_EQ(level, MakeCpuKernels(level).level);
+  }
+}
+
+TEST_P(CpuKernelsTest, ExpandValidity) {
+  for (size_t length : LENGTHS) {
+    for (int64_t offset : {0, 1, 5, 8, 13}) {
+      const std::vector<uint8_t> validity = RandomBytes(rng_, (offset + length + 7) / 8);
+      for (const uint8_t *bitmap : {validity.data(), static_cast<const uint8_t *>(nullptr)}) {
+        std::vector<ssize_t> expected(length, -1);
+        std::vector<ssize_t> actual(length, -1);
+        scalar_.expand_validity(bitmap, offset, length, 4, expected.data());
+        kernels_.expand_validity(bitmap, offset, length, 4, actual.data());
+        ASSERT_EQ(expected, actual) << "length=" << length << " offset=" << offset;
+      }
+    }
+  }
+}
+
+TEST_P(CpuKernelsTest, UnpackBits) {
+  for (size_t length : LENGTHS) {
+    for (int64_t offset : {0, 3, 8, 11}) {
+      const std::vector<uint8_t> bitmap = RandomBytes(rng_, (offset + length + 7) / 8);
+      std::vector<uint8_t> expected(length, 0xAB);
+      std::vector<uint8_t> actual(length, 0xAB);
+      scalar_.unpack_bits(bitmap.data(), offset, length, expected.data());
+      kernels_.unpack_bits(bitmap.data(), offset, length, actual.data());
+      ASSERT_EQ(expected, actual) << "length=" << length << " offset=" << offset;
+    }
+  }
+}
+
+TEST_P(CpuKernelsTest, AsciiToUtf16) {
+  for (size_t length : LENGTHS) {
+    const std::string text = RandomText(rng_, length);
+    std::vector<char16_t> expected(length, 0xABAB);
+    std::vector<char16_t> actual(length, 0xABAB);
+    ASSERT_EQ(scalar_.ascii_to_utf16(text.data(), length, expected.data()),
+              kernels_.ascii_to_utf16(text.data(), length, actual.data()));
+    ASSERT_EQ(expected, actual) << "length=" << length;
+  }
+}
+
+TEST_P(CpuKernelsTest, AsciiToUtf32) {
+  for (size_t length : LENGTHS) {
+    const std::string text = RandomText(rng_, length);
+    std::vector<char32_t> expected(length, 0xABABABAB);
+    std::vector<char32_t> actual(length, 0xABABABAB);
+    ASSERT_EQ(scalar_.ascii_to_utf32(text.data(), length, expected.data()),
+              kernels_.ascii_to_utf32(text.data(), length, actual.data()));
+    ASSERT_EQ(expected, actual) << "length=" << length;
+  }
+}
+
+TEST_P(CpuKernelsTest, StridedCopy) {
+  for (size_t count : LENGTHS) {
+    for (size_t width : {1, 2, 4, 8}) {
+      for (size_t stride : {width, width + 8, 3 * width + 5}) {
+        const std::vector<uint8_t> src = RandomBytes(rng_, count * width);
+        std::vector<uint8_t> expected(count * stride, 0xAB);
+        std::vector<uint8_t> actual(count * stride, 0xAB);
+        scalar_.strided_copy(src.data(), width, count, expected.data(), stride);
+        kernels_.strided_copy(src.data(), width, count, actual.data(), stride);
+        ASSERT_EQ(expected, actual) << "count=" << count << " width=" << width << " stride=" << stride;
+      }
+    }
+  }
+}
+
+TEST_P(CpuKernelsTest, HexEncode) {
+  for (size_t length : LENGTHS) {
+    const std::vector<uint8_t> src = RandomBytes(rng_, length);
+    std::string expected(2 * length + 1, '#');
+    std::string actual(2 * length + 1, '#');
+    scalar_.hex_encode(src.data(), length, &expected[0]);
+    kernels_.hex_encode(src.data(), length, &actual[0]);
+    ASSERT_EQ(expected, actual) << "length=" << length;
+  }
+}
+
+TEST(CpuDispatch, ScalarHexEncode) {
+  const uint8_t bytes[] = {0x00, 0x0F, 0xA5, 0xFF};
+  std::string hex(8, '#');
+  MakeCpuKernels(CpuDispatchLevel_SCALAR).hex_encode(bytes, sizeof(bytes), &hex[0]);
+  ASSERT_EQ("000FA5FF", hex);
+}
+
+// Hosts without SIMD support run no instance.
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(CpuKernelsTest);
+
+INSTANTIATE_TEST_SUITE_P(SupportedLevels, CpuKernelsTest, ::testing::ValuesIn(SupportedLevels()),
+                         [](const ::testing::TestParamInfo<CpuDispatchLevel> &info) {
+                           std::string name = CpuDispatchLevelToString(info.param);
+                           name.erase(std::remove(name.begin(), name.end(), '.'), name.end());
+                           return name;
+                         });
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "flight_sql_parameter_writer.h"
+#include "mock_spi.h"
+
+#include <odbcabstraction/encoding.h>
+#include <odbcabstraction/odbc_impl/ODBCConnection.h>
+#include <odbcabstraction/odbc_impl/ODBCEnvironment.h>
+#include <odbcabstraction/odbc_impl/ODBCStatement.h>
+
+#include <arrow/array.h>
+#include "gtest/gtest.h"
+#include <cstring>
+#include <sqlext.h>
+
+namespace driver {
+namespace flight_sql {
+
+using odbcabstraction::Connection;
+using odbcabstraction::DriverException;
+using odbcabstraction::ParameterType;
+using ODBC::ODBCConnection;
+using ODBC::ODBCEnvironment;
+using ODBC::ODBCStatement;
+
+namespace {
+/// Encodes text as SQLWCHARs of the size the driver manager uses.
+std::vector<uint8_t> ToWcs(const std::u32string &text) {
+  std::vector<uint8_t> result;
+  for (char32_t code_point : text) {
+    std::vector<char32_t> code_units;
+    if (odbcabstraction::GetSqlWCharSize() == sizeof(char16_t) && code_point >= 0x10000) {
+      code_units.push_back(0xD800 + ((code_point - 0x10000) >> 10));
+      code_units.push_back(0xDC00 + ((code_point - 0x10000) & 0x3FF));
+    } else {
+      code_units.push_back(code_point);
+    }
+    for (char32_t code_unit : code_units) {
+      uint8_t bytes[sizeof(char32_t)];
+      if (odbcabstraction::GetSqlWCharSize() == sizeof(char16_t)) {
+        const auto narrow = static_cast<char16_t>(code_unit);
+        std::memcpy(bytes, &narrow, sizeof(narrow));
+      } else {
+        std::memcpy(bytes, &code_unit, sizeof(code_unit));
+      }
+      result.insert(result.end(), bytes, bytes + odbcabstraction::GetSqlWCharSize());
+    }
+  }
+  return result;
+}
+
+class DataAtExecutionTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    driver_ = std::make_shared<MockDriver>();
+    environment_.reset(new ODBCEnvironment(driver_));
+    environment_->setODBCVersion(SQL_OV_ODBC3);
+    connection_ = environment_->CreateConnection();
+
+    std::vector<std::string> missing_properties;
+    connection_->connect("", Connection::ConnPropertyMap(), missing_properties);
+    statement_ = connection_->createStatement().get();
+    statement_->Prepare("INSERT INTO documents VALUES (?, ?, ?)");
+  }
+
+  void TearDown() override {
+    statement_->releaseStatement();
+    connection_->releaseConnection();
+  }
+
+  MockStatement &GetSpiStatement() { return *driver_->last_connection->last_statement; }
+
+  std::shared_ptr<MockDriver> driver_;
+  std::unique_ptr<ODBCEnvironment> environment_;
+  std::shared_ptr<ODBCConnection> connection_;
+  ODBCStatement *statement_;
+};
+}
+
+TEST_F(DataAtExecutionTest, ExecutesBoundParametersDirectly) {
+  char name[] = "report";
+  SQLLEN name_length = SQL_NTS;
+  SQLLEN null_indicator = SQL_NULL_DATA;
+  const uint8_t blob[] = {0, 1, 2};
+  SQLLEN blob_length = sizeof(blob);
+  statement_->BindParameter(1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR, 0, 0, name, 0, &name_length);
+  statement_->BindParameter(2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR, 0, 0, name, 0, &null_indicator);
+  statement_->BindParameter(3, SQL_PARAM_INPUT, SQL_C_DEFAULT, SQL_VARBINARY, 0, 0,
+                            const_cast<uint8_t *>(blob), 0, &blob_length);
+
+  ASSERT_EQ(SQL_SUCCESS, statement_->ExecutePrepared());
+
+  MockStatement &spi_statement = GetSpiStatement();
+  ASSERT_EQ(1, spi_statement.prepared_executions);
+  ASSERT_EQ(std::vector<ParameterType>({odbcabstraction::ParameterType_STRING,
+                                        odbcabstraction::ParameterType_STRING,
+                                        odbcabstraction::ParameterType_BINARY}),
+            spi_statement.parameter_types);
+  ASSERT_EQ(std::string("report"), *spi_statement.parameter_writer->values[0]);
+  ASSERT_FALSE(spi_statement.parameter_writer->values[1]);
+  ASSERT_EQ(std::string("\0\1\2", 3), *spi_statement.parameter_writer->values[2]);
+}
+
+TEST_F(DataAtExecutionTest, StreamsPutDataPieces) {
+  char name[] = "report";
+  SQLLEN name_length = SQL_NTS;
+  SQLLEN text_length = SQL_LEN_DATA_AT_EXEC(0);
+  SQLLEN blob_length = SQL_DATA_AT_EXEC;
+  int text_token = 2;
+  int blob_token = 3;
+  statement_->BindParameter(1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR, 0, 0, name, 0, &name_length);
+  statement_->BindParameter(2, SQL_PARAM_INPUT, SQL_C_WCHAR, SQL_WLONGVARCHAR, 0, 0, &text_token, 0,
+                            &text_length);
+  statement_->BindParameter(3, SQL_PARAM_INPUT, SQL_C_BINARY, SQL_LONGVARBINARY, 0, 0, &blob_token, 0,
+                            &blob_length);
+
+  ASSERT_EQ(SQL_NEED_DATA, statement_->ExecutePrepared());
+  MockStatement &spi_statement = GetSpiStatement();
+  ASSERT_EQ(0, spi_statement.prepared_executions);
+  ASSERT_THROW(statement_->ExecutePrepared(), DriverException);
+
+  SQLPOINTER token = nullptr;
+  ASSERT_EQ(SQL_NEED_DATA, statement_->ParamData(&token));
+  ASSERT_EQ(&text_token, token);
+
+  // Split the text one byte at a time, cutting through code units and surrogate pairs.
+  const std::vector<uint8_t> text = ToWcs(U"café \U0001F600");
+  for (size_t i = 0; i < text.size(); ++i) {
+    statement_->PutData(const_cast<uint8_t *>(&text[i]), 1);
+  }
+
+  ASSERT_EQ(SQL_NEED_DATA, statement_->ParamData(&token));
+  ASSERT_EQ(&blob_token, token);
+  char first[] = "abc";
+  char second[] = "def";
+  statement_->PutData(first, 3);
+  statement_->PutData(second, 3);
+
+  ASSERT_EQ(SQL_SUCCESS, statement_->ParamData(&token));
+  ASSERT_EQ(1, spi_statement.prepared_executions);
+  ASSERT_EQ(std::string("report"), *spi_statement.parameter_writer->values[0]);
+  ASSERT_EQ(std::string(u8"café \U0001F600"), *spi_statement.parameter_writer->values[1]);
+  ASSERT_EQ(std::string("abcdef"), *spi_statement.parameter_writer->values[2]);
+
+  // The statement can be executed again, asking for the values anew.
+  ASSERT_EQ(SQL_NEED_DATA, statement_->ExecutePrepared());
+}
+
+TEST_F(DataAtExecutionTest, CancelAbandonsExecution) {
+  SQLLEN length = SQL_DATA_AT_EXEC;
+  statement_->BindParameter(1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_LONGVARCHAR, 0, 0, nullptr, 0, &length);
+
+  ASSERT_EQ(SQL_NEED_DATA, statement_->ExecutePrepared());
+  ASSERT_THROW(statement_->PutData(const_cast<char *>("x"), 1), DriverException);
+  SQLPOINTER token;
+  ASSERT_EQ(SQL_NEED_DATA, statement_->ParamData(&token));
+  statement_->PutData(const_cast<char *>("x"), 1);
+
+  statement_->Cancel();
+  ASSERT_THROW(statement_->ParamData(&token), DriverException);
+  ASSERT_EQ(0, GetSpiStatement().prepared_executions);
+}
+
+TEST_F(DataAtExecutionTest, RejectsUnsupportedTypes) {
+  SQLINTEGER value = 1;
+  ASSERT_THROW(statement_->BindParameter(1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &value, 0, nullptr),
+               DriverException);
+  ASSERT_THROW(statement_->BindParameter(1, SQL_PARAM_OUTPUT, SQL_C_CHAR, SQL_VARCHAR, 0, 0, &value, 0, nullptr),
+               DriverException);
+}
+
+TEST(FlightSqlParameterWriter, AppendsPiecesToBuilders) {
+  FlightSqlParameterWriter writer({odbcabstraction::ParameterType_STRING,
+                                   odbcabstraction::ParameterType_BINARY,
+                                   odbcabstraction::ParameterType_STRING});
+  writer.Append(0, "hello ", 6);
+  writer.Append(0, "world", 5);
+  writer.SetNull(1);
+  ASSERT_THROW(writer.Append(1, "x", 1), DriverException);
+
+  const auto &batch = writer.Finish();
+  ASSERT_EQ(1, batch->num_rows());
+  ASSERT_EQ(3, batch->num_columns());
+  ASSERT_EQ("hello world", std::static_pointer_cast<arrow::StringArray>(batch->column(0))->GetString(0));
+  ASSERT_TRUE(batch->column(1)->IsNull(0));
+  ASSERT_EQ("", std::static_pointer_cast<arrow::StringArray>(batch->column(2))->GetString(0));
+}
+
+} // namespace flight_sql
+} // namespace driver
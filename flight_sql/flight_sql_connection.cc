@@ -7,11 +7,13 @@
 #include "flight_sql_connection.h"
 
 #include <odbcabstraction/platform.h>
+#include <odbcabstraction/logger.h>
 #include <odbcabstraction/utils.h>
 
 #include <arrow/flight/types.h>
 #include <arrow/flight/client_cookie_middleware.h>
 #include "address_info.h"
+#include "admission_control.h"
 #include "flight_sql_auth_method.h"
 #include "flight_sql_statement.h"
 #include "flight_sql_ssl_config.h"
@@ -68,13 +70,19 @@ const std::string FlightSqlConnection::USE_SYSTEM_TRUST_STORE = "useSystemTrustS
 const std::string FlightSqlConnection::STRING_COLUMN_LENGTH = "StringColumnLength";
 const std::string FlightSqlConnection::USE_WIDE_CHAR = "UseWideChar";
 const std::string FlightSqlConnection::CHUNK_BUFFER_CAPACITY = "ChunkBufferCapacity";
+const std::string FlightSqlConnection::COMPLEX_TYPES_AS_ARROW_IPC = "ComplexTypesAsArrowIpc";
+const std::string FlightSqlConnection::MAX_CONCURRENT_QUERIES = "MaxConcurrentQueries";
+const std::string FlightSqlConnection::ADMISSION_TIMEOUT = "AdmissionTimeout";
+const std::string FlightSqlConnection::BATCH_STATEMENTS = "BatchStatements";
 
 const std::vector<std::string> FlightSqlConnection::ALL_KEYS = {
     FlightSqlConnection::DSN, FlightSqlConnection::DRIVER, FlightSqlConnection::HOST, FlightSqlConnection::PORT,
     FlightSqlConnection::TOKEN, FlightSqlConnection::UID, FlightSqlConnection::USER_ID, FlightSqlConnection::PWD,
     FlightSqlConnection::USE_ENCRYPTION, FlightSqlConnection::TRUSTED_CERTS, FlightSqlConnection::USE_SYSTEM_TRUST_STORE,
     FlightSqlConnection::DISABLE_CERTIFICATE_VERIFICATION, FlightSqlConnection::STRING_COLUMN_LENGTH,
-    FlightSqlConnection::USE_WIDE_CHAR, FlightSqlConnection::CHUNK_BUFFER_CAPACITY};
+    FlightSqlConnection::USE_WIDE_CHAR, FlightSqlConnection::CHUNK_BUFFER_CAPACITY,
+    FlightSqlConnection::COMPLEX_TYPES_AS_ARROW_IPC, FlightSqlConnection::MAX_CONCURRENT_QUERIES,
+    FlightSqlConnection::ADMISSION_TIMEOUT, FlightSqlConnection::BATCH_STATEMENTS};
 
 namespace {
 
@@ -114,22 +122,31 @@ inline std::string GetCerts() {
 
 #endif
 
-const std::set<std::string, odbcabstraction::CaseInsensitiveComparator> BUILT_IN_PROPERTIES = {
-    FlightSqlConnection::HOST,
-    FlightSqlConnection::PORT,
-    FlightSqlConnection::USER,
-    FlightSqlConnection::USER_ID,
-    FlightSqlConnection::UID,
-    FlightSqlConnection::PASSWORD,
-    FlightSqlConnection::PWD,
-    FlightSqlConnection::TOKEN,
-    FlightSqlConnection::USE_ENCRYPTION,
-    FlightSqlConnection::DISABLE_CERTIFICATE_VERIFICATION,
-    FlightSqlConnection::TRUSTED_CERTS,
-    FlightSqlConnection::USE_SYSTEM_TRUST_STORE,
-    FlightSqlConnection::STRING_COLUMN_LENGTH,
-    FlightSqlConnection::USE_WIDE_CHAR
-};
+/// Whether property is handled by the driver rather than passed on to the server
+/// as a header.
+bool IsBuiltInProperty(const std::string &property) {
+  static const std::set<std::string, odbcabstraction::CaseInsensitiveComparator> BUILT_IN_PROPERTIES = {
+      FlightSqlConnection::HOST,
+      FlightSqlConnection::PORT,
+      FlightSqlConnection::USER,
+      FlightSqlConnection::USER_ID,
+      FlightSqlConnection::UID,
+      FlightSqlConnection::PASSWORD,
+      FlightSqlConnection::PWD,
+      FlightSqlConnection::TOKEN,
+      FlightSqlConnection::USE_ENCRYPTION,
+      FlightSqlConnection::DISABLE_CERTIFICATE_VERIFICATION,
+      FlightSqlConnection::TRUSTED_CERTS,
+      FlightSqlConnection::USE_SYSTEM_TRUST_STORE,
+      FlightSqlConnection::STRING_COLUMN_LENGTH,
+      FlightSqlConnection::USE_WIDE_CHAR,
+      FlightSqlConnection::COMPLEX_TYPES_AS_ARROW_IPC,
+      FlightSqlConnection::MAX_CONCURRENT_QUERIES,
+      FlightSqlConnection::ADMISSION_TIMEOUT,
+      FlightSqlConnection::BATCH_STATEMENTS
+  };
+  return BUILT_IN_PROPERTIES.count(property) != 0;
+}
 
 Connection::ConnPropertyMap::const_iterator
 TrackMissingRequiredProperty(const std::string &property,
@@ -191,6 +208,17 @@ void FlightSqlConnection::Connect(const ConnPropertyMap &properties,
     info_.SetProperty(SQL_USER_NAME, auth_method->GetUser());
     attribute_[CONNECTION_DEAD] = static_cast<uint32_t>(SQL_FALSE);
     PopulateMetadataSettings(properties);
+
+    const size_t max_concurrent_queries = GetMaxConcurrentQueries(properties);
+    if (max_concurrent_queries > 0) {
+      admission_ = HostAdmission::ForHost(location.ToString(), max_concurrent_queries);
+      admission_timeout_ = GetAdmissionTimeout(properties);
+    } else {
+      admission_.reset();
+    }
+
+    connected_attribute_ = attribute_;
+    connected_call_options_ = call_options_;
   } catch (...) {
     attribute_[CONNECTION_DEAD] = static_cast<uint32_t>(SQL_TRUE);
     sql_client_.reset();
@@ -203,6 +231,8 @@ void FlightSqlConnection::PopulateMetadataSettings(const Connection::ConnPropert
   metadata_settings_.string_column_length_ = GetStringColumnLength(conn_property_map);
   metadata_settings_.use_wide_char_ = GetUseWideChar(conn_property_map);
   metadata_settings_.chunk_buffer_capacity_ = GetChunkBufferCapacity(conn_property_map);
+  metadata_settings_.complex_types_as_arrow_ipc_ = GetComplexTypesAsArrowIpc(conn_property_map);
+  metadata_settings_.batch_statements_ = GetBatchStatements(conn_property_map);
 }
 
 boost::optional<int32_t> FlightSqlConnection::GetStringColumnLength(const Connection::ConnPropertyMap &conn_property_map) {
@@ -245,6 +275,47 @@ size_t FlightSqlConnection::GetChunkBufferCapacity(const ConnPropertyMap &connPr
   return default_value;
 }
 
+bool FlightSqlConnection::GetComplexTypesAsArrowIpc(const ConnPropertyMap &connPropertyMap) {
+  // Complex types are exposed as JSON strings unless the application asks for Arrow IPC.
+  return AsBool(connPropertyMap, FlightSqlConnection::COMPLEX_TYPES_AS_ARROW_IPC).value_or(false);
+}
+
+bool FlightSqlConnection::GetBatchStatements(const ConnPropertyMap &connPropertyMap) {
+  // Queries are sent to the server as written unless scripts are to be split.
+  return AsBool(connPropertyMap, FlightSqlConnection::BATCH_STATEMENTS).value_or(false);
+}
+
+size_t FlightSqlConnection::GetMaxConcurrentQueries(const ConnPropertyMap &connPropertyMap) {
+  // Unlimited by default.
+  size_t default_value = 0;
+  try {
+    return AsInt32(0, connPropertyMap, FlightSqlConnection::MAX_CONCURRENT_QUERIES).value_or(default_value);
+  } catch (const std::exception& e) {
+    diagnostics_.AddWarning(
+            std::string("Invalid value for connection property " + FlightSqlConnection::MAX_CONCURRENT_QUERIES +
+                        ". Please ensure it has a valid numeric value. Message: " + e.what()),
+            "01000", odbcabstraction::ODBCErrorCodes_GENERAL_WARNING);
+  }
+
+  return default_value;
+}
+
+std::chrono::milliseconds FlightSqlConnection::GetAdmissionTimeout(const ConnPropertyMap &connPropertyMap) {
+  // In seconds, 0 fails right away when the server is at its limit.
+  int32_t default_value = 30;
+  int32_t timeout = default_value;
+  try {
+    timeout = AsInt32(0, connPropertyMap, FlightSqlConnection::ADMISSION_TIMEOUT).value_or(default_value);
+  } catch (const std::exception& e) {
+    diagnostics_.AddWarning(
+            std::string("Invalid value for connection property " + FlightSqlConnection::ADMISSION_TIMEOUT +
+                        ". Please ensure it has a valid numeric value. Message: " + e.what()),
+            "01000", odbcabstraction::ODBCErrorCodes_GENERAL_WARNING);
+  }
+
+  return std::chrono::seconds(timeout);
+}
+
 const FlightCallOptions &
 FlightSqlConnection::PopulateCallOptions(const ConnPropertyMap &props) {
   // Set CONNECTION_TIMEOUT attribute or LOGIN_TIMEOUT depending on if this
@@ -257,7 +328,7 @@ FlightSqlConnection::PopulateCallOptions(const ConnPropertyMap &props) {
   }
 
   for (auto prop : props) {
-    if (BUILT_IN_PROPERTIES.count(prop.first) != 0) {
+    if (IsBuiltInProperty(prop.first)) {
       continue;
     }
 
@@ -377,7 +448,9 @@ std::shared_ptr<Statement> FlightSqlConnection::CreateStatement() {
               diagnostics_,
               *sql_client_,
               call_options_,
-              metadata_settings_
+              metadata_settings_,
+              admission_,
+              admission_timeout_
               )
       );
 }
@@ -406,11 +479,57 @@ FlightSqlConnection::GetAttribute(Connection::AttributeId attribute) {
     return boost::make_optional(Attribute(static_cast<uint32_t>(0)));
   default:
     const auto &it = attribute_.find(attribute);
-    return boost::make_optional(it != attribute_.end(), it->second);
+    if (it == attribute_.end()) {
+      return boost::none;
+    }
+    return it->second;
+  }
+}
+
+bool FlightSqlConnection::Reset() {
+  if (closed_ || !sql_client_) {
+    return false;
   }
+  const auto &dead = attribute_.find(CONNECTION_DEAD);
+  if (dead != attribute_.end() && boost::get<uint32_t>(dead->second) == SQL_TRUE) {
+    return false;
+  }
+
+  attribute_ = connected_attribute_;
+  call_options_ = connected_call_options_;
+  diagnostics_.Clear();
+  return true;
+}
+
+bool FlightSqlConnection::IsAlive() {
+  if (closed_ || !sql_client_) {
+    return false;
+  }
+
+  // Asking for the flight of a single SqlInfo is a round trip that doesn't stream data.
+  FlightCallOptions options = call_options_;
+  options.timeout = TimeoutDuration{10.0};
+  const auto &result = sql_client_->GetSqlInfo(
+      options, {arrow::flight::sql::SqlInfoOptions::FLIGHT_SQL_SERVER_NAME});
+  if (!result.ok()) {
+    LOG_DEBUG("Connection health check failed: {}", result.status().ToString());
+    attribute_[CONNECTION_DEAD] = static_cast<uint32_t>(SQL_TRUE);
+    return false;
+  }
+  return true;
 }
 
 Connection::Info FlightSqlConnection::GetInfo(uint16_t info_type) {
+  // Scripts are split by the driver, so batch support doesn't depend on the server.
+  if (info_type == SQL_BATCH_SUPPORT) {
+    return static_cast<uint32_t>(metadata_settings_.batch_statements_
+                                     ? SQL_BS_SELECT_EXPLICIT | SQL_BS_ROW_COUNT_EXPLICIT
+                                     : 0);
+  }
+  if (info_type == SQL_BATCH_ROW_COUNT) {
+    return static_cast<uint32_t>(metadata_settings_.batch_statements_ ? SQL_BRC_EXPLICIT : 0);
+  }
+
   auto result = info_.GetInfo(info_type);
   if (info_type == SQL_DBMS_NAME || info_type == SQL_SERVER_NAME) {
     // Update the database component reported in error messages.
@@ -423,7 +542,7 @@ Connection::Info FlightSqlConnection::GetInfo(uint16_t info_type) {
 FlightSqlConnection::FlightSqlConnection(OdbcVersion odbc_version, const std::string &driver_version)
     : diagnostics_("Apache Arrow", "Flight SQL", odbc_version),
       odbc_version_(odbc_version), info_(call_options_, sql_client_, driver_version),
-      closed_(true) {
+      closed_(true), admission_timeout_(0) {
   attribute_[CONNECTION_DEAD] = static_cast<uint32_t>(SQL_TRUE);
   attribute_[LOGIN_TIMEOUT] = static_cast<uint32_t>(0);
   attribute_[CONNECTION_TIMEOUT] = static_cast<uint32_t>(0);
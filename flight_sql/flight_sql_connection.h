@@ -10,6 +10,7 @@
 
 #include <arrow/flight/api.h>
 #include <arrow/flight/sql/api.h>
+#include <chrono>
 #include <vector>
 
 #include "get_info_cache.h"
@@ -19,6 +20,7 @@ namespace driver {
 namespace flight_sql {
 
 class FlightSqlSslConfig;
+class HostAdmission;
 
 /// \brief Create an instance of the FlightSqlSslConfig class, from the properties passed
 ///        into the map.
@@ -40,6 +42,12 @@ private:
   odbcabstraction::Diagnostics diagnostics_;
   odbcabstraction::OdbcVersion odbc_version_;
   bool closed_;
+  /// Limits the queries run against the server, null when unlimited.
+  std::shared_ptr<HostAdmission> admission_;
+  std::chrono::milliseconds admission_timeout_;
+  /// State right after Connect(), restored by Reset() before the connection is pooled.
+  std::map<AttributeId, Attribute> connected_attribute_;
+  arrow::flight::FlightCallOptions connected_call_options_;
 
   void PopulateMetadataSettings(const Connection::ConnPropertyMap &connPropertyMap);
 
@@ -62,6 +70,10 @@ public:
   static const std::string STRING_COLUMN_LENGTH;
   static const std::string USE_WIDE_CHAR;
   static const std::string CHUNK_BUFFER_CAPACITY;
+  static const std::string COMPLEX_TYPES_AS_ARROW_IPC;
+  static const std::string MAX_CONCURRENT_QUERIES;
+  static const std::string ADMISSION_TIMEOUT;
+  static const std::string BATCH_STATEMENTS;
 
   explicit FlightSqlConnection(odbcabstraction::OdbcVersion odbc_version, const std::string &driver_version = "0.9.0.0");
 
@@ -79,6 +91,10 @@ public:
 
   Info GetInfo(uint16_t info_type) override;
 
+  bool Reset() override;
+
+  bool IsAlive() override;
+
   /// \brief Builds a Location used for FlightClient connection.
   /// \note Visible for testing
   static arrow::flight::Location
@@ -107,6 +123,14 @@ public:
   bool GetUseWideChar(const ConnPropertyMap &connPropertyMap);
 
   size_t GetChunkBufferCapacity(const ConnPropertyMap &connPropertyMap);
+
+  bool GetComplexTypesAsArrowIpc(const ConnPropertyMap &connPropertyMap);
+
+  bool GetBatchStatements(const ConnPropertyMap &connPropertyMap);
+
+  size_t GetMaxConcurrentQueries(const ConnPropertyMap &connPropertyMap);
+
+  std::chrono::milliseconds GetAdmissionTimeout(const ConnPropertyMap &connPropertyMap);
 };
 } // namespace flight_sql
 } // namespace driver
@@ -9,8 +9,10 @@
 
 #include <flight_sql/flight_sql_driver.h>
 #include <odbcabstraction/platform.h>
+#include <odbcabstraction/exceptions.h>
 #include <odbcabstraction/spd_logger.h>
 #include "flight_sql_connection.h"
+#include "stream_io_pool.h"
 #include "odbcabstraction/utils.h"
 
 
@@ -47,7 +49,8 @@ namespace {
 FlightSqlDriver::FlightSqlDriver()
     : diagnostics_("Apache Arrow", "Flight SQL", OdbcVersion::V_3),
       version_("0.9.0.0")
-{}
+{
+}
 
 std::shared_ptr<Connection>
 FlightSqlDriver::CreateConnection(OdbcVersion odbc_version) {
@@ -62,31 +65,43 @@ void FlightSqlDriver::SetVersion(std::string version) {
   version_ = std::move(version);
 }
 
+void FlightSqlDriver::SubmitTask(std::function<void()> task) {
+  // The pool adds threads while tasks wait behind blocked reads, so a slow connect
+  // doesn't hold up result streams for long.
+  StreamIoPool::GetInstance().Submit(odbcabstraction::StreamPriority_INTERACTIVE, std::move(task));
+}
+
 void FlightSqlDriver::RegisterLog() {
   odbcabstraction::PropertyMap propertyMap;
-  driver::odbcabstraction::ReadConfigFile(propertyMap, CONFIG_FILE_NAME);
+  try {
+    driver::odbcabstraction::ReadConfigFile(propertyMap, CONFIG_FILE_NAME);
+  } catch (const odbcabstraction::DriverException &) {
+    // Without a config file logging stays disabled.
+    return;
+  }
 
+  // Return before touching spdlog unless logging is asked for: setting up its
+  // async logger and thread pool would otherwise add to every driver load.
   auto log_enable_iterator = propertyMap.find(SPDLogger::LOG_ENABLED);
-  auto log_enabled =
-          log_enable_iterator != propertyMap.end() ? odbcabstraction::AsBool(log_enable_iterator->second) : false;
-
-  // if (!log_enabled) {
-  //   return;
-  // }
+  bool log_enabled = log_enable_iterator != propertyMap.end() &&
+                     odbcabstraction::AsBool(log_enable_iterator->second).value_or(false);
+  if (!log_enabled) {
+    return;
+  }
 
   auto log_path_iterator = propertyMap.find(SPDLogger::LOG_PATH);
-  std::string log_path = "D:\\arrow-odbc.log";
-    // log_path_iterator != propertyMap.end() ? log_path_iterator->second : "";
+  std::string log_path =
+    log_path_iterator != propertyMap.end() ? log_path_iterator->second : "";
   if (log_path.empty()) {
     return;
   }
 
   auto log_level_iterator = propertyMap.find(SPDLogger::LOG_LEVEL);
-  auto log_level = odbcabstraction::LogLevel_TRACE;
-          // ToLogLevel(log_level_iterator != propertyMap.end() ? std::stoi(log_level_iterator->second) : 1);
-  // if (log_level == odbcabstraction::LogLevel_OFF) {
-  //   return;
-  // }
+  auto log_level =
+    ToLogLevel(log_level_iterator != propertyMap.end() ? std::stoi(log_level_iterator->second) : 1);
+  if (log_level == odbcabstraction::LogLevel_OFF) {
+    return;
+  }
 
   auto maximum_file_size_iterator = propertyMap.find(SPDLogger::MAXIMUM_FILE_SIZE);
   auto maximum_file_size = maximum_file_size_iterator != propertyMap.end() ?
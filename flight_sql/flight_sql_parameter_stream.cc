@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "flight_sql_parameter_stream.h"
+#include "utils.h"
+
+#include <arrow/c/abi.h>
+#include <arrow/c/bridge.h>
+#include <odbcabstraction/exceptions.h>
+
+namespace driver {
+namespace flight_sql {
+
+using odbcabstraction::DriverException;
+
+FlightSqlParameterStream::FlightSqlParameterStream(
+    struct ArrowArrayStream *stream, const std::shared_ptr<arrow::Schema> &parameter_schema) {
+  // Importing moves the stream into the reader, which releases it once destroyed.
+  auto import_result = arrow::ImportRecordBatchReader(stream);
+  ThrowIfNotOK(import_result.status());
+  reader_ = import_result.ValueOrDie();
+
+  if (parameter_schema && parameter_schema->num_fields() != reader_->schema()->num_fields()) {
+    throw DriverException("Parameter stream does not match the number of statement parameters", "07002");
+  }
+}
+
+int64_t FlightSqlParameterStream::ExecuteBatches(const BatchExecutor &execute_batch) {
+  int64_t rows_affected = 0;
+  std::shared_ptr<arrow::RecordBatch> batch;
+  while (true) {
+    ThrowIfNotOK(reader_->ReadNext(&batch));
+    if (!batch) {
+      break;
+    }
+    if (batch->num_rows() == 0) {
+      continue;
+    }
+    rows_affected += execute_batch(batch);
+  }
+  return rows_affected;
+}
+
+void ReleaseParameterStream(struct ArrowArrayStream *stream) {
+  if (stream != nullptr && stream->release != nullptr) {
+    stream->release(stream);
+  }
+}
+
+} // namespace flight_sql
+} // namespace driver
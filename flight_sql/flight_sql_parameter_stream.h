@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#pragma once
+
+#include <arrow/record_batch.h>
+#include <functional>
+#include <memory>
+
+struct ArrowArrayStream;
+
+namespace driver {
+namespace flight_sql {
+
+/// \brief Batches of an ArrowArrayStream bound as the parameter sets of a prepared
+/// statement, one execution per batch.
+class FlightSqlParameterStream {
+public:
+  typedef std::function<int64_t(const std::shared_ptr<arrow::RecordBatch> &)> BatchExecutor;
+
+  /// \brief Imports stream, which is released along with this object. Throws a
+  /// DriverException with SQLSTATE 07002 if it doesn't have one column per parameter.
+  /// \param parameter_schema parameters of the statement, null if not described by
+  /// the server.
+  FlightSqlParameterStream(struct ArrowArrayStream *stream,
+                           const std::shared_ptr<arrow::Schema> &parameter_schema);
+
+  /// \brief Runs execute_batch on every non-empty batch. The next batch is only pulled
+  /// from the producer once execute_batch returned, so a slow server throttles the
+  /// producer instead of having the driver buffer its output.
+  /// \return the sum of the rows affected returned by execute_batch.
+  int64_t ExecuteBatches(const BatchExecutor &execute_batch);
+
+private:
+  std::shared_ptr<arrow::RecordBatchReader> reader_;
+};
+
+/// \brief Releases stream unless it is null or was already released.
+void ReleaseParameterStream(struct ArrowArrayStream *stream);
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "flight_sql_parameter_stream.h"
+
+#include "arrow/testing/builder.h"
+#include <arrow/c/abi.h>
+#include <arrow/c/bridge.h>
+#include <odbcabstraction/exceptions.h>
+#include "gtest/gtest.h"
+
+namespace driver {
+namespace flight_sql {
+
+using odbcabstraction::DriverException;
+
+namespace {
+std::shared_ptr<arrow::Schema> MakeSchema(int num_fields) {
+  arrow::FieldVector fields;
+  for (int i = 0; i < num_fields; ++i) {
+    fields.push_back(arrow::field("p" + std::to_string(i), arrow::int32()));
+  }
+  return arrow::schema(fields);
+}
+
+std::shared_ptr<arrow::RecordBatch> MakeBatch(const std::vector<int32_t> &values) {
+  std::shared_ptr<arrow::Array> array;
+  arrow::ArrayFromVector<arrow::Int32Type, int32_t>(values, &array);
+  return arrow::RecordBatch::Make(MakeSchema(1), array->length(), {array});
+}
+
+/// Producer serving batches, then failing if fail_after_batches is set, and recording
+/// when the consumer released it.
+class TestBatchReader : public arrow::RecordBatchReader {
+public:
+  TestBatchReader(std::shared_ptr<arrow::Schema> schema,
+                  std::vector<std::shared_ptr<arrow::RecordBatch>> batches, bool fail_after_batches,
+                  bool &released)
+      : schema_(std::move(schema)), batches_(std::move(batches)),
+        fail_after_batches_(fail_after_batches), released_(released) {}
+
+  ~TestBatchReader() override { released_ = true; }
+
+  std::shared_ptr<arrow::Schema> schema() const override { return schema_; }
+
+  arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch> *batch) override {
+    if (next_ < batches_.size()) {
+      *batch = batches_[next_++];
+      return arrow::Status::OK();
+    }
+    if (fail_after_batches_) {
+      return arrow::Status::IOError("Producer failed");
+    }
+    batch->reset();
+    return arrow::Status::OK();
+  }
+
+  size_t next_ = 0;
+
+private:
+  std::shared_ptr<arrow::Schema> schema_;
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches_;
+  bool fail_after_batches_;
+  bool &released_;
+};
+
+class FlightSqlParameterStreamTest : public ::testing::Test {
+protected:
+  struct ArrowArrayStream *Export(std::vector<std::shared_ptr<arrow::RecordBatch>> batches,
+                                  int num_fields = 1, bool fail_after_batches = false) {
+    reader_ = std::make_shared<TestBatchReader>(MakeSchema(num_fields), std::move(batches),
+                                                fail_after_batches, released_);
+    EXPECT_TRUE(arrow::ExportRecordBatchReader(reader_, &stream_).ok());
+    return &stream_;
+  }
+
+  /// Drops the test's reference, so that only the stream keeps the reader alive.
+  void DropReader() { reader_.reset(); }
+
+  bool released_ = false;
+  struct ArrowArrayStream stream_;
+  std::shared_ptr<TestBatchReader> reader_;
+};
+} // namespace
+
+TEST_F(FlightSqlParameterStreamTest, SumsRowsAffectedOfNonEmptyBatches) {
+  std::vector<int64_t> executed_rows;
+  {
+    FlightSqlParameterStream stream(
+        Export({MakeBatch({1, 2, 3}), MakeBatch({}), MakeBatch({4, 5})}), MakeSchema(1));
+    DropReader();
+
+    ASSERT_EQ(10, stream.ExecuteBatches([&](const std::shared_ptr<arrow::RecordBatch> &batch) {
+      executed_rows.push_back(batch->num_rows());
+      return 2 * batch->num_rows();
+    }));
+  }
+
+  ASSERT_EQ(std::vector<int64_t>({3, 2}), executed_rows);
+  ASSERT_TRUE(released_);
+}
+
+TEST_F(FlightSqlParameterStreamTest, EmptyStreamExecutesNothing) {
+  FlightSqlParameterStream stream(Export({}), nullptr);
+
+  int executions = 0;
+  ASSERT_EQ(0, stream.ExecuteBatches([&](const std::shared_ptr<arrow::RecordBatch> &) {
+    ++executions;
+    return int64_t(1);
+  }));
+  ASSERT_EQ(0, executions);
+}
+
+TEST_F(FlightSqlParameterStreamTest, RejectsStreamNotMatchingParameters) {
+  struct ArrowArrayStream *stream = Export({MakeBatch({1})}, 2);
+  DropReader();
+
+  try {
+    FlightSqlParameterStream parameter_stream(stream, MakeSchema(1));
+    FAIL() << "Expected the stream to be rejected";
+  } catch (const DriverException &e) {
+    ASSERT_EQ("07002", e.GetSqlState());
+  }
+  ASSERT_TRUE(released_);
+}
+
+TEST_F(FlightSqlParameterStreamTest, StopsOnProducerFailure) {
+  FlightSqlParameterStream stream(Export({MakeBatch({1, 2})}, 1, true), MakeSchema(1));
+
+  int executions = 0;
+  ASSERT_THROW(stream.ExecuteBatches([&](const std::shared_ptr<arrow::RecordBatch> &batch) {
+    ++executions;
+    return batch->num_rows();
+  }), DriverException);
+  ASSERT_EQ(1, executions);
+}
+
+TEST_F(FlightSqlParameterStreamTest, StopsPullingWhenAnExecutionFails) {
+  FlightSqlParameterStream stream(Export({MakeBatch({1}), MakeBatch({2}), MakeBatch({3})}),
+                                  MakeSchema(1));
+
+  ASSERT_THROW(stream.ExecuteBatches([](const std::shared_ptr<arrow::RecordBatch> &) -> int64_t {
+    throw DriverException("Execution failed");
+  }), DriverException);
+  // The batch after the failed one was never requested from the producer.
+  ASSERT_EQ(1, reader_->next_);
+}
+
+TEST_F(FlightSqlParameterStreamTest, ReleasesUnexecutedStream) {
+  struct ArrowArrayStream *stream = Export({MakeBatch({1})});
+  DropReader();
+
+  ReleaseParameterStream(stream);
+  ASSERT_TRUE(released_);
+  ASSERT_EQ(nullptr, stream->release);
+
+  // Released and null streams are left alone.
+  ReleaseParameterStream(stream);
+  ReleaseParameterStream(nullptr);
+}
+
+} // namespace flight_sql
+} // namespace driver
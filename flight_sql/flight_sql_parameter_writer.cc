@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "flight_sql_parameter_writer.h"
+
+#include "utils.h"
+#include <odbcabstraction/exceptions.h>
+
+namespace driver {
+namespace flight_sql {
+
+using odbcabstraction::DriverException;
+using odbcabstraction::ParameterType;
+
+FlightSqlParameterWriter::FlightSqlParameterWriter(const std::vector<ParameterType> &types)
+    : states_(types.size(), ValueState_NONE) {
+  arrow::FieldVector fields;
+  for (size_t i = 0; i < types.size(); ++i) {
+    const std::string name = "parameter_" + std::to_string(i + 1);
+    if (types[i] == odbcabstraction::ParameterType_STRING) {
+      builders_.emplace_back(new arrow::StringBuilder());
+      fields.push_back(arrow::field(name, arrow::utf8()));
+    } else {
+      builders_.emplace_back(new arrow::BinaryBuilder());
+      fields.push_back(arrow::field(name, arrow::binary()));
+    }
+  }
+  schema_ = arrow::schema(std::move(fields));
+}
+
+arrow::BinaryBuilder &FlightSqlParameterWriter::GetBuilder(size_t index) {
+  if (index >= builders_.size()) {
+    throw DriverException("Invalid parameter index: " + std::to_string(index + 1), "07009");
+  }
+  return *builders_[index];
+}
+
+void FlightSqlParameterWriter::Append(size_t index, const void *data, size_t length) {
+  arrow::BinaryBuilder &builder = GetBuilder(index);
+  const auto *bytes = static_cast<const uint8_t *>(data);
+  const auto value_length = static_cast<int32_t>(length);
+  if (value_length < 0 || static_cast<size_t>(value_length) != length) {
+    throw DriverException("Parameter value is too long", "22001");
+  }
+
+  switch (states_[index]) {
+    case ValueState_NONE:
+      ThrowIfNotOK(builder.Append(bytes, value_length));
+      states_[index] = ValueState_DATA;
+      break;
+    case ValueState_DATA:
+      ThrowIfNotOK(builder.ExtendCurrent(bytes, value_length));
+      break;
+    case ValueState_NULL:
+      throw DriverException("Attempt to concatenate a null value", "HY020");
+  }
+}
+
+void FlightSqlParameterWriter::SetNull(size_t index) {
+  arrow::BinaryBuilder &builder = GetBuilder(index);
+  if (states_[index] != ValueState_NONE) {
+    throw DriverException("Attempt to concatenate a null value", "HY020");
+  }
+  ThrowIfNotOK(builder.AppendNull());
+  states_[index] = ValueState_NULL;
+}
+
+std::shared_ptr<arrow::RecordBatch> FlightSqlParameterWriter::Finish() {
+  arrow::ArrayVector columns;
+  for (size_t i = 0; i < builders_.size(); ++i) {
+    if (states_[i] == ValueState_NONE) {
+      ThrowIfNotOK(builders_[i]->AppendEmptyValue());
+    }
+    std::shared_ptr<arrow::Array> column;
+    ThrowIfNotOK(builders_[i]->Finish(&column));
+    columns.push_back(std::move(column));
+  }
+  return arrow::RecordBatch::Make(schema_, 1, std::move(columns));
+}
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#pragma once
+
+#include <odbcabstraction/spi/parameter_writer.h>
+
+#include <arrow/array/builder_binary.h>
+#include <arrow/record_batch.h>
+#include <memory>
+#include <vector>
+
+namespace driver {
+namespace flight_sql {
+
+/// \brief Writes a parameter set straight into Arrow builders, one column per
+/// parameter, to be bound to a prepared statement as a single-row batch.
+class FlightSqlParameterWriter : public odbcabstraction::ParameterWriter {
+public:
+  explicit FlightSqlParameterWriter(const std::vector<odbcabstraction::ParameterType> &types);
+
+  void Append(size_t index, const void *data, size_t length) override;
+
+  void SetNull(size_t index) override;
+
+  /// \brief Builds the batch of parameter values. Parameters that received no
+  /// value are bound as empty values.
+  std::shared_ptr<arrow::RecordBatch> Finish();
+
+private:
+  enum ValueState { ValueState_NONE, ValueState_DATA, ValueState_NULL };
+
+  std::shared_ptr<arrow::Schema> schema_;
+  // StringBuilder derives from BinaryBuilder, both append bytes the same way.
+  std::vector<std::unique_ptr<arrow::BinaryBuilder>> builders_;
+  std::vector<ValueState> states_;
+
+  arrow::BinaryBuilder &GetBuilder(size_t index);
+};
+
+} // namespace flight_sql
+} // namespace driver
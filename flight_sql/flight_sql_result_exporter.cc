@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "flight_sql_result_exporter.h"
+
+#include "flight_sql_stream_chunk_buffer.h"
+#include "utils.h"
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/record_batch.h>
+#include <arrow/table.h>
+#include <arrow/util/compression.h>
+#include <odbcabstraction/exceptions.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/properties.h>
+#include <vector>
+
+namespace driver {
+namespace flight_sql {
+
+using arrow::RecordBatch;
+using arrow::Schema;
+using arrow::io::FileOutputStream;
+using odbcabstraction::DriverException;
+using odbcabstraction::ExportCompression;
+
+namespace {
+
+arrow::Compression::type GetIpcCompression(ExportCompression compression) {
+  switch (compression) {
+    case odbcabstraction::ExportCompression_NONE:
+      return arrow::Compression::UNCOMPRESSED;
+    case odbcabstraction::ExportCompression_LZ4:
+      return arrow::Compression::LZ4_FRAME;
+    case odbcabstraction::ExportCompression_ZSTD:
+      return arrow::Compression::ZSTD;
+    default:
+      throw DriverException("Compression codec is not supported by Arrow IPC exports", "HY024");
+  }
+}
+
+arrow::Compression::type GetParquetCompression(ExportCompression compression) {
+  switch (compression) {
+    case odbcabstraction::ExportCompression_NONE:
+      return arrow::Compression::UNCOMPRESSED;
+    case odbcabstraction::ExportCompression_LZ4:
+      return arrow::Compression::LZ4;
+    case odbcabstraction::ExportCompression_ZSTD:
+      return arrow::Compression::ZSTD;
+    case odbcabstraction::ExportCompression_SNAPPY:
+      return arrow::Compression::SNAPPY;
+    default:
+      throw DriverException("Compression codec is not supported by Parquet exports", "HY024");
+  }
+}
+
+std::shared_ptr<FileOutputStream> OpenFile(const std::string &path) {
+  auto result = FileOutputStream::Open(path);
+  if (!result.ok()) {
+    throw DriverException("Cannot open export file: " + result.status().message(), "HY000");
+  }
+  return result.ValueOrDie();
+}
+
+class IpcFileSink : public RecordBatchFileSink {
+  std::shared_ptr<FileOutputStream> file_;
+  std::shared_ptr<arrow::ipc::RecordBatchWriter> writer_;
+  int64_t rows_written_ = 0;
+
+public:
+  IpcFileSink(const std::shared_ptr<Schema> &schema, const ExportOptions &options) {
+    auto ipc_options = arrow::ipc::IpcWriteOptions::Defaults();
+    const arrow::Compression::type compression = GetIpcCompression(options.compression);
+    if (compression != arrow::Compression::UNCOMPRESSED) {
+      auto codec = arrow::util::Codec::Create(compression);
+      ThrowIfNotOK(codec.status());
+      ipc_options.codec = std::move(codec).ValueOrDie();
+    }
+
+    file_ = OpenFile(options.path);
+    auto writer = arrow::ipc::MakeFileWriter(file_, schema, ipc_options);
+    ThrowIfNotOK(writer.status());
+    writer_ = writer.ValueOrDie();
+  }
+
+  void Write(const std::shared_ptr<RecordBatch> &batch) override {
+    ThrowIfNotOK(writer_->WriteRecordBatch(*batch));
+    rows_written_ += batch->num_rows();
+  }
+
+  int64_t Close() override {
+    ThrowIfNotOK(writer_->Close());
+    ThrowIfNotOK(file_->Close());
+    return rows_written_;
+  }
+};
+
+/// Flight streams usually carry batches far smaller than a useful row group, and
+/// every WriteTable call ends at least one row group, so batches are buffered until
+/// a full row group is pending.
+class ParquetFileSink : public RecordBatchFileSink {
+  std::shared_ptr<FileOutputStream> file_;
+  std::unique_ptr<parquet::arrow::FileWriter> writer_;
+  std::vector<std::shared_ptr<RecordBatch>> pending_batches_;
+  int64_t pending_rows_ = 0;
+  int64_t row_group_size_;
+  int64_t rows_written_ = 0;
+
+  /// Writes the pending rows as row groups of row_group_size_ rows. Unless
+  /// include_partial is set, a trailing partial row group stays pending.
+  void FlushRowGroups(bool include_partial) {
+    if (pending_batches_.empty()) {
+      return;
+    }
+
+    auto result = arrow::Table::FromRecordBatches(pending_batches_);
+    ThrowIfNotOK(result.status());
+    const auto &table = result.ValueOrDie();
+
+    const int64_t rows_to_write =
+        include_partial ? pending_rows_ : pending_rows_ - pending_rows_ % row_group_size_;
+    ThrowIfNotOK(writer_->WriteTable(*table->Slice(0, rows_to_write), row_group_size_));
+    rows_written_ += rows_to_write;
+
+    pending_batches_.clear();
+    pending_rows_ -= rows_to_write;
+    if (pending_rows_ > 0) {
+      const auto &remainder = table->Slice(rows_to_write);
+      arrow::TableBatchReader reader(*remainder);
+      ThrowIfNotOK(reader.ReadAll(&pending_batches_));
+    }
+  }
+
+public:
+  ParquetFileSink(const std::shared_ptr<Schema> &schema, const ExportOptions &options)
+      : row_group_size_(options.row_group_size > 0 ? options.row_group_size
+                                                   : DEFAULT_EXPORT_ROW_GROUP_SIZE) {
+    parquet::WriterProperties::Builder properties;
+    properties.compression(GetParquetCompression(options.compression));
+    properties.max_row_group_length(row_group_size_);
+
+    file_ = OpenFile(options.path);
+    ThrowIfNotOK(parquet::arrow::FileWriter::Open(
+        *schema, arrow::default_memory_pool(), file_, properties.build(),
+        parquet::default_arrow_writer_properties(), &writer_));
+  }
+
+  void Write(const std::shared_ptr<RecordBatch> &batch) override {
+    pending_batches_.push_back(batch);
+    pending_rows_ += batch->num_rows();
+    if (pending_rows_ >= row_group_size_) {
+      FlushRowGroups(false);
+    }
+  }
+
+  int64_t Close() override {
+    FlushRowGroups(true);
+    ThrowIfNotOK(writer_->Close());
+    ThrowIfNotOK(file_->Close());
+    return rows_written_;
+  }
+};
+
+} // namespace
+
+std::unique_ptr<RecordBatchFileSink>
+OpenRecordBatchFileSink(const std::shared_ptr<Schema> &schema,
+                        const ExportOptions &options) {
+  switch (options.format) {
+    case odbcabstraction::ExportFormat_ARROW_IPC:
+      return std::unique_ptr<RecordBatchFileSink>(new IpcFileSink(schema, options));
+    case odbcabstraction::ExportFormat_PARQUET:
+      return std::unique_ptr<RecordBatchFileSink>(new ParquetFileSink(schema, options));
+    default:
+      throw DriverException("Invalid export format", "HY024");
+  }
+}
+
+int64_t ExportFlightToFile(FlightSqlClient &client,
+                           const arrow::flight::FlightCallOptions &call_options,
+                           const std::shared_ptr<FlightInfo> &flight_info,
+                           const ExportOptions &options, size_t queue_capacity,
+                           const std::vector<SortKey> &merge_sort_keys,
+                           odbcabstraction::StreamPriority priority) {
+  std::shared_ptr<Schema> schema;
+  ThrowIfNotOK(flight_info->GetSchema(nullptr, &schema));
+
+  const std::unique_ptr<RecordBatchFileSink> sink = OpenRecordBatchFileSink(schema, options);
+
+  // The I/O pool keeps reading the endpoints while the batch previously taken
+  // from the chunk buffer is encoded and written here.
+  FlightStreamChunkBuffer chunk_buffer(client, call_options, flight_info, queue_capacity, merge_sort_keys,
+                                       priority);
+  FlightStreamChunk chunk;
+  while (chunk_buffer.GetNext(&chunk)) {
+    sink->Write(chunk.data);
+  }
+
+  return sink->Close();
+}
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#pragma once
+
+#include "sorted_batch_merger.h"
+#include <arrow/flight/sql/client.h>
+#include <arrow/type_fwd.h>
+#include <odbcabstraction/types.h>
+#include <memory>
+#include <string>
+
+namespace driver {
+namespace flight_sql {
+
+/// Rows buffered per Parquet row group when ExportOptions::row_group_size is 0.
+constexpr int64_t DEFAULT_EXPORT_ROW_GROUP_SIZE = 1024 * 1024;
+
+struct ExportOptions {
+  std::string path;
+  odbcabstraction::ExportFormat format{odbcabstraction::ExportFormat_ARROW_IPC};
+  odbcabstraction::ExportCompression compression{odbcabstraction::ExportCompression_NONE};
+  /// Maximum number of rows per Parquet row group, 0 for DEFAULT_EXPORT_ROW_GROUP_SIZE.
+  int64_t row_group_size{0};
+};
+
+/// \brief Writes record batches sharing a schema to a local Arrow IPC or Parquet file.
+class RecordBatchFileSink {
+public:
+  virtual ~RecordBatchFileSink() = default;
+
+  virtual void Write(const std::shared_ptr<arrow::RecordBatch> &batch) = 0;
+
+  /// \brief Finishes the file footer and closes the file.
+  /// \return the number of rows written.
+  virtual int64_t Close() = 0;
+};
+
+/// \brief Creates (or truncates) options.path and writes the file header for schema.
+/// Throws a DriverException if the file cannot be opened or the codec is not
+/// supported by the format.
+std::unique_ptr<RecordBatchFileSink>
+OpenRecordBatchFileSink(const std::shared_ptr<arrow::Schema> &schema,
+                        const ExportOptions &options);
+
+/// \brief Streams every endpoint of flight_info to the file described by options.
+///
+/// Endpoints are read by FlightStreamChunkBuffer, so up to queue_capacity batches
+/// are fetched from the network while earlier ones are being written. Endpoints
+/// sorted by merge_sort_keys are written in global order. Reads are scheduled as
+/// bulk reads unless priority says otherwise.
+/// \return the number of rows written.
+int64_t ExportFlightToFile(arrow::flight::sql::FlightSqlClient &client,
+                           const arrow::flight::FlightCallOptions &call_options,
+                           const std::shared_ptr<arrow::flight::FlightInfo> &flight_info,
+                           const ExportOptions &options, size_t queue_capacity,
+                           const std::vector<SortKey> &merge_sort_keys = std::vector<SortKey>(),
+                           odbcabstraction::StreamPriority priority = odbcabstraction::StreamPriority_BULK);
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "flight_sql_result_exporter.h"
+
+#include "gtest/gtest.h"
+#include "arrow/testing/gtest_util.h"
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/record_batch.h>
+#include <arrow/table.h>
+#include <arrow/util/io_util.h>
+#include <odbcabstraction/exceptions.h>
+#include <parquet/arrow/reader.h>
+
+namespace driver {
+namespace flight_sql {
+
+using namespace arrow;
+using odbcabstraction::DriverException;
+
+namespace {
+std::shared_ptr<Schema> GetSchema() {
+  return schema({field("id", int64()), field("name", utf8())});
+}
+
+std::vector<std::shared_ptr<RecordBatch>> GetBatches() {
+  return {
+    RecordBatchFromJSON(GetSchema(), R"([[1, "a"], [2, null], [3, "c"], [4, "dd"]])"),
+    RecordBatchFromJSON(GetSchema(), R"([[5, "e"], [null, "f"], [7, "g"], [8, ""]])"),
+  };
+}
+
+int64_t WriteBatches(const ExportOptions &options) {
+  const std::unique_ptr<RecordBatchFileSink> sink = OpenRecordBatchFileSink(GetSchema(), options);
+  for (const auto &batch : GetBatches()) {
+    sink->Write(batch);
+  }
+  return sink->Close();
+}
+
+std::string GetExportPath(const internal::TemporaryDir &dir, const std::string &name) {
+  return dir.path().ToString() + name;
+}
+}
+
+TEST(RecordBatchFileSink, ArrowIpc_Zstd) {
+  ASSERT_OK_AND_ASSIGN(auto dir, internal::TemporaryDir::Make("odbc-export-"));
+  ExportOptions options;
+  options.path = GetExportPath(*dir, "result.arrow");
+  options.format = odbcabstraction::ExportFormat_ARROW_IPC;
+  options.compression = odbcabstraction::ExportCompression_ZSTD;
+
+  ASSERT_EQ(8, WriteBatches(options));
+
+  ASSERT_OK_AND_ASSIGN(auto file, io::ReadableFile::Open(options.path));
+  ASSERT_OK_AND_ASSIGN(auto reader, ipc::RecordBatchFileReader::Open(file));
+  ASSERT_EQ(2, reader->num_record_batches());
+
+  const auto &expected = GetBatches();
+  for (int i = 0; i < reader->num_record_batches(); ++i) {
+    ASSERT_OK_AND_ASSIGN(auto batch, reader->ReadRecordBatch(i));
+    ASSERT_TRUE(batch->Equals(*expected[i])) << batch->ToString();
+  }
+}
+
+TEST(RecordBatchFileSink, Parquet_RowGroupSize) {
+  ASSERT_OK_AND_ASSIGN(auto dir, internal::TemporaryDir::Make("odbc-export-"));
+  ExportOptions options;
+  options.path = GetExportPath(*dir, "result.parquet");
+  options.format = odbcabstraction::ExportFormat_PARQUET;
+  options.compression = odbcabstraction::ExportCompression_SNAPPY;
+  options.row_group_size = 3;
+
+  ASSERT_EQ(8, WriteBatches(options));
+
+  ASSERT_OK_AND_ASSIGN(auto file, io::ReadableFile::Open(options.path));
+  std::unique_ptr<parquet::arrow::FileReader> reader;
+  ASSERT_OK(parquet::arrow::OpenFile(file, default_memory_pool(), &reader));
+  // Row groups are filled across the 4-row batches: 3 + 3 + 2.
+  ASSERT_EQ(3, reader->num_row_groups());
+
+  std::shared_ptr<Table> table;
+  ASSERT_OK(reader->ReadTable(&table));
+  ASSERT_OK_AND_ASSIGN(auto expected, Table::FromRecordBatches(GetBatches()));
+  ASSERT_TRUE(table->Equals(*expected)) << table->ToString();
+}
+
+TEST(RecordBatchFileSink, ArrowIpc_UnsupportedCodec) {
+  ASSERT_OK_AND_ASSIGN(auto dir, internal::TemporaryDir::Make("odbc-export-"));
+  ExportOptions options;
+  options.path = GetExportPath(*dir, "result.arrow");
+  options.format = odbcabstraction::ExportFormat_ARROW_IPC;
+  options.compression = odbcabstraction::ExportCompression_SNAPPY;
+
+  ASSERT_THROW(OpenRecordBatchFileSink(GetSchema(), options), DriverException);
+}
+
+} // namespace flight_sql
+} // namespace driver
@@ -35,10 +35,14 @@ FlightSqlResultSet::FlightSqlResultSet(
     const std::shared_ptr<FlightInfo> &flight_info,
     const std::shared_ptr<RecordBatchTransformer> &transformer,
     odbcabstraction::Diagnostics& diagnostics,
-    const odbcabstraction::MetadataSettings &metadata_settings)
+    const odbcabstraction::MetadataSettings &metadata_settings,
+    const std::vector<SortKey> &merge_sort_keys,
+    odbcabstraction::StreamPriority priority,
+    std::shared_ptr<AdmissionPermit> admission_permit)
     :
       metadata_settings_(metadata_settings),
-      chunk_buffer_(flight_sql_client, call_options, flight_info, metadata_settings_.chunk_buffer_capacity_),
+      chunk_buffer_(flight_sql_client, call_options, flight_info, metadata_settings_.chunk_buffer_capacity_,
+                    merge_sort_keys, priority, std::move(admission_permit)),
       transformer_(transformer),
       metadata_(transformer ? new FlightSqlResultSetMetadata(transformer->GetTransformedSchema(),
                                                              metadata_settings_)
@@ -46,7 +50,9 @@ FlightSqlResultSet::FlightSqlResultSet(
       columns_(metadata_->GetColumnCount()),
       get_data_offsets_(metadata_->GetColumnCount(), 0),
       diagnostics_(diagnostics),
-      current_row_(0), num_binding_(0), reset_get_data_(false) {
+      current_row_(0), num_binding_(0), reset_get_data_(false),
+      fetch_plan_bind_offset_(0), fetch_plan_bind_type_(0), fetch_plan_valid_(false),
+      fetch_plan_has_string_view_(false) {
   current_chunk_.data = nullptr;
   if (transformer_) {
     schema_ = transformer_->GetTransformedSchema();
@@ -55,7 +61,64 @@ FlightSqlResultSet::FlightSqlResultSet(
   }
 
   for (size_t i = 0; i < columns_.size(); ++i) {
-    columns_[i] = FlightSqlResultSetColumn(metadata_settings.use_wide_char_);
+    columns_[i] = FlightSqlResultSetColumn(metadata_settings.use_wide_char_,
+                                           metadata_settings.complex_types_as_arrow_ipc_);
+  }
+}
+
+bool FlightSqlResultSet::LoadNextChunk() {
+  if (!chunk_buffer_.GetNext(&current_chunk_)) {
+    return false;
+  }
+
+  if (transformer_) {
+    current_chunk_.data = transformer_->Transform(current_chunk_.data);
+  }
+
+  for (size_t column_num = 0; column_num < columns_.size(); ++column_num) {
+    columns_[column_num].ResetAccessor(current_chunk_.data->column(column_num));
+  }
+  RefreshFetchPlanAccessors();
+  return true;
+}
+
+void FlightSqlResultSet::BuildFetchPlan(size_t bind_offset, size_t bind_type) {
+  fetch_plan_.clear();
+  fetch_plan_has_string_view_ = false;
+
+  for (size_t column_num = 0; column_num < columns_.size(); ++column_num) {
+    auto &column = columns_[column_num];
+    // There can be unbound columns.
+    if (!column.is_bound_)
+      continue;
+
+    FetchPlanStep step;
+    step.column = &column;
+    step.buffer = column.binding_.buffer
+                      ? static_cast<uint8_t *>(column.binding_.buffer) + bind_offset
+                      : nullptr;
+    step.strlen_buffer = column.binding_.strlen_buffer
+                             ? reinterpret_cast<ssize_t *>(
+                                   reinterpret_cast<uint8_t *>(column.binding_.strlen_buffer) + bind_offset)
+                             : nullptr;
+    step.column_number = static_cast<int32_t>(column_num + 1);
+    fetch_plan_.push_back(step);
+
+    if (column.binding_.target_type == odbcabstraction::CDataType_STRING_VIEW) {
+      fetch_plan_has_string_view_ = true;
+    }
+  }
+
+  fetch_plan_bind_offset_ = bind_offset;
+  fetch_plan_bind_type_ = bind_type;
+  fetch_plan_valid_ = true;
+  RefreshFetchPlanAccessors();
+}
+
+void FlightSqlResultSet::RefreshFetchPlanAccessors() {
+  for (auto &step : fetch_plan_) {
+    step.accessor = step.column->GetAccessorForBinding();
+    step.cell_length = step.accessor ? step.accessor->GetCellLength(&step.column->binding_) : 0;
   }
 }
 
@@ -63,18 +126,17 @@ size_t FlightSqlResultSet::Move(size_t rows, size_t bind_offset, size_t bind_typ
   // Consider it might be the first call to Move() and current_chunk is not
   // populated yet
   assert(rows > 0);
-  if (current_chunk_.data == nullptr) {
-    if (!chunk_buffer_.GetNext(&current_chunk_)) {
-      return 0;
-    }
+  // Views handed out by the previous fetch are no longer valid once the cursor moves.
+  retained_batches_.clear();
+  // Repeated records are counted per fetch.
+  diagnostics_.StartAggregation();
 
-    if (transformer_) {
-      current_chunk_.data = transformer_->Transform(current_chunk_.data);
-    }
+  if (current_chunk_.data == nullptr && !LoadNextChunk()) {
+    return 0;
+  }
 
-    for (size_t column_num = 0; column_num < columns_.size(); ++column_num) {
-      columns_[column_num].ResetAccessor(current_chunk_.data->column(column_num));
-    }
+  if (!fetch_plan_valid_ || bind_offset != fetch_plan_bind_offset_ || bind_type != fetch_plan_bind_type_) {
+    BuildFetchPlan(bind_offset, bind_type);
   }
 
   // Reset GetData value offsets.
@@ -90,92 +152,73 @@ size_t FlightSqlResultSet::Move(size_t rows, size_t bind_offset, size_t bind_typ
                  static_cast<size_t>(batch_rows - current_row_));
 
     if (rows_to_fetch == 0) {
-      if (!chunk_buffer_.GetNext(&current_chunk_)) {
-        break;
-      }
-
-      if (transformer_) {
-        current_chunk_.data = transformer_->Transform(current_chunk_.data);
+      if (fetched_rows > 0 && fetch_plan_has_string_view_) {
+        retained_batches_.push_back(current_chunk_.data);
       }
 
-      for (size_t column_num = 0; column_num < columns_.size(); ++column_num) {
-        columns_[column_num].ResetAccessor(current_chunk_.data->column(column_num));
+      if (!LoadNextChunk()) {
+        break;
       }
       current_row_ = 0;
       continue;
     }
 
-    for (auto & column : columns_) {
-      // There can be unbound columns.
-      if (!column.is_bound_)
-        continue;
+    // Rows start out successful, accessors only downgrade the status of the rows they
+    // had issues with so that an error on one column isn't hidden by the next one.
+    if (row_status_array) {
+      std::fill(&row_status_array[fetched_rows], &row_status_array[fetched_rows + rows_to_fetch],
+                odbcabstraction::RowStatus_SUCCESS);
+    }
 
-      auto *accessor = column.GetAccessorForBinding();
-      ColumnBinding shifted_binding = column.binding_;
+    for (const auto &step : fetch_plan_) {
+      ColumnBinding shifted_binding = step.column->binding_;
       uint16_t *shifted_row_status_array = row_status_array ? &row_status_array[fetched_rows] : nullptr;
 
-      if (shifted_row_status_array) {
-        std::fill(shifted_row_status_array, &shifted_row_status_array[rows_to_fetch], odbcabstraction::RowStatus_SUCCESS);
-      }
-
       size_t accessor_rows = 0;
       try {
         if (!bind_type) {
           // Columnar binding. Have the accessor convert multiple rows.
-          if (shifted_binding.buffer) {
-            shifted_binding.buffer =
-                static_cast<uint8_t *>(shifted_binding.buffer) +
-                accessor->GetCellLength(&shifted_binding) * fetched_rows +
-                bind_offset;
-          }
-
-          if (shifted_binding.strlen_buffer) {
-            shifted_binding.strlen_buffer = reinterpret_cast<ssize_t *>(
-                reinterpret_cast<uint8_t *>(
-                    &shifted_binding.strlen_buffer[fetched_rows]) +
-                bind_offset);
-          }
+          shifted_binding.buffer = step.buffer ? step.buffer + step.cell_length * fetched_rows : nullptr;
+          shifted_binding.strlen_buffer = step.strlen_buffer ? step.strlen_buffer + fetched_rows : nullptr;
 
           int64_t value_offset = 0;
-          accessor_rows = accessor->GetColumnarData(&shifted_binding, current_row_, rows_to_fetch, value_offset, false,
-                                                    diagnostics_, shifted_row_status_array);
+          diagnostics_.SetRecordPosition(static_cast<int64_t>(fetched_rows) + 1, step.column_number);
+          accessor_rows = step.accessor->GetColumnarData(&shifted_binding, current_row_, rows_to_fetch, value_offset,
+                                                         false, diagnostics_, shifted_row_status_array);
         }
         else {
-          // Row-wise binding. Identify the base position of the buffer and indicator based on the bind offset,
-          // the number of already-fetched rows, and the bind_type holding the size of an application-side row.
-          if (shifted_binding.buffer) {
-            shifted_binding.buffer =
-                static_cast<uint8_t *>(shifted_binding.buffer) + bind_offset +
-                bind_type * fetched_rows;
-          }
-
-          if (shifted_binding.strlen_buffer) {
-            shifted_binding.strlen_buffer = reinterpret_cast<ssize_t *>(
-                reinterpret_cast<uint8_t *>(shifted_binding.strlen_buffer) +
-                bind_offset + bind_type * fetched_rows);
-          }
-
-          // Loop and run the accessor one-row-at-a-time.
-          for (size_t i = 0; i < rows_to_fetch; ++i) {
-            int64_t value_offset = 0;
-
-            // Adjust offsets passed to the accessor as we fetch rows.
-            // Note that current_row_ is updated outside of this loop.
-            accessor_rows += accessor->GetColumnarData(&shifted_binding, current_row_ + i, 1, value_offset, false,
-                                                       diagnostics_, shifted_row_status_array);
-            if (shifted_binding.buffer) {
-              shifted_binding.buffer =
-                  static_cast<uint8_t *>(shifted_binding.buffer) + bind_type;
-            }
-
-            if (shifted_binding.strlen_buffer) {
-              shifted_binding.strlen_buffer = reinterpret_cast<ssize_t *>(
-                  reinterpret_cast<uint8_t *>(shifted_binding.strlen_buffer) +
-                  bind_type);
-            }
-
-            if (shifted_row_status_array) {
-              shifted_row_status_array++;
+          // Row-wise binding. The base position of the buffer and indicator is the bind offset
+          // plus the number of already-fetched rows times bind_type, the size of an application-side row.
+          uint8_t *buffer = step.buffer ? step.buffer + bind_type * fetched_rows : nullptr;
+          uint8_t *strlen_buffer = step.strlen_buffer
+                                       ? reinterpret_cast<uint8_t *>(step.strlen_buffer) + bind_type * fetched_rows
+                                       : nullptr;
+
+          // Accessors copying fixed-width values without conversion fill all rows at once.
+          shifted_binding.buffer = buffer;
+          shifted_binding.strlen_buffer = reinterpret_cast<ssize_t *>(strlen_buffer);
+          accessor_rows = step.accessor->GetRowWiseData(&shifted_binding, current_row_, rows_to_fetch, bind_type);
+
+          if (accessor_rows == 0) {
+            // Otherwise loop and run the accessor one-row-at-a-time.
+            for (size_t i = 0; i < rows_to_fetch; ++i) {
+              int64_t value_offset = 0;
+              shifted_binding.buffer = buffer;
+              shifted_binding.strlen_buffer = reinterpret_cast<ssize_t *>(strlen_buffer);
+
+              // Note that current_row_ is updated outside of this loop.
+              diagnostics_.SetRecordPosition(static_cast<int64_t>(fetched_rows + i) + 1, step.column_number);
+              accessor_rows += step.accessor->GetColumnarData(&shifted_binding, current_row_ + i, 1, value_offset,
+                                                              false, diagnostics_, shifted_row_status_array);
+              if (buffer) {
+                buffer += bind_type;
+              }
+              if (strlen_buffer) {
+                strlen_buffer += bind_type;
+              }
+              if (shifted_row_status_array) {
+                shifted_row_status_array++;
+              }
             }
           }
         }
@@ -196,6 +239,7 @@ size_t FlightSqlResultSet::Move(size_t rows, size_t bind_offset, size_t bind_typ
     current_row_ += static_cast<int64_t>(rows_to_fetch);
     fetched_rows += rows_to_fetch;
   }
+  diagnostics_.ClearRecordPosition();
 
   if (rows > fetched_rows && row_status_array) {
     std::fill(&row_status_array[fetched_rows], &row_status_array[rows], odbcabstraction::RowStatus_NOROW);
@@ -206,11 +250,13 @@ size_t FlightSqlResultSet::Move(size_t rows, size_t bind_offset, size_t bind_typ
 void FlightSqlResultSet::Close() {
   chunk_buffer_.Close();
   current_chunk_.data = nullptr;
+  retained_batches_.clear();
 }
 
 void FlightSqlResultSet::Cancel() {
   chunk_buffer_.Close();
   current_chunk_.data = nullptr;
+  retained_batches_.clear();
 }
 
 bool FlightSqlResultSet::GetData(int column_n, int16_t target_type,
@@ -227,13 +273,16 @@ bool FlightSqlResultSet::GetData(int column_n, int16_t target_type,
                         strlen_buffer);
 
   auto &column = columns_[column_n - 1];
-  Accessor *accessor = column.GetAccessorForGetData(binding.target_type);
-
-
   // Note: current_row_ is always positioned at the index _after_ the one we are
   // on after calling Move(). So if we want to get data from the _last_ row
   // fetched, we need to subtract one from the current row.
-  accessor->GetColumnarData(&binding, current_row_ - 1, 1, value_offset, true, diagnostics_, nullptr);
+  int64_t accessor_row;
+  Accessor *accessor = column.GetAccessorForGetData(binding.target_type, current_row_ - 1, accessor_row);
+
+  diagnostics_.StartAggregation();
+  diagnostics_.SetRecordPosition(odbcabstraction::NO_ROW_NUMBER, column_n);
+  accessor->GetColumnarData(&binding, accessor_row, 1, value_offset, true, diagnostics_, nullptr);
+  diagnostics_.ClearRecordPosition();
 
   // If there was truncation, the converter would have reported it to the diagnostics.
   return diagnostics_.HasWarning();
@@ -248,6 +297,7 @@ void FlightSqlResultSet::BindColumn(int column_n, int16_t target_type,
                                     size_t buffer_length,
                                     ssize_t *strlen_buffer) {
   auto &column = columns_[column_n - 1];
+  fetch_plan_valid_ = false;
   if (buffer == nullptr) {
     if (column.is_bound_) {
       num_binding_--;
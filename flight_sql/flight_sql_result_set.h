@@ -31,13 +31,26 @@ using odbcabstraction::DriverException;
 using odbcabstraction::ResultSet;
 using odbcabstraction::ResultSetMetadata;
 
+class Accessor;
 class FlightSqlResultSetColumn;
 
 class FlightSqlResultSet : public ResultSet {
 private:
+  /// \brief A bound column with its buffers resolved for the current bind offset.
+  struct FetchPlanStep {
+    FlightSqlResultSetColumn *column;
+    Accessor *accessor;
+    size_t cell_length;
+    uint8_t *buffer;        // Bound buffer with the bind offset applied, may be null.
+    ssize_t *strlen_buffer; // Bound indicator buffer with the bind offset applied, may be null.
+    int32_t column_number;  // 1-based, as reported in diagnostics.
+  };
+
   const odbcabstraction::MetadataSettings& metadata_settings_;
   FlightStreamChunkBuffer chunk_buffer_;
   FlightStreamChunk current_chunk_;
+  // Batches left behind during the current fetch that STRING_VIEW bindings still point into.
+  std::vector<std::shared_ptr<arrow::RecordBatch>> retained_batches_;
   std::shared_ptr<Schema> schema_;
   std::shared_ptr<RecordBatchTransformer> transformer_;
   std::shared_ptr<ResultSetMetadata> metadata_;
@@ -48,6 +61,19 @@ private:
   int num_binding_;
   bool reset_get_data_;
 
+  // Move walks this plan instead of every column. It is rebuilt when a column is bound
+  // or unbound or the bind offset or type changes, and its accessors are refreshed
+  // when the chunk changes.
+  std::vector<FetchPlanStep> fetch_plan_;
+  size_t fetch_plan_bind_offset_;
+  size_t fetch_plan_bind_type_;
+  bool fetch_plan_valid_;
+  bool fetch_plan_has_string_view_;
+
+  bool LoadNextChunk();
+  void BuildFetchPlan(size_t bind_offset, size_t bind_type);
+  void RefreshFetchPlanAccessors();
+
 public:
   ~FlightSqlResultSet() override;
 
@@ -57,7 +83,10 @@ public:
       const std::shared_ptr<FlightInfo> &flight_info,
       const std::shared_ptr<RecordBatchTransformer> &transformer,
       odbcabstraction::Diagnostics& diagnostics,
-      const odbcabstraction::MetadataSettings &metadata_settings);
+      const odbcabstraction::MetadataSettings &metadata_settings,
+      const std::vector<SortKey> &merge_sort_keys = std::vector<SortKey>(),
+      odbcabstraction::StreamPriority priority = odbcabstraction::StreamPriority_INTERACTIVE,
+      std::shared_ptr<AdmissionPermit> admission_permit = nullptr);
 
   void Close() override;
 
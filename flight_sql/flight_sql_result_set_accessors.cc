@@ -19,15 +19,13 @@ typedef std::function<Accessor *(arrow::Array *)> AccessorConstructor;
 
 namespace {
 
-const std::unordered_map<SourceAndTargetPair, AccessorConstructor,
-                         boost::hash<SourceAndTargetPair>>
-    ACCESSORS_CONSTRUCTORS = {
-        {SourceAndTargetPair(arrow::Type::type::STRING, CDataType_CHAR),
-         [](arrow::Array *array) {
-           return new StringArrayFlightSqlAccessor<CDataType_CHAR, char>(array);
-         }},
-        {SourceAndTargetPair(arrow::Type::type::STRING, CDataType_WCHAR),
-                CreateWCharStringArrayAccessor},
+typedef std::unordered_map<SourceAndTargetPair, AccessorConstructor,
+                           boost::hash<SourceAndTargetPair>>
+    AccessorConstructorMap;
+
+/// The map is built by the first fetch rather than while the driver library loads.
+const AccessorConstructorMap &GetAccessorConstructors() {
+  static const AccessorConstructorMap ACCESSORS_CONSTRUCTORS = {
         {SourceAndTargetPair(arrow::Type::type::DOUBLE, CDataType_DOUBLE),
          [](arrow::Array *array) {
            return new PrimitiveArrayFlightSqlAccessor<DoubleArray,
@@ -88,6 +86,34 @@ const std::unordered_map<SourceAndTargetPair, AccessorConstructor,
          [](arrow::Array *array) {
            return new BinaryArrayFlightSqlAccessor<CDataType_BINARY>(array);
          }},
+        {SourceAndTargetPair(arrow::Type::type::BINARY, CDataType_CHAR),
+         [](arrow::Array *array) {
+           return new BinaryArrayFlightSqlAccessor<CDataType_CHAR, char>(array);
+         }},
+        {SourceAndTargetPair(arrow::Type::type::BINARY, CDataType_WCHAR),
+                CreateWCharBinaryArrayAccessor},
+        {SourceAndTargetPair(arrow::Type::type::FIXED_SIZE_BINARY, CDataType_BINARY),
+         [](arrow::Array *array) {
+           return new FixedSizeBinaryArrayFlightSqlAccessor<CDataType_BINARY>(array);
+         }},
+        {SourceAndTargetPair(arrow::Type::type::FIXED_SIZE_BINARY, CDataType_CHAR),
+         [](arrow::Array *array) {
+           return new FixedSizeBinaryArrayFlightSqlAccessor<CDataType_CHAR, char>(array);
+         }},
+        {SourceAndTargetPair(arrow::Type::type::FIXED_SIZE_BINARY, CDataType_WCHAR),
+                CreateWCharFixedSizeBinaryArrayAccessor},
+        {SourceAndTargetPair(arrow::Type::type::FIXED_SIZE_BINARY, CDataType_GUID),
+         [](arrow::Array *array) {
+           return new FixedSizeBinaryArrayFlightSqlAccessor<CDataType_GUID>(array);
+         }},
+        {SourceAndTargetPair(arrow::Type::type::STRING, CDataType_STRING_VIEW),
+         [](arrow::Array *array) {
+           return new StringViewArrayFlightSqlAccessor<StringArray>(array);
+         }},
+        {SourceAndTargetPair(arrow::Type::type::BINARY, CDataType_STRING_VIEW),
+         [](arrow::Array *array) {
+           return new StringViewArrayFlightSqlAccessor<BinaryArray>(array);
+         }},
         {SourceAndTargetPair(arrow::Type::type::DATE32, CDataType_DATE),
           [](arrow::Array *array) {
             return new DateArrayFlightSqlAccessor<CDataType_DATE, Date32Array>(array);
@@ -129,21 +155,109 @@ const std::unordered_map<SourceAndTargetPair, AccessorConstructor,
           [](arrow::Array *array) {
            return CreateTimeAccessor(array, arrow::Type::type::TIME64);
           }},
+        {SourceAndTargetPair(arrow::Type::type::DATE32, CDataType_CHAR),
+          [](arrow::Array *array) {
+           return CreateTemporalTextAccessor(array, CDataType_CHAR);
+          }},
+        {SourceAndTargetPair(arrow::Type::type::DATE32, CDataType_WCHAR),
+          [](arrow::Array *array) {
+           return CreateTemporalTextAccessor(array, CDataType_WCHAR);
+          }},
+        {SourceAndTargetPair(arrow::Type::type::DATE64, CDataType_CHAR),
+          [](arrow::Array *array) {
+           return CreateTemporalTextAccessor(array, CDataType_CHAR);
+          }},
+        {SourceAndTargetPair(arrow::Type::type::DATE64, CDataType_WCHAR),
+          [](arrow::Array *array) {
+           return CreateTemporalTextAccessor(array, CDataType_WCHAR);
+          }},
+        {SourceAndTargetPair(arrow::Type::type::TIME32, CDataType_CHAR),
+          [](arrow::Array *array) {
+           return CreateTemporalTextAccessor(array, CDataType_CHAR);
+          }},
+        {SourceAndTargetPair(arrow::Type::type::TIME32, CDataType_WCHAR),
+          [](arrow::Array *array) {
+           return CreateTemporalTextAccessor(array, CDataType_WCHAR);
+          }},
+        {SourceAndTargetPair(arrow::Type::type::TIME64, CDataType_CHAR),
+          [](arrow::Array *array) {
+           return CreateTemporalTextAccessor(array, CDataType_CHAR);
+          }},
+        {SourceAndTargetPair(arrow::Type::type::TIME64, CDataType_WCHAR),
+          [](arrow::Array *array) {
+           return CreateTemporalTextAccessor(array, CDataType_WCHAR);
+          }},
+        {SourceAndTargetPair(arrow::Type::type::TIMESTAMP, CDataType_CHAR),
+          [](arrow::Array *array) {
+           return CreateTemporalTextAccessor(array, CDataType_CHAR);
+          }},
+        {SourceAndTargetPair(arrow::Type::type::TIMESTAMP, CDataType_WCHAR),
+          [](arrow::Array *array) {
+           return CreateTemporalTextAccessor(array, CDataType_WCHAR);
+          }},
         {SourceAndTargetPair(arrow::Type::type::DECIMAL128, CDataType_NUMERIC),
           [](arrow::Array *array) {
             return new DecimalArrayFlightSqlAccessor<Decimal128Array, CDataType_NUMERIC>(array);
+          }},
+        {SourceAndTargetPair(arrow::Type::type::DECIMAL128, CDataType_CHAR),
+          [](arrow::Array *array) {
+            return new DecimalArrayFlightSqlAccessor<Decimal128Array, CDataType_CHAR>(array);
+          }},
+        {SourceAndTargetPair(arrow::Type::type::DECIMAL128, CDataType_WCHAR),
+          [](arrow::Array *array) {
+            return new DecimalArrayFlightSqlAccessor<Decimal128Array, CDataType_WCHAR>(array);
+          }},
+        {SourceAndTargetPair(arrow::Type::type::DECIMAL128, CDataType_DOUBLE),
+          [](arrow::Array *array) {
+            return new DecimalArrayFlightSqlAccessor<Decimal128Array, CDataType_DOUBLE>(array);
+          }},
+        {SourceAndTargetPair(arrow::Type::type::DECIMAL256, CDataType_NUMERIC),
+          [](arrow::Array *array) {
+            return new DecimalArrayFlightSqlAccessor<Decimal256Array, CDataType_NUMERIC>(array);
+          }},
+        {SourceAndTargetPair(arrow::Type::type::DECIMAL256, CDataType_CHAR),
+          [](arrow::Array *array) {
+            return new DecimalArrayFlightSqlAccessor<Decimal256Array, CDataType_CHAR>(array);
+          }},
+        {SourceAndTargetPair(arrow::Type::type::DECIMAL256, CDataType_WCHAR),
+          [](arrow::Array *array) {
+            return new DecimalArrayFlightSqlAccessor<Decimal256Array, CDataType_WCHAR>(array);
+          }},
+        {SourceAndTargetPair(arrow::Type::type::DECIMAL256, CDataType_DOUBLE),
+          [](arrow::Array *array) {
+            return new DecimalArrayFlightSqlAccessor<Decimal256Array, CDataType_DOUBLE>(array);
           }}};
+  return ACCESSORS_CONSTRUCTORS;
 }
+} // namespace
 
 std::unique_ptr<Accessor> CreateAccessor(arrow::Array *source_array,
-                                         CDataType target_type) {
-  auto it = ACCESSORS_CONSTRUCTORS.find(
+                                         CDataType target_type,
+                                         ConversionMemo *memo) {
+  // String accessors are built here rather than in the map, as they take the memo.
+  if (source_array->type_id() == arrow::Type::type::STRING) {
+    if (target_type == CDataType_CHAR) {
+      return std::unique_ptr<Accessor>(
+          new StringArrayFlightSqlAccessor<CDataType_CHAR, char>(source_array, memo));
+    }
+    if (target_type == CDataType_WCHAR) {
+      return std::unique_ptr<Accessor>(CreateWCharStringArrayAccessor(source_array, memo));
+    }
+  }
+
+  const AccessorConstructorMap &constructors = GetAccessorConstructors();
+  auto it = constructors.find(
       SourceAndTargetPair(source_array->type_id(), target_type));
-  if (it != ACCESSORS_CONSTRUCTORS.end()) {
+  if (it != constructors.end()) {
     auto accessor = it->second(source_array);
     return std::unique_ptr<Accessor>(accessor);
   }
 
+  // Conversions between numeric types are generated rather than listed.
+  if (Accessor *accessor = CreateNumericConversionAccessor(source_array, target_type)) {
+    return std::unique_ptr<Accessor>(accessor);
+  }
+
   std::stringstream ss;
   ss << "Unsupported type conversion! Tried to convert '"
      << source_array->type()->ToString() << "' to C type '" << target_type
@@ -14,11 +14,15 @@ namespace driver {
 namespace flight_sql {
 
 class Accessor;
+class ConversionMemo;
 class FlightSqlResultSet;
 
+/// \param memo memo of converted string values kept by the column across chunks, may
+///        be null.
 std::unique_ptr<Accessor>
 CreateAccessor(arrow::Array *source_array,
-               odbcabstraction::CDataType target_type);
+               odbcabstraction::CDataType target_type,
+               ConversionMemo *memo = nullptr);
 
 } // namespace flight_sql
 } // namespace driver
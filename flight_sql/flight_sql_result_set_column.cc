@@ -9,6 +9,7 @@
 #include "flight_sql_result_set_accessors.h"
 #include "utils.h"
 #include <accessors/types.h>
+#include <algorithm>
 #include <memory>
 #include <odbcabstraction/types.h>
 
@@ -34,22 +35,35 @@ std::unique_ptr<Accessor>
 FlightSqlResultSetColumn::CreateAccessor(CDataType target_type) {
   cached_casted_array_ = CastArray(original_array_, target_type);
 
-  return flight_sql::CreateAccessor(cached_casted_array_.get(), target_type);
+  if (!memo_ || memo_target_type_ != target_type) {
+    memo_.reset(new ConversionMemo());
+    memo_target_type_ = target_type;
+  }
+  return flight_sql::CreateAccessor(cached_casted_array_.get(), target_type, memo_.get());
 }
 
 Accessor *
-FlightSqlResultSetColumn::GetAccessorForTargetType(CDataType target_type) {
-  // Cast the original array to a type matching the target_type.
-  if (target_type == odbcabstraction::CDataType_DEFAULT) {
-    target_type = ConvertArrowTypeToC(original_array_->type_id(), use_wide_char_);
+FlightSqlResultSetColumn::GetAccessorForSlice(CDataType target_type, int64_t row) {
+  if (NeedArrayConversion(original_array_->type_id(), target_type)) {
+    // Only convert the rows from the requested one onwards, as applications
+    // usually walk through the result set forwards.
+    const int64_t length = std::min(GET_DATA_SLICE_ROWS, original_array_->length() - row);
+    get_data_slice_start_ = row;
+    get_data_array_ = CastArray(original_array_->Slice(row, length), target_type);
+  } else {
+    get_data_slice_start_ = 0;
+    get_data_array_ = original_array_;
   }
 
-  cached_accessor_ = CreateAccessor(target_type);
-  return cached_accessor_.get();
+  get_data_accessor_ = flight_sql::CreateAccessor(get_data_array_.get(), target_type);
+  return get_data_accessor_.get();
 }
 
-FlightSqlResultSetColumn::FlightSqlResultSetColumn(bool use_wide_char)
-    : use_wide_char_(use_wide_char),
+FlightSqlResultSetColumn::FlightSqlResultSetColumn(bool use_wide_char, bool complex_types_as_arrow_ipc)
+    : memo_target_type_(odbcabstraction::CDataType_DEFAULT),
+      get_data_slice_start_(0),
+      use_wide_char_(use_wide_char),
+      complex_types_as_arrow_ipc_(complex_types_as_arrow_ipc),
       is_bound_(false) {}
 
 void FlightSqlResultSetColumn::SetBinding(const ColumnBinding& new_binding, arrow::Type::type arrow_type) {
@@ -57,7 +71,7 @@ void FlightSqlResultSetColumn::SetBinding(const ColumnBinding& new_binding, arro
   is_bound_ = true;
 
   if (binding_.target_type == odbcabstraction::CDataType_DEFAULT) {
-    binding_.target_type = ConvertArrowTypeToC(arrow_type, use_wide_char_);
+    binding_.target_type = GetDefaultTargetType(arrow_type);
   }
 
   // Overwrite the binding if the caller is using SQL_C_NUMERIC and has used zero
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <accessors/conversion_memo.h>
 #include <accessors/types.h>
 #include <arrow/array.h>
 #include "utils.h"
@@ -15,37 +16,73 @@ namespace flight_sql {
 
 using arrow::Array;
 
+/// Number of rows converted at once when SQLGetData needs a type conversion.
+constexpr int64_t GET_DATA_SLICE_ROWS = 1024;
+
 class FlightSqlResultSetColumn {
 private:
   std::shared_ptr<Array> original_array_;
   std::shared_ptr<Array> cached_casted_array_;
   std::unique_ptr<Accessor> cached_accessor_;
 
+  // Converted string values of the column, kept across chunks so that the accessor of
+  // each chunk doesn't sample the column again. Its entries are only valid for
+  // memo_target_type_.
+  std::unique_ptr<ConversionMemo> memo_;
+  CDataType memo_target_type_;
+
+  // SQLGetData on a target type other than the bound one only converts the slice of
+  // the chunk holding the requested row. The slice is kept for the following rows and
+  // dropped when the chunk changes.
+  std::shared_ptr<Array> get_data_array_;
+  std::unique_ptr<Accessor> get_data_accessor_;
+  int64_t get_data_slice_start_;
+
   std::unique_ptr<Accessor> CreateAccessor(CDataType target_type);
 
-  Accessor *GetAccessorForTargetType(CDataType target_type);
+  Accessor *GetAccessorForSlice(CDataType target_type, int64_t row);
 
 public:
   FlightSqlResultSetColumn() = default;
-  explicit FlightSqlResultSetColumn(bool use_wide_char);
+  FlightSqlResultSetColumn(bool use_wide_char, bool complex_types_as_arrow_ipc);
 
   ColumnBinding binding_;
   bool use_wide_char_;
+  bool complex_types_as_arrow_ipc_;
   bool is_bound_;
 
+  inline CDataType GetDefaultTargetType(arrow::Type::type arrow_type) const {
+    if (complex_types_as_arrow_ipc_ && IsComplexType(arrow_type)) {
+      return odbcabstraction::CDataType_BINARY;
+    }
+    return ConvertArrowTypeToC(arrow_type, use_wide_char_);
+  }
+
   inline Accessor *GetAccessorForBinding() {
     return cached_accessor_.get();
   }
 
-  inline Accessor *GetAccessorForGetData(CDataType target_type) {
+  /// \brief Returns an accessor able to read the given row of the current chunk.
+  /// \param row           row of the current chunk to read.
+  /// \param accessor_row  set to the position of that row within the accessor's array.
+  inline Accessor *GetAccessorForGetData(CDataType target_type, int64_t row,
+                                         int64_t &accessor_row) {
     if (target_type == odbcabstraction::CDataType_DEFAULT) {
-      target_type = ConvertArrowTypeToC(original_array_->type_id(), use_wide_char_);
+      target_type = GetDefaultTargetType(original_array_->type_id());
     }
 
     if (cached_accessor_ && cached_accessor_->target_type_ == target_type) {
+      accessor_row = row;
       return cached_accessor_.get();
     }
-    return GetAccessorForTargetType(target_type);
+
+    if (!get_data_accessor_ || get_data_accessor_->target_type_ != target_type ||
+        row < get_data_slice_start_ ||
+        row >= get_data_slice_start_ + get_data_array_->length()) {
+      GetAccessorForSlice(target_type, row);
+    }
+    accessor_row = row - get_data_slice_start_;
+    return get_data_accessor_.get();
   }
 
   void SetBinding(const ColumnBinding& new_binding, arrow::Type::type arrow_type);
@@ -54,9 +91,9 @@ public:
 
   inline void ResetAccessor(std::shared_ptr<Array> array) {
     original_array_ = std::move(array);
-    if (cached_accessor_) {
-      cached_accessor_ = CreateAccessor(cached_accessor_->target_type_);
-    } else if (is_bound_) {
+    get_data_array_.reset();
+    get_data_accessor_.reset();
+    if (is_bound_) {
       cached_accessor_ = CreateAccessor(binding_.target_type);
     } else {
       cached_casted_array_.reset();
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "flight_sql_result_set_column.h"
+
+#include "arrow/testing/builder.h"
+#include "gtest/gtest.h"
+#include <odbcabstraction/diagnostics.h>
+
+namespace driver {
+namespace flight_sql {
+
+using namespace arrow;
+using namespace odbcabstraction;
+
+namespace {
+const int64_t CHUNK_ROWS = 3000;
+
+/// An int32 chunk whose value at each row is the row plus first_value.
+std::shared_ptr<Array> Chunk(int32_t first_value) {
+  std::vector<int32_t> values(CHUNK_ROWS);
+  for (int64_t i = 0; i < CHUNK_ROWS; ++i) {
+    values[i] = static_cast<int32_t>(first_value + i);
+  }
+  std::shared_ptr<Array> array;
+  ArrayFromVector<Int32Type, int32_t>(values, &array);
+  return array;
+}
+
+std::string ReadChar(Accessor *accessor, int64_t accessor_row) {
+  char buffer[32];
+  ssize_t strlen_buffer;
+  ColumnBinding binding(CDataType_CHAR, 0, 0, buffer, sizeof(buffer), &strlen_buffer);
+  int64_t value_offset = 0;
+  Diagnostics diagnostics("Foo", "Foo", OdbcVersion::V_3);
+  accessor->GetColumnarData(&binding, accessor_row, 1, value_offset, false, diagnostics, nullptr);
+  return std::string(buffer);
+}
+
+class FlightSqlResultSetColumnTest : public ::testing::Test {
+protected:
+  FlightSqlResultSetColumnTest() : column_(false, false) {}
+
+  void SetUp() override {
+    column_.ResetAccessor(Chunk(0));
+  }
+
+  FlightSqlResultSetColumn column_;
+};
+}
+
+TEST_F(FlightSqlResultSetColumnTest, ReusesSliceWithinSliceRows) {
+  int64_t accessor_row = -1;
+  Accessor *accessor = column_.GetAccessorForGetData(CDataType_CHAR, 0, accessor_row);
+  ASSERT_EQ(0, accessor_row);
+  ASSERT_EQ("0", ReadChar(accessor, accessor_row));
+
+  const int64_t last_row = GET_DATA_SLICE_ROWS - 1;
+  ASSERT_EQ(accessor, column_.GetAccessorForGetData(CDataType_CHAR, last_row, accessor_row));
+  ASSERT_EQ(last_row, accessor_row);
+  ASSERT_EQ(std::to_string(last_row), ReadChar(accessor, accessor_row));
+}
+
+TEST_F(FlightSqlResultSetColumnTest, ConvertsAgainWhenRowLeavesSlice) {
+  int64_t accessor_row = -1;
+  Accessor *first = column_.GetAccessorForGetData(CDataType_CHAR, 10, accessor_row);
+
+  // Past the end of the slice.
+  Accessor *next = column_.GetAccessorForGetData(CDataType_CHAR, 10 + GET_DATA_SLICE_ROWS, accessor_row);
+  ASSERT_NE(first, next);
+  ASSERT_EQ(0, accessor_row);
+  ASSERT_EQ(std::to_string(10 + GET_DATA_SLICE_ROWS), ReadChar(next, accessor_row));
+
+  // Before the start of the slice.
+  Accessor *previous = column_.GetAccessorForGetData(CDataType_CHAR, 5, accessor_row);
+  ASSERT_NE(next, previous);
+  ASSERT_EQ(0, accessor_row);
+  ASSERT_EQ("5", ReadChar(previous, accessor_row));
+}
+
+TEST_F(FlightSqlResultSetColumnTest, ConvertsAgainWhenTargetTypeChanges) {
+  int64_t accessor_row = -1;
+  Accessor *char_accessor = column_.GetAccessorForGetData(CDataType_CHAR, 7, accessor_row);
+  ASSERT_EQ(CDataType_CHAR, char_accessor->target_type_);
+
+  Accessor *wchar_accessor = column_.GetAccessorForGetData(CDataType_WCHAR, 7, accessor_row);
+  ASSERT_NE(char_accessor, wchar_accessor);
+  ASSERT_EQ(CDataType_WCHAR, wchar_accessor->target_type_);
+  ASSERT_EQ(0, accessor_row);
+
+  Accessor *char_again = column_.GetAccessorForGetData(CDataType_CHAR, 8, accessor_row);
+  ASSERT_EQ(CDataType_CHAR, char_again->target_type_);
+  ASSERT_EQ("8", ReadChar(char_again, accessor_row));
+}
+
+TEST_F(FlightSqlResultSetColumnTest, DropsSliceOnResetAccessor) {
+  int64_t accessor_row = -1;
+  ASSERT_EQ("5", ReadChar(column_.GetAccessorForGetData(CDataType_CHAR, 5, accessor_row), accessor_row));
+
+  column_.ResetAccessor(Chunk(100000));
+  Accessor *accessor = column_.GetAccessorForGetData(CDataType_CHAR, 5, accessor_row);
+  ASSERT_EQ(0, accessor_row);
+  ASSERT_EQ("100005", ReadChar(accessor, accessor_row));
+}
+
+TEST_F(FlightSqlResultSetColumnTest, SliceStartingMidChunk) {
+  int64_t accessor_row = -1;
+  Accessor *accessor = column_.GetAccessorForGetData(CDataType_CHAR, 1500, accessor_row);
+  ASSERT_EQ(0, accessor_row);
+
+  ASSERT_EQ(accessor, column_.GetAccessorForGetData(CDataType_CHAR, 1600, accessor_row));
+  ASSERT_EQ(100, accessor_row);
+  ASSERT_EQ("1600", ReadChar(accessor, accessor_row));
+
+  // The last slice of the chunk is shorter than GET_DATA_SLICE_ROWS.
+  accessor = column_.GetAccessorForGetData(CDataType_CHAR, CHUNK_ROWS - 100, accessor_row);
+  ASSERT_EQ(accessor, column_.GetAccessorForGetData(CDataType_CHAR, CHUNK_ROWS - 1, accessor_row));
+  ASSERT_EQ(99, accessor_row);
+  ASSERT_EQ(std::to_string(CHUNK_ROWS - 1), ReadChar(accessor, accessor_row));
+}
+
+TEST_F(FlightSqlResultSetColumnTest, ReadsWholeChunkWithoutConversion) {
+  int64_t accessor_row = -1;
+  Accessor *accessor = column_.GetAccessorForGetData(CDataType_DEFAULT, 2000, accessor_row);
+  ASSERT_EQ(CDataType_SLONG, accessor->target_type_);
+  ASSERT_EQ(2000, accessor_row);
+  ASSERT_EQ(accessor, column_.GetAccessorForGetData(CDataType_SLONG, 10, accessor_row));
+  ASSERT_EQ(10, accessor_row);
+}
+
+TEST_F(FlightSqlResultSetColumnTest, UsesBoundAccessorForBoundType) {
+  char buffer[32];
+  ColumnBinding binding(CDataType_CHAR, 0, 0, buffer, sizeof(buffer), nullptr);
+  column_.SetBinding(binding, arrow::Type::INT32);
+
+  int64_t accessor_row = -1;
+  ASSERT_EQ(column_.GetAccessorForBinding(),
+            column_.GetAccessorForGetData(CDataType_CHAR, 2000, accessor_row));
+  ASSERT_EQ(2000, accessor_row);
+}
+
+} // namespace flight_sql
+} // namespace driver
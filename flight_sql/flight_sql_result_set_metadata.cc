@@ -8,6 +8,7 @@
 #include <odbcabstraction/platform.h>
 #include <arrow/flight/sql/column_metadata.h>
 #include <arrow/util/key_value_metadata.h>
+#include "arrow_ipc_converter.h"
 #include "utils.h"
 
 #include <odbcabstraction/types.h>
@@ -42,6 +43,11 @@ inline arrow::flight::sql::ColumnMetadata GetMetadata(const std::shared_ptr<Fiel
 arrow::Result<int32_t> GetFieldPrecision(const std::shared_ptr<Field> &field) {
   return GetMetadata(field).GetPrecision();
 }
+
+inline bool IsDecimalField(const std::shared_ptr<Field> &field) {
+  return field->type()->id() == arrow::Type::DECIMAL128 ||
+         field->type()->id() == arrow::Type::DECIMAL256;
+}
 }
 
 size_t FlightSqlResultSetMetadata::GetColumnCount() {
@@ -59,8 +65,13 @@ std::string FlightSqlResultSetMetadata::GetName(int column_position) {
 size_t FlightSqlResultSetMetadata::GetPrecision(int column_position) {
   const std::shared_ptr<Field> &field = schema_->field(column_position - 1);
 
+  // Decimal types carry their own precision, use it when the server doesn't report one.
+  if (IsDecimalField(field)) {
+    return GetFieldPrecision(field).ValueOr(GetDecimalTypePrecision(field->type()));
+  }
+
   int32_t column_size = GetFieldPrecision(field).ValueOrElse([] { return 0; });
-  SqlDataType data_type_v3 = GetDataTypeFromArrowField_V3(field, metadata_settings_.use_wide_char_);
+  SqlDataType data_type_v3 = GetDataTypeFromArrowField_V3(field, metadata_settings_);
 
   return GetColumnSize(data_type_v3, column_size).value_or(0);
 }
@@ -69,15 +80,19 @@ size_t FlightSqlResultSetMetadata::GetScale(int column_position) {
   const std::shared_ptr<Field> &field = schema_->field(column_position - 1);
   arrow::flight::sql::ColumnMetadata metadata = GetMetadata(field);
 
+  if (IsDecimalField(field)) {
+    return metadata.GetScale().ValueOr(GetDecimalTypeScale(field->type()));
+  }
+
   int32_t type_scale = metadata.GetScale().ValueOrElse([] { return 0; });
-  SqlDataType data_type_v3 = GetDataTypeFromArrowField_V3(field, metadata_settings_.use_wide_char_);
+  SqlDataType data_type_v3 = GetDataTypeFromArrowField_V3(field, metadata_settings_);
 
   return GetTypeScale(data_type_v3, type_scale).value_or(0);
 }
 
 uint16_t FlightSqlResultSetMetadata::GetDataType(int column_position) {
   const std::shared_ptr<Field> &field = schema_->field(column_position - 1);
-  const SqlDataType conciseType = GetDataTypeFromArrowField_V3(field, metadata_settings_.use_wide_char_);
+  const SqlDataType conciseType = GetDataTypeFromArrowField_V3(field, metadata_settings_);
   return GetNonConciseDataType(conciseType);
 }
 
@@ -114,7 +129,7 @@ size_t FlightSqlResultSetMetadata::GetColumnDisplaySize(
   const std::shared_ptr<Field> &field = schema_->field(column_position - 1);
 
   int32_t column_size = metadata_settings_.string_column_length_.value_or(GetFieldPrecision(field).ValueOr(DefaultLengthForVariableLengthColumns));
-  SqlDataType data_type_v3 = GetDataTypeFromArrowField_V3(field, metadata_settings_.use_wide_char_);
+  SqlDataType data_type_v3 = GetDataTypeFromArrowField_V3(field, metadata_settings_);
 
   return GetDisplaySize(data_type_v3, column_size).value_or(NO_TOTAL);
 }
@@ -131,7 +146,7 @@ std::string FlightSqlResultSetMetadata::GetBaseTableName(int column_position) {
 uint16_t FlightSqlResultSetMetadata::GetConciseType(int column_position) {
   const std::shared_ptr<Field> &field = schema_->field(column_position -1);
 
-  const SqlDataType sqlColumnType = GetDataTypeFromArrowField_V3(field, metadata_settings_.use_wide_char_);
+  const SqlDataType sqlColumnType = GetDataTypeFromArrowField_V3(field, metadata_settings_);
   return sqlColumnType;
 }
 
@@ -139,7 +154,7 @@ size_t FlightSqlResultSetMetadata::GetLength(int column_position) {
   const std::shared_ptr<Field> &field = schema_->field(column_position - 1);
 
   int32_t column_size = metadata_settings_.string_column_length_.value_or(GetFieldPrecision(field).ValueOr(DefaultLengthForVariableLengthColumns));
-  SqlDataType data_type_v3 = GetDataTypeFromArrowField_V3(field, metadata_settings_.use_wide_char_);
+  SqlDataType data_type_v3 = GetDataTypeFromArrowField_V3(field, metadata_settings_);
 
   return flight_sql::GetLength(data_type_v3, column_size).value_or(DefaultLengthForVariableLengthColumns);
 }
@@ -163,7 +178,7 @@ std::string FlightSqlResultSetMetadata::GetLocalTypeName(int column_position) {
 
 size_t FlightSqlResultSetMetadata::GetNumPrecRadix(int column_position) {
   const std::shared_ptr<Field> &field = schema_->field(column_position - 1);
-  SqlDataType data_type_v3 = GetDataTypeFromArrowField_V3(field, metadata_settings_.use_wide_char_);
+  SqlDataType data_type_v3 = GetDataTypeFromArrowField_V3(field, metadata_settings_);
 
   return GetRadixFromSqlDataType(data_type_v3).value_or(NO_TOTAL);
 }
@@ -173,12 +188,12 @@ size_t FlightSqlResultSetMetadata::GetOctetLength(int column_position) {
   arrow::flight::sql::ColumnMetadata metadata = GetMetadata(field);
 
   int32_t column_size = metadata_settings_.string_column_length_.value_or(GetFieldPrecision(field).ValueOr(DefaultLengthForVariableLengthColumns));
-  SqlDataType data_type_v3 = GetDataTypeFromArrowField_V3(field, metadata_settings_.use_wide_char_);
+  SqlDataType data_type_v3 = GetDataTypeFromArrowField_V3(field, metadata_settings_);
 
   // Workaround to get the precision for Decimal and Numeric types, since server doesn't return it currently.
   // TODO: Use the server precision when its fixed.
   std::shared_ptr<DataType> arrow_type = field->type();
-  if (arrow_type->id() == arrow::Type::DECIMAL128){
+  if (IsDecimalField(field)){
     int32_t precision = GetDecimalTypePrecision(arrow_type);
     return GetCharOctetLength(data_type_v3, column_size, precision).value_or(DefaultDecimalPrecision+2);
   }
@@ -237,6 +252,17 @@ bool FlightSqlResultSetMetadata::IsFixedPrecScale(int column_position) {
   return false;
 }
 
+std::string FlightSqlResultSetMetadata::GetArrowIpcSchema(int column_position) {
+  const std::shared_ptr<DataType> &type = schema_->field(column_position - 1)->type();
+  if (!metadata_settings_.complex_types_as_arrow_ipc_ || !IsComplexType(type->id())) {
+    return "";
+  }
+
+  const auto &schema_message = SerializeArrowIpcSchema(type);
+  ThrowIfNotOK(schema_message.status());
+  return schema_message.ValueOrDie()->ToString();
+}
+
 FlightSqlResultSetMetadata::FlightSqlResultSetMetadata(
     std::shared_ptr<arrow::Schema> schema,
     const odbcabstraction::MetadataSettings& metadata_settings)
@@ -82,6 +82,8 @@ public:
   bool IsUnsigned(int column_position) override;
 
   bool IsFixedPrecScale(int column_position) override;
+
+  std::string GetArrowIpcSchema(int column_position) override;
 };
 } // namespace flight_sql
 } // namespace driver
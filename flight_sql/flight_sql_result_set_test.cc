@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "flight_sql_result_set.h"
+
+#include "arrow/testing/builder.h"
+#include "arrow/testing/gtest_util.h"
+#include <arrow/flight/client.h>
+#include <arrow/flight/server.h>
+#include <odbcabstraction/diagnostics.h>
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstring>
+
+namespace driver {
+namespace flight_sql {
+
+using arrow::RecordBatch;
+using arrow::RecordBatchReader;
+using arrow::Status;
+using arrow::flight::FlightClient;
+using arrow::flight::FlightClientOptions;
+using arrow::flight::FlightDataStream;
+using arrow::flight::FlightDescriptor;
+using arrow::flight::FlightServerBase;
+using arrow::flight::FlightServerOptions;
+using arrow::flight::Location;
+using arrow::flight::RecordBatchStream;
+using arrow::flight::ServerCallContext;
+using arrow::flight::Ticket;
+using odbcabstraction::CDataType_CHAR;
+using odbcabstraction::CDataType_SLONG;
+using odbcabstraction::Diagnostics;
+using odbcabstraction::MetadataSettings;
+using odbcabstraction::OdbcVersion;
+
+namespace {
+/// Serves the same batches for every ticket.
+class BatchServer : public FlightServerBase {
+public:
+  BatchServer(std::shared_ptr<Schema> schema, std::vector<std::shared_ptr<RecordBatch>> batches)
+      : schema_(std::move(schema)), batches_(std::move(batches)) {}
+
+  Status DoGet(const ServerCallContext &context, const Ticket &request,
+               std::unique_ptr<FlightDataStream> *stream) override {
+    ARROW_ASSIGN_OR_RAISE(auto reader, RecordBatchReader::Make(batches_, schema_));
+    stream->reset(new RecordBatchStream(reader));
+    return Status::OK();
+  }
+
+private:
+  std::shared_ptr<Schema> schema_;
+  std::vector<std::shared_ptr<RecordBatch>> batches_;
+};
+
+const int64_t ROWS = 8;
+const size_t NAME_LENGTH = 8;
+
+std::string Name(int64_t row) {
+  return "row" + std::to_string(row);
+}
+
+/// An application-side row for row-wise binding.
+struct Row {
+  int32_t id;
+  ssize_t id_indicator;
+  char name[NAME_LENGTH];
+  ssize_t name_indicator;
+};
+
+/// The result set reads (id int32, name utf8) rows from a local server, in a chunk of 3
+/// rows followed by one of 5.
+class FlightSqlResultSetTest : public ::testing::Test {
+protected:
+  FlightSqlResultSetTest() : diagnostics_("Foo", "Foo", OdbcVersion::V_3) {}
+
+  void SetUp() override {
+    const auto schema = arrow::schema({arrow::field("id", arrow::int32()), arrow::field("name", arrow::utf8())});
+    std::vector<std::shared_ptr<RecordBatch>> batches;
+    for (const auto &rows : std::vector<std::pair<int64_t, int64_t>>{{0, 3}, {3, ROWS}}) {
+      std::vector<int32_t> ids;
+      std::vector<std::string> names;
+      for (int64_t row = rows.first; row < rows.second; ++row) {
+        ids.push_back(static_cast<int32_t>(row));
+        names.push_back(Name(row));
+      }
+      std::shared_ptr<arrow::Array> id_array, name_array;
+      arrow::ArrayFromVector<arrow::Int32Type, int32_t>(ids, &id_array);
+      arrow::ArrayFromVector<arrow::StringType, std::string>(names, &name_array);
+      batches.push_back(RecordBatch::Make(schema, static_cast<int64_t>(ids.size()), {id_array, name_array}));
+    }
+
+    server_.reset(new BatchServer(schema, batches));
+    Location location;
+    ASSERT_OK(Location::ForGrpcTcp("localhost", 0, &location));
+    ASSERT_OK(server_->Init(FlightServerOptions(location)));
+
+    Location server_location;
+    ASSERT_OK(Location::ForGrpcTcp("localhost", server_->port(), &server_location));
+    std::unique_ptr<FlightClient> flight_client;
+    ASSERT_OK(FlightClient::Connect(server_location, FlightClientOptions::Defaults(), &flight_client));
+    sql_client_.reset(new FlightSqlClient(std::move(flight_client)));
+
+    ASSERT_OK_AND_ASSIGN(auto flight_info,
+                         FlightInfo::Make(*schema, FlightDescriptor::Command(""),
+                                          {FlightEndpoint{Ticket{""}, {}}}, ROWS, -1));
+    settings_.chunk_buffer_capacity_ = 5;
+    settings_.use_wide_char_ = false;
+    settings_.complex_types_as_arrow_ipc_ = false;
+    result_set_.reset(new FlightSqlResultSet(*sql_client_, arrow::flight::FlightCallOptions(),
+                                             std::make_shared<FlightInfo>(std::move(flight_info)),
+                                             nullptr, diagnostics_, settings_));
+  }
+
+  void TearDown() override {
+    result_set_.reset();
+    sql_client_.reset();
+    ASSERT_OK(server_->Shutdown());
+  }
+
+  std::unique_ptr<BatchServer> server_;
+  std::unique_ptr<FlightSqlClient> sql_client_;
+  Diagnostics diagnostics_;
+  MetadataSettings settings_;
+  std::unique_ptr<FlightSqlResultSet> result_set_;
+};
+}
+
+TEST_F(FlightSqlResultSetTest, ColumnarCrossesChunkBoundary) {
+  const int64_t rowset_size = 5;
+  int32_t ids[rowset_size] = {};
+  ssize_t id_indicators[rowset_size] = {};
+  char names[rowset_size][NAME_LENGTH] = {};
+  ssize_t name_indicators[rowset_size] = {};
+  result_set_->BindColumn(1, CDataType_SLONG, 0, 0, ids, sizeof(int32_t), id_indicators);
+  result_set_->BindColumn(2, CDataType_CHAR, 0, 0, names, NAME_LENGTH, name_indicators);
+
+  uint16_t row_status[rowset_size];
+  for (int64_t first_row = 0; first_row < ROWS; first_row += rowset_size) {
+    const int64_t fetched = std::min(rowset_size, ROWS - first_row);
+    ASSERT_EQ(fetched, result_set_->Move(rowset_size, 0, 0, row_status));
+    for (int64_t i = 0; i < fetched; ++i) {
+      ASSERT_EQ(first_row + i, ids[i]);
+      ASSERT_EQ(static_cast<ssize_t>(sizeof(int32_t)), id_indicators[i]);
+      ASSERT_EQ(Name(first_row + i), names[i]);
+      ASSERT_EQ(Name(first_row + i).size(), name_indicators[i]);
+      ASSERT_EQ(odbcabstraction::RowStatus_SUCCESS, row_status[i]);
+    }
+  }
+  ASSERT_EQ(odbcabstraction::RowStatus_NOROW, row_status[3]);
+}
+
+TEST_F(FlightSqlResultSetTest, ColumnarBindOffsetChangesBetweenFetches) {
+  int32_t ids[2 * ROWS] = {};
+  ssize_t indicators[2 * ROWS] = {};
+  result_set_->BindColumn(1, CDataType_SLONG, 0, 0, ids, sizeof(int32_t), indicators);
+
+  ASSERT_EQ(2, result_set_->Move(2, 0, 0, nullptr));
+  // The bind offset shifts the value and indicator buffers by the same number of bytes.
+  const size_t bind_offset = 4 * sizeof(ssize_t);
+  ASSERT_EQ(2, result_set_->Move(2, bind_offset, 0, nullptr));
+
+  const int32_t *shifted_ids = ids + bind_offset / sizeof(int32_t);
+  const ssize_t *shifted_indicators = indicators + bind_offset / sizeof(ssize_t);
+  ASSERT_EQ(0, ids[0]);
+  ASSERT_EQ(1, ids[1]);
+  ASSERT_EQ(2, shifted_ids[0]);
+  ASSERT_EQ(3, shifted_ids[1]);
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(int32_t)), shifted_indicators[1]);
+  ASSERT_EQ(0, indicators[2]);
+}
+
+TEST_F(FlightSqlResultSetTest, ColumnarRebindAndUnbindBetweenFetches) {
+  int32_t ids[2] = {};
+  char names[2][NAME_LENGTH] = {};
+  result_set_->BindColumn(1, CDataType_SLONG, 0, 0, ids, sizeof(int32_t), nullptr);
+  result_set_->BindColumn(2, CDataType_CHAR, 0, 0, names, NAME_LENGTH, nullptr);
+  ASSERT_EQ(2, result_set_->Move(2, 0, 0, nullptr));
+
+  // The id column moves to another buffer as text and the name column is unbound.
+  char id_texts[2][NAME_LENGTH] = {};
+  result_set_->BindColumn(1, CDataType_CHAR, 0, 0, id_texts, NAME_LENGTH, nullptr);
+  result_set_->BindColumn(2, CDataType_CHAR, 0, 0, nullptr, 0, nullptr);
+  ASSERT_EQ(2, result_set_->Move(2, 0, 0, nullptr));
+
+  ASSERT_EQ(0, ids[0]);
+  ASSERT_EQ(1, ids[1]);
+  ASSERT_EQ(Name(0), names[0]);
+  ASSERT_EQ(Name(1), names[1]);
+  ASSERT_STREQ("2", id_texts[0]);
+  ASSERT_STREQ("3", id_texts[1]);
+}
+
+TEST_F(FlightSqlResultSetTest, RowWiseCrossesChunkBoundary) {
+  Row rows[ROWS];
+  memset(rows, 0, sizeof(rows));
+  result_set_->BindColumn(1, CDataType_SLONG, 0, 0, &rows[0].id, sizeof(int32_t), &rows[0].id_indicator);
+  result_set_->BindColumn(2, CDataType_CHAR, 0, 0, rows[0].name, NAME_LENGTH, &rows[0].name_indicator);
+
+  uint16_t row_status[5];
+  ASSERT_EQ(5, result_set_->Move(5, 0, sizeof(Row), row_status));
+  ASSERT_EQ(3, result_set_->Move(5, 5 * sizeof(Row), sizeof(Row), row_status));
+
+  for (int64_t row = 0; row < ROWS; ++row) {
+    ASSERT_EQ(row, rows[row].id);
+    ASSERT_EQ(static_cast<ssize_t>(sizeof(int32_t)), rows[row].id_indicator);
+    ASSERT_EQ(Name(row), rows[row].name);
+    ASSERT_EQ(Name(row).size(), rows[row].name_indicator);
+  }
+  ASSERT_EQ(odbcabstraction::RowStatus_NOROW, row_status[3]);
+}
+
+TEST_F(FlightSqlResultSetTest, RowWiseBindOffsetChangesBetweenFetches) {
+  Row rows[4];
+  memset(rows, 0, sizeof(rows));
+  result_set_->BindColumn(1, CDataType_SLONG, 0, 0, &rows[0].id, sizeof(int32_t), &rows[0].id_indicator);
+  result_set_->BindColumn(2, CDataType_CHAR, 0, 0, rows[0].name, NAME_LENGTH, &rows[0].name_indicator);
+
+  ASSERT_EQ(1, result_set_->Move(1, 0, sizeof(Row), nullptr));
+  ASSERT_EQ(2, result_set_->Move(2, 2 * sizeof(Row), sizeof(Row), nullptr));
+
+  ASSERT_EQ(0, rows[0].id);
+  ASSERT_EQ(Name(0), rows[0].name);
+  ASSERT_EQ(0, rows[1].id_indicator);
+  ASSERT_EQ(0, rows[1].name_indicator);
+  ASSERT_EQ(1, rows[2].id);
+  ASSERT_EQ(Name(1), rows[2].name);
+  ASSERT_EQ(2, rows[3].id);
+  ASSERT_EQ(Name(2), rows[3].name);
+}
+
+TEST_F(FlightSqlResultSetTest, RowWiseRebindAndUnbindBetweenFetches) {
+  Row rows[2];
+  memset(rows, 0, sizeof(rows));
+  result_set_->BindColumn(1, CDataType_SLONG, 0, 0, &rows[0].id, sizeof(int32_t), &rows[0].id_indicator);
+  result_set_->BindColumn(2, CDataType_CHAR, 0, 0, rows[0].name, NAME_LENGTH, &rows[0].name_indicator);
+  ASSERT_EQ(2, result_set_->Move(2, 0, sizeof(Row), nullptr));
+
+  // The id column is read as text into the name field, and the name column is unbound.
+  Row next_rows[2];
+  memset(next_rows, 0, sizeof(next_rows));
+  result_set_->BindColumn(2, CDataType_CHAR, 0, 0, nullptr, 0, nullptr);
+  result_set_->BindColumn(1, CDataType_CHAR, 0, 0, next_rows[0].name, NAME_LENGTH, &next_rows[0].name_indicator);
+  ASSERT_EQ(2, result_set_->Move(2, 0, sizeof(Row), nullptr));
+
+  ASSERT_EQ(Name(1), rows[1].name);
+  ASSERT_STREQ("2", next_rows[0].name);
+  ASSERT_STREQ("3", next_rows[1].name);
+  ASSERT_EQ(1, next_rows[1].name_indicator);
+  ASSERT_EQ(0, next_rows[0].id);
+  ASSERT_EQ(0, next_rows[0].id_indicator);
+}
+
+} // namespace flight_sql
+} // namespace driver
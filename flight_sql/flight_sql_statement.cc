@@ -6,17 +6,24 @@
 
 #include "flight_sql_statement.h"
 #include <odbcabstraction/platform.h>
+#include <odbcabstraction/logger.h>
+#include "admission_control.h"
+#include "flight_sql_parameter_stream.h"
+#include "flight_sql_result_exporter.h"
 #include "flight_sql_result_set.h"
 #include "flight_sql_result_set_metadata.h"
 #include "flight_sql_statement_get_columns.h"
 #include "flight_sql_statement_get_tables.h"
 #include "flight_sql_statement_get_type_info.h"
 #include "record_batch_transformer.h"
+#include "sorted_batch_merger.h"
+#include "sql_script_splitter.h"
 #include "utils.h"
 #include <arrow/io/memory.h>
 #include <sql.h>
 #include <sqlext.h>
 
+#include <algorithm>
 #include <boost/optional.hpp>
 #include <utility>
 #include <odbcabstraction/exceptions.h>
@@ -49,19 +56,78 @@ void ClosePreparedStatementIfAny(
   }
 }
 
+/// Results expected to reach either estimate are classified as bulk.
+constexpr int64_t BULK_ESTIMATED_ROWS = 1000000;
+constexpr int64_t BULK_ESTIMATED_BYTES = 256 * 1024 * 1024;
+/// Applications fetching this many rows per call are extracting rather than
+/// displaying data.
+constexpr size_t BULK_ROW_ARRAY_SIZE = 10000;
+
+odbcabstraction::StreamPriority
+ResolveStreamPriority(odbcabstraction::StreamPriority requested, size_t row_array_size,
+                      const FlightInfo &flight_info) {
+  if (requested != odbcabstraction::StreamPriority_AUTO) {
+    return requested;
+  }
+  if (row_array_size >= BULK_ROW_ARRAY_SIZE ||
+      flight_info.total_records() >= BULK_ESTIMATED_ROWS ||
+      flight_info.total_bytes() >= BULK_ESTIMATED_BYTES) {
+    return odbcabstraction::StreamPriority_BULK;
+  }
+  return odbcabstraction::StreamPriority_INTERACTIVE;
+}
+
+/// Unbinds the parameters of a prepared statement when going out of scope, so that
+/// the last batch of a failed stream isn't bound to later executions.
+class ParameterBindingScope {
+public:
+  explicit ParameterBindingScope(PreparedStatement &prepared_statement)
+      : prepared_statement_(prepared_statement) {}
+
+  ~ParameterBindingScope() {
+    // Only resets a member of the prepared statement, it can't fail.
+    static_cast<void>(prepared_statement_.SetParameters(nullptr));
+  }
+
+private:
+  PreparedStatement &prepared_statement_;
+};
+
 } // namespace
 
 FlightSqlStatement::FlightSqlStatement(
     const odbcabstraction::Diagnostics& diagnostics,
     FlightSqlClient &sql_client,
     FlightCallOptions call_options,
-    const odbcabstraction::MetadataSettings& metadata_settings)
+    const odbcabstraction::MetadataSettings& metadata_settings,
+    std::shared_ptr<HostAdmission> admission,
+    std::chrono::milliseconds admission_timeout)
     : diagnostics_("Apache Arrow", diagnostics.GetDataSourceComponent(), diagnostics.GetOdbcVersion()),
-      sql_client_(sql_client), call_options_(std::move(call_options)), metadata_settings_(metadata_settings) {
+      sql_client_(sql_client), call_options_(std::move(call_options)), metadata_settings_(metadata_settings),
+      update_count_(-1), admission_(std::move(admission)), admission_timeout_(admission_timeout),
+      batch_position_(0) {
+  SetDefaultAttributes();
+}
+
+FlightSqlStatement::~FlightSqlStatement() {
+  ReleaseParameterStream(static_cast<struct ArrowArrayStream *>(
+      boost::get<void *>(attribute_[PARAMETER_STREAM])));
+}
+
+void FlightSqlStatement::SetDefaultAttributes() {
   attribute_[METADATA_ID] = static_cast<size_t>(SQL_FALSE);
   attribute_[MAX_LENGTH] = static_cast<size_t>(0);
   attribute_[NOSCAN] = static_cast<size_t>(SQL_NOSCAN_OFF);
   attribute_[QUERY_TIMEOUT] = static_cast<size_t>(0);
+  attribute_[EXPORT_PATH] = std::string();
+  attribute_[EXPORT_FORMAT] = static_cast<size_t>(odbcabstraction::ExportFormat_ARROW_IPC);
+  attribute_[EXPORT_COMPRESSION] = static_cast<size_t>(odbcabstraction::ExportCompression_NONE);
+  attribute_[EXPORT_ROW_GROUP_SIZE] = static_cast<size_t>(0);
+  attribute_[EXPORT_ROW_COUNT] = static_cast<size_t>(0);
+  attribute_[PARAMETER_STREAM] = static_cast<void *>(nullptr);
+  attribute_[MERGE_SORT_KEYS] = std::string();
+  attribute_[PRIORITY] = static_cast<size_t>(odbcabstraction::StreamPriority_AUTO);
+  attribute_[ROW_ARRAY_SIZE] = static_cast<size_t>(1);
   call_options_.timeout = TimeoutDuration{-1};
 }
 
@@ -82,6 +148,37 @@ bool FlightSqlStatement::SetAttribute(StatementAttributeId attribute,
       call_options_.timeout = TimeoutDuration{-1};
       // Intentional fall-through.
     }
+    attribute_[attribute] = value;
+    return true;
+  case EXPORT_FORMAT:
+    if (boost::get<size_t>(value) > odbcabstraction::ExportFormat_PARQUET) {
+      throw DriverException("Invalid export format", "HY024");
+    }
+    attribute_[attribute] = value;
+    return true;
+  case EXPORT_COMPRESSION:
+    if (boost::get<size_t>(value) > odbcabstraction::ExportCompression_SNAPPY) {
+      throw DriverException("Invalid export compression", "HY024");
+    }
+    attribute_[attribute] = value;
+    return true;
+  case EXPORT_ROW_COUNT:
+    throw DriverException("Cannot set read-only attribute", "HY092");
+  case PRIORITY:
+    if (boost::get<size_t>(value) > odbcabstraction::StreamPriority_BULK) {
+      throw DriverException("Invalid priority", "HY024");
+    }
+    attribute_[attribute] = value;
+    return true;
+  case PARAMETER_STREAM: {
+    // The stream being replaced will never be executed.
+    void *previous_stream = boost::get<void *>(attribute_[attribute]);
+    if (previous_stream != boost::get<void *>(value)) {
+      ReleaseParameterStream(static_cast<struct ArrowArrayStream *>(previous_stream));
+    }
+    attribute_[attribute] = value;
+    return true;
+  }
   default:
     attribute_[attribute] = value;
     return true;
@@ -97,6 +194,8 @@ FlightSqlStatement::GetAttribute(StatementAttributeId attribute) {
 boost::optional<std::shared_ptr<ResultSetMetadata>>
 FlightSqlStatement::Prepare(const std::string &query) {
   ClosePreparedStatementIfAny(prepared_statement_);
+  ClearBatch();
+  parameter_writer_.reset();
 
   Result<std::shared_ptr<PreparedStatement>> result =
       sql_client_.Prepare(call_options_, query);
@@ -120,28 +219,242 @@ bool IsUseWildcardEnabled(const FlightCallOptions &call_options) {
   return false;
 }
 
+std::shared_ptr<AdmissionPermit> FlightSqlStatement::Admit() {
+  if (!admission_) {
+    return nullptr;
+  }
+
+  const bool admitted = admission_->Acquire(admission_timeout_);
+  const auto &statistics = admission_->GetStatistics();
+  if (!admitted) {
+    LOG_WARN("Timed out waiting for a query slot, {} queries in flight and {} waiting",
+             statistics.in_flight, statistics.waiting);
+    throw DriverException("Timed out waiting for the server to accept more queries", "HYT00");
+  }
+  LOG_DEBUG("Admitted query, {} in flight and {} waiting, {} us average wait",
+            statistics.in_flight, statistics.waiting,
+            statistics.total_wait_time.count() / std::max<int64_t>(1, statistics.admitted + statistics.timed_out));
+  return std::make_shared<AdmissionPermit>(admission_);
+}
+
+bool FlightSqlStatement::ExecuteFlightInfo(const std::shared_ptr<FlightInfo> &flight_info,
+                                           const std::shared_ptr<AdmissionPermit> &admission_permit) {
+  std::vector<SortKey> merge_sort_keys;
+  const std::string &sort_keys = boost::get<std::string>(attribute_[MERGE_SORT_KEYS]);
+  if (!sort_keys.empty()) {
+    std::shared_ptr<arrow::Schema> schema;
+    ThrowIfNotOK(flight_info->GetSchema(nullptr, &schema));
+    merge_sort_keys = ParseSortKeys(sort_keys, *schema);
+  }
+
+  const auto requested_priority = static_cast<odbcabstraction::StreamPriority>(
+      boost::get<size_t>(attribute_[PRIORITY]));
+  const std::string &export_path = boost::get<std::string>(attribute_[EXPORT_PATH]);
+  if (export_path.empty()) {
+    update_count_ = -1;
+    current_result_set_ = std::make_shared<FlightSqlResultSet>(
+        sql_client_, call_options_, flight_info, nullptr, diagnostics_, metadata_settings_,
+        merge_sort_keys,
+        ResolveStreamPriority(requested_priority, boost::get<size_t>(attribute_[ROW_ARRAY_SIZE]),
+                              *flight_info),
+        admission_permit);
+    return true;
+  }
+
+  ExportOptions options;
+  options.path = export_path;
+  options.format = static_cast<odbcabstraction::ExportFormat>(
+      boost::get<size_t>(attribute_[EXPORT_FORMAT]));
+  options.compression = static_cast<odbcabstraction::ExportCompression>(
+      boost::get<size_t>(attribute_[EXPORT_COMPRESSION]));
+  options.row_group_size = static_cast<int64_t>(
+      boost::get<size_t>(attribute_[EXPORT_ROW_GROUP_SIZE]));
+
+  current_result_set_.reset();
+  update_count_ = -1;
+  int64_t rows_written = ExportFlightToFile(
+      sql_client_, call_options_, flight_info, options, metadata_settings_.chunk_buffer_capacity_,
+      merge_sort_keys,
+      requested_priority == odbcabstraction::StreamPriority_AUTO ? odbcabstraction::StreamPriority_BULK
+                                                                 : requested_priority);
+  attribute_[EXPORT_ROW_COUNT] = static_cast<size_t>(rows_written);
+  update_count_ = static_cast<long>(rows_written);
+
+  return false;
+}
+
+bool FlightSqlStatement::ExecuteParameterStream(struct ArrowArrayStream *stream) {
+  FlightSqlParameterStream parameter_stream(stream, prepared_statement_->parameter_schema());
+
+  current_result_set_.reset();
+  update_count_ = -1;
+
+  // The slot is held for the whole stream of executions.
+  const auto &admission_permit = Admit();
+
+  PreparedStatement &prepared_statement = *prepared_statement_;
+  ParameterBindingScope binding_scope(prepared_statement);
+  const int64_t rows_affected = parameter_stream.ExecuteBatches(
+      [&prepared_statement](const std::shared_ptr<arrow::RecordBatch> &batch) -> int64_t {
+        ThrowIfNotOK(prepared_statement.SetParameters(batch));
+        Result<int64_t> result = prepared_statement.ExecuteUpdate();
+        ThrowIfNotOK(result.status());
+        return result.ValueOrDie();
+      });
+
+  update_count_ = static_cast<long>(rows_affected);
+  return false;
+}
+
+odbcabstraction::ParameterWriter &
+FlightSqlStatement::BeginParameters(const std::vector<odbcabstraction::ParameterType> &types) {
+  if (!prepared_statement_) {
+    throw DriverException("Function sequence error", "HY010");
+  }
+
+  const auto &parameter_schema = prepared_statement_->parameter_schema();
+  if (parameter_schema && parameter_schema->num_fields() != static_cast<int>(types.size())) {
+    throw DriverException("Bound parameters do not match the number of statement parameters", "07002");
+  }
+
+  parameter_writer_.reset(new FlightSqlParameterWriter(types));
+  return *parameter_writer_;
+}
+
 bool FlightSqlStatement::ExecutePrepared() {
   assert(prepared_statement_.get() != nullptr);
 
+  void *parameter_stream = boost::get<void *>(attribute_[PARAMETER_STREAM]);
+  if (parameter_stream != nullptr) {
+    attribute_[PARAMETER_STREAM] = static_cast<void *>(nullptr);
+    return ExecuteParameterStream(static_cast<struct ArrowArrayStream *>(parameter_stream));
+  }
+
+  const auto &admission_permit = Admit();
+  if (parameter_writer_) {
+    const std::unique_ptr<FlightSqlParameterWriter> parameter_writer = std::move(parameter_writer_);
+    ThrowIfNotOK(prepared_statement_->SetParameters(parameter_writer->Finish()));
+  }
   Result<std::shared_ptr<FlightInfo>> result = prepared_statement_->Execute();
   ThrowIfNotOK(result.status());
 
-  current_result_set_ = std::make_shared<FlightSqlResultSet>(
-      sql_client_, call_options_, result.ValueOrDie(), nullptr, diagnostics_, metadata_settings_);
-
-  return true;
+  return ExecuteFlightInfo(result.ValueOrDie(), admission_permit);
 }
 
 bool FlightSqlStatement::Execute(const std::string &query) {
+  if (boost::get<void *>(attribute_[PARAMETER_STREAM]) != nullptr) {
+    throw DriverException("Parameter streams can only be bound to prepared statements", "HY010");
+  }
+
   ClosePreparedStatementIfAny(prepared_statement_);
+  ClearBatch();
+
+  // Exported results would overwrite each other, so scripts are only split when they
+  // are read through result sets.
+  if (metadata_settings_.batch_statements_ &&
+      boost::get<std::string>(attribute_[EXPORT_PATH]).empty()) {
+    std::vector<std::string> statements = SplitSqlStatements(query);
+    if (statements.size() > 1) {
+      batch_ = std::move(statements);
+      try {
+        return ExecuteBatchStatement();
+      } catch (...) {
+        ClearBatch();
+        throw;
+      }
+    }
+  }
 
+  const auto &admission_permit = Admit();
   Result<std::shared_ptr<FlightInfo>> result =
       sql_client_.Execute(call_options_, query);
   ThrowIfNotOK(result.status());
 
-  current_result_set_ = std::make_shared<FlightSqlResultSet>(
-      sql_client_, call_options_, result.ValueOrDie(), nullptr, diagnostics_, metadata_settings_);
+  return ExecuteFlightInfo(result.ValueOrDie(), admission_permit);
+}
 
+bool FlightSqlStatement::ExecuteBatchStatement() {
+  const std::string &query = batch_[batch_position_];
+  current_result_set_.reset();
+  update_count_ = -1;
+
+  std::shared_ptr<AdmissionPermit> admission_permit;
+  std::shared_ptr<FlightInfo> flight_info;
+  if (prefetched_info_.valid()) {
+    Result<std::shared_ptr<FlightInfo>> result = prefetched_info_.get();
+    admission_permit = std::move(prefetched_permit_);
+    ThrowIfNotOK(result.status());
+    flight_info = result.ValueOrDie();
+  } else if (ReturnsResultSet(query)) {
+    admission_permit = Admit();
+    Result<std::shared_ptr<FlightInfo>> result = sql_client_.Execute(call_options_, query);
+    ThrowIfNotOK(result.status());
+    flight_info = result.ValueOrDie();
+  } else {
+    {
+      const auto &update_permit = Admit();
+      Result<int64_t> result = sql_client_.ExecuteUpdate(call_options_, query);
+      ThrowIfNotOK(result.status());
+      update_count_ = static_cast<long>(result.ValueOrDie());
+    }
+    PrefetchNextBatchStatement();
+    return false;
+  }
+
+  PrefetchNextBatchStatement();
+  return ExecuteFlightInfo(flight_info, admission_permit);
+}
+
+void FlightSqlStatement::PrefetchNextBatchStatement() {
+  const size_t next = batch_position_ + 1;
+  if (next >= batch_.size() || !ReturnsResultSet(batch_[next])) {
+    return;
+  }
+
+  if (admission_) {
+    // The current result may hold the last slot, so waiting here could only time out.
+    if (!admission_->Acquire(std::chrono::milliseconds(0))) {
+      return;
+    }
+    prefetched_permit_ = std::make_shared<AdmissionPermit>(admission_);
+  }
+
+  FlightSqlClient &sql_client = sql_client_;
+  const FlightCallOptions call_options = call_options_;
+  const std::string query = batch_[next];
+  prefetched_info_ = std::async(std::launch::async, [&sql_client, call_options, query]() {
+    return sql_client.Execute(call_options, query);
+  });
+}
+
+void FlightSqlStatement::ClearBatch() {
+  // Destroying the future waits for the prefetched execution, whose result is dropped.
+  prefetched_info_ = std::future<Result<std::shared_ptr<FlightInfo>>>();
+  prefetched_permit_.reset();
+  batch_.clear();
+  batch_position_ = 0;
+}
+
+bool FlightSqlStatement::NextResult(bool *has_result_set) {
+  if (current_result_set_) {
+    current_result_set_->Close();
+    current_result_set_.reset();
+  }
+  update_count_ = -1;
+
+  if (batch_position_ + 1 >= batch_.size()) {
+    ClearBatch();
+    return false;
+  }
+
+  ++batch_position_;
+  try {
+    *has_result_set = ExecuteBatchStatement();
+  } catch (...) {
+    // Like a failing script, the batch stops at the first failing statement.
+    ClearBatch();
+    throw;
+  }
   return true;
 }
 
@@ -149,7 +462,7 @@ std::shared_ptr<ResultSet> FlightSqlStatement::GetResultSet() {
   return current_result_set_;
 }
 
-long FlightSqlStatement::GetUpdateCount() { return -1; }
+long FlightSqlStatement::GetUpdateCount() { return update_count_; }
 
 std::shared_ptr<odbcabstraction::ResultSet> FlightSqlStatement::GetTables(
     const std::string *catalog_name, const std::string *schema_name,
@@ -302,6 +615,27 @@ odbcabstraction::Diagnostics &FlightSqlStatement::GetDiagnostics() {
   return diagnostics_;
 }
 
+bool FlightSqlStatement::Reset() {
+  ClearBatch();
+  parameter_writer_.reset();
+  if (current_result_set_) {
+    current_result_set_->Close();
+    current_result_set_.reset();
+  }
+  if (prepared_statement_ && !prepared_statement_->Close().ok()) {
+    return false;
+  }
+  prepared_statement_.reset();
+
+  ReleaseParameterStream(static_cast<struct ArrowArrayStream *>(
+      boost::get<void *>(attribute_[PARAMETER_STREAM])));
+  attribute_.clear();
+  SetDefaultAttributes();
+  update_count_ = -1;
+  diagnostics_.Clear();
+  return true;
+}
+
 void FlightSqlStatement::Cancel() {
   if (!current_result_set_) return;
   current_result_set_->Cancel();
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "flight_sql_parameter_writer.h"
 #include "flight_sql_statement_get_tables.h"
 #include "odbcabstraction/types.h"
 #include <odbcabstraction/spi/statement.h>
@@ -14,10 +15,17 @@
 #include <arrow/flight/api.h>
 #include <arrow/flight/sql/api.h>
 #include <arrow/flight/types.h>
+#include <chrono>
+#include <future>
+
+struct ArrowArrayStream;
 
 namespace driver {
 namespace flight_sql {
 
+class AdmissionPermit;
+class HostAdmission;
+
 class FlightSqlStatement : public odbcabstraction::Statement {
 
 private:
@@ -28,18 +36,66 @@ private:
   std::shared_ptr<odbcabstraction::ResultSet> current_result_set_;
   std::shared_ptr<arrow::flight::sql::PreparedStatement> prepared_statement_;
   const odbcabstraction::MetadataSettings &metadata_settings_;
+  long update_count_;
+  std::shared_ptr<HostAdmission> admission_;
+  std::chrono::milliseconds admission_timeout_;
+  /// Statements of the script being run in batch mode and the index of the current one.
+  std::vector<std::string> batch_;
+  size_t batch_position_;
+  /// Execution of the next batch statement, issued while the current result is read.
+  std::future<arrow::Result<std::shared_ptr<arrow::flight::FlightInfo>>> prefetched_info_;
+  std::shared_ptr<AdmissionPermit> prefetched_permit_;
+  /// Values bound to the prepared statement on its next execution.
+  std::unique_ptr<FlightSqlParameterWriter> parameter_writer_;
+
+  void SetDefaultAttributes();
 
   std::shared_ptr<odbcabstraction::ResultSet>
   GetTables(const std::string *catalog_name, const std::string *schema_name,
             const std::string *table_name, const std::string *table_type,
             const ColumnNames &column_names);
 
+  /// \brief Waits for a query slot on the server when admission control is enabled.
+  /// Throws a DriverException if no slot frees up within the admission timeout.
+  /// \return the slot, or null when admission control is disabled.
+  std::shared_ptr<AdmissionPermit> Admit();
+
+  /// \brief Runs the query described by flight_info, writing it to EXPORT_PATH when
+  /// set or opening a result set over it otherwise.
+  /// \param admission_permit slot held until the result is read or closed, may be null.
+  /// \return true if a result set was opened.
+  bool ExecuteFlightInfo(const std::shared_ptr<arrow::flight::FlightInfo> &flight_info,
+                         const std::shared_ptr<AdmissionPermit> &admission_permit);
+
+  /// \brief Executes the prepared statement once per batch of stream, binding the
+  /// batch as its parameter sets. The stream is released when this returns, and no
+  /// parameters are left bound to the prepared statement.
+  /// \return false, the update count being the sum of the rows affected.
+  bool ExecuteParameterStream(struct ArrowArrayStream *stream);
+
+  /// \brief Runs the current statement of the batch, using its prefetched execution
+  /// when there is one, and prefetches the statement after it.
+  /// \return true if a result set was opened.
+  bool ExecuteBatchStatement();
+
+  /// \brief Issues the execution of the next batch statement in the background if it
+  /// is a query. Updates only run once the results before them were consumed.
+  void PrefetchNextBatchStatement();
+
+  /// \brief Drops the remaining statements of the batch, waiting for any prefetched
+  /// execution to complete.
+  void ClearBatch();
+
 public:
   FlightSqlStatement(
       const odbcabstraction::Diagnostics &diagnostics,
       arrow::flight::sql::FlightSqlClient &sql_client,
       arrow::flight::FlightCallOptions call_options,
-      const odbcabstraction::MetadataSettings& metadata_settings);
+      const odbcabstraction::MetadataSettings& metadata_settings,
+      std::shared_ptr<HostAdmission> admission = nullptr,
+      std::chrono::milliseconds admission_timeout = std::chrono::milliseconds(0));
+
+  ~FlightSqlStatement() override;
 
   bool SetAttribute(StatementAttributeId attribute, const Attribute &value) override;
 
@@ -48,6 +104,9 @@ public:
   boost::optional<std::shared_ptr<odbcabstraction::ResultSetMetadata>>
   Prepare(const std::string &query) override;
 
+  odbcabstraction::ParameterWriter &
+  BeginParameters(const std::vector<odbcabstraction::ParameterType> &types) override;
+
   bool ExecutePrepared() override;
 
   bool Execute(const std::string &query) override;
@@ -56,6 +115,8 @@ public:
 
   long GetUpdateCount() override;
 
+  bool NextResult(bool *has_result_set) override;
+
   std::shared_ptr<odbcabstraction::ResultSet>
   GetTables_V2(const std::string *catalog_name, const std::string *schema_name,
                const std::string *table_name, const std::string *table_type) override;
@@ -79,6 +140,8 @@ public:
   odbcabstraction::Diagnostics &GetDiagnostics() override;
 
   void Cancel() override;
+
+  bool Reset() override;
 };
 } // namespace flight_sql
 } // namespace driver
@@ -5,18 +5,202 @@
  */
 
 #include "flight_sql_stream_chunk_buffer.h"
+#include "admission_control.h"
+#include "stream_io_pool.h"
 #include "utils.h"
+#include <odbcabstraction/logger.h>
+#include <arrow/record_batch.h>
+#include <arrow/util/byte_size.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 
 namespace driver {
 namespace flight_sql {
 
 using arrow::flight::FlightEndpoint;
+using odbcabstraction::StreamPriority;
+
+/// \brief Bytes a cursor has buffered ahead of its consumer. Bulk cursors charge them
+/// to the pool's prefetch budget.
+struct PrefetchAccount {
+  StreamIoPool &pool;
+  const StreamPriority priority;
+  std::atomic<int64_t> buffered_bytes;
+
+  PrefetchAccount(StreamIoPool &pool, StreamPriority priority)
+      : pool(pool), priority(priority), buffered_bytes(0) {}
+
+  void Add(int64_t bytes) {
+    buffered_bytes += bytes;
+    if (priority == odbcabstraction::StreamPriority_BULK) {
+      pool.AddBulkPrefetchBytes(bytes);
+    }
+  }
+
+  void Release(int64_t bytes) {
+    buffered_bytes -= bytes;
+    if (priority == odbcabstraction::StreamPriority_BULK) {
+      pool.ReleaseBulkPrefetchBytes(bytes);
+    }
+  }
+
+  void Release(const FlightStreamChunk &chunk) {
+    if (chunk.data) {
+      Release(arrow::util::TotalBufferSize(*chunk.data));
+    }
+  }
+};
+
+/// \brief Reads one endpoint stream on the StreamIoPool.
+///
+/// A read is only submitted once the destination queue has room for its result, so
+/// pool threads never wait on a consumer and a cursor that is not being fetched from
+/// holds no thread at all. When the consumer frees room the queue's listener
+/// schedules the next read. Bulk streams that already have data buffered also wait
+/// for the pool's prefetch budget.
+class PooledStreamProducer : public std::enable_shared_from_this<PooledStreamProducer> {
+public:
+  typedef BlockingQueue<Result<FlightStreamChunk>> ChunkQueue;
+
+  PooledStreamProducer(std::shared_ptr<FlightStreamReader> reader,
+                       std::shared_ptr<ChunkQueue> queue,
+                       std::shared_ptr<PrefetchAccount> account)
+      : reader_(std::move(reader)), queue_(std::move(queue)), account_(std::move(account)),
+        reading_(false), finished_(false), waiting_for_budget_(false) {
+    queue_->AddExternalProducer();
+  }
+
+  /// \brief Submits the next read unless one is in flight, the stream is finished,
+  /// the queue is full or, for bulk streams, the prefetch budget is exhausted.
+  void ScheduleRead() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (reading_ || finished_) {
+      return;
+    }
+
+    // A consumer waiting on an empty queue is always served, so a cursor can't be
+    // starved by the data other cursors hold.
+    if (account_->priority == odbcabstraction::StreamPriority_BULK && !queue_->Empty()) {
+      std::function<void()> on_available;
+      if (!waiting_for_budget_) {
+        std::weak_ptr<PooledStreamProducer> weak_self = shared_from_this();
+        on_available = [weak_self] {
+          if (auto self = weak_self.lock()) {
+            self->OnBudgetAvailable();
+          }
+        };
+      }
+      if (!account_->pool.HasBulkPrefetchBudget(on_available)) {
+        waiting_for_budget_ = true;
+        return;
+      }
+    }
+
+    if (!queue_->TryReserve()) {
+      return;
+    }
+    reading_ = true;
+    lock.unlock();
+
+    std::shared_ptr<PooledStreamProducer> self = shared_from_this();
+    account_->pool.Submit(account_->priority, [self] { self->Read(); });
+  }
+
+  /// \brief Cancels the stream and waits for a read in flight to complete.
+  void Stop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    finished_ = true;
+    if (reading_) {
+      reader_->Cancel();
+    }
+    read_done_.wait(lock, [this] { return !reading_; });
+  }
+
+private:
+  std::shared_ptr<FlightStreamReader> reader_;
+  std::shared_ptr<ChunkQueue> queue_;
+  std::shared_ptr<PrefetchAccount> account_;
+
+  std::mutex mutex_;
+  std::condition_variable read_done_;
+  bool reading_;
+  bool finished_;
+  bool waiting_for_budget_;
+
+  void OnBudgetAvailable() {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      waiting_for_budget_ = false;
+    }
+    ScheduleRead();
+  }
+
+  void Read() {
+    bool stopped;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      stopped = finished_;
+    }
+
+    bool end_of_stream = true;
+    if (stopped) {
+      queue_->CancelReservation();
+    } else {
+      const auto start = std::chrono::steady_clock::now();
+      auto result = reader_->Next();
+      const auto read_time = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start);
+
+      end_of_stream = !result.ok() || result.ValueOrDie().data == nullptr;
+      if (!end_of_stream) {
+        const auto &data = result.ValueOrDie().data;
+        const int64_t bytes = arrow::util::TotalBufferSize(*data);
+        account_->pool.RecordRead(account_->priority, data->num_rows(), bytes, read_time);
+        // Charged before the push so the consumer never releases bytes not yet added.
+        account_->Add(bytes);
+      }
+
+      if (!result.ok() || !end_of_stream) {
+        queue_->PushReserved(std::move(result));
+      } else {
+        queue_->CancelReservation();
+      }
+    }
+
+    bool remove_producer = false;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      reading_ = false;
+      if (end_of_stream && !finished_) {
+        finished_ = true;
+        remove_producer = true;
+      }
+    }
+    read_done_.notify_all();
+
+    if (remove_producer) {
+      queue_->RemoveExternalProducer();
+    } else if (!end_of_stream) {
+      ScheduleRead();
+    }
+  }
+};
 
 FlightStreamChunkBuffer::FlightStreamChunkBuffer(FlightSqlClient &flight_sql_client,
                                                  const arrow::flight::FlightCallOptions &call_options,
                                                  const std::shared_ptr<FlightInfo> &flight_info,
-                                                 size_t queue_capacity): queue_(queue_capacity) {
+                                                 size_t queue_capacity,
+                                                 const std::vector<SortKey> &merge_sort_keys,
+                                                 StreamPriority priority,
+                                                 std::shared_ptr<AdmissionPermit> admission_permit)
+    : queue_(std::make_shared<ChunkQueue>(queue_capacity)),
+      account_(std::make_shared<PrefetchAccount>(StreamIoPool::GetInstance(), priority)),
+      admission_permit_(std::move(admission_permit)) {
+  const bool merge = !merge_sort_keys.empty() && flight_info->endpoints().size() > 1;
+  std::vector<SortedBatchMerger::BatchSupplier> merge_inputs;
 
   // FIXME: Endpoint iteration should consider endpoints may be at different hosts
   for (const auto & endpoint : flight_info->endpoints()) {
@@ -26,20 +210,74 @@ FlightStreamChunkBuffer::FlightStreamChunkBuffer(FlightSqlClient &flight_sql_cli
     ThrowIfNotOK(result.status());
     std::shared_ptr<FlightStreamReader> stream_reader_ptr(std::move(result.ValueOrDie()));
 
-    BlockingQueue<Result<FlightStreamChunk>>::Supplier supplier = [=] {
-      auto result = stream_reader_ptr->Next();
-      bool isNotOk = !result.ok();
-      bool isNotEmpty = result.ok() && (result.ValueOrDie().data != nullptr);
+    if (!merge) {
+      producers_.push_back(std::make_shared<PooledStreamProducer>(stream_reader_ptr, queue_, account_));
+      continue;
+    }
 
-      return boost::make_optional(isNotOk || isNotEmpty, std::move(result));
-    };
-    queue_.AddProducer(std::move(supplier));
+    auto endpoint_queue = std::make_shared<ChunkQueue>(queue_capacity);
+    producers_.push_back(std::make_shared<PooledStreamProducer>(stream_reader_ptr, endpoint_queue, account_));
+    std::weak_ptr<PooledStreamProducer> producer = producers_.back();
+    endpoint_queue->SetNotFullListener([producer] {
+      if (auto locked = producer.lock()) {
+        locked->ScheduleRead();
+      }
+    });
+    std::shared_ptr<PrefetchAccount> account = account_;
+    merge_inputs.emplace_back([endpoint_queue, account](std::shared_ptr<arrow::RecordBatch> *batch) {
+      Result<FlightStreamChunk> result;
+      if (!endpoint_queue->Pop(&result)) {
+        return false;
+      }
+      ThrowIfNotOK(result.status());
+      account->Release(result.ValueOrDie());
+      *batch = result.ValueOrDie().data;
+      return *batch != nullptr;
+    });
+    endpoint_queues_.push_back(std::move(endpoint_queue));
+  }
+
+  if (merge) {
+    std::shared_ptr<arrow::Schema> schema;
+    ThrowIfNotOK(flight_info->GetSchema(nullptr, &schema));
+    merger_.reset(new SortedBatchMerger(schema, std::move(merge_inputs), merge_sort_keys));
+  } else {
+    // Endpoints share the queue, any of them may use room freed by the consumer.
+    std::vector<std::weak_ptr<PooledStreamProducer>> producers(producers_.begin(), producers_.end());
+    queue_->SetNotFullListener([producers] {
+      for (const auto &producer : producers) {
+        if (auto locked = producer.lock()) {
+          locked->ScheduleRead();
+        }
+      }
+    });
+  }
+
+  for (const auto &producer : producers_) {
+    producer->ScheduleRead();
   }
 }
 
 bool FlightStreamChunkBuffer::GetNext(FlightStreamChunk *chunk) {
+  if (merger_) {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    try {
+      if (!merger_->Next(&batch)) {
+        admission_permit_.reset();
+        return false;
+      }
+    } catch (...) {
+      Close();
+      throw;
+    }
+    chunk->data = std::move(batch);
+    chunk->app_metadata = nullptr;
+    return true;
+  }
+
   Result<FlightStreamChunk> result;
-  if (!queue_.Pop(&result)) {
+  if (!queue_->Pop(&result)) {
+    admission_permit_.reset();
     return false;
   }
 
@@ -47,16 +285,33 @@ bool FlightStreamChunkBuffer::GetNext(FlightStreamChunk *chunk) {
     Close();
     throw odbcabstraction::DriverException(result.status().message());
   }
+  account_->Release(result.ValueOrDie());
   *chunk = std::move(result.ValueOrDie());
   return chunk->data != nullptr;
 }
 
 void FlightStreamChunkBuffer::Close() {
-  queue_.Close();
+  queue_->Close();
+  for (const auto &endpoint_queue : endpoint_queues_) {
+    endpoint_queue->Close();
+  }
+  for (const auto &producer : producers_) {
+    producer->Stop();
+  }
+  // Chunks left in the queues are dropped with them.
+  account_->Release(account_->buffered_bytes.load());
+  admission_permit_.reset();
 }
 
 FlightStreamChunkBuffer::~FlightStreamChunkBuffer() {
   Close();
+
+  const auto &statistics = account_->pool.GetStatistics(account_->priority);
+  LOG_DEBUG("{} stream reads so far: {} batches, {} rows, {} bytes in {} us, "
+            "waited {} us for I/O threads (max {} us)",
+            account_->priority == odbcabstraction::StreamPriority_BULK ? "Bulk" : "Interactive",
+            statistics.reads, statistics.rows, statistics.bytes, statistics.read_time.count(),
+            statistics.queue_wait_time.count(), statistics.max_queue_wait_time.count());
 }
 
 }
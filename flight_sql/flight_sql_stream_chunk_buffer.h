@@ -6,9 +6,13 @@
 
 #pragma once
 
+#include "sorted_batch_merger.h"
+#include <odbcabstraction/types.h>
 #include <arrow/flight/client.h>
 #include <arrow/flight/sql/client.h>
 #include <odbcabstraction/blocking_queue.h>
+#include <memory>
+#include <vector>
 
 
 namespace driver {
@@ -21,14 +25,40 @@ using arrow::flight::FlightStreamReader;
 using arrow::flight::sql::FlightSqlClient;
 using driver::odbcabstraction::BlockingQueue;
 
+class AdmissionPermit;
+class PooledStreamProducer;
+struct PrefetchAccount;
+
+/// \brief Prefetches the endpoints of a FlightInfo. Endpoint streams are read on the
+/// process-wide StreamIoPool rather than on threads owned by the cursor.
 class FlightStreamChunkBuffer {
-  BlockingQueue<Result<FlightStreamChunk>> queue_;
+  typedef BlockingQueue<Result<FlightStreamChunk>> ChunkQueue;
+
+  std::shared_ptr<ChunkQueue> queue_;
+  /// When merging, each endpoint is prefetched into its own queue and the merger
+  /// pulls from them in sort order.
+  std::vector<std::shared_ptr<ChunkQueue>> endpoint_queues_;
+  std::vector<std::shared_ptr<PooledStreamProducer>> producers_;
+  std::shared_ptr<PrefetchAccount> account_;
+  std::unique_ptr<SortedBatchMerger> merger_;
+  /// Query slot released once the result has been read or the buffer is closed.
+  std::shared_ptr<AdmissionPermit> admission_permit_;
 
 public:
+  /// \param merge_sort_keys keys every endpoint is sorted by. When set and there are
+  ///        several endpoints, chunks are merged into global order instead of being
+  ///        returned in arrival order.
+  /// \param priority StreamPriority_INTERACTIVE or StreamPriority_BULK, the class
+  ///        endpoint reads are scheduled with.
+  /// \param admission_permit query slot held while the result is read, may be null.
   FlightStreamChunkBuffer(FlightSqlClient &flight_sql_client,
                           const arrow::flight::FlightCallOptions &call_options,
                           const std::shared_ptr<FlightInfo> &flight_info,
-                          size_t queue_capacity = 5);
+                          size_t queue_capacity = 5,
+                          const std::vector<SortKey> &merge_sort_keys = std::vector<SortKey>(),
+                          odbcabstraction::StreamPriority priority =
+                              odbcabstraction::StreamPriority_INTERACTIVE,
+                          std::shared_ptr<AdmissionPermit> admission_permit = nullptr);
 
   ~FlightStreamChunkBuffer();
 
@@ -28,6 +28,8 @@ public:
   void SetVersion(std::string version) override;
 
   void RegisterLog() override;
+
+  void SubmitTask(std::function<void()> task) override;
 };
 
 }; // namespace flight_sql
@@ -37,7 +37,61 @@ using driver::odbcabstraction::ResultSet;
 using driver::odbcabstraction::ResultSetMetadata;
 using driver::odbcabstraction::Statement;
 
-Connection::ConnPropertyMap parse_connection_properties(const int argc, char *argv[]) {
+/// Options of the "export" command, which writes the result of a query to a local file.
+struct ExportCommand {
+  bool enabled = false;
+  std::string query;
+  std::string output;
+  size_t format = driver::odbcabstraction::ExportFormat_ARROW_IPC;
+  size_t compression = driver::odbcabstraction::ExportCompression_NONE;
+  size_t row_group_size = 0;
+};
+
+void print_usage(const char *program) {
+  std::cerr << "Usage: " << program << " [export] [options]\n"
+            << "Options:\n"
+            << "  --host, -h <host>           Flight SQL server host\n"
+            << "  --port, -p <port>           Flight SQL server port\n"
+            << "  --user, -u <username>       Username\n"
+            << "  --password, -w <password>   Password\n"
+            << "  --data-plane, -d <name>     Data plane name\n"
+            << "  --cluster, -c <name>        Cluster name\n"
+            << "  --no-encryption, -n         Disable encryption\n"
+            << "  --disable-cert-verify, -k   Disable certificate verification\n"
+            << "Export options:\n"
+            << "  --query, -q <sql>           Query whose result is exported\n"
+            << "  --output, -o <path>         File the result is written to\n"
+            << "  --format, -f <format>       arrow (default) or parquet\n"
+            << "  --compression, -z <codec>   none (default), lz4, zstd or snappy (parquet only)\n"
+            << "  --row-group-size, -g <rows> Maximum rows per Parquet row group\n";
+}
+
+size_t parse_export_format(const std::string &value) {
+  if (value == "arrow" || value == "ipc") {
+    return driver::odbcabstraction::ExportFormat_ARROW_IPC;
+  } else if (value == "parquet") {
+    return driver::odbcabstraction::ExportFormat_PARQUET;
+  }
+  std::cerr << "Unknown export format: " << value << std::endl;
+  exit(1);
+}
+
+size_t parse_export_compression(const std::string &value) {
+  if (value == "none") {
+    return driver::odbcabstraction::ExportCompression_NONE;
+  } else if (value == "lz4") {
+    return driver::odbcabstraction::ExportCompression_LZ4;
+  } else if (value == "zstd") {
+    return driver::odbcabstraction::ExportCompression_ZSTD;
+  } else if (value == "snappy") {
+    return driver::odbcabstraction::ExportCompression_SNAPPY;
+  }
+  std::cerr << "Unknown export compression: " << value << std::endl;
+  exit(1);
+}
+
+Connection::ConnPropertyMap parse_connection_properties(const int argc, char *argv[],
+                                                        ExportCommand &export_command) {
   // Default values
   Connection::ConnPropertyMap properties = {
           {FlightSqlConnection::HOST, std::string("localhost")},
@@ -49,9 +103,16 @@ Connection::ConnPropertyMap parse_connection_properties(const int argc, char *ar
           {"data_plane", "spark-resources"},
           {"cluster", "arrow"}};
 
+  // The command, if any, comes before the options.
+  int first_option = 1;
+  if (argc > 1 && std::string(argv[1]) == "export") {
+    export_command.enabled = true;
+    first_option = 2;
+  }
+
 #ifdef _WIN32
   // Simple argument parsing for Windows
-  for (int i = 1; i < argc; i++) {
+  for (int i = first_option; i < argc; i++) {
     std::string arg = argv[i];
 
     if (arg == "--host" || arg == "-h") {
@@ -76,17 +137,23 @@ Connection::ConnPropertyMap parse_connection_properties(const int argc, char *ar
       properties[FlightSqlConnection::USE_ENCRYPTION] = "false";
     } else if (arg == "--disable-cert-verify" || arg == "-k") {
       properties[FlightSqlConnection::DISABLE_CERTIFICATE_VERIFICATION] = "true";
+    } else if (arg == "--query" || arg == "-q") {
+      if (i + 1 < argc)
+        export_command.query = argv[++i];
+    } else if (arg == "--output" || arg == "-o") {
+      if (i + 1 < argc)
+        export_command.output = argv[++i];
+    } else if (arg == "--format" || arg == "-f") {
+      if (i + 1 < argc)
+        export_command.format = parse_export_format(argv[++i]);
+    } else if (arg == "--compression" || arg == "-z") {
+      if (i + 1 < argc)
+        export_command.compression = parse_export_compression(argv[++i]);
+    } else if (arg == "--row-group-size" || arg == "-g") {
+      if (i + 1 < argc)
+        export_command.row_group_size = std::stoul(argv[++i]);
     } else {
-      std::cerr << "Usage: " << argv[0] << " [options]\n"
-                << "Options:\n"
-                << "  --host, -h <host>           Flight SQL server host\n"
-                << "  --port, -p <port>           Flight SQL server port\n"
-                << "  --user, -u <username>       Username\n"
-                << "  --password, -w <password>   Password\n"
-                << "  --data-plane, -d <name>     Data plane name\n"
-                << "  --cluster, -c <name>        Cluster name\n"
-                << "  --no-encryption, -n         Disable encryption\n"
-                << "  --disable-cert-verify, -k   Disable certificate verification\n";
+      print_usage(argv[0]);
       exit(1);
     }
   }
@@ -100,11 +167,17 @@ Connection::ConnPropertyMap parse_connection_properties(const int argc, char *ar
                                          {"cluster", required_argument, 0, 'c'},
                                          {"no-encryption", no_argument, 0, 'n'},
                                          {"disable-cert-verify", no_argument, 0, 'k'},
+                                         {"query", required_argument, 0, 'q'},
+                                         {"output", required_argument, 0, 'o'},
+                                         {"format", required_argument, 0, 'f'},
+                                         {"compression", required_argument, 0, 'z'},
+                                         {"row-group-size", required_argument, 0, 'g'},
                                          {0, 0, 0, 0}};
 
   int opt;
   int option_index = 0;
-  while ((opt = getopt_long(argc, argv, "h:p:u:w:d:c:nk", long_options, &option_index)) != -1) {
+  optind = first_option;
+  while ((opt = getopt_long(argc, argv, "h:p:u:w:d:c:nkq:o:f:z:g:", long_options, &option_index)) != -1) {
     switch (opt) {
       case 'h':
         properties[FlightSqlConnection::HOST] = std::string(optarg);
@@ -130,22 +203,33 @@ Connection::ConnPropertyMap parse_connection_properties(const int argc, char *ar
       case 'k':
         properties[FlightSqlConnection::DISABLE_CERTIFICATE_VERIFICATION] = std::string("true");
         break;
+      case 'q':
+        export_command.query = std::string(optarg);
+        break;
+      case 'o':
+        export_command.output = std::string(optarg);
+        break;
+      case 'f':
+        export_command.format = parse_export_format(optarg);
+        break;
+      case 'z':
+        export_command.compression = parse_export_compression(optarg);
+        break;
+      case 'g':
+        export_command.row_group_size = std::stoul(optarg);
+        break;
       default:
-        std::cerr << "Usage: " << argv[0] << " [options]\n"
-                  << "Options:\n"
-                  << "  --host, -h <host>           Flight SQL server host\n"
-                  << "  --port, -p <port>           Flight SQL server port\n"
-                  << "  --user, -u <username>       Username\n"
-                  << "  --password, -w <password>   Password\n"
-                  << "  --data-plane, -d <name>     Data plane name\n"
-                  << "  --cluster, -c <name>        Cluster name\n"
-                  << "  --no-encryption, -n         Disable encryption\n"
-                  << "  --disable-cert-verify, -k   Disable certificate verification\n";
+        print_usage(argv[0]);
         exit(1);
     }
   }
 #endif
 
+  if (export_command.enabled && (export_command.query.empty() || export_command.output.empty())) {
+    print_usage(argv[0]);
+    exit(1);
+  }
+
   return properties;
 }
 
@@ -337,19 +421,36 @@ void TestGetColumnsV3(const std::shared_ptr<Connection> &connection) {
   std::cout << column_count << std::endl;
 }
 
+void RunExport(const std::shared_ptr<Connection> &connection, const ExportCommand &command) {
+  const std::shared_ptr<Statement> statement = connection->CreateStatement();
+  statement->SetAttribute(Statement::EXPORT_PATH, command.output);
+  statement->SetAttribute(Statement::EXPORT_FORMAT, command.format);
+  statement->SetAttribute(Statement::EXPORT_COMPRESSION, command.compression);
+  statement->SetAttribute(Statement::EXPORT_ROW_GROUP_SIZE, command.row_group_size);
+
+  statement->Execute(command.query);
+
+  std::cout << "Exported " << statement->GetUpdateCount() << " rows to " << command.output << std::endl;
+}
+
 int main(const int argc, char *argv[]) {
   FlightSqlDriver driver;
 
   const std::shared_ptr<Connection> &connection = driver.CreateConnection(driver::odbcabstraction::V_3);
 
-  const Connection::ConnPropertyMap properties = parse_connection_properties(argc, argv);
+  ExportCommand export_command;
+  const Connection::ConnPropertyMap properties = parse_connection_properties(argc, argv, export_command);
 
   std::vector<std::string> missing_attr;
   connection->Connect(properties, missing_attr);
 
-  TestInitialGetTablesCall(connection);
-  TestGetTablesV3(connection);
-  TestGetColumnsV3(connection);
+  if (export_command.enabled) {
+    RunExport(connection, export_command);
+  } else {
+    TestInitialGetTablesCall(connection);
+    TestGetTablesV3(connection);
+    TestGetColumnsV3(connection);
+  }
 
   connection->Close();
   return 0;
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#pragma once
+
+#include "stream_io_pool.h"
+
+#include <odbcabstraction/exceptions.h>
+#include <odbcabstraction/spi/connection.h>
+#include <odbcabstraction/spi/driver.h>
+#include <odbcabstraction/spi/statement.h>
+
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace driver {
+namespace flight_sql {
+
+/// \brief Records the parameter values written to a MockStatement.
+class MockParameterWriter : public odbcabstraction::ParameterWriter {
+public:
+  explicit MockParameterWriter(size_t parameter_count) : values(parameter_count) {}
+
+  void Append(size_t index, const void *data, size_t length) override {
+    if (!values.at(index)) {
+      values[index] = std::string();
+    }
+    values[index]->append(static_cast<const char *>(data), length);
+    ++appends;
+  }
+
+  void SetNull(size_t index) override { values.at(index) = boost::none; }
+
+  std::vector<boost::optional<std::string>> values;
+  int64_t appends = 0;
+};
+
+/// \brief In-memory SPI implementation for testing the ODBC handle layer without a
+/// Flight SQL server.
+class MockStatement : public odbcabstraction::Statement {
+public:
+  explicit MockStatement(int64_t &resets)
+      : diagnostics_("Mock", "Mock", odbcabstraction::V_3), resets_(resets) {}
+
+  bool SetAttribute(StatementAttributeId attribute, const Attribute &value) override {
+    attribute_[attribute] = value;
+    return true;
+  }
+
+  boost::optional<Attribute> GetAttribute(StatementAttributeId attribute) override {
+    const auto &it = attribute_.find(attribute);
+    if (it == attribute_.end()) {
+      return boost::none;
+    }
+    return it->second;
+  }
+
+  boost::optional<std::shared_ptr<odbcabstraction::ResultSetMetadata>> Prepare(const std::string &query) override {
+    return boost::none;
+  }
+
+  odbcabstraction::ParameterWriter &
+  BeginParameters(const std::vector<odbcabstraction::ParameterType> &types) override {
+    parameter_types = types;
+    parameter_writer.reset(new MockParameterWriter(types.size()));
+    return *parameter_writer;
+  }
+
+  bool ExecutePrepared() override {
+    ++prepared_executions;
+    return false;
+  }
+
+  bool Execute(const std::string &query) override { return false; }
+
+  std::shared_ptr<odbcabstraction::ResultSet> GetResultSet() override { return nullptr; }
+
+  long GetUpdateCount() override { return -1; }
+
+  std::shared_ptr<odbcabstraction::ResultSet> GetTables_V2(const std::string *, const std::string *,
+                                          const std::string *, const std::string *) override {
+    return nullptr;
+  }
+
+  std::shared_ptr<odbcabstraction::ResultSet> GetTables_V3(const std::string *, const std::string *,
+                                          const std::string *, const std::string *) override {
+    return nullptr;
+  }
+
+  std::shared_ptr<odbcabstraction::ResultSet> GetColumns_V2(const std::string *, const std::string *,
+                                           const std::string *, const std::string *) override {
+    return nullptr;
+  }
+
+  std::shared_ptr<odbcabstraction::ResultSet> GetColumns_V3(const std::string *, const std::string *,
+                                           const std::string *, const std::string *) override {
+    return nullptr;
+  }
+
+  std::shared_ptr<odbcabstraction::ResultSet> GetTypeInfo_V2(int16_t data_type) override { return nullptr; }
+
+  std::shared_ptr<odbcabstraction::ResultSet> GetTypeInfo_V3(int16_t data_type) override { return nullptr; }
+
+  odbcabstraction::Diagnostics &GetDiagnostics() override { return diagnostics_; }
+
+  void Cancel() override {}
+
+  bool Reset() override {
+    attribute_.clear();
+    ++resets_;
+    return true;
+  }
+
+  std::vector<odbcabstraction::ParameterType> parameter_types;
+  std::unique_ptr<MockParameterWriter> parameter_writer;
+  int64_t prepared_executions = 0;
+
+private:
+  odbcabstraction::Diagnostics diagnostics_;
+  std::map<StatementAttributeId, Attribute> attribute_;
+  int64_t &resets_;
+};
+
+class MockConnection : public odbcabstraction::Connection {
+public:
+  explicit MockConnection(odbcabstraction::OdbcVersion odbc_version = odbcabstraction::V_3)
+      : diagnostics_("Mock", "Mock", odbc_version) {}
+
+  void Connect(const ConnPropertyMap &properties, std::vector<std::string> &missing_attr) override {
+    WaitForGate();
+    if (properties.count("missing")) {
+      missing_attr.push_back(properties.at("missing"));
+      throw odbcabstraction::DriverException("Missing property", "28000");
+    }
+    ++connects;
+  }
+
+  void Close() override {
+    WaitForGate();
+    ++closes;
+  }
+
+  std::shared_ptr<odbcabstraction::Statement> CreateStatement() override {
+    ++created_statements;
+    last_statement = std::make_shared<MockStatement>(reset_statements);
+    return last_statement;
+  }
+
+  bool SetAttribute(AttributeId attribute, const Attribute &value) override {
+    attribute_[attribute] = value;
+    return true;
+  }
+
+  boost::optional<Attribute> GetAttribute(AttributeId attribute) override {
+    const auto &it = attribute_.find(attribute);
+    if (it == attribute_.end()) {
+      return boost::none;
+    }
+    return it->second;
+  }
+
+  Info GetInfo(uint16_t info_type) override { return static_cast<uint32_t>(0); }
+
+  odbcabstraction::Diagnostics &GetDiagnostics() override { return diagnostics_; }
+
+  bool Reset() override {
+    attribute_.clear();
+    ++resets;
+    return reusable;
+  }
+
+  bool IsAlive() override {
+    ++health_checks;
+    return alive;
+  }
+
+  /// When valid, Connect and Close block until it is ready.
+  std::shared_future<void> gate;
+  int64_t connects = 0;
+  int64_t closes = 0;
+  int64_t created_statements = 0;
+  int64_t reset_statements = 0;
+  std::shared_ptr<MockStatement> last_statement;
+  /// Results of Reset and IsAlive.
+  bool reusable = true;
+  bool alive = true;
+  int64_t resets = 0;
+  int64_t health_checks = 0;
+
+private:
+  void WaitForGate() {
+    if (gate.valid()) {
+      gate.wait();
+    }
+  }
+
+  odbcabstraction::Diagnostics diagnostics_;
+  std::map<AttributeId, Attribute> attribute_;
+};
+
+class MockDriver : public odbcabstraction::Driver {
+public:
+  MockDriver() : diagnostics_("Mock", "Mock", odbcabstraction::V_3) {}
+
+  std::shared_ptr<odbcabstraction::Connection> CreateConnection(odbcabstraction::OdbcVersion odbc_version) override {
+    last_connection = std::make_shared<MockConnection>(odbc_version);
+    return last_connection;
+  }
+
+  odbcabstraction::Diagnostics &GetDiagnostics() override { return diagnostics_; }
+
+  void SetVersion(std::string version) override {}
+
+  void RegisterLog() override {}
+
+  void SubmitTask(std::function<void()> task) override {
+    ++submitted_tasks;
+    tasks_.Submit(odbcabstraction::StreamPriority_INTERACTIVE, std::move(task));
+  }
+
+  std::shared_ptr<MockConnection> last_connection;
+  int64_t submitted_tasks = 0;
+
+private:
+  odbcabstraction::Diagnostics diagnostics_;
+  StreamIoPool tasks_{1};
+};
+
+} // namespace flight_sql
+} // namespace driver
@@ -19,83 +19,98 @@ namespace flight_sql {
 // based on Calcite's SqlJdbcFunctionCall class.
 
 namespace {
-static const std::unordered_map<std::string, uint32_t> numeric_functions = {
-    {"ABS", SQL_FN_NUM_ABS},         {"ACOS", SQL_FN_NUM_ACOS},
-    {"ASIN", SQL_FN_NUM_ASIN},       {"ATAN", SQL_FN_NUM_ATAN},
-    {"ATAN2", SQL_FN_NUM_ATAN2},     {"CEILING", SQL_FN_NUM_CEILING},
-    {"COS", SQL_FN_NUM_ACOS},        {"COT", SQL_FN_NUM_COT},
-    {"DEGREES", SQL_FN_NUM_DEGREES}, {"EXP", SQL_FN_NUM_EXP},
-    {"FLOOR", SQL_FN_NUM_FLOOR},     {"LOG", SQL_FN_NUM_LOG},
-    {"LOG10", SQL_FN_NUM_LOG10},     {"MOD", SQL_FN_NUM_MOD},
-    {"PI", SQL_FN_NUM_PI},           {"POWER", SQL_FN_NUM_POWER},
-    {"RADIANS", SQL_FN_NUM_RADIANS}, {"RAND", SQL_FN_NUM_RAND},
-    {"ROUND", SQL_FN_NUM_ROUND},     {"SIGN", SQL_FN_NUM_SIGN},
-    {"SIN", SQL_FN_NUM_SIN},         {"SQRT", SQL_FN_NUM_SQRT},
-    {"TAN", SQL_FN_NUM_TAN},         {"TRUNCATE", SQL_FN_NUM_TRUNCATE}};
+// The tables are built on first use rather than while the driver library loads.
+typedef std::unordered_map<std::string, uint32_t> FunctionMap;
 
-static const std::unordered_map<std::string, uint32_t> system_functions = {
-    {"DATABASE", SQL_FN_SYS_DBNAME},
-    {"IFNULL", SQL_FN_SYS_IFNULL},
-    {"USER", SQL_FN_SYS_USERNAME}};
+const FunctionMap &NumericFunctions() {
+  static const FunctionMap functions = {
+      {"ABS", SQL_FN_NUM_ABS},         {"ACOS", SQL_FN_NUM_ACOS},
+      {"ASIN", SQL_FN_NUM_ASIN},       {"ATAN", SQL_FN_NUM_ATAN},
+      {"ATAN2", SQL_FN_NUM_ATAN2},     {"CEILING", SQL_FN_NUM_CEILING},
+      {"COS", SQL_FN_NUM_ACOS},        {"COT", SQL_FN_NUM_COT},
+      {"DEGREES", SQL_FN_NUM_DEGREES}, {"EXP", SQL_FN_NUM_EXP},
+      {"FLOOR", SQL_FN_NUM_FLOOR},     {"LOG", SQL_FN_NUM_LOG},
+      {"LOG10", SQL_FN_NUM_LOG10},     {"MOD", SQL_FN_NUM_MOD},
+      {"PI", SQL_FN_NUM_PI},           {"POWER", SQL_FN_NUM_POWER},
+      {"RADIANS", SQL_FN_NUM_RADIANS}, {"RAND", SQL_FN_NUM_RAND},
+      {"ROUND", SQL_FN_NUM_ROUND},     {"SIGN", SQL_FN_NUM_SIGN},
+      {"SIN", SQL_FN_NUM_SIN},         {"SQRT", SQL_FN_NUM_SQRT},
+      {"TAN", SQL_FN_NUM_TAN},         {"TRUNCATE", SQL_FN_NUM_TRUNCATE}};
+  return functions;
+}
 
-static const std::unordered_map<std::string, uint32_t> datetime_functions = {
-    {"CURDATE", SQL_FN_TD_CURDATE},
-    {"CURTIME", SQL_FN_TD_CURTIME},
-    {"DAYNAME", SQL_FN_TD_DAYNAME},
-    {"DAYOFMONTH", SQL_FN_TD_DAYOFMONTH},
-    {"DAYOFWEEK", SQL_FN_TD_DAYOFWEEK},
-    {"DAYOFYEAR", SQL_FN_TD_DAYOFYEAR},
-    {"HOUR", SQL_FN_TD_HOUR},
-    {"MINUTE", SQL_FN_TD_MINUTE},
-    {"MONTH", SQL_FN_TD_MONTH},
-    {"MONTHNAME", SQL_FN_TD_MONTHNAME},
-    {"NOW", SQL_FN_TD_NOW},
-    {"QUARTER", SQL_FN_TD_QUARTER},
-    {"SECOND", SQL_FN_TD_SECOND},
-    {"TIMESTAMPADD", SQL_FN_TD_TIMESTAMPADD},
-    {"TIMESTAMPDIFF", SQL_FN_TD_TIMESTAMPDIFF},
-    {"WEEK", SQL_FN_TD_WEEK},
-    {"YEAR", SQL_FN_TD_YEAR},
-    // Additional functions in ODBC but not Calcite:
-    {"CURRENT_DATE", SQL_FN_TD_CURRENT_DATE},
-    {"CURRENT_TIME", SQL_FN_TD_CURRENT_TIME},
-    {"CURRENT_TIMESTAMP", SQL_FN_TD_CURRENT_TIMESTAMP},
-    {"EXTRACT", SQL_FN_TD_EXTRACT}};
+const FunctionMap &SystemFunctions() {
+  static const FunctionMap functions = {
+      {"DATABASE", SQL_FN_SYS_DBNAME},
+      {"IFNULL", SQL_FN_SYS_IFNULL},
+      {"USER", SQL_FN_SYS_USERNAME}};
+  return functions;
+}
 
-static const std::unordered_map<std::string, uint32_t> string_functions = {
-    {"ASCII", SQL_FN_STR_ASCII},
-    {"CHAR", SQL_FN_STR_CHAR},
-    {"CONCAT", SQL_FN_STR_CONCAT},
-    {"DIFFERENCE", SQL_FN_STR_DIFFERENCE},
-    {"INSERT", SQL_FN_STR_INSERT},
-    {"LCASE", SQL_FN_STR_LCASE},
-    {"LEFT", SQL_FN_STR_LEFT},
-    {"LENGTH", SQL_FN_STR_LENGTH},
-    {"LOCATE", SQL_FN_STR_LOCATE},
-    {"LTRIM", SQL_FN_STR_LTRIM},
-    {"REPEAT", SQL_FN_STR_REPEAT},
-    {"REPLACE", SQL_FN_STR_REPLACE},
-    {"RIGHT", SQL_FN_STR_RIGHT},
-    {"RTRIM", SQL_FN_STR_RTRIM},
-    {"SOUNDEX", SQL_FN_STR_SOUNDEX},
-    {"SPACE", SQL_FN_STR_SPACE},
-    {"SUBSTRING", SQL_FN_STR_SUBSTRING},
-    {"UCASE", SQL_FN_STR_UCASE},
-    // Additional functions in ODBC but not Calcite:
-    {"LOCATE_2", SQL_FN_STR_LOCATE_2},
-    {"BIT_LENGTH", SQL_FN_STR_BIT_LENGTH},
-    {"CHAR_LENGTH", SQL_FN_STR_CHAR_LENGTH},
-    {"CHARACTER_LENGTH", SQL_FN_STR_CHARACTER_LENGTH},
-    {"OCTET_LENGTH", SQL_FN_STR_OCTET_LENGTH},
-    {"POSTION", SQL_FN_STR_POSITION},
-    {"SOUNDEX", SQL_FN_STR_SOUNDEX}};
+const FunctionMap &DatetimeFunctions() {
+  static const FunctionMap functions = {
+      {"CURDATE", SQL_FN_TD_CURDATE},
+      {"CURTIME", SQL_FN_TD_CURTIME},
+      {"DAYNAME", SQL_FN_TD_DAYNAME},
+      {"DAYOFMONTH", SQL_FN_TD_DAYOFMONTH},
+      {"DAYOFWEEK", SQL_FN_TD_DAYOFWEEK},
+      {"DAYOFYEAR", SQL_FN_TD_DAYOFYEAR},
+      {"HOUR", SQL_FN_TD_HOUR},
+      {"MINUTE", SQL_FN_TD_MINUTE},
+      {"MONTH", SQL_FN_TD_MONTH},
+      {"MONTHNAME", SQL_FN_TD_MONTHNAME},
+      {"NOW", SQL_FN_TD_NOW},
+      {"QUARTER", SQL_FN_TD_QUARTER},
+      {"SECOND", SQL_FN_TD_SECOND},
+      {"TIMESTAMPADD", SQL_FN_TD_TIMESTAMPADD},
+      {"TIMESTAMPDIFF", SQL_FN_TD_TIMESTAMPDIFF},
+      {"WEEK", SQL_FN_TD_WEEK},
+      {"YEAR", SQL_FN_TD_YEAR},
+      // Additional functions in ODBC but not Calcite:
+      {"CURRENT_DATE", SQL_FN_TD_CURRENT_DATE},
+      {"CURRENT_TIME", SQL_FN_TD_CURRENT_TIME},
+      {"CURRENT_TIMESTAMP", SQL_FN_TD_CURRENT_TIMESTAMP},
+      {"EXTRACT", SQL_FN_TD_EXTRACT}};
+  return functions;
+}
+
+const FunctionMap &StringFunctions() {
+  static const FunctionMap functions = {
+      {"ASCII", SQL_FN_STR_ASCII},
+      {"CHAR", SQL_FN_STR_CHAR},
+      {"CONCAT", SQL_FN_STR_CONCAT},
+      {"DIFFERENCE", SQL_FN_STR_DIFFERENCE},
+      {"INSERT", SQL_FN_STR_INSERT},
+      {"LCASE", SQL_FN_STR_LCASE},
+      {"LEFT", SQL_FN_STR_LEFT},
+      {"LENGTH", SQL_FN_STR_LENGTH},
+      {"LOCATE", SQL_FN_STR_LOCATE},
+      {"LTRIM", SQL_FN_STR_LTRIM},
+      {"REPEAT", SQL_FN_STR_REPEAT},
+      {"REPLACE", SQL_FN_STR_REPLACE},
+      {"RIGHT", SQL_FN_STR_RIGHT},
+      {"RTRIM", SQL_FN_STR_RTRIM},
+      {"SOUNDEX", SQL_FN_STR_SOUNDEX},
+      {"SPACE", SQL_FN_STR_SPACE},
+      {"SUBSTRING", SQL_FN_STR_SUBSTRING},
+      {"UCASE", SQL_FN_STR_UCASE},
+      // Additional functions in ODBC but not Calcite:
+      {"LOCATE_2", SQL_FN_STR_LOCATE_2},
+      {"BIT_LENGTH", SQL_FN_STR_BIT_LENGTH},
+      {"CHAR_LENGTH", SQL_FN_STR_CHAR_LENGTH},
+      {"CHARACTER_LENGTH", SQL_FN_STR_CHARACTER_LENGTH},
+      {"OCTET_LENGTH", SQL_FN_STR_OCTET_LENGTH},
+      {"POSTION", SQL_FN_STR_POSITION},
+      {"SOUNDEX", SQL_FN_STR_SOUNDEX}};
+  return functions;
+}
 } // namespace
 
 void ReportSystemFunction(const std::string &function,
                           uint32_t &current_sys_functions,
                           uint32_t &current_convert_functions) {
-  const auto &result = system_functions.find(function);
-  if (result != system_functions.end()) {
+  const auto &result = SystemFunctions().find(function);
+  if (result != SystemFunctions().end()) {
     current_sys_functions |= result->second;
   } else if (function == "CONVERT") {
     // CAST and CONVERT are system functions from FlightSql/Calcite, but are
@@ -107,24 +122,24 @@ void ReportSystemFunction(const std::string &function,
 
 void ReportNumericFunction(const std::string &function,
                            uint32_t &current_functions) {
-  const auto &result = numeric_functions.find(function);
-  if (result != numeric_functions.end()) {
+  const auto &result = NumericFunctions().find(function);
+  if (result != NumericFunctions().end()) {
     current_functions |= result->second;
   }
 }
 
 void ReportStringFunction(const std::string &function,
                           uint32_t &current_functions) {
-  const auto &result = string_functions.find(function);
-  if (result != string_functions.end()) {
+  const auto &result = StringFunctions().find(function);
+  if (result != StringFunctions().end()) {
     current_functions |= result->second;
   }
 }
 
 void ReportDatetimeFunction(const std::string &function,
                             uint32_t &current_functions) {
-  const auto &result = datetime_functions.find(function);
-  if (result != datetime_functions.end()) {
+  const auto &result = DatetimeFunctions().find(function);
+  if (result != DatetimeFunctions().end()) {
     current_functions |= result->second;
   }
 }
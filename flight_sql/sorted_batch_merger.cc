@@ -0,0 +1,342 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "sorted_batch_merger.h"
+
+#include "utils.h"
+#include <arrow/array.h>
+#include <arrow/array/concatenate.h>
+#include <arrow/record_batch.h>
+#include <arrow/util/decimal.h>
+#include <boost/algorithm/string/predicate.hpp>
+#include <odbcabstraction/exceptions.h>
+#include <algorithm>
+#include <sstream>
+
+namespace driver {
+namespace flight_sql {
+
+using arrow::Array;
+using arrow::RecordBatch;
+using odbcabstraction::DriverException;
+
+namespace {
+
+template <typename T>
+int CompareOrdered(const T &left_value, const T &right_value) {
+  return left_value < right_value ? -1 : (right_value < left_value ? 1 : 0);
+}
+
+template <typename C_TYPE>
+int ComparePrimitives(const Array &left, int64_t left_row, const Array &right, int64_t right_row) {
+  return CompareOrdered(left.data()->GetValues<C_TYPE>(1)[left_row],
+                        right.data()->GetValues<C_TYPE>(1)[right_row]);
+}
+
+int CompareBooleans(const Array &left, int64_t left_row, const Array &right, int64_t right_row) {
+  return CompareOrdered(static_cast<const arrow::BooleanArray &>(left).Value(left_row),
+                        static_cast<const arrow::BooleanArray &>(right).Value(right_row));
+}
+
+template <typename ARRAY_TYPE>
+int CompareViews(const Array &left, int64_t left_row, const Array &right, int64_t right_row) {
+  return static_cast<const ARRAY_TYPE &>(left).GetView(left_row).compare(
+      static_cast<const ARRAY_TYPE &>(right).GetView(right_row));
+}
+
+int CompareDecimal128(const Array &left, int64_t left_row, const Array &right, int64_t right_row) {
+  return CompareOrdered(
+      arrow::Decimal128(static_cast<const arrow::Decimal128Array &>(left).GetValue(left_row)),
+      arrow::Decimal128(static_cast<const arrow::Decimal128Array &>(right).GetValue(right_row)));
+}
+
+typedef int (*CompareFunction)(const Array &, int64_t, const Array &, int64_t);
+
+CompareFunction GetCompareFunction(const arrow::DataType &type) {
+  switch (type.id()) {
+    case arrow::Type::BOOL:
+      return CompareBooleans;
+    case arrow::Type::INT8:
+      return ComparePrimitives<int8_t>;
+    case arrow::Type::INT16:
+      return ComparePrimitives<int16_t>;
+    case arrow::Type::INT32:
+    case arrow::Type::DATE32:
+    case arrow::Type::TIME32:
+      return ComparePrimitives<int32_t>;
+    case arrow::Type::INT64:
+    case arrow::Type::DATE64:
+    case arrow::Type::TIME64:
+    case arrow::Type::TIMESTAMP:
+    case arrow::Type::DURATION:
+      return ComparePrimitives<int64_t>;
+    case arrow::Type::UINT8:
+      return ComparePrimitives<uint8_t>;
+    case arrow::Type::UINT16:
+      return ComparePrimitives<uint16_t>;
+    case arrow::Type::UINT32:
+      return ComparePrimitives<uint32_t>;
+    case arrow::Type::UINT64:
+      return ComparePrimitives<uint64_t>;
+    case arrow::Type::FLOAT:
+      return ComparePrimitives<float>;
+    case arrow::Type::DOUBLE:
+      return ComparePrimitives<double>;
+    case arrow::Type::STRING:
+    case arrow::Type::BINARY:
+      return CompareViews<arrow::BinaryArray>;
+    case arrow::Type::LARGE_STRING:
+    case arrow::Type::LARGE_BINARY:
+      return CompareViews<arrow::LargeBinaryArray>;
+    case arrow::Type::FIXED_SIZE_BINARY:
+      return CompareViews<arrow::FixedSizeBinaryArray>;
+    case arrow::Type::DECIMAL128:
+      return CompareDecimal128;
+    default:
+      throw DriverException("Unsupported sort key type: " + type.ToString(), "HYC00");
+  }
+}
+
+int FindColumn(const arrow::Schema &schema, const std::string &name) {
+  int index = schema.GetFieldIndex(name);
+  if (index >= 0) {
+    return index;
+  }
+
+  for (int i = 0; i < schema.num_fields(); ++i) {
+    if (boost::iequals(schema.field(i)->name(), name)) {
+      return i;
+    }
+  }
+  throw DriverException("Unknown sort key column: " + name, "42S22");
+}
+
+} // namespace
+
+std::vector<SortKey> ParseSortKeys(const std::string &sort_keys, const arrow::Schema &schema) {
+  std::vector<SortKey> result;
+
+  size_t pos = 0;
+  while (pos < sort_keys.size()) {
+    while (pos < sort_keys.size() && isspace(static_cast<unsigned char>(sort_keys[pos]))) {
+      ++pos;
+    }
+    if (pos == sort_keys.size()) {
+      break;
+    }
+
+    std::string name;
+    if (sort_keys[pos] == '"') {
+      size_t end = sort_keys.find('"', pos + 1);
+      if (end == std::string::npos) {
+        throw DriverException("Unterminated quoted sort key: " + sort_keys, "HY024");
+      }
+      name = sort_keys.substr(pos + 1, end - pos - 1);
+      pos = end + 1;
+    } else {
+      size_t end = sort_keys.find_first_of(", \t", pos);
+      end = end == std::string::npos ? sort_keys.size() : end;
+      name = sort_keys.substr(pos, end - pos);
+      pos = end;
+    }
+
+    size_t end = sort_keys.find(',', pos);
+    end = end == std::string::npos ? sort_keys.size() : end;
+    std::istringstream modifiers(sort_keys.substr(pos, end - pos));
+    pos = end + 1;
+
+    SortKey key{FindColumn(schema, name), true, false};
+    bool has_null_order = false;
+    std::string word;
+    while (modifiers >> word) {
+      if (boost::iequals(word, "ASC")) {
+        key.ascending = true;
+      } else if (boost::iequals(word, "DESC")) {
+        key.ascending = false;
+      } else if (boost::iequals(word, "NULLS") && modifiers >> word &&
+                 (boost::iequals(word, "FIRST") || boost::iequals(word, "LAST"))) {
+        key.nulls_first = boost::iequals(word, "FIRST");
+        has_null_order = true;
+      } else {
+        throw DriverException("Invalid sort key: " + sort_keys, "HY024");
+      }
+    }
+    if (!has_null_order) {
+      key.nulls_first = !key.ascending;
+    }
+    result.push_back(key);
+  }
+
+  return result;
+}
+
+SortedBatchMerger::SortedBatchMerger(std::shared_ptr<arrow::Schema> schema,
+                                     std::vector<BatchSupplier> inputs,
+                                     std::vector<SortKey> sort_keys,
+                                     int64_t max_batch_rows)
+    : schema_(std::move(schema)), sort_keys_(std::move(sort_keys)),
+      max_batch_rows_(max_batch_rows), started_(false) {
+  for (const auto &key : sort_keys_) {
+    compare_functions_.push_back(GetCompareFunction(*schema_->field(key.column)->type()));
+  }
+
+  cursors_.resize(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    cursors_[i].supplier = std::move(inputs[i]);
+    cursors_[i].row = 0;
+    cursors_[i].exhausted = false;
+  }
+  tree_.resize(std::max<size_t>(cursors_.size(), 1));
+}
+
+SortedBatchMerger::~SortedBatchMerger() = default;
+
+void SortedBatchMerger::LoadNextBatch(Cursor &cursor) {
+  cursor.row = 0;
+  cursor.keys.clear();
+  while (cursor.supplier(&cursor.batch)) {
+    if (cursor.batch->num_rows() > 0) {
+      for (const auto &key : sort_keys_) {
+        cursor.keys.push_back(cursor.batch->column(key.column));
+      }
+      return;
+    }
+  }
+  cursor.batch.reset();
+  cursor.exhausted = true;
+}
+
+bool SortedBatchMerger::Less(size_t left, size_t right) const {
+  const Cursor &a = cursors_[left];
+  const Cursor &b = cursors_[right];
+  // Exhausted cursors lose every match, ties are broken by input order.
+  if (a.exhausted || b.exhausted) {
+    return a.exhausted == b.exhausted ? left < right : b.exhausted;
+  }
+
+  for (size_t k = 0; k < sort_keys_.size(); ++k) {
+    const Array &left_keys = *a.keys[k];
+    const Array &right_keys = *b.keys[k];
+    const bool left_null = left_keys.IsNull(a.row);
+    const bool right_null = right_keys.IsNull(b.row);
+
+    if (left_null || right_null) {
+      if (left_null && right_null) {
+        continue;
+      }
+      // Null placement does not depend on the direction of the key.
+      return left_null == sort_keys_[k].nulls_first;
+    }
+
+    const int result = compare_functions_[k](left_keys, a.row, right_keys, b.row);
+    if (result != 0) {
+      return sort_keys_[k].ascending ? result < 0 : result > 0;
+    }
+  }
+
+  return left < right;
+}
+
+void SortedBatchMerger::BuildTree() {
+  const size_t k = cursors_.size();
+  if (k == 1) {
+    tree_[0] = 0;
+    return;
+  }
+
+  std::vector<size_t> winners(2 * k);
+  for (size_t i = 0; i < k; ++i) {
+    winners[k + i] = i;
+  }
+  for (size_t node = k - 1; node > 0; --node) {
+    const size_t left = winners[2 * node];
+    const size_t right = winners[2 * node + 1];
+    if (Less(left, right)) {
+      winners[node] = left;
+      tree_[node] = right;
+    } else {
+      winners[node] = right;
+      tree_[node] = left;
+    }
+  }
+  tree_[0] = winners[1];
+}
+
+void SortedBatchMerger::Replay(size_t cursor) {
+  size_t winner = cursor;
+  for (size_t node = (cursor + cursors_.size()) / 2; node > 0; node /= 2) {
+    if (Less(tree_[node], winner)) {
+      std::swap(tree_[node], winner);
+    }
+  }
+  tree_[0] = winner;
+}
+
+bool SortedBatchMerger::Next(std::shared_ptr<RecordBatch> *batch) {
+  if (cursors_.empty()) {
+    return false;
+  }
+
+  if (!started_) {
+    for (auto &cursor : cursors_) {
+      LoadNextBatch(cursor);
+    }
+    BuildTree();
+    started_ = true;
+  }
+
+  std::vector<std::shared_ptr<RecordBatch>> runs;
+  int64_t num_rows = 0;
+  while (num_rows < max_batch_rows_) {
+    const size_t winner = tree_[0];
+    Cursor &cursor = cursors_[winner];
+    if (cursor.exhausted) {
+      break;
+    }
+
+    // Take rows from the winner for as long as it keeps winning within its batch.
+    const std::shared_ptr<RecordBatch> run_batch = cursor.batch;
+    const int64_t run_start = cursor.row;
+    int64_t run_length = 0;
+    bool keeps_winning = true;
+    while (keeps_winning && num_rows < max_batch_rows_) {
+      ++run_length;
+      ++num_rows;
+      if (++cursor.row == run_batch->num_rows()) {
+        LoadNextBatch(cursor);
+        keeps_winning = false;
+      }
+      Replay(winner);
+      keeps_winning = keeps_winning && tree_[0] == winner;
+    }
+    runs.push_back(run_batch->Slice(run_start, run_length));
+  }
+
+  if (runs.empty()) {
+    return false;
+  }
+  if (runs.size() == 1) {
+    *batch = std::move(runs[0]);
+    return true;
+  }
+
+  std::vector<std::shared_ptr<Array>> columns(schema_->num_fields());
+  for (int i = 0; i < schema_->num_fields(); ++i) {
+    arrow::ArrayVector chunks;
+    chunks.reserve(runs.size());
+    for (const auto &run : runs) {
+      chunks.push_back(run->column(i));
+    }
+    auto result = arrow::Concatenate(chunks);
+    ThrowIfNotOK(result.status());
+    columns[i] = result.ValueOrDie();
+  }
+  *batch = RecordBatch::Make(schema_, num_rows, std::move(columns));
+  return true;
+}
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#pragma once
+
+#include <arrow/type_fwd.h>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace driver {
+namespace flight_sql {
+
+/// Maximum number of rows in the batches produced by SortedBatchMerger.
+constexpr int64_t DEFAULT_MERGE_BATCH_ROWS = 64 * 1024;
+
+struct SortKey {
+  int column;
+  bool ascending;
+  bool nulls_first;
+};
+
+/// \brief Parses a comma separated list of `column [ASC|DESC] [NULLS FIRST|NULLS LAST]`
+/// resolved against schema. Column names may be double quoted. Nulls sort as the
+/// largest values unless NULLS FIRST or NULLS LAST is given.
+/// Throws a DriverException if a column is not found or the syntax is invalid.
+std::vector<SortKey> ParseSortKeys(const std::string &sort_keys, const arrow::Schema &schema);
+
+/// \brief Merges several streams of record batches, each sorted by the same keys,
+/// into a single stream in global order.
+///
+/// The next row is chosen with a loser tree over the stream cursors, so each row costs
+/// O(log k) comparisons for k streams. Consecutive rows taken from the same batch are
+/// emitted as slices of it, and only interleaved runs are copied.
+class SortedBatchMerger {
+public:
+  /// \brief Sets batch to the next batch of a stream, returning false once the stream
+  /// is exhausted.
+  typedef std::function<bool(std::shared_ptr<arrow::RecordBatch> *batch)> BatchSupplier;
+
+  SortedBatchMerger(std::shared_ptr<arrow::Schema> schema, std::vector<BatchSupplier> inputs,
+                    std::vector<SortKey> sort_keys,
+                    int64_t max_batch_rows = DEFAULT_MERGE_BATCH_ROWS);
+
+  ~SortedBatchMerger();
+
+  /// \brief Produces the next batch in global order.
+  /// \return false once every input is exhausted.
+  bool Next(std::shared_ptr<arrow::RecordBatch> *batch);
+
+private:
+  typedef int (*CompareFunction)(const arrow::Array &left, int64_t left_row,
+                                 const arrow::Array &right, int64_t right_row);
+
+  struct Cursor {
+    BatchSupplier supplier;
+    std::shared_ptr<arrow::RecordBatch> batch;
+    std::vector<std::shared_ptr<arrow::Array>> keys;
+    int64_t row;
+    bool exhausted;
+  };
+
+  std::shared_ptr<arrow::Schema> schema_;
+  std::vector<SortKey> sort_keys_;
+  std::vector<CompareFunction> compare_functions_;
+  std::vector<Cursor> cursors_;
+  /// tree_[0] holds the winning cursor, tree_[1..k-1] the loser of each match.
+  /// Leaves are implicit: cursor i sits at position k + i.
+  std::vector<size_t> tree_;
+  int64_t max_batch_rows_;
+  bool started_;
+
+  void LoadNextBatch(Cursor &cursor);
+  bool Less(size_t left, size_t right) const;
+  void BuildTree();
+  void Replay(size_t cursor);
+};
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "sorted_batch_merger.h"
+
+#include "gtest/gtest.h"
+#include "arrow/testing/gtest_util.h"
+#include <arrow/record_batch.h>
+#include <arrow/table.h>
+#include <odbcabstraction/exceptions.h>
+
+namespace driver {
+namespace flight_sql {
+
+using namespace arrow;
+using odbcabstraction::DriverException;
+
+namespace {
+std::shared_ptr<Schema> GetSchema() {
+  return schema({field("key", int64()), field("name", utf8())});
+}
+
+SortedBatchMerger::BatchSupplier MakeSupplier(std::vector<std::string> batches_json) {
+  auto batches = std::make_shared<std::vector<std::shared_ptr<RecordBatch>>>();
+  for (const auto &json : batches_json) {
+    batches->push_back(RecordBatchFromJSON(GetSchema(), json));
+  }
+  auto next = std::make_shared<size_t>(0);
+  return [batches, next](std::shared_ptr<RecordBatch> *batch) {
+    if (*next == batches->size()) {
+      return false;
+    }
+    *batch = (*batches)[(*next)++];
+    return true;
+  };
+}
+
+std::shared_ptr<Table> MergeAll(SortedBatchMerger &merger, int64_t max_batch_rows) {
+  std::vector<std::shared_ptr<RecordBatch>> batches;
+  std::shared_ptr<RecordBatch> batch;
+  while (merger.Next(&batch)) {
+    EXPECT_LE(batch->num_rows(), max_batch_rows);
+    batches.push_back(batch);
+  }
+  return Table::FromRecordBatches(GetSchema(), batches).ValueOrDie();
+}
+}
+
+TEST(SortedBatchMerger, ParseSortKeys) {
+  auto sort_keys = ParseSortKeys(R"(name DESC, "KEY" asc nulls first)", *GetSchema());
+
+  ASSERT_EQ(2, sort_keys.size());
+  ASSERT_EQ(1, sort_keys[0].column);
+  ASSERT_FALSE(sort_keys[0].ascending);
+  ASSERT_TRUE(sort_keys[0].nulls_first);
+  ASSERT_EQ(0, sort_keys[1].column);
+  ASSERT_TRUE(sort_keys[1].ascending);
+  ASSERT_TRUE(sort_keys[1].nulls_first);
+
+  ASSERT_THROW(ParseSortKeys("missing", *GetSchema()), DriverException);
+  ASSERT_THROW(ParseSortKeys("key SIDEWAYS", *GetSchema()), DriverException);
+}
+
+TEST(SortedBatchMerger, Ascending) {
+  std::vector<SortedBatchMerger::BatchSupplier> inputs{
+      MakeSupplier({R"([[1, "a"], [4, "d"]])", R"([])", R"([[7, "g"], [null, "n1"]])"}),
+      MakeSupplier({R"([[2, "b"], [3, "c"], [5, "e"], [6, "f"]])"}),
+      MakeSupplier({}),
+      MakeSupplier({R"([[0, "z"]])", R"([[8, "h"], [null, "n2"]])"}),
+  };
+  SortedBatchMerger merger(GetSchema(), std::move(inputs), ParseSortKeys("key", *GetSchema()), 3);
+
+  const auto &merged = MergeAll(merger, 3);
+  const auto &expected = TableFromJSON(GetSchema(), {R"([
+      [0, "z"], [1, "a"], [2, "b"], [3, "c"], [4, "d"], [5, "e"], [6, "f"],
+      [7, "g"], [8, "h"], [null, "n1"], [null, "n2"]
+  ])"});
+  ASSERT_TRUE(merged->Equals(*expected)) << merged->ToString();
+}
+
+TEST(SortedBatchMerger, DescendingWithTieBreaker) {
+  std::vector<SortedBatchMerger::BatchSupplier> inputs{
+      MakeSupplier({R"([[null, "x"], [3, "b"], [1, "b"]])"}),
+      MakeSupplier({R"([[3, "a"], [2, "c"]])", R"([[1, "a"]])"}),
+  };
+  SortedBatchMerger merger(GetSchema(), std::move(inputs),
+                           ParseSortKeys("key DESC, name", *GetSchema()));
+
+  const auto &merged = MergeAll(merger, DEFAULT_MERGE_BATCH_ROWS);
+  const auto &expected = TableFromJSON(GetSchema(), {R"([
+      [null, "x"], [3, "a"], [3, "b"], [2, "c"], [1, "a"], [1, "b"]
+  ])"});
+  ASSERT_TRUE(merged->Equals(*expected)) << merged->ToString();
+}
+
+TEST(SortedBatchMerger, SplitsAtMaxBatchRows) {
+  std::vector<SortedBatchMerger::BatchSupplier> inputs{
+      MakeSupplier({R"([[1, "a"], [2, "b"], [3, "c"]])"}),
+  };
+  SortedBatchMerger merger(GetSchema(), std::move(inputs), ParseSortKeys("key", *GetSchema()), 2);
+
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_TRUE(merger.Next(&batch));
+  ASSERT_EQ(2, batch->num_rows());
+  ASSERT_TRUE(merger.Next(&batch));
+  ASSERT_EQ(1, batch->num_rows());
+  ASSERT_FALSE(merger.Next(&batch));
+}
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "sql_script_splitter.h"
+
+#include <boost/algorithm/string.hpp>
+#include <cctype>
+
+namespace driver {
+namespace flight_sql {
+
+namespace {
+bool IsSpace(char c) {
+  return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+bool IsIdentifierChar(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_';
+}
+
+/// Returns the end of the quoted text starting at begin, a doubled quote being an
+/// escaped one.
+size_t SkipQuoted(const std::string &script, size_t begin, char quote) {
+  size_t pos = begin + 1;
+  while (pos < script.size()) {
+    if (script[pos] == quote) {
+      if (pos + 1 < script.size() && script[pos + 1] == quote) {
+        pos += 2;
+        continue;
+      }
+      return pos + 1;
+    }
+    if (script[pos] == '\\' && quote != '`') {
+      // Backslash escapes, as accepted by several Flight SQL servers.
+      pos += 2;
+      continue;
+    }
+    ++pos;
+  }
+  return script.size();
+}
+
+/// Returns the end of the comment starting at begin, or begin if there is none.
+size_t SkipComment(const std::string &script, size_t begin) {
+  if (script.compare(begin, 2, "--") == 0) {
+    const size_t end = script.find('\n', begin);
+    return end == std::string::npos ? script.size() : end + 1;
+  }
+  if (script.compare(begin, 2, "/*") == 0) {
+    const size_t end = script.find("*/", begin + 2);
+    return end == std::string::npos ? script.size() : end + 2;
+  }
+  return begin;
+}
+
+/// Returns the end of the dollar quoted string starting at begin, or begin if the
+/// dollar sign doesn't open one (e.g. a positional parameter such as $1).
+size_t SkipDollarQuoted(const std::string &script, size_t begin) {
+  size_t tag_end = begin + 1;
+  while (tag_end < script.size() && IsIdentifierChar(script[tag_end])) {
+    ++tag_end;
+  }
+  if (tag_end >= script.size() || script[tag_end] != '$' ||
+      (tag_end > begin + 1 && std::isdigit(static_cast<unsigned char>(script[begin + 1])))) {
+    return begin;
+  }
+
+  const std::string tag = script.substr(begin, tag_end - begin + 1);
+  const size_t end = script.find(tag, tag_end + 1);
+  return end == std::string::npos ? script.size() : end + tag.size();
+}
+
+void AddStatement(std::vector<std::string> &statements, const std::string &script,
+                  size_t begin, size_t end) {
+  std::string statement = script.substr(begin, end - begin);
+  boost::algorithm::trim_if(statement, IsSpace);
+  if (!statement.empty()) {
+    statements.push_back(std::move(statement));
+  }
+}
+} // namespace
+
+std::vector<std::string> SplitSqlStatements(const std::string &script) {
+  std::vector<std::string> statements;
+
+  size_t begin = 0;
+  size_t pos = 0;
+  while (pos < script.size()) {
+    const char c = script[pos];
+    if (c == '\'' || c == '"' || c == '`') {
+      pos = SkipQuoted(script, pos, c);
+    } else if (c == '-' || c == '/') {
+      const size_t end = SkipComment(script, pos);
+      pos = end == pos ? pos + 1 : end;
+    } else if (c == '$' && (pos == 0 || !IsIdentifierChar(script[pos - 1]))) {
+      const size_t end = SkipDollarQuoted(script, pos);
+      pos = end == pos ? pos + 1 : end;
+    } else if (c == ';') {
+      AddStatement(statements, script, begin, pos);
+      begin = ++pos;
+    } else {
+      ++pos;
+    }
+  }
+  AddStatement(statements, script, begin, script.size());
+
+  return statements;
+}
+
+bool ReturnsResultSet(const std::string &statement) {
+  size_t pos = 0;
+  while (pos < statement.size()) {
+    if (IsSpace(statement[pos]) || statement[pos] == '(') {
+      ++pos;
+      continue;
+    }
+    const size_t end = SkipComment(statement, pos);
+    if (end == pos) {
+      break;
+    }
+    pos = end;
+  }
+
+  size_t keyword_end = pos;
+  while (keyword_end < statement.size() && IsIdentifierChar(statement[keyword_end])) {
+    ++keyword_end;
+  }
+  const std::string keyword = statement.substr(pos, keyword_end - pos);
+
+  static const char *const QUERY_KEYWORDS[] = {"SELECT", "WITH", "VALUES", "SHOW",
+                                               "DESCRIBE", "DESC", "EXPLAIN", "TABLE"};
+  for (const char *query_keyword : QUERY_KEYWORDS) {
+    if (boost::iequals(keyword, query_keyword)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace driver {
+namespace flight_sql {
+
+/// \brief Splits a script into its statements at top-level semi-colons.
+///
+/// Semi-colons inside single or double quoted strings, backtick quoted identifiers,
+/// `--` and `/* */` comments and `$tag$` dollar quoted strings don't end a statement.
+/// Statements are trimmed and empty ones, such as after a trailing semi-colon, are
+/// dropped. Unterminated quotes or comments extend to the end of the script.
+std::vector<std::string> SplitSqlStatements(const std::string &script);
+
+/// \brief Guesses from its leading keyword whether statement produces a result set.
+///
+/// Leading comments and opening parentheses are skipped. Statements starting with
+/// SELECT, WITH, VALUES, SHOW, DESCRIBE, DESC, EXPLAIN or TABLE are assumed to be
+/// read-only queries; anything else is treated as an update.
+bool ReturnsResultSet(const std::string &statement);
+
+} // namespace flight_sql
+} // namespace driver
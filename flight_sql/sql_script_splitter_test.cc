@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "sql_script_splitter.h"
+
+#include "gtest/gtest.h"
+
+namespace driver {
+namespace flight_sql {
+
+typedef std::vector<std::string> Statements;
+
+TEST(SplitSqlStatements, SplitsAtSemicolons) {
+  ASSERT_EQ(Statements({"SELECT 1", "INSERT INTO t VALUES (1)", "SELECT 2"}),
+            SplitSqlStatements("SELECT 1; INSERT INTO t VALUES (1);\n  SELECT 2;"));
+  ASSERT_EQ(Statements({"SELECT 1"}), SplitSqlStatements("SELECT 1"));
+  ASSERT_EQ(Statements(), SplitSqlStatements(" ; ;\n"));
+}
+
+TEST(SplitSqlStatements, IgnoresSemicolonsInQuotes) {
+  ASSERT_EQ(Statements({"SELECT 'a;b', 'it''s;'", "SELECT \"c;d\", `e;f`"}),
+            SplitSqlStatements("SELECT 'a;b', 'it''s;'; SELECT \"c;d\", `e;f`"));
+  ASSERT_EQ(Statements({"SELECT 'a\\';b'", "SELECT 2"}),
+            SplitSqlStatements("SELECT 'a\\';b'; SELECT 2"));
+}
+
+TEST(SplitSqlStatements, IgnoresSemicolonsInComments) {
+  ASSERT_EQ(Statements({"SELECT 1 -- one; two", "/* a; b */ SELECT 2"}),
+            SplitSqlStatements("SELECT 1 -- one; two\n; /* a; b */ SELECT 2"));
+  ASSERT_EQ(Statements({"SELECT 4 - 2", "SELECT 4 / 2"}),
+            SplitSqlStatements("SELECT 4 - 2; SELECT 4 / 2"));
+}
+
+TEST(SplitSqlStatements, IgnoresSemicolonsInDollarQuotes) {
+  ASSERT_EQ(Statements({"SELECT $$a;b$$", "SELECT $tag$c;$$;d$tag$"}),
+            SplitSqlStatements("SELECT $$a;b$$; SELECT $tag$c;$$;d$tag$"));
+  ASSERT_EQ(Statements({"SELECT $1", "SELECT $2"}), SplitSqlStatements("SELECT $1; SELECT $2"));
+}
+
+TEST(SplitSqlStatements, KeepsUnterminatedQuotes) {
+  ASSERT_EQ(Statements({"SELECT 1", "SELECT 'a; b"}),
+            SplitSqlStatements("SELECT 1; SELECT 'a; b"));
+}
+
+TEST(ReturnsResultSet, ClassifiesLeadingKeyword) {
+  ASSERT_TRUE(ReturnsResultSet("SELECT 1"));
+  ASSERT_TRUE(ReturnsResultSet("with t AS (SELECT 1) SELECT * FROM t"));
+  ASSERT_TRUE(ReturnsResultSet("  -- comment\n/* comment */ (SELECT 1) UNION (SELECT 2)"));
+  ASSERT_TRUE(ReturnsResultSet("SHOW TABLES"));
+  ASSERT_FALSE(ReturnsResultSet("INSERT INTO t SELECT 1"));
+  ASSERT_FALSE(ReturnsResultSet("CREATE TABLE t AS SELECT 1"));
+  ASSERT_FALSE(ReturnsResultSet("SELECTION"));
+  ASSERT_FALSE(ReturnsResultSet(""));
+}
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+// Times each step from loading the ODBC driver library to fetching the first row of a
+// query, as a short-lived application goes through them. The probe doesn't link the
+// driver, so the load step includes its static initialisation and the loading of its
+// dependencies, as in a process that starts clean:
+//
+//   arrow_odbc_startup_probe <driver library> <connection string> [query]
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include <sql.h>
+#include <sqlext.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+typedef SQLRETURN (SQL_API *AllocHandleFunction)(SQLSMALLINT, SQLHANDLE, SQLHANDLE *);
+typedef SQLRETURN (SQL_API *SetEnvAttrFunction)(SQLHENV, SQLINTEGER, SQLPOINTER, SQLINTEGER);
+typedef SQLRETURN (SQL_API *DriverConnectFunction)(SQLHDBC, SQLHWND, SQLCHAR *, SQLSMALLINT,
+                                                   SQLCHAR *, SQLSMALLINT, SQLSMALLINT *,
+                                                   SQLUSMALLINT);
+typedef SQLRETURN (SQL_API *ExecDirectFunction)(SQLHSTMT, SQLCHAR *, SQLINTEGER);
+typedef SQLRETURN (SQL_API *FetchFunction)(SQLHSTMT);
+typedef SQLRETURN (SQL_API *GetDataFunction)(SQLHSTMT, SQLUSMALLINT, SQLSMALLINT, SQLPOINTER,
+                                             SQLLEN, SQLLEN *);
+typedef SQLRETURN (SQL_API *GetDiagRecFunction)(SQLSMALLINT, SQLHANDLE, SQLSMALLINT, SQLCHAR *,
+                                                SQLINTEGER *, SQLCHAR *, SQLSMALLINT,
+                                                SQLSMALLINT *);
+typedef SQLRETURN (SQL_API *DisconnectFunction)(SQLHDBC);
+typedef SQLRETURN (SQL_API *FreeHandleFunction)(SQLSMALLINT, SQLHANDLE);
+
+/// The ODBC functions the probe calls, looked up in the driver library.
+struct DriverFunctions {
+  AllocHandleFunction alloc_handle;
+  SetEnvAttrFunction set_env_attr;
+  DriverConnectFunction driver_connect;
+  ExecDirectFunction exec_direct;
+  FetchFunction fetch;
+  GetDataFunction get_data;
+  GetDiagRecFunction get_diag_rec;
+  DisconnectFunction disconnect;
+  FreeHandleFunction free_handle;
+};
+
+void *LoadDriverLibrary(const std::string &path) {
+#ifdef _WIN32
+  void *library = LoadLibraryA(path.c_str());
+  if (library == nullptr) {
+    std::cerr << "Could not load " << path << ": error " << GetLastError() << std::endl;
+  }
+#else
+  void *library = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (library == nullptr) {
+    std::cerr << "Could not load " << path << ": " << dlerror() << std::endl;
+  }
+#endif
+  return library;
+}
+
+template <typename FUNCTION>
+bool FindFunction(void *library, const char *name, FUNCTION &function) {
+#ifdef _WIN32
+  function = reinterpret_cast<FUNCTION>(GetProcAddress(static_cast<HMODULE>(library), name));
+#else
+  function = reinterpret_cast<FUNCTION>(dlsym(library, name));
+#endif
+  if (function == nullptr) {
+    std::cerr << "The driver library does not export " << name << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool FindDriverFunctions(void *library, DriverFunctions &functions) {
+  return FindFunction(library, "SQLAllocHandle", functions.alloc_handle) &&
+         FindFunction(library, "SQLSetEnvAttr", functions.set_env_attr) &&
+         FindFunction(library, "SQLDriverConnect", functions.driver_connect) &&
+         FindFunction(library, "SQLExecDirect", functions.exec_direct) &&
+         FindFunction(library, "SQLFetch", functions.fetch) &&
+         FindFunction(library, "SQLGetData", functions.get_data) &&
+         FindFunction(library, "SQLGetDiagRec", functions.get_diag_rec) &&
+         FindFunction(library, "SQLDisconnect", functions.disconnect) &&
+         FindFunction(library, "SQLFreeHandle", functions.free_handle);
+}
+
+/// Prints the first diagnostic record of handle when rc is an error.
+bool Check(const DriverFunctions &functions, const char *step, SQLRETURN rc,
+           SQLSMALLINT handle_type, SQLHANDLE handle) {
+  if (SQL_SUCCEEDED(rc)) {
+    return true;
+  }
+
+  SQLCHAR sql_state[6] = {0};
+  SQLCHAR message[SQL_MAX_MESSAGE_LENGTH] = {0};
+  SQLINTEGER native_error = 0;
+  SQLSMALLINT message_length = 0;
+  std::cerr << step << " failed";
+  if (handle != SQL_NULL_HANDLE &&
+      SQL_SUCCEEDED(functions.get_diag_rec(handle_type, handle, 1, sql_state, &native_error,
+                                           message, sizeof(message), &message_length))) {
+    std::cerr << ": [" << sql_state << "] " << message;
+  }
+  std::cerr << std::endl;
+  return false;
+}
+
+/// Prints the time since last and moves last to now.
+void ReportStep(const char *step, Clock::time_point &last) {
+  const auto now = Clock::now();
+  std::cout << std::left << std::setw(12) << step << std::right << std::fixed
+            << std::setprecision(3) << std::setw(10)
+            << std::chrono::duration<double, std::milli>(now - last).count() << " ms" << std::endl;
+  last = now;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0] << " <driver library> <connection string> [query]\n"
+              << "Times loading the driver, connecting, executing the query (SELECT 1)\n"
+              << "and fetching its first row." << std::endl;
+    return 1;
+  }
+  std::string connection_string = argv[2];
+  std::string query = argc > 3 ? argv[3] : "SELECT 1";
+
+  const Clock::time_point start = Clock::now();
+  Clock::time_point last = start;
+
+  void *library = LoadDriverLibrary(argv[1]);
+  DriverFunctions functions;
+  if (library == nullptr || !FindDriverFunctions(library, functions)) {
+    return 1;
+  }
+  ReportStep("load", last);
+
+  SQLHENV env = SQL_NULL_HENV;
+  SQLHDBC dbc = SQL_NULL_HDBC;
+  if (!Check(functions, "SQLAllocHandle(SQL_HANDLE_ENV)",
+             functions.alloc_handle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &env), SQL_HANDLE_ENV, env) ||
+      !Check(functions, "SQLSetEnvAttr",
+             functions.set_env_attr(env, SQL_ATTR_ODBC_VERSION,
+                                    reinterpret_cast<SQLPOINTER>(SQL_OV_ODBC3), 0),
+             SQL_HANDLE_ENV, env) ||
+      !Check(functions, "SQLAllocHandle(SQL_HANDLE_DBC)",
+             functions.alloc_handle(SQL_HANDLE_DBC, env, &dbc), SQL_HANDLE_ENV, env)) {
+    return 1;
+  }
+  ReportStep("environment", last);
+
+  if (!Check(functions, "SQLDriverConnect",
+             functions.driver_connect(dbc, nullptr,
+                                      reinterpret_cast<SQLCHAR *>(&connection_string[0]),
+                                      SQL_NTS, nullptr, 0, nullptr, SQL_DRIVER_NOPROMPT),
+             SQL_HANDLE_DBC, dbc)) {
+    return 1;
+  }
+  ReportStep("connect", last);
+
+  SQLHSTMT stmt = SQL_NULL_HSTMT;
+  if (!Check(functions, "SQLAllocHandle(SQL_HANDLE_STMT)",
+             functions.alloc_handle(SQL_HANDLE_STMT, dbc, &stmt), SQL_HANDLE_DBC, dbc) ||
+      !Check(functions, "SQLExecDirect",
+             functions.exec_direct(stmt, reinterpret_cast<SQLCHAR *>(&query[0]), SQL_NTS),
+             SQL_HANDLE_STMT, stmt)) {
+    return 1;
+  }
+  ReportStep("execute", last);
+
+  const SQLRETURN fetch_rc = functions.fetch(stmt);
+  if (fetch_rc != SQL_NO_DATA) {
+    char value[256];
+    SQLLEN value_length;
+    if (!Check(functions, "SQLFetch", fetch_rc, SQL_HANDLE_STMT, stmt) ||
+        !Check(functions, "SQLGetData",
+               functions.get_data(stmt, 1, SQL_C_CHAR, value, sizeof(value), &value_length),
+               SQL_HANDLE_STMT, stmt)) {
+      return 1;
+    }
+  }
+  ReportStep("first row", last);
+
+  Clock::time_point total = start;
+  ReportStep("total", total);
+
+  functions.free_handle(SQL_HANDLE_STMT, stmt);
+  functions.disconnect(dbc);
+  functions.free_handle(SQL_HANDLE_DBC, dbc);
+  functions.free_handle(SQL_HANDLE_ENV, env);
+  return 0;
+}
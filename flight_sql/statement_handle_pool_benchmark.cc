@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "mock_spi.h"
+
+#include <odbcabstraction/odbc_impl/ODBCConnection.h>
+#include <odbcabstraction/odbc_impl/ODBCEnvironment.h>
+#include <odbcabstraction/odbc_impl/ODBCStatement.h>
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <sqlext.h>
+
+namespace driver {
+namespace flight_sql {
+
+using odbcabstraction::Connection;
+using ODBC::ODBCConnection;
+using ODBC::ODBCEnvironment;
+using ODBC::ODBCStatement;
+
+namespace {
+/// A connection to the mock driver whose statements are handed out by the pool.
+class MockConnectionHandle {
+public:
+  MockConnectionHandle()
+      : driver_(std::make_shared<MockDriver>()), environment_(new ODBCEnvironment(driver_)) {
+    environment_->setODBCVersion(SQL_OV_ODBC3);
+    connection_ = environment_->CreateConnection();
+    std::vector<std::string> missing_properties;
+    connection_->connect("", Connection::ConnPropertyMap(), missing_properties);
+  }
+
+  ~MockConnectionHandle() {
+    connection_->releaseConnection();
+  }
+
+  std::vector<ODBCStatement *> CreateStatements(int64_t count) {
+    std::vector<ODBCStatement *> statements;
+    for (int64_t i = 0; i < count; ++i) {
+      statements.push_back(connection_->createStatement().get());
+    }
+    return statements;
+  }
+
+  ODBCConnection &connection() { return *connection_; }
+
+private:
+  std::shared_ptr<MockDriver> driver_;
+  std::unique_ptr<ODBCEnvironment> environment_;
+  std::shared_ptr<ODBCConnection> connection_;
+};
+
+/// SQLAllocHandle followed by SQLFreeHandle, next to range(0) live statements.
+void BM_AllocateFreeStatement(benchmark::State &state) {
+  MockConnectionHandle handle;
+  const std::vector<ODBCStatement *> live = handle.CreateStatements(state.range(0));
+
+  for (auto _ : state) {
+    handle.connection().createStatement()->releaseStatement();
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  for (ODBCStatement *statement : live) {
+    statement->releaseStatement();
+  }
+}
+
+/// Frees range(0) live statements in random order.
+void BM_FreeStatementsInRandomOrder(benchmark::State &state) {
+  MockConnectionHandle handle;
+  std::mt19937 rng(42);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<ODBCStatement *> live = handle.CreateStatements(state.range(0));
+    std::shuffle(live.begin(), live.end(), rng);
+    state.ResumeTiming();
+
+    for (ODBCStatement *statement : live) {
+      statement->releaseStatement();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}
+
+BENCHMARK(BM_AllocateFreeStatement)->Arg(0)->Arg(10000);
+BENCHMARK(BM_FreeStatementsInRandomOrder)->Arg(10000);
+
+} // namespace flight_sql
+} // namespace driver
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "mock_spi.h"
+
+#include <odbcabstraction/odbc_impl/ODBCConnection.h>
+#include <odbcabstraction/odbc_impl/ODBCEnvironment.h>
+#include <odbcabstraction/odbc_impl/ODBCStatement.h>
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <sqlext.h>
+
+namespace driver {
+namespace flight_sql {
+
+using odbcabstraction::Connection;
+using ODBC::ODBCConnection;
+using ODBC::ODBCEnvironment;
+using ODBC::ODBCStatement;
+
+namespace {
+class StatementHandlePoolTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    driver_ = std::make_shared<MockDriver>();
+    environment_.reset(new ODBCEnvironment(driver_));
+    environment_->setODBCVersion(SQL_OV_ODBC3);
+    connection_ = environment_->CreateConnection();
+
+    std::vector<std::string> missing_properties;
+    connection_->connect("", Connection::ConnPropertyMap(), missing_properties);
+  }
+
+  void TearDown() override {
+    connection_->releaseConnection();
+  }
+
+  MockConnection &GetSpiConnection() { return *driver_->last_connection; }
+
+  std::shared_ptr<MockDriver> driver_;
+  std::unique_ptr<ODBCEnvironment> environment_;
+  std::shared_ptr<ODBCConnection> connection_;
+};
+}
+
+TEST_F(StatementHandlePoolTest, ReusesReleasedStatements) {
+  ODBCStatement *statement = connection_->createStatement().get();
+  const int64_t created = GetSpiConnection().created_statements;
+
+  SQLULEN array_size = 10;
+  statement->SetStmtAttr(SQL_ATTR_ROW_ARRAY_SIZE, reinterpret_cast<SQLPOINTER>(array_size), 0, false);
+  statement->releaseStatement();
+  ASSERT_EQ(1, GetSpiConnection().reset_statements);
+
+  ODBCStatement *reused = connection_->createStatement().get();
+  ASSERT_EQ(statement, reused);
+  ASSERT_EQ(created, GetSpiConnection().created_statements);
+
+  array_size = 0;
+  reused->GetStmtAttr(SQL_ATTR_ROW_ARRAY_SIZE, &array_size, 0, nullptr, false);
+  ASSERT_EQ(1, array_size);
+  reused->releaseStatement();
+}
+
+TEST_F(StatementHandlePoolTest, ReleasesInAnyOrder) {
+  std::vector<ODBCStatement *> statements;
+  for (int i = 0; i < 1000; ++i) {
+    statements.push_back(connection_->createStatement().get());
+  }
+  std::shuffle(statements.begin(), statements.end(), std::mt19937(42));
+
+  for (ODBCStatement *statement : statements) {
+    statement->releaseStatement();
+  }
+  // Releasing a statement twice must not drop another one.
+  statements[0]->releaseStatement();
+
+  const int64_t created = GetSpiConnection().created_statements;
+  for (int i = 0; i < 16; ++i) {
+    connection_->createStatement();
+  }
+  ASSERT_EQ(created, GetSpiConnection().created_statements);
+}
+
+} // namespace flight_sql
+} // namespace driver
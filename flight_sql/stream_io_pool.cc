@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "stream_io_pool.h"
+
+#include <odbcabstraction/logger.h>
+#include <algorithm>
+
+namespace driver {
+namespace flight_sql {
+
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+namespace {
+constexpr unsigned int MIN_IO_THREADS = 2;
+constexpr unsigned int MAX_IO_THREADS = 8;
+/// Threads the shared pool may grow to while reads are stalled.
+constexpr size_t MAX_STALLED_IO_THREADS = 64;
+}
+
+constexpr int StreamIoPool::INTERACTIVE_BURST;
+constexpr int64_t StreamIoPool::DEFAULT_BULK_PREFETCH_BUDGET;
+constexpr std::chrono::milliseconds StreamIoPool::DEFAULT_STALL_TIMEOUT;
+
+StreamIoPool::StreamIoPool(size_t num_threads, int64_t bulk_prefetch_budget,
+                           size_t max_threads, std::chrono::milliseconds stall_timeout)
+    : running_bulk_tasks_(0),
+      max_bulk_tasks_(std::max<size_t>(1, num_threads - 1)),
+      interactive_streak_(0),
+      shutdown_(false),
+      bulk_prefetch_budget_(bulk_prefetch_budget),
+      bulk_prefetch_bytes_(0),
+      max_threads_(std::max(num_threads, max_threads)),
+      stall_timeout_(stall_timeout) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  threads_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads_.emplace_back([this] { Run(); });
+  }
+  if (max_threads_ > num_threads) {
+    monitor_ = std::thread([this] { Monitor(); });
+  }
+}
+
+StreamIoPool::~StreamIoPool() {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  task_available_.notify_all();
+  task_submitted_.notify_all();
+  // Join the monitor first, no threads are added once it is gone.
+  if (monitor_.joinable()) {
+    monitor_.join();
+  }
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+StreamIoPool &StreamIoPool::GetInstance() {
+  // Intentionally leaked: joining threads from a static destructor can deadlock while
+  // the driver library is being unloaded.
+  static StreamIoPool *instance = new StreamIoPool(
+      std::max(MIN_IO_THREADS, std::min(MAX_IO_THREADS, std::thread::hardware_concurrency())),
+      DEFAULT_BULK_PREFETCH_BUDGET, MAX_STALLED_IO_THREADS);
+  return *instance;
+}
+
+void StreamIoPool::Submit(StreamPriority priority, Task task) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto &tasks = priority == odbcabstraction::StreamPriority_BULK ? bulk_tasks_ : interactive_tasks_;
+    tasks.push_back(PendingTask{std::move(task), steady_clock::now()});
+  }
+  task_available_.notify_one();
+  task_submitted_.notify_one();
+}
+
+size_t StreamIoPool::GetThreadCount() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return threads_.size();
+}
+
+bool StreamIoPool::HasBulkPrefetchBudget(std::function<void()> on_available) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (bulk_prefetch_bytes_ < bulk_prefetch_budget_) {
+    return true;
+  }
+  if (on_available) {
+    budget_waiters_.push_back(std::move(on_available));
+  }
+  return false;
+}
+
+void StreamIoPool::AddBulkPrefetchBytes(int64_t bytes) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  bulk_prefetch_bytes_ += bytes;
+}
+
+void StreamIoPool::ReleaseBulkPrefetchBytes(int64_t bytes) {
+  std::vector<std::function<void()>> waiters;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    bulk_prefetch_bytes_ -= bytes;
+    if (bulk_prefetch_bytes_ < bulk_prefetch_budget_) {
+      waiters.swap(budget_waiters_);
+    }
+  }
+  for (const auto &waiter : waiters) {
+    waiter();
+  }
+}
+
+void StreamIoPool::RecordRead(StreamPriority priority, int64_t rows, int64_t bytes,
+                              microseconds read_time) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto &statistics = GetStatisticsLocked(priority);
+  statistics.reads++;
+  statistics.rows += rows;
+  statistics.bytes += bytes;
+  statistics.read_time += read_time;
+}
+
+StreamStatistics StreamIoPool::GetStatistics(StreamPriority priority) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return GetStatisticsLocked(priority);
+}
+
+StreamStatistics &StreamIoPool::GetStatisticsLocked(StreamPriority priority) {
+  return priority == odbcabstraction::StreamPriority_BULK ? bulk_statistics_ : interactive_statistics_;
+}
+
+bool StreamIoPool::CanRunBulkTask() const {
+  return !bulk_tasks_.empty() && (running_bulk_tasks_ < max_bulk_tasks_ || shutdown_);
+}
+
+void StreamIoPool::AddThreadLocked() {
+  threads_.emplace_back([this] { Run(); });
+  // Bulk reads still leave one thread to interactive ones.
+  max_bulk_tasks_ = threads_.size() - 1;
+}
+
+void StreamIoPool::Monitor() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!shutdown_ && threads_.size() < max_threads_) {
+    if (interactive_tasks_.empty() && bulk_tasks_.empty()) {
+      task_submitted_.wait(lock);
+      continue;
+    }
+
+    // The oldest read of each queue is at its front.
+    steady_clock::time_point oldest = steady_clock::time_point::max();
+    if (!interactive_tasks_.empty()) {
+      oldest = interactive_tasks_.front().submitted;
+    }
+    if (!bulk_tasks_.empty()) {
+      oldest = std::min(oldest, bulk_tasks_.front().submitted);
+    }
+
+    const steady_clock::time_point stalled_at = oldest + stall_timeout_;
+    if (steady_clock::now() < stalled_at) {
+      task_submitted_.wait_until(lock, stalled_at);
+      continue;
+    }
+
+    AddThreadLocked();
+    LOG_DEBUG("Stream reads waited over {} ms for a thread, the I/O pool now has {} threads",
+              stall_timeout_.count(), threads_.size());
+    task_available_.notify_all();
+
+    // Let the new thread pick a read up before checking again.
+    task_submitted_.wait_for(lock, stall_timeout_);
+  }
+}
+
+void StreamIoPool::Run() {
+  while (true) {
+    PendingTask pending;
+    bool bulk;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_available_.wait(lock, [this] {
+        return shutdown_ || !interactive_tasks_.empty() || CanRunBulkTask();
+      });
+
+      const bool can_run_bulk = CanRunBulkTask();
+      if (interactive_tasks_.empty() && !can_run_bulk) {
+        return;
+      }
+
+      // Interactive reads go first, but a waiting bulk read gets every
+      // INTERACTIVE_BURST-th turn so extracts keep moving under constant load.
+      bulk = can_run_bulk && (interactive_tasks_.empty() || interactive_streak_ >= INTERACTIVE_BURST);
+      auto &tasks = bulk ? bulk_tasks_ : interactive_tasks_;
+      pending = std::move(tasks.front());
+      tasks.pop_front();
+
+      if (bulk) {
+        running_bulk_tasks_++;
+        interactive_streak_ = 0;
+      } else if (can_run_bulk) {
+        interactive_streak_++;
+      }
+
+      const auto queue_wait_time = duration_cast<microseconds>(steady_clock::now() - pending.submitted);
+      auto &statistics = bulk ? bulk_statistics_ : interactive_statistics_;
+      statistics.queue_wait_time += queue_wait_time;
+      statistics.max_queue_wait_time = std::max(statistics.max_queue_wait_time, queue_wait_time);
+    }
+
+    try {
+      pending.task();
+    } catch (...) {
+      // Tasks report their own failures, a stray exception must not take the pool down.
+    }
+
+    if (bulk) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        running_bulk_tasks_--;
+      }
+      task_available_.notify_one();
+    }
+  }
+}
+
+} // namespace flight_sql
+} // namespace driver
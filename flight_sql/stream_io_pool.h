@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#pragma once
+
+#include <odbcabstraction/types.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace driver {
+namespace flight_sql {
+
+using odbcabstraction::StreamPriority;
+
+/// \brief Read counters of one priority class.
+struct StreamStatistics {
+  int64_t reads = 0;
+  int64_t rows = 0;
+  int64_t bytes = 0;
+  /// Time spent in reads, throughput is bytes over this.
+  std::chrono::microseconds read_time{0};
+  /// Time reads waited for a pool thread once submitted.
+  std::chrono::microseconds queue_wait_time{0};
+  std::chrono::microseconds max_queue_wait_time{0};
+};
+
+/// \brief Threads reading result streams on behalf of every open cursor in the process.
+///
+/// Stream producers submit one read at a time and resubmit themselves once the result
+/// is delivered, so cursors take turns on the pool threads instead of each owning
+/// threads of its own. Interactive reads are served first, but every
+/// INTERACTIVE_BURST interactive reads let a waiting bulk read through, and bulk
+/// reads never occupy the last pool thread. Bulk streams also share a prefetch budget
+/// bounding the bytes they buffer ahead of their consumers.
+///
+/// Reads block until the server produces a batch, so a few slow queries could hold
+/// every thread. When a read has waited stall_timeout for a thread, the pool adds
+/// one, up to max_threads, so that slow streams don't starve the others.
+class StreamIoPool {
+public:
+  typedef std::function<void()> Task;
+
+  static constexpr int INTERACTIVE_BURST = 4;
+  static constexpr int64_t DEFAULT_BULK_PREFETCH_BUDGET = 256 * 1024 * 1024;
+  static constexpr std::chrono::milliseconds DEFAULT_STALL_TIMEOUT{100};
+
+  /// \param max_threads threads the pool may grow to, no growth if below num_threads.
+  explicit StreamIoPool(size_t num_threads,
+                        int64_t bulk_prefetch_budget = DEFAULT_BULK_PREFETCH_BUDGET,
+                        size_t max_threads = 0,
+                        std::chrono::milliseconds stall_timeout = DEFAULT_STALL_TIMEOUT);
+
+  ~StreamIoPool();
+
+  /// \brief Returns the pool shared by all connections, started on first use.
+  static StreamIoPool &GetInstance();
+
+  /// \param priority StreamPriority_INTERACTIVE or StreamPriority_BULK.
+  void Submit(StreamPriority priority, Task task);
+
+  /// \brief Checks whether bulk streams may buffer more data.
+  /// \param on_available if set and this returns false, called once without the
+  ///        pool lock held when budget is released.
+  bool HasBulkPrefetchBudget(std::function<void()> on_available);
+
+  void AddBulkPrefetchBytes(int64_t bytes);
+
+  void ReleaseBulkPrefetchBytes(int64_t bytes);
+
+  /// \brief Accounts a completed read of the given class.
+  void RecordRead(StreamPriority priority, int64_t rows, int64_t bytes,
+                  std::chrono::microseconds read_time);
+
+  StreamStatistics GetStatistics(StreamPriority priority);
+
+  size_t GetThreadCount();
+
+private:
+  struct PendingTask {
+    Task task;
+    std::chrono::steady_clock::time_point submitted;
+  };
+
+  std::mutex mutex_;
+  std::condition_variable task_available_;
+  std::condition_variable task_submitted_;
+  std::deque<PendingTask> interactive_tasks_;
+  std::deque<PendingTask> bulk_tasks_;
+  size_t running_bulk_tasks_;
+  size_t max_bulk_tasks_;
+  int interactive_streak_;
+  bool shutdown_;
+
+  int64_t bulk_prefetch_budget_;
+  int64_t bulk_prefetch_bytes_;
+  std::vector<std::function<void()>> budget_waiters_;
+
+  StreamStatistics interactive_statistics_;
+  StreamStatistics bulk_statistics_;
+
+  const size_t max_threads_;
+  const std::chrono::milliseconds stall_timeout_;
+  std::vector<std::thread> threads_;
+  /// Adds threads when reads stall, only started when the pool may grow.
+  std::thread monitor_;
+
+  bool CanRunBulkTask() const;
+  StreamStatistics &GetStatisticsLocked(StreamPriority priority);
+  void AddThreadLocked();
+  void Run();
+  void Monitor();
+};
+
+} // namespace flight_sql
+} // namespace driver
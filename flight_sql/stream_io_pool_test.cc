@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include "stream_io_pool.h"
+
+#include "gtest/gtest.h"
+#include <odbcabstraction/blocking_queue.h>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <set>
+
+namespace driver {
+namespace flight_sql {
+
+using odbcabstraction::BlockingQueue;
+
+namespace {
+/// Produces the integers below limit from the pool, one item per task, only
+/// submitting a task once the queue has room for its item.
+class CountingProducer : public std::enable_shared_from_this<CountingProducer> {
+public:
+  CountingProducer(BlockingQueue<int> &queue, StreamIoPool &pool, int limit)
+      : queue_(queue), pool_(pool), limit_(limit), next_(0), reading_(false) {
+    queue_.AddExternalProducer();
+  }
+
+  void Schedule() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (reading_ || next_ == limit_ || !queue_.TryReserve()) {
+      return;
+    }
+    reading_ = true;
+    lock.unlock();
+
+    auto self = shared_from_this();
+    pool_.Submit(odbcabstraction::StreamPriority_INTERACTIVE, [self] { self->Produce(); });
+  }
+
+private:
+  BlockingQueue<int> &queue_;
+  StreamIoPool &pool_;
+  const int limit_;
+  std::mutex mutex_;
+  int next_;
+  bool reading_;
+
+  void Produce() {
+    bool done;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      queue_.PushReserved(next_++);
+      reading_ = false;
+      done = next_ == limit_;
+    }
+    if (done) {
+      queue_.RemoveExternalProducer();
+    } else {
+      Schedule();
+    }
+  }
+};
+}
+
+TEST(StreamIoPool, RunsTasksOnFixedThreads) {
+  StreamIoPool pool(2);
+  ASSERT_EQ(2, pool.GetThreadCount());
+
+  std::mutex mutex;
+  std::set<std::thread::id> thread_ids;
+  std::atomic<int> completed(0);
+  for (int i = 0; i < 100; ++i) {
+    pool.Submit(odbcabstraction::StreamPriority_INTERACTIVE, [&] {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        thread_ids.insert(std::this_thread::get_id());
+      }
+      completed++;
+    });
+  }
+
+  while (completed < 100) {
+    std::this_thread::yield();
+  }
+  ASSERT_LE(thread_ids.size(), 2);
+  ASSERT_EQ(0, thread_ids.count(std::this_thread::get_id()));
+}
+
+TEST(StreamIoPool, ProducersShareThreadsAndRespectQueueCapacity) {
+  StreamIoPool pool(1);
+  const int num_producers = 3;
+  const int items_per_producer = 50;
+
+  BlockingQueue<int> queue(2);
+  std::vector<std::shared_ptr<CountingProducer>> producers;
+  for (int i = 0; i < num_producers; ++i) {
+    producers.push_back(std::make_shared<CountingProducer>(queue, pool, items_per_producer));
+  }
+  queue.SetNotFullListener([&producers] {
+    for (const auto &producer : producers) {
+      producer->Schedule();
+    }
+  });
+  for (const auto &producer : producers) {
+    producer->Schedule();
+  }
+
+  std::vector<int> counts(items_per_producer, 0);
+  int item;
+  int popped = 0;
+  while (queue.Pop(&item)) {
+    counts[item]++;
+    popped++;
+  }
+
+  ASSERT_EQ(num_producers * items_per_producer, popped);
+  for (int count : counts) {
+    ASSERT_EQ(num_producers, count);
+  }
+}
+
+TEST(StreamIoPool, KeepsAThreadForInteractiveReads) {
+  StreamIoPool pool(2);
+
+  std::promise<void> release_bulk;
+  std::shared_future<void> bulk_released = release_bulk.get_future().share();
+  std::atomic<int> bulk_started(0);
+  for (int i = 0; i < 2; ++i) {
+    pool.Submit(odbcabstraction::StreamPriority_BULK, [&, bulk_released] {
+      bulk_started++;
+      bulk_released.wait();
+    });
+  }
+  // Interactive reads are picked first, so only submit one once a bulk read holds a thread.
+  while (bulk_started == 0) {
+    std::this_thread::yield();
+  }
+
+  std::promise<void> interactive_done;
+  pool.Submit(odbcabstraction::StreamPriority_INTERACTIVE, [&] { interactive_done.set_value(); });
+
+  // The second bulk read can't take the last thread, so the interactive one runs
+  // while the first bulk read is still blocked.
+  ASSERT_EQ(std::future_status::ready,
+            interactive_done.get_future().wait_for(std::chrono::seconds(10)));
+  ASSERT_EQ(1, bulk_started);
+
+  release_bulk.set_value();
+}
+
+TEST(StreamIoPool, StalledReadsDoNotStarveOtherStreams) {
+  StreamIoPool pool(1, StreamIoPool::DEFAULT_BULK_PREFETCH_BUDGET, 2, std::chrono::milliseconds(20));
+
+  // A server slow to produce its next batch holds the only thread.
+  std::promise<void> release_stalled;
+  std::shared_future<void> stalled_released = release_stalled.get_future().share();
+  pool.Submit(odbcabstraction::StreamPriority_INTERACTIVE, [stalled_released] { stalled_released.wait(); });
+
+  std::promise<void> other_done;
+  pool.Submit(odbcabstraction::StreamPriority_INTERACTIVE, [&] { other_done.set_value(); });
+
+  ASSERT_EQ(std::future_status::ready, other_done.get_future().wait_for(std::chrono::seconds(10)));
+  ASSERT_EQ(2, pool.GetThreadCount());
+
+  release_stalled.set_value();
+}
+
+TEST(StreamIoPool, GrowsUpToMaxThreads) {
+  StreamIoPool pool(1, StreamIoPool::DEFAULT_BULK_PREFETCH_BUDGET, 3, std::chrono::milliseconds(5));
+
+  std::promise<void> release_stalled;
+  std::shared_future<void> stalled_released = release_stalled.get_future().share();
+  std::atomic<int> started(0);
+  for (int i = 0; i < 5; ++i) {
+    pool.Submit(odbcabstraction::StreamPriority_BULK, [&started, stalled_released] {
+      started++;
+      stalled_released.wait();
+    });
+  }
+
+  // Bulk reads leave a thread to interactive ones however far the pool grows.
+  std::promise<void> interactive_done;
+  pool.Submit(odbcabstraction::StreamPriority_INTERACTIVE, [&] { interactive_done.set_value(); });
+  ASSERT_EQ(std::future_status::ready,
+            interactive_done.get_future().wait_for(std::chrono::seconds(10)));
+
+  // The monitor stops once the pool reaches max_threads, with two bulk reads running.
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while ((pool.GetThreadCount() < 3 || started < 2) && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+  ASSERT_EQ(3, pool.GetThreadCount());
+  ASSERT_EQ(2, started);
+
+  release_stalled.set_value();
+}
+
+TEST(StreamIoPool, DoesNotGrowWithoutStalls) {
+  StreamIoPool pool(1, StreamIoPool::DEFAULT_BULK_PREFETCH_BUDGET, 4, std::chrono::seconds(10));
+
+  std::atomic<int> completed(0);
+  for (int i = 0; i < 100; ++i) {
+    pool.Submit(odbcabstraction::StreamPriority_INTERACTIVE, [&] { completed++; });
+  }
+  while (completed < 100) {
+    std::this_thread::yield();
+  }
+  ASSERT_EQ(1, pool.GetThreadCount());
+}
+
+TEST(StreamIoPool, BulkPrefetchBudget) {
+  StreamIoPool pool(1, 100);
+  int notified = 0;
+
+  ASSERT_TRUE(pool.HasBulkPrefetchBudget([&] { notified++; }));
+  pool.AddBulkPrefetchBytes(150);
+  ASSERT_FALSE(pool.HasBulkPrefetchBudget([&] { notified++; }));
+  ASSERT_FALSE(pool.HasBulkPrefetchBudget(nullptr));
+
+  pool.ReleaseBulkPrefetchBytes(20);
+  ASSERT_EQ(0, notified);
+  pool.ReleaseBulkPrefetchBytes(100);
+  ASSERT_EQ(1, notified);
+  ASSERT_TRUE(pool.HasBulkPrefetchBudget(nullptr));
+}
+
+TEST(StreamIoPool, Statistics) {
+  StreamIoPool pool(1);
+  pool.RecordRead(odbcabstraction::StreamPriority_BULK, 10, 1000, std::chrono::microseconds(5));
+  pool.RecordRead(odbcabstraction::StreamPriority_BULK, 20, 3000, std::chrono::microseconds(7));
+
+  const auto &bulk = pool.GetStatistics(odbcabstraction::StreamPriority_BULK);
+  ASSERT_EQ(2, bulk.reads);
+  ASSERT_EQ(30, bulk.rows);
+  ASSERT_EQ(4000, bulk.bytes);
+  ASSERT_EQ(12, bulk.read_time.count());
+  ASSERT_EQ(0, pool.GetStatistics(odbcabstraction::StreamPriority_INTERACTIVE).reads);
+}
+
+} // namespace flight_sql
+} // namespace driver
@@ -5,6 +5,7 @@
  */
 
 #include "utils.h"
+#include "accessors/numeric_conversion_array_accessor.h"
 
 #include <odbcabstraction/calendar_utils.h>
 #include <odbcabstraction/encoding.h>
@@ -16,6 +17,7 @@
 #include <arrow/type_fwd.h>
 #include <arrow/compute/api.h>
 
+#include "arrow_ipc_converter.h"
 #include "json_converter.h"
 
 #include <boost/tokenizer.hpp>
@@ -27,6 +29,18 @@ namespace driver {
 namespace flight_sql {
 
 namespace {
+odbcabstraction::SqlDataType GetDefaultSqlCharType(bool useWideChar) {
+  return useWideChar ? odbcabstraction::SqlDataType_WCHAR : odbcabstraction::SqlDataType_CHAR;
+}
+odbcabstraction::SqlDataType GetDefaultSqlVarcharType(bool useWideChar) {
+  return useWideChar ? odbcabstraction::SqlDataType_WVARCHAR : odbcabstraction::SqlDataType_VARCHAR;
+}
+odbcabstraction::CDataType GetDefaultCCharType(bool useWideChar) {
+  return useWideChar ? odbcabstraction::CDataType_WCHAR : odbcabstraction::CDataType_CHAR;
+}
+
+}
+
 bool IsComplexType(arrow::Type::type type_id) {
   switch (type_id) {
     case arrow::Type::LIST:
@@ -40,18 +54,6 @@ bool IsComplexType(arrow::Type::type type_id) {
   }
 }
 
-odbcabstraction::SqlDataType GetDefaultSqlCharType(bool useWideChar) {
-  return useWideChar ? odbcabstraction::SqlDataType_WCHAR : odbcabstraction::SqlDataType_CHAR;
-}
-odbcabstraction::SqlDataType GetDefaultSqlVarcharType(bool useWideChar) {
-  return useWideChar ? odbcabstraction::SqlDataType_WVARCHAR : odbcabstraction::SqlDataType_VARCHAR;
-}
-odbcabstraction::CDataType GetDefaultCCharType(bool useWideChar) {
-  return useWideChar ? odbcabstraction::CDataType_WCHAR : odbcabstraction::CDataType_CHAR;
-}
-
-}
-
 using namespace odbcabstraction;
 using arrow::util::make_optional;
 using arrow::util::nullopt;
@@ -98,6 +100,7 @@ GetDataTypeFromArrowField_V3(const std::shared_ptr<arrow::Field> &field, bool us
   case arrow::Type::TIMESTAMP:
     return odbcabstraction::SqlDataType_TYPE_TIMESTAMP;
   case arrow::Type::DECIMAL128:
+  case arrow::Type::DECIMAL256:
     return odbcabstraction::SqlDataType_DECIMAL;
   case arrow::Type::TIME32:
   case arrow::Type::TIME64:
@@ -127,6 +130,15 @@ GetDataTypeFromArrowField_V3(const std::shared_ptr<arrow::Field> &field, bool us
   return GetDefaultSqlVarcharType(useWideChar);
 }
 
+SqlDataType
+GetDataTypeFromArrowField_V3(const std::shared_ptr<arrow::Field> &field,
+                             const odbcabstraction::MetadataSettings &metadata_settings) {
+  if (metadata_settings.complex_types_as_arrow_ipc_ && IsComplexType(field->type()->id())) {
+    return odbcabstraction::SqlDataType_LONGVARBINARY;
+  }
+  return GetDataTypeFromArrowField_V3(field, metadata_settings.use_wide_char_);
+}
+
 SqlDataType EnsureRightSqlCharType(SqlDataType data_type, bool useWideChar) {
   switch (data_type) {
     case SqlDataType_CHAR:
@@ -700,47 +712,59 @@ bool NeedArrayConversion(arrow::Type::type original_type_id, odbcabstraction::CD
   switch (original_type_id) {
     case arrow::Type::DATE32:
     case arrow::Type::DATE64:
-      return data_type != odbcabstraction::CDataType_DATE;
+      return data_type != odbcabstraction::CDataType_DATE &&
+             data_type != odbcabstraction::CDataType_CHAR &&
+             data_type != odbcabstraction::CDataType_WCHAR;
     case arrow::Type::TIME32:
     case arrow::Type::TIME64:
-      return data_type != odbcabstraction::CDataType_TIME;
+      return data_type != odbcabstraction::CDataType_TIME &&
+             data_type != odbcabstraction::CDataType_CHAR &&
+             data_type != odbcabstraction::CDataType_WCHAR;
     case arrow::Type::TIMESTAMP:
-      return data_type != odbcabstraction::CDataType_TIMESTAMP;
+      return data_type != odbcabstraction::CDataType_TIMESTAMP &&
+             data_type != odbcabstraction::CDataType_CHAR &&
+             data_type != odbcabstraction::CDataType_WCHAR;
     case arrow::Type::STRING:
       return data_type != odbcabstraction::CDataType_CHAR &&
-             data_type != odbcabstraction::CDataType_WCHAR;
+             data_type != odbcabstraction::CDataType_WCHAR &&
+             data_type != odbcabstraction::CDataType_STRING_VIEW;
+    case arrow::Type::INT8:
+    case arrow::Type::UINT8:
     case arrow::Type::INT16:
-      return data_type != odbcabstraction::CDataType_SSHORT;
     case arrow::Type::UINT16:
-      return data_type != odbcabstraction::CDataType_USHORT;
     case arrow::Type::INT32:
-      return data_type != odbcabstraction::CDataType_SLONG;
     case arrow::Type::UINT32:
-      return data_type != odbcabstraction::CDataType_ULONG;
+    case arrow::Type::INT64:
+    case arrow::Type::UINT64:
     case arrow::Type::FLOAT:
-      return data_type != odbcabstraction::CDataType_FLOAT;
     case arrow::Type::DOUBLE:
-      return data_type != odbcabstraction::CDataType_DOUBLE;
+      // Numeric targets are converted by the accessor, row by row.
+      return !IsNumericCDataType(data_type);
     case arrow::Type::BOOL:
       return data_type != odbcabstraction::CDataType_BIT;
-    case arrow::Type::INT8:
-      return data_type != odbcabstraction::CDataType_STINYINT;
-    case arrow::Type::UINT8:
-      return data_type != odbcabstraction::CDataType_UTINYINT;
-    case arrow::Type::INT64:
-      return data_type != odbcabstraction::CDataType_SBIGINT;
-    case arrow::Type::UINT64:
-      return data_type != odbcabstraction::CDataType_UBIGINT;
     case arrow::Type::BINARY:
-      return data_type != odbcabstraction::CDataType_BINARY;
+      return data_type != odbcabstraction::CDataType_BINARY &&
+             data_type != odbcabstraction::CDataType_CHAR &&
+             data_type != odbcabstraction::CDataType_WCHAR &&
+             data_type != odbcabstraction::CDataType_STRING_VIEW;
+    case arrow::Type::FIXED_SIZE_BINARY:
+      return data_type != odbcabstraction::CDataType_BINARY &&
+             data_type != odbcabstraction::CDataType_CHAR &&
+             data_type != odbcabstraction::CDataType_WCHAR &&
+             data_type != odbcabstraction::CDataType_GUID;
     case arrow::Type::DECIMAL128:
-      return data_type != odbcabstraction::CDataType_NUMERIC;
+    case arrow::Type::DECIMAL256:
+      return data_type != odbcabstraction::CDataType_NUMERIC &&
+             data_type != odbcabstraction::CDataType_DOUBLE &&
+             data_type != odbcabstraction::CDataType_CHAR &&
+             data_type != odbcabstraction::CDataType_WCHAR;
     case arrow::Type::LIST:
     case arrow::Type::LARGE_LIST:
     case arrow::Type::FIXED_SIZE_LIST:
     case arrow::Type::MAP:
     case arrow::Type::STRUCT:
-      return data_type == odbcabstraction::CDataType_CHAR || data_type == odbcabstraction::CDataType_WCHAR;
+      return data_type == odbcabstraction::CDataType_CHAR || data_type == odbcabstraction::CDataType_WCHAR ||
+             data_type == odbcabstraction::CDataType_BINARY;
     default:
       throw odbcabstraction::DriverException(std::string("Invalid conversion"));
   }
@@ -858,8 +882,10 @@ odbcabstraction::CDataType ConvertArrowTypeToC(arrow::Type::type type_id, bool u
     case arrow::Type::UINT64:
       return odbcabstraction::CDataType_UBIGINT;
     case arrow::Type::BINARY:
+    case arrow::Type::FIXED_SIZE_BINARY:
       return odbcabstraction::CDataType_BINARY;
     case arrow::Type::DECIMAL128:
+    case arrow::Type::DECIMAL256:
       return odbcabstraction::CDataType_NUMERIC;
     case arrow::Type::DATE64:
     case arrow::Type::DATE32:
@@ -966,28 +992,6 @@ ArrayConvertTask GetConverter(arrow::Type::type original_type_id,
       return CheckConversion(arrow::compute::CallFunction(
         "cast", {first_converted_array}, &cast_options));
     };
-  } else if (original_type_id == arrow::Type::DECIMAL128 &&
-             (target_type == odbcabstraction::CDataType_CHAR ||
-              target_type == odbcabstraction::CDataType_WCHAR)) {
-    return [=](const std::shared_ptr<arrow::Array> &original_array) {
-      arrow::StringBuilder builder;
-      int64_t length = original_array->length();
-      ThrowIfNotOK(builder.ReserveData(length));
-
-      for (int64_t i = 0; i < length; ++i) {
-        if (original_array->IsNull(i)) {
-          ThrowIfNotOK(builder.AppendNull());
-        } else {
-          auto result = original_array->GetScalar(i);
-          auto scalar = result.ValueOrDie();
-          ThrowIfNotOK(builder.Append(scalar->ToString()));
-        }
-      }
-
-      auto finish = builder.Finish();
-
-      return finish.ValueOrDie();
-    };
   } else if (IsComplexType(original_type_id) &&
              (target_type == odbcabstraction::CDataType_CHAR ||
               target_type == odbcabstraction::CDataType_WCHAR)) {
@@ -996,6 +1000,13 @@ ArrayConvertTask GetConverter(arrow::Type::type original_type_id,
       ThrowIfNotOK(json_conversion_result.status());
       return json_conversion_result.ValueOrDie();
     };
+  } else if (IsComplexType(original_type_id) &&
+             target_type == odbcabstraction::CDataType_BINARY) {
+    return [=](const std::shared_ptr<arrow::Array> &original_array) {
+      const auto &ipc_conversion_result = ConvertToArrowIpc(original_array);
+      ThrowIfNotOK(ipc_conversion_result.status());
+      return ipc_conversion_result.ValueOrDie();
+    };
   } else {
     // Default converter
     return [=](const std::shared_ptr<arrow::Array> &original_array) {
@@ -1090,13 +1101,13 @@ std::string ConvertToDBMSVer(const std::string &str) {
 }
 
 int32_t GetDecimalTypeScale(const std::shared_ptr<arrow::DataType>& decimalType){
-  auto decimal128Type = std::dynamic_pointer_cast<arrow::Decimal128Type>(decimalType);
-  return decimal128Type->scale();
+  auto decimal_type = std::dynamic_pointer_cast<arrow::DecimalType>(decimalType);
+  return decimal_type->scale();
 }
 
 int32_t GetDecimalTypePrecision(const std::shared_ptr<arrow::DataType>& decimalType){
-  auto decimal128Type = std::dynamic_pointer_cast<arrow::Decimal128Type>(decimalType);
-  return decimal128Type->precision();
+  auto decimal_type = std::dynamic_pointer_cast<arrow::DecimalType>(decimalType);
+  return decimal_type->precision();
 }
 
 } // namespace flight_sql
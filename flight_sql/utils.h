@@ -50,6 +50,14 @@ arrow::Status AppendToBuilder(BUILDER &builder, T value) {
 odbcabstraction::SqlDataType
 GetDataTypeFromArrowField_V3(const std::shared_ptr<arrow::Field> &field, bool useWideChar);
 
+/// \brief Same as above, but honours the connection settings that change how columns are exposed,
+/// e.g. complex columns reported as binary when they are encoded as Arrow IPC.
+odbcabstraction::SqlDataType
+GetDataTypeFromArrowField_V3(const std::shared_ptr<arrow::Field> &field,
+                             const odbcabstraction::MetadataSettings &metadata_settings);
+
+bool IsComplexType(arrow::Type::type type_id);
+
 odbcabstraction::SqlDataType EnsureRightSqlCharType(odbcabstraction::SqlDataType data_type, bool useWideChar);
 
 int16_t ConvertSqlDataTypeFromV3ToV2(int16_t data_type_v3);
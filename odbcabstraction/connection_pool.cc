@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include <odbcabstraction/connection_pool.h>
+
+#include <odbcabstraction/logger.h>
+#include <boost/algorithm/string/case_conv.hpp>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace driver {
+namespace odbcabstraction {
+
+ConnectionPool::ConnectionPool(ConnectionPoolSettings settings, TimeSource now)
+    : settings_(settings), now_(std::move(now)), stopping_(false) {
+  maintenance_thread_ = std::thread([this] { RunMaintenance(); });
+}
+
+ConnectionPool::~ConnectionPool() {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  stop_requested_.notify_all();
+  maintenance_thread_.join();
+
+  for (const auto &key_entries : idle_) {
+    for (const auto &entry : key_entries.second) {
+      CloseQuietly(entry.connection);
+    }
+  }
+}
+
+std::shared_ptr<ConnectionPool> ConnectionPool::GetDriverPool() {
+  // Intentionally leaked: the maintenance thread can't be joined from a static
+  // destructor while the driver library is being unloaded.
+  static auto *pool = new std::shared_ptr<ConnectionPool>(std::make_shared<ConnectionPool>());
+  return *pool;
+}
+
+std::string ConnectionPool::MakeKey(const std::string &dsn, const Connection::ConnPropertyMap &properties,
+                                    OdbcVersion odbc_version) {
+  // Properties are already sorted case-insensitively. NUL separators keep values
+  // containing '=' or ';' from colliding with other property sets.
+  std::string key = std::to_string(odbc_version);
+  key.push_back('\0');
+  key += boost::algorithm::to_lower_copy(dsn);
+  key.push_back('\0');
+  for (const auto &property : properties) {
+    key += boost::algorithm::to_lower_copy(property.first);
+    key.push_back('\0');
+    key += property.second;
+    key.push_back('\0');
+  }
+  return key;
+}
+
+std::shared_ptr<Connection> ConnectionPool::Acquire(const std::string &key, Clock::time_point *connected_at) {
+  std::vector<std::shared_ptr<Connection>> expired;
+  std::shared_ptr<Connection> connection;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = idle_.find(key);
+    const auto now = now_();
+    while (it != idle_.end() && !it->second.empty()) {
+      Entry entry = std::move(it->second.back());
+      it->second.pop_back();
+      statistics_.idle--;
+      if (IsExpired(entry, now)) {
+        statistics_.expired++;
+        expired.push_back(std::move(entry.connection));
+        continue;
+      }
+      connection = std::move(entry.connection);
+      *connected_at = entry.created;
+      break;
+    }
+    if (it != idle_.end() && it->second.empty()) {
+      idle_.erase(it);
+    }
+
+    if (connection) {
+      statistics_.hits++;
+    } else {
+      statistics_.misses++;
+    }
+  }
+
+  for (const auto &expired_connection : expired) {
+    CloseQuietly(expired_connection);
+  }
+  return connection;
+}
+
+void ConnectionPool::Release(const std::string &key, std::shared_ptr<Connection> connection,
+                             Clock::time_point connected_at) {
+  const auto now = now_();
+  Entry entry{std::move(connection), connected_at, now, now};
+
+  bool reset = false;
+  try {
+    reset = entry.connection->Reset();
+  } catch (...) {
+    // Treated as a connection that can't be reused.
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!reset) {
+      statistics_.broken++;
+    } else if (IsExpired(entry, now)) {
+      statistics_.expired++;
+    } else {
+      auto &entries = idle_[key];
+      if (entries.size() < settings_.max_idle_per_key) {
+        entries.push_back(std::move(entry));
+        statistics_.idle++;
+        return;
+      }
+    }
+  }
+
+  CloseQuietly(entry.connection);
+}
+
+ConnectionPoolStatistics ConnectionPool::GetStatistics() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return statistics_;
+}
+
+bool ConnectionPool::IsExpired(const Entry &entry, Clock::time_point now) const {
+  return now - entry.created >= settings_.max_lifetime || now - entry.last_used >= settings_.max_idle_time;
+}
+
+void ConnectionPool::RunMaintenance() {
+  // Sweeping a few times per keepalive interval bounds how late a check can be.
+  const auto period = std::max<Clock::duration>(settings_.keepalive_interval / 4, std::chrono::seconds(1));
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stop_requested_.wait_for(lock, period, [this] { return stopping_; })) {
+    lock.unlock();
+    Maintain();
+    lock.lock();
+  }
+}
+
+void ConnectionPool::Maintain() {
+  std::vector<std::shared_ptr<Connection>> to_close;
+  std::vector<std::pair<std::string, Entry>> to_check;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const auto now = now_();
+    for (auto it = idle_.begin(); it != idle_.end();) {
+      auto &entries = it->second;
+      for (auto entry = entries.begin(); entry != entries.end();) {
+        if (IsExpired(*entry, now)) {
+          statistics_.expired++;
+          to_close.push_back(std::move(entry->connection));
+        } else if (now - entry->last_checked >= settings_.keepalive_interval) {
+          // Checked without the lock held, the connection is out of the pool meanwhile.
+          to_check.emplace_back(it->first, std::move(*entry));
+        } else {
+          ++entry;
+          continue;
+        }
+        entry = entries.erase(entry);
+        statistics_.idle--;
+      }
+      it = entries.empty() ? idle_.erase(it) : std::next(it);
+    }
+  }
+
+  for (auto &key_entry : to_check) {
+    bool alive = false;
+    try {
+      alive = key_entry.second.connection->IsAlive();
+    } catch (...) {
+      // Treated as a dead connection.
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto &entries = idle_[key_entry.first];
+    if (alive && entries.size() < settings_.max_idle_per_key) {
+      key_entry.second.last_checked = now_();
+      // Keep the most recently used connections at the back.
+      auto position = entries.begin();
+      while (position != entries.end() && position->last_used <= key_entry.second.last_used) {
+        ++position;
+      }
+      entries.insert(position, std::move(key_entry.second));
+      statistics_.idle++;
+    } else {
+      if (!alive) {
+        statistics_.broken++;
+      }
+      if (entries.empty()) {
+        idle_.erase(key_entry.first);
+      }
+      to_close.push_back(std::move(key_entry.second.connection));
+    }
+  }
+
+  for (const auto &connection : to_close) {
+    CloseQuietly(connection);
+  }
+
+  if (!to_close.empty() || !to_check.empty()) {
+    LOG_DEBUG("Connection pool maintenance checked {} and closed {} idle connections",
+              to_check.size(), to_close.size());
+  }
+}
+
+void ConnectionPool::CloseQuietly(const std::shared_ptr<Connection> &connection) {
+  try {
+    connection->Close();
+  } catch (...) {
+    // The connection is being discarded either way.
+  }
+}
+
+} // namespace odbcabstraction
+} // namespace driver
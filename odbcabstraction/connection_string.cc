@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include <odbcabstraction/connection_string.h>
+
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <cstdlib>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+namespace driver {
+namespace odbcabstraction {
+
+namespace {
+bool IsSpace(char c) {
+  return c == ' ' || c == '\t';
+}
+
+// Returns the position of the closing brace of a braced value starting at begin, or
+// npos if the value isn't properly closed.
+size_t FindClosingBrace(const std::string &conn_str, size_t begin) {
+  size_t pos = conn_str.find('}', begin + 1);
+  while (pos != std::string::npos) {
+    size_t next = pos + 1;
+    while (next < conn_str.size() && IsSpace(conn_str[next])) {
+      ++next;
+    }
+    if (next == conn_str.size() || conn_str[next] == ';') {
+      return pos;
+    }
+    pos = conn_str.find('}', pos + 1);
+  }
+  return std::string::npos;
+}
+
+// Keys whose values are secrets, as used by the drivers built on this library.
+bool IsCredential(const std::string &key) {
+  return boost::iequals(key, "PWD") || boost::iequals(key, "Password") ||
+         boost::iequals(key, "Token");
+}
+
+bool HasCredentials(const ConnectionString &parsed) {
+  return std::any_of(parsed.attributes.begin(), parsed.attributes.end(),
+                     [](const std::pair<std::string, std::string> &attribute) {
+                       return IsCredential(attribute.first);
+                     });
+}
+
+void AddPair(ConnectionString &result, bool &is_dsn_first, bool &is_driver_first,
+             std::string key, std::string value) {
+  boost::algorithm::trim_if(key, IsSpace);
+  if (key.empty() || value.empty()) {
+    return;
+  }
+
+  // If the DSN shows up before driver key, load settings from the DSN.
+  // Only load values from the DSN once regardless of how many times the DSN
+  // key shows up.
+  if (boost::iequals(key, "DSN")) {
+    if (!is_driver_first && !is_dsn_first) {
+      is_dsn_first = true;
+      result.dsn = std::move(value);
+    }
+    return;
+  }
+  if (boost::iequals(key, "Driver")) {
+    if (!is_dsn_first) {
+      is_driver_first = true;
+    }
+    return;
+  }
+
+  if (value.size() >= 2 && value.front() == '{' && value.back() == '}') {
+    value = value.substr(1, value.size() - 2);
+  }
+  result.attributes.emplace_back(std::move(key), std::move(value));
+}
+}
+
+constexpr size_t ConnectionStringCache::MAX_CONNECTION_STRINGS;
+
+ConnectionString ParseConnectionString(const std::string &conn_str) {
+  ConnectionString result;
+  bool is_dsn_first = false;
+  bool is_driver_first = false;
+
+  size_t pos = 0;
+  while (pos < conn_str.size()) {
+    const size_t equals = conn_str.find_first_of("=;", pos);
+    if (equals == std::string::npos) {
+      break;
+    }
+    if (conn_str[equals] == ';') {
+      // A segment without a value.
+      pos = equals + 1;
+      continue;
+    }
+
+    size_t value_begin = equals + 1;
+    while (value_begin < conn_str.size() && IsSpace(conn_str[value_begin])) {
+      ++value_begin;
+    }
+
+    size_t value_end = std::string::npos;
+    if (value_begin < conn_str.size() && conn_str[value_begin] == '{') {
+      const size_t closing = FindClosingBrace(conn_str, value_begin);
+      if (closing != std::string::npos) {
+        value_end = closing + 1;
+      }
+    } else {
+      // Unbraced values keep their leading spaces, as they always did.
+      value_begin = equals + 1;
+    }
+    if (value_end == std::string::npos) {
+      value_end = std::min(conn_str.find(';', value_begin), conn_str.size());
+    }
+
+    AddPair(result, is_dsn_first, is_driver_first, conn_str.substr(pos, equals - pos),
+            conn_str.substr(value_begin, value_end - value_begin));
+
+    const size_t separator = conn_str.find(';', value_end);
+    if (separator == std::string::npos) {
+      break;
+    }
+    pos = separator + 1;
+  }
+  return result;
+}
+
+ConnectionStringCache &ConnectionStringCache::GetInstance() {
+  static ConnectionStringCache instance;
+  return instance;
+}
+
+std::shared_ptr<const ConnectionString> ConnectionStringCache::Parse(const std::string &conn_str) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto &it = connection_strings_.find(conn_str);
+    if (it != connection_strings_.end()) {
+      return it->second;
+    }
+  }
+
+  auto parsed = std::make_shared<const ConnectionString>(ParseConnectionString(conn_str));
+  if (HasCredentials(*parsed)) {
+    return parsed;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (connection_strings_.size() >= MAX_CONNECTION_STRINGS) {
+    connection_strings_.clear();
+  }
+  connection_strings_.emplace(conn_str, parsed);
+  return parsed;
+}
+
+std::shared_ptr<const PropertyMap> ConnectionStringCache::GetDsnProperties(const std::string &dsn,
+                                                                          const DsnLoader &loader) {
+#ifdef _WIN32
+  // DSNs live in the registry, which has no cheap change detection.
+  auto properties = std::make_shared<PropertyMap>();
+  loader(dsn, *properties);
+  return properties;
+#else
+  FileStamps stamps = GetOdbcIniStamps();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stamps != odbc_ini_stamps_) {
+      dsns_.clear();
+      odbc_ini_stamps_ = stamps;
+    }
+    const auto &it = dsns_.find(dsn);
+    if (it != dsns_.end()) {
+      return it->second;
+    }
+  }
+
+  // Loading is slow, so it runs unlocked. Concurrent misses on the same DSN load it twice.
+  auto properties = std::make_shared<PropertyMap>();
+  loader(dsn, *properties);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Only cache what was read from the files as they were before loading.
+  if (stamps == odbc_ini_stamps_ && stamps == GetOdbcIniStamps()) {
+    dsns_[dsn] = properties;
+  }
+  return properties;
+#endif
+}
+
+ConnectionStringCache::FileStamps ConnectionStringCache::GetOdbcIniStamps() {
+  FileStamps stamps;
+#ifndef _WIN32
+  std::vector<std::string> paths;
+  if (const char *odbc_ini = std::getenv("ODBCINI")) {
+    paths.emplace_back(odbc_ini);
+  }
+  if (const char *home = std::getenv("HOME")) {
+    paths.emplace_back(std::string(home) + "/.odbc.ini");
+    paths.emplace_back(std::string(home) + "/Library/ODBC/odbc.ini");
+  }
+  if (const char *odbc_sys_ini = std::getenv("ODBCSYSINI")) {
+    paths.emplace_back(std::string(odbc_sys_ini) + "/odbc.ini");
+  }
+  paths.emplace_back("/etc/odbc.ini");
+  paths.emplace_back("/usr/local/etc/odbc.ini");
+  paths.emplace_back("/Library/ODBC/odbc.ini");
+
+  for (const auto &path : paths) {
+    struct stat info;
+    if (stat(path.c_str(), &info) == 0) {
+#ifdef __APPLE__
+      const struct timespec &modified = info.st_mtimespec;
+#else
+      const struct timespec &modified = info.st_mtim;
+#endif
+      stamps.emplace_back(static_cast<int64_t>(modified.tv_sec) * 1000000000 + modified.tv_nsec,
+                          static_cast<int64_t>(info.st_size));
+    } else {
+      stamps.emplace_back(-1, -1);
+    }
+  }
+#endif
+  return stamps;
+}
+
+} // namespace odbcabstraction
+} // namespace driver
@@ -0,0 +1,661 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#include <odbcabstraction/cpu_dispatch.h>
+#include <odbcabstraction/logger.h>
+#include <odbcabstraction/types.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ODBCABSTRACTION_X86_64
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define ODBCABSTRACTION_ARM64
+#include <arm_neon.h>
+#endif
+
+// Variants are compiled for their instruction set only, so the library as a whole
+// keeps running on CPUs that lack it. MSVC accepts intrinsics without flags.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define ODBCABSTRACTION_TARGET(isa)
+#else
+#define ODBCABSTRACTION_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace driver {
+namespace odbcabstraction {
+
+namespace {
+
+inline bool GetBit(const uint8_t *bits, int64_t i) {
+  return (bits[i >> 3] >> (i & 7)) & 1;
+}
+
+/// Splits the bit range [offset, offset + length) into an unaligned head, whole
+/// bytes that SIMD variants can consume, and a tail.
+struct BitmapSpan {
+  int64_t head;
+  int64_t bytes;
+  int64_t tail;
+};
+
+inline BitmapSpan SplitBitmap(int64_t offset, int64_t length) {
+  int64_t head = std::min<int64_t>(length, (8 - (offset & 7)) & 7);
+  int64_t bytes = (length - head) / 8;
+  return BitmapSpan{head, bytes, length - head - bytes * 8};
+}
+
+// Scalar kernels ==================================================================================
+
+void ExpandValidityScalar(const uint8_t *validity, int64_t offset, int64_t length,
+                          ssize_t value_length, ssize_t *indicators) {
+  if (!validity) {
+    std::fill(indicators, indicators + length, value_length);
+    return;
+  }
+  for (int64_t i = 0; i < length; ++i) {
+    indicators[i] = GetBit(validity, offset + i) ? value_length : NULL_DATA;
+  }
+}
+
+void UnpackBitsScalar(const uint8_t *bitmap, int64_t offset, int64_t length, uint8_t *out) {
+  for (int64_t i = 0; i < length; ++i) {
+    out[i] = GetBit(bitmap, offset + i) ? 1 : 0;
+  }
+}
+
+template <typename CHAR_TYPE>
+size_t AsciiToWideScalar(const char *src, size_t length, CHAR_TYPE *dst) {
+  size_t i = 0;
+  for (; i < length && static_cast<uint8_t>(src[i]) < 0x80; ++i) {
+    dst[i] = static_cast<CHAR_TYPE>(src[i]);
+  }
+  return i;
+}
+
+size_t AsciiToUtf16Scalar(const char *src, size_t length, char16_t *dst) {
+  return AsciiToWideScalar(src, length, dst);
+}
+
+size_t AsciiToUtf32Scalar(const char *src, size_t length, char32_t *dst) {
+  return AsciiToWideScalar(src, length, dst);
+}
+
+// memcpy already picks the widest moves available at runtime, so this kernel has no
+// specialised variants; it only saves the per-cell call overhead of row-wise bindings.
+void StridedCopyScalar(const uint8_t *src, size_t width, size_t count, uint8_t *dst, size_t stride) {
+  if (stride == width) {
+    std::memcpy(dst, src, width * count);
+    return;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    std::memcpy(dst + i * stride, src + i * width, width);
+  }
+}
+
+const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+/// Both digits of every byte value, so the scalar kernel does one lookup per byte.
+struct HexPairTable {
+  char pairs[256][2];
+
+  HexPairTable() {
+    for (int b = 0; b < 256; ++b) {
+      pairs[b][0] = HEX_DIGITS[b >> 4];
+      pairs[b][1] = HEX_DIGITS[b & 0xF];
+    }
+  }
+};
+
+void HexEncodeScalar(const uint8_t *src, size_t length, char *dst) {
+  static const HexPairTable table;
+  for (size_t i = 0; i < length; ++i) {
+    std::memcpy(dst + 2 * i, table.pairs[src[i]], 2);
+  }
+}
+
+#if defined(ODBCABSTRACTION_X86_64)
+
+// SSE4.2 kernels ==================================================================================
+
+ODBCABSTRACTION_TARGET("sse4.2")
+void ExpandValiditySse42(const uint8_t *validity, int64_t offset, int64_t length,
+                         ssize_t value_length, ssize_t *indicators) {
+  if (!validity) {
+    ExpandValidityScalar(validity, offset, length, value_length, indicators);
+    return;
+  }
+  const BitmapSpan span = SplitBitmap(offset, length);
+  ExpandValidityScalar(validity, offset, span.head, value_length, indicators);
+
+  const uint8_t *bytes = validity + ((offset + span.head) >> 3);
+  ssize_t *out = indicators + span.head;
+  const __m128i valid = _mm_set1_epi64x(value_length);
+  const __m128i null = _mm_set1_epi64x(NULL_DATA);
+  const __m128i masks[4] = {_mm_set_epi64x(2, 1), _mm_set_epi64x(8, 4),
+                            _mm_set_epi64x(32, 16), _mm_set_epi64x(128, 64)};
+  for (int64_t b = 0; b < span.bytes; ++b, out += 8) {
+    const __m128i byte = _mm_set1_epi64x(bytes[b]);
+    for (int k = 0; k < 4; ++k) {
+      const __m128i is_set = _mm_cmpeq_epi64(_mm_and_si128(byte, masks[k]), masks[k]);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * k), _mm_blendv_epi8(null, valid, is_set));
+    }
+  }
+
+  ExpandValidityScalar(validity, offset + span.head + span.bytes * 8, span.tail, value_length, out);
+}
+
+ODBCABSTRACTION_TARGET("sse4.2")
+void UnpackBitsSse42(const uint8_t *bitmap, int64_t offset, int64_t length, uint8_t *out) {
+  const BitmapSpan span = SplitBitmap(offset, length);
+  UnpackBitsScalar(bitmap, offset, span.head, out);
+
+  const uint8_t *bytes = bitmap + ((offset + span.head) >> 3);
+  uint8_t *dst = out + span.head;
+  const __m128i shuffle = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1);
+  const __m128i masks = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+  const __m128i ones = _mm_set1_epi8(1);
+  int64_t b = 0;
+  for (; b + 2 <= span.bytes; b += 2, dst += 16) {
+    uint16_t two_bytes;
+    std::memcpy(&two_bytes, bytes + b, sizeof(two_bytes));
+    const __m128i spread = _mm_shuffle_epi8(_mm_cvtsi32_si128(two_bytes), shuffle);
+    const __m128i is_set = _mm_cmpeq_epi8(_mm_and_si128(spread, masks), masks);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_and_si128(is_set, ones));
+  }
+
+  const int64_t consumed = span.head + b * 8;
+  UnpackBitsScalar(bitmap, offset + consumed, length - consumed, out + consumed);
+}
+
+ODBCABSTRACTION_TARGET("sse4.2")
+size_t AsciiToUtf16Sse42(const char *src, size_t length, char16_t *dst) {
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    if (_mm_movemask_epi8(chars) != 0) {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_unpacklo_epi8(chars, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 8), _mm_unpackhi_epi8(chars, zero));
+  }
+  return i + AsciiToUtf16Scalar(src + i, length - i, dst + i);
+}
+
+ODBCABSTRACTION_TARGET("sse4.2")
+size_t AsciiToUtf32Sse42(const char *src, size_t length, char32_t *dst) {
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    if (_mm_movemask_epi8(chars) != 0) {
+      break;
+    }
+    __m128i *out = reinterpret_cast<__m128i *>(dst + i);
+    _mm_storeu_si128(out, _mm_cvtepu8_epi32(chars));
+    _mm_storeu_si128(out + 1, _mm_cvtepu8_epi32(_mm_srli_si128(chars, 4)));
+    _mm_storeu_si128(out + 2, _mm_cvtepu8_epi32(_mm_srli_si128(chars, 8)));
+    _mm_storeu_si128(out + 3, _mm_cvtepu8_epi32(_mm_srli_si128(chars, 12)));
+  }
+  return i + AsciiToUtf32Scalar(src + i, length - i, dst + i);
+}
+
+ODBCABSTRACTION_TARGET("sse4.2")
+void HexEncodeSse42(const uint8_t *src, size_t length, char *dst) {
+  // Each nibble indexes the digit table with a byte shuffle, then the high and low
+  // digits are interleaved back into source order.
+  const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i *>(HEX_DIGITS));
+  const __m128i low_nibble = _mm_set1_epi8(0x0F);
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    const __m128i high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(bytes, 4), low_nibble));
+    const __m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(bytes, low_nibble));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 2 * i), _mm_unpacklo_epi8(high, low));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+  }
+  HexEncodeScalar(src + i, length - i, dst + 2 * i);
+}
+
+// AVX2 kernels ====================================================================================
+
+ODBCABSTRACTION_TARGET("avx2")
+void ExpandValidityAvx2(const uint8_t *validity, int64_t offset, int64_t length,
+                        ssize_t value_length, ssize_t *indicators) {
+  if (!validity) {
+    ExpandValidityScalar(validity, offset, length, value_length, indicators);
+    return;
+  }
+  const BitmapSpan span = SplitBitmap(offset, length);
+  ExpandValidityScalar(validity, offset, span.head, value_length, indicators);
+
+  const uint8_t *bytes = validity + ((offset + span.head) >> 3);
+  ssize_t *out = indicators + span.head;
+  const __m256i valid = _mm256_set1_epi64x(value_length);
+  const __m256i null = _mm256_set1_epi64x(NULL_DATA);
+  const __m256i low_masks = _mm256_setr_epi64x(1, 2, 4, 8);
+  const __m256i high_masks = _mm256_setr_epi64x(16, 32, 64, 128);
+  for (int64_t b = 0; b < span.bytes; ++b, out += 8) {
+    const __m256i byte = _mm256_set1_epi64x(bytes[b]);
+    const __m256i low_set = _mm256_cmpeq_epi64(_mm256_and_si256(byte, low_masks), low_masks);
+    const __m256i high_set = _mm256_cmpeq_epi64(_mm256_and_si256(byte, high_masks), high_masks);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), _mm256_blendv_epi8(null, valid, low_set));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 4), _mm256_blendv_epi8(null, valid, high_set));
+  }
+
+  ExpandValidityScalar(validity, offset + span.head + span.bytes * 8, span.tail, value_length, out);
+}
+
+ODBCABSTRACTION_TARGET("avx2")
+void UnpackBitsAvx2(const uint8_t *bitmap, int64_t offset, int64_t length, uint8_t *out) {
+  const BitmapSpan span = SplitBitmap(offset, length);
+  UnpackBitsScalar(bitmap, offset, span.head, out);
+
+  const uint8_t *bytes = bitmap + ((offset + span.head) >> 3);
+  uint8_t *dst = out + span.head;
+  // Every 128-bit lane holds the four source bytes, the lower lane spreads bytes 0
+  // and 1 and the upper lane spreads bytes 2 and 3.
+  const __m256i shuffle = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                                           2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+  const __m256i masks = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                         1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+  const __m256i ones = _mm256_set1_epi8(1);
+  int64_t b = 0;
+  for (; b + 4 <= span.bytes; b += 4, dst += 32) {
+    int32_t four_bytes;
+    std::memcpy(&four_bytes, bytes + b, sizeof(four_bytes));
+    const __m256i spread = _mm256_shuffle_epi8(_mm256_set1_epi32(four_bytes), shuffle);
+    const __m256i is_set = _mm256_cmpeq_epi8(_mm256_and_si256(spread, masks), masks);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), _mm256_and_si256(is_set, ones));
+  }
+
+  const int64_t consumed = span.head + b * 8;
+  UnpackBitsSse42(bitmap, offset + consumed, length - consumed, out + consumed);
+}
+
+ODBCABSTRACTION_TARGET("avx2")
+size_t AsciiToUtf16Avx2(const char *src, size_t length, char16_t *dst) {
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    if (_mm256_movemask_epi8(chars) != 0) {
+      break;
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                        _mm256_cvtepu8_epi16(_mm256_castsi256_si128(chars)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i + 16),
+                        _mm256_cvtepu8_epi16(_mm256_extracti128_si256(chars, 1)));
+  }
+  return i + AsciiToUtf16Sse42(src + i, length - i, dst + i);
+}
+
+ODBCABSTRACTION_TARGET("avx2")
+size_t AsciiToUtf32Avx2(const char *src, size_t length, char32_t *dst) {
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    if (_mm_movemask_epi8(chars) != 0) {
+      break;
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_cvtepu8_epi32(chars));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i + 8),
+                        _mm256_cvtepu8_epi32(_mm_srli_si128(chars, 8)));
+  }
+  return i + AsciiToUtf32Scalar(src + i, length - i, dst + i);
+}
+
+ODBCABSTRACTION_TARGET("avx2")
+void HexEncodeAvx2(const uint8_t *src, size_t length, char *dst) {
+  const __m256i digits = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(HEX_DIGITS)));
+  const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    // Unpacking works within 128-bit lanes, so the middle quarters are swapped
+    // beforehand to get both halves of the output in source order.
+    const __m256i bytes = _mm256_permute4x64_epi64(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i)), 0xD8);
+    const __m256i high =
+        _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), low_nibble));
+    const __m256i low = _mm256_shuffle_epi8(digits, _mm256_and_si256(bytes, low_nibble));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + 2 * i), _mm256_unpacklo_epi8(high, low));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + 2 * i + 32), _mm256_unpackhi_epi8(high, low));
+  }
+  HexEncodeSse42(src + i, length - i, dst + 2 * i);
+}
+
+// AVX-512 kernels =================================================================================
+
+ODBCABSTRACTION_TARGET("avx512f,avx512bw")
+void ExpandValidityAvx512(const uint8_t *validity, int64_t offset, int64_t length,
+                          ssize_t value_length, ssize_t *indicators) {
+  if (!validity) {
+    ExpandValidityScalar(validity, offset, length, value_length, indicators);
+    return;
+  }
+  const BitmapSpan span = SplitBitmap(offset, length);
+  ExpandValidityScalar(validity, offset, span.head, value_length, indicators);
+
+  const uint8_t *bytes = validity + ((offset + span.head) >> 3);
+  ssize_t *out = indicators + span.head;
+  const __m512i valid = _mm512_set1_epi64(value_length);
+  const __m512i null = _mm512_set1_epi64(NULL_DATA);
+  // Each validity byte is directly usable as the blend mask of eight 64-bit lanes.
+  for (int64_t b = 0; b < span.bytes; ++b, out += 8) {
+    _mm512_storeu_si512(out, _mm512_mask_blend_epi64(static_cast<__mmask8>(bytes[b]), null, valid));
+  }
+
+  ExpandValidityScalar(validity, offset + span.head + span.bytes * 8, span.tail, value_length, out);
+}
+
+ODBCABSTRACTION_TARGET("avx512f,avx512bw")
+void UnpackBitsAvx512(const uint8_t *bitmap, int64_t offset, int64_t length, uint8_t *out) {
+  const BitmapSpan span = SplitBitmap(offset, length);
+  UnpackBitsScalar(bitmap, offset, span.head, out);
+
+  const uint8_t *bytes = bitmap + ((offset + span.head) >> 3);
+  uint8_t *dst = out + span.head;
+  const __m512i ones = _mm512_set1_epi8(1);
+  int64_t b = 0;
+  for (; b + 8 <= span.bytes; b += 8, dst += 64) {
+    uint64_t eight_bytes;
+    std::memcpy(&eight_bytes, bytes + b, sizeof(eight_bytes));
+    _mm512_storeu_si512(dst, _mm512_maskz_mov_epi8(static_cast<__mmask64>(eight_bytes), ones));
+  }
+
+  const int64_t consumed = span.head + b * 8;
+  UnpackBitsAvx2(bitmap, offset + consumed, length - consumed, out + consumed);
+}
+
+ODBCABSTRACTION_TARGET("avx512f,avx512bw")
+size_t AsciiToUtf16Avx512(const char *src, size_t length, char16_t *dst) {
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    if (_mm256_movemask_epi8(chars) != 0) {
+      break;
+    }
+    _mm512_storeu_si512(dst + i, _mm512_cvtepu8_epi16(chars));
+  }
+  return i + AsciiToUtf16Sse42(src + i, length - i, dst + i);
+}
+
+ODBCABSTRACTION_TARGET("avx512f,avx512bw")
+size_t AsciiToUtf32Avx512(const char *src, size_t length, char32_t *dst) {
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    if (_mm_movemask_epi8(chars) != 0) {
+      break;
+    }
+    _mm512_storeu_si512(dst + i, _mm512_cvtepu8_epi32(chars));
+  }
+  return i + AsciiToUtf32Scalar(src + i, length - i, dst + i);
+}
+
+CpuDispatchLevel DetectX86Level() {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  const int max_leaf = info[0];
+  if (max_leaf < 1) {
+    return CpuDispatchLevel_SCALAR;
+  }
+
+  __cpuid(info, 1);
+  const bool has_sse42 = (info[2] & (1 << 20)) != 0;
+  const bool has_osxsave = (info[2] & (1 << 27)) != 0;
+  if (!has_sse42) {
+    return CpuDispatchLevel_SCALAR;
+  }
+  if (!has_osxsave || max_leaf < 7) {
+    return CpuDispatchLevel_SSE4_2;
+  }
+
+  // The OS must save the YMM (and for AVX-512 also the opmask and ZMM) registers.
+  const unsigned long long xcr0 = _xgetbv(0);
+  __cpuidex(info, 7, 0);
+  const bool has_avx2 = (info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6;
+  const bool has_avx512 = (info[1] & (1 << 16)) != 0 && (info[1] & (1 << 30)) != 0 &&
+                          (xcr0 & 0xE6) == 0xE6;
+#else
+  __builtin_cpu_init();
+  const bool has_sse42 = __builtin_cpu_supports("sse4.2");
+  const bool has_avx2 = __builtin_cpu_supports("avx2");
+  const bool has_avx512 = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#endif
+
+  if (has_avx512) {
+    return CpuDispatchLevel_AVX512;
+  } else if (has_avx2) {
+    return CpuDispatchLevel_AVX2;
+  } else if (has_sse42) {
+    return CpuDispatchLevel_SSE4_2;
+  }
+  return CpuDispatchLevel_SCALAR;
+}
+
+#elif defined(ODBCABSTRACTION_ARM64)
+
+// NEON kernels ====================================================================================
+
+void ExpandValidityNeon(const uint8_t *validity, int64_t offset, int64_t length,
+                        ssize_t value_length, ssize_t *indicators) {
+  if (!validity) {
+    ExpandValidityScalar(validity, offset, length, value_length, indicators);
+    return;
+  }
+  const BitmapSpan span = SplitBitmap(offset, length);
+  ExpandValidityScalar(validity, offset, span.head, value_length, indicators);
+
+  const uint8_t *bytes = validity + ((offset + span.head) >> 3);
+  ssize_t *out = indicators + span.head;
+  const int64x2_t valid = vdupq_n_s64(value_length);
+  const int64x2_t null = vdupq_n_s64(NULL_DATA);
+  const uint64_t mask_values[8] = {1, 2, 4, 8, 16, 32, 64, 128};
+  const uint64x2_t masks[4] = {vld1q_u64(mask_values), vld1q_u64(mask_values + 2),
+                               vld1q_u64(mask_values + 4), vld1q_u64(mask_values + 6)};
+  for (int64_t b = 0; b < span.bytes; ++b, out += 8) {
+    const uint64x2_t byte = vdupq_n_u64(bytes[b]);
+    for (int k = 0; k < 4; ++k) {
+      vst1q_s64(reinterpret_cast<int64_t *>(out + 2 * k), vbslq_s64(vtstq_u64(byte, masks[k]), valid, null));
+    }
+  }
+
+  ExpandValidityScalar(validity, offset + span.head + span.bytes * 8, span.tail, value_length, out);
+}
+
+void UnpackBitsNeon(const uint8_t *bitmap, int64_t offset, int64_t length, uint8_t *out) {
+  const BitmapSpan span = SplitBitmap(offset, length);
+  UnpackBitsScalar(bitmap, offset, span.head, out);
+
+  const uint8_t *bytes = bitmap + ((offset + span.head) >> 3);
+  uint8_t *dst = out + span.head;
+  const uint8_t mask_values[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  const uint8x16_t masks = vld1q_u8(mask_values);
+  const uint8x16_t ones = vdupq_n_u8(1);
+  int64_t b = 0;
+  for (; b + 2 <= span.bytes; b += 2, dst += 16) {
+    const uint8x16_t spread = vcombine_u8(vdup_n_u8(bytes[b]), vdup_n_u8(bytes[b + 1]));
+    vst1q_u8(dst, vandq_u8(vtstq_u8(spread, masks), ones));
+  }
+
+  const int64_t consumed = span.head + b * 8;
+  UnpackBitsScalar(bitmap, offset + consumed, length - consumed, out + consumed);
+}
+
+size_t AsciiToUtf16Neon(const char *src, size_t length, char16_t *dst) {
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const uint8x16_t chars = vld1q_u8(reinterpret_cast<const uint8_t *>(src + i));
+    if (vmaxvq_u8(chars) >= 0x80) {
+      break;
+    }
+    vst1q_u16(reinterpret_cast<uint16_t *>(dst + i), vmovl_u8(vget_low_u8(chars)));
+    vst1q_u16(reinterpret_cast<uint16_t *>(dst + i + 8), vmovl_u8(vget_high_u8(chars)));
+  }
+  return i + AsciiToUtf16Scalar(src + i, length - i, dst + i);
+}
+
+size_t AsciiToUtf32Neon(const char *src, size_t length, char32_t *dst) {
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const uint8x16_t chars = vld1q_u8(reinterpret_cast<const uint8_t *>(src + i));
+    if (vmaxvq_u8(chars) >= 0x80) {
+      break;
+    }
+    const uint16x8_t low = vmovl_u8(vget_low_u8(chars));
+    const uint16x8_t high = vmovl_u8(vget_high_u8(chars));
+    uint32_t *out = reinterpret_cast<uint32_t *>(dst + i);
+    vst1q_u32(out, vmovl_u16(vget_low_u16(low)));
+    vst1q_u32(out + 4, vmovl_u16(vget_high_u16(low)));
+    vst1q_u32(out + 8, vmovl_u16(vget_low_u16(high)));
+    vst1q_u32(out + 12, vmovl_u16(vget_high_u16(high)));
+  }
+  return i + AsciiToUtf32Scalar(src + i, length - i, dst + i);
+}
+
+void HexEncodeNeon(const uint8_t *src, size_t length, char *dst) {
+  const uint8x16_t digits = vld1q_u8(reinterpret_cast<const uint8_t *>(HEX_DIGITS));
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const uint8x16_t bytes = vld1q_u8(src + i);
+    uint8x16x2_t pairs;
+    pairs.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(bytes, 4));
+    pairs.val[1] = vqtbl1q_u8(digits, vandq_u8(bytes, vdupq_n_u8(0x0F)));
+    vst2q_u8(reinterpret_cast<uint8_t *>(dst + 2 * i), pairs);
+  }
+  HexEncodeScalar(src + i, length - i, dst + 2 * i);
+}
+
+#endif
+
+CpuDispatchLevel GetLevelOverride(CpuDispatchLevel detected) {
+  const char *env_p = std::getenv("ARROW_ODBC_CPU_DISPATCH");
+  if (!env_p) {
+    return detected;
+  }
+
+  std::string value(env_p);
+  std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+  CpuDispatchLevel requested = detected;
+  if (value == "scalar") {
+    requested = CpuDispatchLevel_SCALAR;
+  } else if (value == "sse4.2") {
+    requested = CpuDispatchLevel_SSE4_2;
+  } else if (value == "avx2") {
+    requested = CpuDispatchLevel_AVX2;
+  } else if (value == "avx512") {
+    requested = CpuDispatchLevel_AVX512;
+  } else if (value == "neon") {
+    requested = CpuDispatchLevel_NEON;
+  }
+
+  // The override can only lower the level, never enable an unsupported instruction set.
+  if (requested == CpuDispatchLevel_SCALAR ||
+      (requested <= detected && detected != CpuDispatchLevel_NEON)) {
+    return requested;
+  }
+  return detected;
+}
+
+} // namespace
+
+CpuDispatchLevel DetectCpuDispatchLevel() {
+#if defined(ODBCABSTRACTION_X86_64)
+  return DetectX86Level();
+#elif defined(ODBCABSTRACTION_ARM64)
+  // NEON is mandatory on AArch64.
+  return CpuDispatchLevel_NEON;
+#else
+  return CpuDispatchLevel_SCALAR;
+#endif
+}
+
+CpuKernels MakeCpuKernels(CpuDispatchLevel level) {
+  CpuKernels kernels{CpuDispatchLevel_SCALAR, ExpandValidityScalar, UnpackBitsScalar,
+                     AsciiToUtf16Scalar, AsciiToUtf32Scalar, StridedCopyScalar,
+                     HexEncodeScalar};
+
+  switch (level) {
+#if defined(ODBCABSTRACTION_X86_64)
+    case CpuDispatchLevel_AVX512:
+      kernels.level = CpuDispatchLevel_AVX512;
+      kernels.expand_validity = ExpandValidityAvx512;
+      kernels.unpack_bits = UnpackBitsAvx512;
+      kernels.ascii_to_utf16 = AsciiToUtf16Avx512;
+      kernels.ascii_to_utf32 = AsciiToUtf32Avx512;
+      // Hex encoding is bound by the byte shuffles, wider registers don't pay off.
+      kernels.hex_encode = HexEncodeAvx2;
+      break;
+    case CpuDispatchLevel_AVX2:
+      kernels.level = CpuDispatchLevel_AVX2;
+      kernels.expand_validity = ExpandValidityAvx2;
+      kernels.unpack_bits = UnpackBitsAvx2;
+      kernels.ascii_to_utf16 = AsciiToUtf16Avx2;
+      kernels.ascii_to_utf32 = AsciiToUtf32Avx2;
+      kernels.hex_encode = HexEncodeAvx2;
+      break;
+    case CpuDispatchLevel_SSE4_2:
+      kernels.level = CpuDispatchLevel_SSE4_2;
+      kernels.expand_validity = ExpandValiditySse42;
+      kernels.unpack_bits = UnpackBitsSse42;
+      kernels.ascii_to_utf16 = AsciiToUtf16Sse42;
+      kernels.ascii_to_utf32 = AsciiToUtf32Sse42;
+      kernels.hex_encode = HexEncodeSse42;
+      break;
+#elif defined(ODBCABSTRACTION_ARM64)
+    case CpuDispatchLevel_NEON:
+      kernels.level = CpuDispatchLevel_NEON;
+      kernels.expand_validity = ExpandValidityNeon;
+      kernels.unpack_bits = UnpackBitsNeon;
+      kernels.ascii_to_utf16 = AsciiToUtf16Neon;
+      kernels.ascii_to_utf32 = AsciiToUtf32Neon;
+      kernels.hex_encode = HexEncodeNeon;
+      break;
+#endif
+    default:
+      break;
+  }
+
+  return kernels;
+}
+
+const CpuKernels &GetCpuKernels() {
+  // Probed on the first fetch rather than while the driver loads, so that applications
+  // that only connect don't pay for it.
+  static const CpuKernels kernels = [] {
+    const CpuKernels selected = MakeCpuKernels(GetLevelOverride(DetectCpuDispatchLevel()));
+    LOG_INFO("Using {} fetch kernels", CpuDispatchLevelToString(selected.level));
+    return selected;
+  }();
+  return kernels;
+}
+
+const char *CpuDispatchLevelToString(CpuDispatchLevel level) {
+  switch (level) {
+    case CpuDispatchLevel_SSE4_2:
+      return "sse4.2";
+    case CpuDispatchLevel_AVX2:
+      return "avx2";
+    case CpuDispatchLevel_AVX512:
+      return "avx512";
+    case CpuDispatchLevel_NEON:
+      return "neon";
+    default:
+      return "scalar";
+  }
+}
+
+} // namespace odbcabstraction
+} // namespace driver
@@ -24,9 +24,13 @@ namespace odbcabstraction {
 
 Diagnostics::Diagnostics(
     std::string vendor, std::string data_source_component, OdbcVersion version) :
+      first_aggregated_error_(0),
+      first_aggregated_warning_(0),
       vendor_(std::move(vendor)),
       data_source_component_(std::move(data_source_component)),
-      version_(version)
+      version_(version),
+      row_number_(NO_ROW_NUMBER),
+      column_number_(NO_COLUMN_NUMBER)
 {}
 
 void Diagnostics::SetDataSourceComponent(std::string component) {
@@ -42,25 +46,27 @@ std::string Diagnostics::GetVendor() const {
 }
 
 void driver::odbcabstraction::Diagnostics::AddError(
-    const driver::odbcabstraction::DriverException &exception) {
+    const driver::odbcabstraction::DriverException &exception, int64_t row_offset) {
   auto record = std::unique_ptr<DiagnosticsRecord>(new DiagnosticsRecord{
     exception.GetMessageText(), exception.GetSqlState(), exception.GetNativeError()});
   if (version_ == OdbcVersion::V_2) {
     RewriteSQLStateForODBC2(record->sql_state_);
   }
-  TrackRecord(*record);
-  owned_records_.push_back(std::move(record));
+  if (TrackRecord(*record, row_offset)) {
+    owned_records_.push_back(std::move(record));
+  }
 }
 
 void driver::odbcabstraction::Diagnostics::AddWarning(
-    std::string message, std::string sql_state, int32_t native_error) {
+    std::string message, std::string sql_state, int32_t native_error, int64_t row_offset) {
 auto record = std::unique_ptr<DiagnosticsRecord>(new DiagnosticsRecord{
       std::move(message),std::move(sql_state), native_error});
   if (version_ == OdbcVersion::V_2) {
     RewriteSQLStateForODBC2(record->sql_state_);
   }
-  TrackRecord(*record);
-  owned_records_.push_back(std::move(record));
+  if (TrackRecord(*record, row_offset)) {
+    owned_records_.push_back(std::move(record));
+  }
 }
 
 std::string driver::odbcabstraction::Diagnostics::GetMessageText(
@@ -70,7 +76,20 @@ std::string driver::odbcabstraction::Diagnostics::GetMessageText(
     message += std::string("[") + vendor_ + "]";
   }
   const DiagnosticsRecord* rec = GetRecordAtIndex(record_index);
-  return message + "[" + data_source_component_ + "] (" + std::to_string(rec->native_error_) + ") " + rec->msg_text_;
+  message += "[" + data_source_component_ + "] (" + std::to_string(rec->native_error_) + ") " + rec->msg_text_;
+
+  const RecordOccurrences& occurrences = GetRecordOccurrences(record_index);
+  if (occurrences.count_ > 1) {
+    message += " (Reported " + std::to_string(occurrences.count_) + " times";
+    if (occurrences.first_row_number_ != NO_ROW_NUMBER) {
+      message += ", first at row " + std::to_string(occurrences.first_row_number_);
+    }
+    if (occurrences.first_column_number_ != NO_COLUMN_NUMBER) {
+      message += ", column " + std::to_string(occurrences.first_column_number_);
+    }
+    message += ")";
+  }
+  return message;
 }
 
 OdbcVersion Diagnostics::GetOdbcVersion() const { return version_; }
@@ -50,5 +50,95 @@ void ComputeSqlWCharSize() {
 }
 #endif
 
+namespace {
+void AppendUtf8(char32_t code_point, std::vector<uint8_t> *result) {
+  if (code_point < 0x80) {
+    result->push_back(static_cast<uint8_t>(code_point));
+  } else if (code_point < 0x800) {
+    result->push_back(static_cast<uint8_t>(0xC0 | (code_point >> 6)));
+    result->push_back(static_cast<uint8_t>(0x80 | (code_point & 0x3F)));
+  } else if (code_point < 0x10000) {
+    result->push_back(static_cast<uint8_t>(0xE0 | (code_point >> 12)));
+    result->push_back(static_cast<uint8_t>(0x80 | ((code_point >> 6) & 0x3F)));
+    result->push_back(static_cast<uint8_t>(0x80 | (code_point & 0x3F)));
+  } else {
+    result->push_back(static_cast<uint8_t>(0xF0 | (code_point >> 18)));
+    result->push_back(static_cast<uint8_t>(0x80 | ((code_point >> 12) & 0x3F)));
+    result->push_back(static_cast<uint8_t>(0x80 | ((code_point >> 6) & 0x3F)));
+    result->push_back(static_cast<uint8_t>(0x80 | (code_point & 0x3F)));
+  }
+}
+
+char32_t ReadCodeUnit(const uint8_t *data, size_t code_unit_size) {
+  if (code_unit_size == sizeof(char16_t)) {
+    char16_t code_unit;
+    std::memcpy(&code_unit, data, sizeof(code_unit));
+    return code_unit;
+  }
+  char32_t code_unit;
+  std::memcpy(&code_unit, data, sizeof(code_unit));
+  return code_unit;
+}
+
+bool IsHighSurrogate(char32_t code_unit) {
+  return code_unit >= 0xD800 && code_unit <= 0xDBFF;
+}
+
+bool IsLowSurrogate(char32_t code_unit) {
+  return code_unit >= 0xDC00 && code_unit <= 0xDFFF;
+}
+}
+
+void WcsToUtf8Converter::Convert(const void *wcs_piece, size_t length_in_bytes,
+                                 std::vector<uint8_t> *result) {
+  const size_t code_unit_size = GetSqlWCharSize();
+  const auto *bytes = static_cast<const uint8_t *>(wcs_piece);
+
+  result->clear();
+  // A UTF-16 code unit takes at most three UTF-8 bytes, a UTF-32 one at most four.
+  result->reserve(length_in_bytes * 3 / 2 + sizeof(char32_t));
+
+  size_t pos = 0;
+  if (pending_size_ > 0) {
+    while (pending_size_ < code_unit_size && pos < length_in_bytes) {
+      pending_[pending_size_++] = bytes[pos++];
+    }
+    if (pending_size_ < code_unit_size) {
+      return;
+    }
+    pending_size_ = 0;
+    ConvertCodeUnit(ReadCodeUnit(pending_, code_unit_size), result);
+  }
+
+  for (; pos + code_unit_size <= length_in_bytes; pos += code_unit_size) {
+    ConvertCodeUnit(ReadCodeUnit(bytes + pos, code_unit_size), result);
+  }
+
+  while (pos < length_in_bytes) {
+    pending_[pending_size_++] = bytes[pos++];
+  }
+}
+
+void WcsToUtf8Converter::ConvertCodeUnit(char32_t code_unit, std::vector<uint8_t> *result) {
+  if (high_surrogate_ != 0) {
+    if (!IsLowSurrogate(code_unit)) {
+      throw DriverException("Invalid UTF-16 character data", "22018");
+    }
+    AppendUtf8(0x10000 + ((static_cast<char32_t>(high_surrogate_) - 0xD800) << 10) + (code_unit - 0xDC00),
+               result);
+    high_surrogate_ = 0;
+    return;
+  }
+
+  if (IsHighSurrogate(code_unit) && GetSqlWCharSize() == sizeof(char16_t)) {
+    high_surrogate_ = static_cast<char16_t>(code_unit);
+    return;
+  }
+  if (IsHighSurrogate(code_unit) || IsLowSurrogate(code_unit) || code_unit > 0x10FFFF) {
+    throw DriverException("Invalid wide character data", "22018");
+  }
+  AppendUtf8(code_unit, result);
+}
+
 } // namespace odbcabstraction
 } // namespace driver
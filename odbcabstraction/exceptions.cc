@@ -34,5 +34,9 @@ CommunicationException::CommunicationException(std::string message, std::string
 NullWithoutIndicatorException::NullWithoutIndicatorException(
     std::string message, std::string sql_state, int32_t native_error)
     : DriverException(message, sql_state, native_error) {}
+
+NumericValueOutOfRangeException::NumericValueOutOfRangeException(
+    std::string message, std::string sql_state, int32_t native_error)
+    : DriverException(message, sql_state, native_error) {}
 } // namespace odbcabstraction
 } // namespace driver
@@ -9,6 +9,7 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <functional>
 #include <thread>
 #include <vector>
 #include <boost/optional.hpp>
@@ -25,14 +26,16 @@ class BlockingQueue {
   size_t buffer_size_{0};
   size_t left_{0}; // index where variables are put inside of buffer (produced)
   size_t right_{0}; // index where variables are removed from buffer (consumed)
+  size_t reserved_{0}; // slots taken by TryReserve but not yet filled
 
   std::mutex mtx_;
   std::condition_variable not_empty_;
   std::condition_variable not_full_;
 
   std::vector<std::thread> threads_;
-  std::atomic<size_t> active_threads_{0};
+  std::atomic<size_t> active_threads_{0}; // producer threads and external producers
   std::atomic<bool> closed_{false};
+  std::function<void()> not_full_listener_;
 
 public:
   typedef std::function<boost::optional<T>(void)> Supplier;
@@ -73,6 +76,63 @@ public:
     not_empty_.notify_one();
   }
 
+  /// \brief Registers a producer that is driven from outside the queue, e.g. by an
+  /// I/O pool, instead of by a thread of its own. Consumers keep waiting for items
+  /// until RemoveExternalProducer is called for it.
+  void AddExternalProducer() {
+    active_threads_++;
+  }
+
+  void RemoveExternalProducer() {
+    std::unique_lock<std::mutex> unique_lock(mtx_);
+    active_threads_--;
+    not_empty_.notify_all();
+  }
+
+  /// \brief Reserves room for one item without blocking.
+  /// \return false if the queue is full or closed.
+  bool TryReserve() {
+    std::unique_lock<std::mutex> unique_lock(mtx_);
+    if (closed_ || buffer_size_ + reserved_ == capacity_) return false;
+    reserved_++;
+    return true;
+  }
+
+  /// \brief Pushes an item into the room taken by a successful TryReserve.
+  void PushReserved(T item) {
+    std::unique_lock<std::mutex> unique_lock(mtx_);
+    reserved_--;
+    if (closed_) return;
+
+    buffer_[right_] = std::move(item);
+
+    right_ = (right_ + 1) % capacity_;
+    buffer_size_++;
+
+    not_empty_.notify_one();
+  }
+
+  /// \brief Gives back the room taken by a successful TryReserve.
+  void CancelReservation() {
+    std::unique_lock<std::mutex> unique_lock(mtx_);
+    reserved_--;
+    not_full_.notify_one();
+    unique_lock.unlock();
+
+    NotifyNotFullListener();
+  }
+
+  bool Empty() {
+    std::unique_lock<std::mutex> unique_lock(mtx_);
+    return buffer_size_ == 0;
+  }
+
+  /// \brief Sets a function called whenever room is freed, without the queue lock
+  /// held. Must be set before items are popped.
+  void SetNotFullListener(std::function<void()> listener) {
+    not_full_listener_ = std::move(listener);
+  }
+
   bool Pop(T *result) {
     std::unique_lock<std::mutex> unique_lock(mtx_);
     if (!WaitUntilCanPopOrClosed(unique_lock)) return false;
@@ -83,7 +143,9 @@ public:
     buffer_size_--;
 
     not_full_.notify_one();
+    unique_lock.unlock();
 
+    NotifyNotFullListener();
     return true;
   }
 
@@ -103,9 +165,15 @@ public:
   }
 
 private:
+  void NotifyNotFullListener() {
+    if (not_full_listener_) {
+      not_full_listener_();
+    }
+  }
+
   bool WaitUntilCanPushOrClosed(std::unique_lock<std::mutex> &unique_lock) {
     not_full_.wait(unique_lock, [this]() {
-      return closed_ || buffer_size_ != capacity_;
+      return closed_ || buffer_size_ + reserved_ != capacity_;
     });
     return !closed_;
   }
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#pragma once
+
+#include <odbcabstraction/spi/connection.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace driver {
+namespace odbcabstraction {
+
+/// \brief Limits applied to the connections idling in a ConnectionPool.
+struct ConnectionPoolSettings {
+  /// Idle connections kept per set of connection properties.
+  size_t max_idle_per_key = 8;
+  /// Idle connections are closed once they have not been used for this long.
+  std::chrono::milliseconds max_idle_time = std::chrono::minutes(5);
+  /// Connections are closed rather than pooled once they are this old.
+  std::chrono::milliseconds max_lifetime = std::chrono::minutes(30);
+  /// Idle connections are checked with Connection::IsAlive() this often, which also
+  /// keeps their server session from expiring.
+  std::chrono::milliseconds keepalive_interval = std::chrono::minutes(1);
+};
+
+/// \brief Counters of a ConnectionPool.
+struct ConnectionPoolStatistics {
+  int64_t hits = 0;
+  int64_t misses = 0;
+  /// Connections closed for reaching max_idle_time or max_lifetime.
+  int64_t expired = 0;
+  /// Connections closed because a health check or state reset failed.
+  int64_t broken = 0;
+  size_t idle = 0;
+};
+
+/// \brief Authenticated connections kept across disconnects, keyed by the connection
+/// properties they were established with.
+///
+/// Connections are reset with Connection::Reset() before being pooled. A background
+/// thread closes expired connections and health checks the idle ones.
+class ConnectionPool {
+public:
+  typedef std::chrono::steady_clock Clock;
+  typedef std::function<Clock::time_point()> TimeSource;
+
+  /// \param now the time expiry and health checks are measured against.
+  explicit ConnectionPool(ConnectionPoolSettings settings = ConnectionPoolSettings(),
+                          TimeSource now = Clock::now);
+
+  ~ConnectionPool();
+
+  /// \brief Returns the pool shared by all environments of the process, used for
+  /// SQL_CP_ONE_PER_DRIVER.
+  static std::shared_ptr<ConnectionPool> GetDriverPool();
+
+  /// \brief Builds the key connections established with dsn and properties are
+  /// pooled under. Property names are compared case-insensitively. Connections
+  /// created for different ODBC versions report diagnostics differently, so
+  /// odbc_version is part of the key.
+  static std::string MakeKey(const std::string &dsn, const Connection::ConnPropertyMap &properties,
+                             OdbcVersion odbc_version);
+
+  /// \brief Takes an idle connection established with key.
+  /// \param connected_at[out] when the returned connection was established.
+  /// \return the connection, or null if none is available.
+  std::shared_ptr<Connection> Acquire(const std::string &key, Clock::time_point *connected_at);
+
+  /// \brief Gives back a connected connection once its user disconnected. The
+  /// connection is closed instead if it can't be reset, is too old or the pool is full.
+  void Release(const std::string &key, std::shared_ptr<Connection> connection,
+               Clock::time_point connected_at);
+
+  ConnectionPoolStatistics GetStatistics();
+
+  /// \brief Closes the expired idle connections and health checks the ones not
+  /// checked for keepalive_interval. The background thread calls it periodically.
+  void Maintain();
+
+private:
+  struct Entry {
+    std::shared_ptr<Connection> connection;
+    Clock::time_point created;
+    Clock::time_point last_used;
+    Clock::time_point last_checked;
+  };
+
+  const ConnectionPoolSettings settings_;
+  const TimeSource now_;
+  std::mutex mutex_;
+  std::condition_variable stop_requested_;
+  /// Most recently used connections are at the back of each deque.
+  std::map<std::string, std::deque<Entry>> idle_;
+  ConnectionPoolStatistics statistics_;
+  bool stopping_;
+  std::thread maintenance_thread_;
+
+  void RunMaintenance();
+  bool IsExpired(const Entry &entry, Clock::time_point now) const;
+  static void CloseQuietly(const std::shared_ptr<Connection> &connection);
+};
+
+} // namespace odbcabstraction
+} // namespace driver
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#pragma once
+
+#include <odbcabstraction/spi/connection.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace driver {
+namespace odbcabstraction {
+
+/// \brief Attributes of a connection string.
+struct ConnectionString {
+  /// The DSN to load properties from, empty if the Driver key came first or no DSN
+  /// was given.
+  std::string dsn;
+  /// Remaining key-value pairs in the order they appear, without the DSN and Driver
+  /// keys. Values have their wrapping curly braces stripped.
+  std::vector<std::pair<std::string, std::string>> attributes;
+};
+
+/// \brief Parses key-value pairs separated by semi-colons in a single pass.
+///
+/// Values wrapped in curly braces may contain semi-colons and equals signs; such a value
+/// ends at the first closing brace followed by a semi-colon or the end of the string.
+/// Spaces around keys are ignored and pairs without a key or value are skipped.
+ConnectionString ParseConnectionString(const std::string &conn_str);
+
+/// \brief Process-wide cache of parsed connection strings and of the properties loaded
+/// from DSNs.
+///
+/// Cached DSN properties are dropped whenever one of the odbc.ini files unixODBC or
+/// iODBC read changes modification time or size.
+class ConnectionStringCache {
+public:
+  /// Loads the properties of a DSN, as read from odbc.ini.
+  typedef std::function<void(const std::string &dsn, PropertyMap &properties)> DsnLoader;
+
+  static ConnectionStringCache &GetInstance();
+
+  /// \brief Returns the parsed form of conn_str, parsing it on first use.
+  ///
+  /// Connection strings holding a password or token are parsed on every call rather
+  /// than kept in memory.
+  std::shared_ptr<const ConnectionString> Parse(const std::string &conn_str);
+
+  /// \brief Returns the properties of dsn, calling loader if they aren't cached or
+  /// odbc.ini changed since they were loaded.
+  std::shared_ptr<const PropertyMap> GetDsnProperties(const std::string &dsn,
+                                                      const DsnLoader &loader);
+
+private:
+  /// Bounds the memory used by applications generating connection strings.
+  static constexpr size_t MAX_CONNECTION_STRINGS = 64;
+
+  typedef std::vector<std::pair<int64_t, int64_t>> FileStamps;
+
+  std::mutex mutex_;
+  std::map<std::string, std::shared_ptr<const ConnectionString>> connection_strings_;
+  std::map<std::string, std::shared_ptr<const PropertyMap>, CaseInsensitiveComparator> dsns_;
+  FileStamps odbc_ini_stamps_;
+
+  static FileStamps GetOdbcIniStamps();
+};
+
+} // namespace odbcabstraction
+} // namespace driver
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#pragma once
+
+#include <odbcabstraction/platform.h>
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(_WIN32)
+#include <sys/types.h>
+#endif
+
+namespace driver {
+namespace odbcabstraction {
+
+/// \brief Instruction set levels a kernel table can be bound to.
+enum CpuDispatchLevel {
+  CpuDispatchLevel_SCALAR = 0,
+  CpuDispatchLevel_SSE4_2,
+  CpuDispatchLevel_AVX2,
+  CpuDispatchLevel_AVX512,
+  CpuDispatchLevel_NEON
+};
+
+/// \brief Table of fetch-path kernels bound to a single instruction set level.
+///
+/// All kernels accept unaligned pointers and bitmaps starting at any bit offset.
+/// Kernels without a specialised variant for a level are bound to the scalar version.
+struct CpuKernels {
+  CpuDispatchLevel level;
+
+  /// \brief Writes value_length to indicators[i] for every valid row and NULL_DATA for
+  /// every null row of the validity bitmap. A null bitmap means all rows are valid.
+  void (*expand_validity)(const uint8_t *validity, int64_t offset, int64_t length,
+                          ssize_t value_length, ssize_t *indicators);
+
+  /// \brief Unpacks length bits starting at offset into one byte per bit, holding 0 or 1.
+  void (*unpack_bits)(const uint8_t *bitmap, int64_t offset, int64_t length, uint8_t *out);
+
+  /// \brief Widens the leading ASCII run of src into UTF-16 code units.
+  /// \return the number of bytes transcoded, stopping at the first non-ASCII byte.
+  size_t (*ascii_to_utf16)(const char *src, size_t length, char16_t *dst);
+
+  /// \brief Widens the leading ASCII run of src into UTF-32 code units.
+  /// \return the number of bytes transcoded, stopping at the first non-ASCII byte.
+  size_t (*ascii_to_utf32)(const char *src, size_t length, char32_t *dst);
+
+  /// \brief Copies count values of width bytes laid out contiguously in src into dst,
+  /// placing consecutive values stride bytes apart (row-wise binding).
+  void (*strided_copy)(const uint8_t *src, size_t width, size_t count, uint8_t *dst, size_t stride);
+
+  /// \brief Writes the upper-case hexadecimal digits of length bytes of src into dst,
+  /// two characters per byte and without a NUL terminator.
+  void (*hex_encode)(const uint8_t *src, size_t length, char *dst);
+};
+
+/// \brief Returns the highest level supported by the running CPU, ignoring any override.
+CpuDispatchLevel DetectCpuDispatchLevel();
+
+/// \brief Builds the kernel table for the given level.
+/// \note The caller must make sure the level is supported by the running CPU.
+CpuKernels MakeCpuKernels(CpuDispatchLevel level);
+
+/// \brief Returns the kernel table used by the driver.
+///
+/// CPU features are detected once, on first use. Setting the environment variable
+/// ARROW_ODBC_CPU_DISPATCH to "scalar" forces the scalar kernels, and setting it to
+/// another level name ("sse4.2", "avx2", "avx512", "neon") caps the level used.
+const CpuKernels &GetCpuKernels();
+
+const char *CpuDispatchLevelToString(CpuDispatchLevel level);
+
+} // namespace odbcabstraction
+} // namespace driver
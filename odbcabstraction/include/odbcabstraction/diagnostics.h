@@ -15,6 +15,11 @@
 
 namespace driver {
 namespace odbcabstraction {
+  /// Row and column numbers reported when a record isn't tied to a position, matching
+  /// SQL_NO_ROW_NUMBER and SQL_NO_COLUMN_NUMBER.
+  constexpr int64_t NO_ROW_NUMBER = -1;
+  constexpr int32_t NO_COLUMN_NUMBER = -1;
+
   class Diagnostics {
   public:
     struct DiagnosticsRecord {
@@ -23,34 +28,113 @@ namespace odbcabstraction {
       int32_t native_error_;
     };
 
+    /// \brief How many times a record was raised since the last Clear(), and the
+    /// rowset position of its first occurrence.
+    struct RecordOccurrences {
+      size_t count_;
+      int64_t first_row_number_;
+      int32_t first_column_number_;
+    };
+
   private:
+    // Identical records are kept once with a repeat count, so the number of records
+    // stays bounded by the number of distinct conditions rather than the rowset size.
     std::vector<const DiagnosticsRecord*> error_records_;
     std::vector<const DiagnosticsRecord*> warning_records_;
+    std::vector<RecordOccurrences> error_occurrences_;
+    std::vector<RecordOccurrences> warning_occurrences_;
+    // Records before these indices were added by an earlier fetch and are not folded into.
+    size_t first_aggregated_error_;
+    size_t first_aggregated_warning_;
     std::vector<std::unique_ptr<DiagnosticsRecord>> owned_records_;
     std::string vendor_;
     std::string data_source_component_;
     OdbcVersion version_;
+    int64_t row_number_;
+    int32_t column_number_;
 
   public:
     Diagnostics(std::string vendor, std::string data_source_component, OdbcVersion version);
-    void AddError(const DriverException& exception);
-    void AddWarning(std::string message, std::string sql_state, int32_t native_error);
+
+    /// \param row_offset offset of the offending row from the row set with SetRecordPosition().
+    void AddError(const DriverException& exception, int64_t row_offset = 0);
+    void AddWarning(std::string message, std::string sql_state, int32_t native_error,
+                    int64_t row_offset = 0);
 
     /// \brief Add a pre-existing truncation warning.
-    inline void AddTruncationWarning() {
+    /// \param row_offset offset of the truncated row from the row set with SetRecordPosition().
+    inline void AddTruncationWarning(int64_t row_offset = 0) {
       static const std::unique_ptr<DiagnosticsRecord> TRUNCATION_WARNING(new DiagnosticsRecord {
           "String or binary data, right-truncated.", "01004",
           ODBCErrorCodes_TRUNCATION_WARNING
       });
-      warning_records_.push_back(TRUNCATION_WARNING.get());
+      TrackRecord(*TRUNCATION_WARNING, row_offset);
+    }
+
+    /// \brief Add a pre-existing fractional truncation warning, raised when a number
+    /// loses its fractional digits on conversion.
+    /// \param row_offset offset of the truncated row from the row set with SetRecordPosition().
+    inline void AddFractionalTruncationWarning(int64_t row_offset = 0) {
+      static const std::unique_ptr<DiagnosticsRecord> FRACTIONAL_TRUNCATION_WARNING(new DiagnosticsRecord {
+          "Fractional truncation", "01S07",
+          ODBCErrorCodes_FRACTIONAL_TRUNCATION_WARNING
+      });
+      TrackRecord(*FRACTIONAL_TRUNCATION_WARNING, row_offset);
+    }
+
+    /// \brief Add a pre-existing error for a number that doesn't fit in its target type.
+    /// \param row_offset offset of the offending row from the row set with SetRecordPosition().
+    inline void AddNumericOutOfRangeError(int64_t row_offset = 0) {
+      static const std::unique_ptr<DiagnosticsRecord> OUT_OF_RANGE_ERROR(new DiagnosticsRecord {
+          "Numeric value out of range", "22003",
+          ODBCErrorCodes_GENERAL_ERROR
+      });
+      TrackRecord(*OUT_OF_RANGE_ERROR, row_offset);
     }
 
-    inline void TrackRecord(const DiagnosticsRecord& record) {
-      if (record.sql_state_[0] == '0' && record.sql_state_[1] == '1') {
-        warning_records_.push_back(&record);
-      } else {
-        error_records_.push_back(&record);
+    /// \brief Tracks the record, or bumps the repeat count of an identical record.
+    /// \return true if the record was added, false if it was folded into an existing one.
+    inline bool TrackRecord(const DiagnosticsRecord& record, int64_t row_offset = 0) {
+      const bool is_warning = record.sql_state_[0] == '0' && record.sql_state_[1] == '1';
+      auto &records = is_warning ? warning_records_ : error_records_;
+      auto &occurrences = is_warning ? warning_occurrences_ : error_occurrences_;
+
+      for (size_t i = is_warning ? first_aggregated_warning_ : first_aggregated_error_;
+           i < records.size(); ++i) {
+        const DiagnosticsRecord *existing = records[i];
+        if (existing == &record ||
+            (existing->native_error_ == record.native_error_ &&
+             existing->sql_state_ == record.sql_state_ &&
+             existing->msg_text_ == record.msg_text_)) {
+          ++occurrences[i].count_;
+          return false;
+        }
       }
+
+      records.push_back(&record);
+      occurrences.push_back(RecordOccurrences{
+          1, row_number_ == NO_ROW_NUMBER ? NO_ROW_NUMBER : row_number_ + row_offset,
+          column_number_});
+      return true;
+    }
+
+    /// \brief Sets the 1-based rowset row and column that records added from now on
+    /// refer to. Accessors add the offset of the cell they are converting.
+    inline void SetRecordPosition(int64_t row_number, int32_t column_number) {
+      row_number_ = row_number;
+      column_number_ = column_number;
+    }
+
+    inline void ClearRecordPosition() {
+      SetRecordPosition(NO_ROW_NUMBER, NO_COLUMN_NUMBER);
+    }
+
+    /// \brief Starts a new fetch: records added from now on are folded into each other
+    /// but not into the records already present, so that repeat counts and first
+    /// positions describe a single fetch.
+    inline void StartAggregation() {
+      first_aggregated_error_ = error_records_.size();
+      first_aggregated_warning_ = warning_records_.size();
     }
 
     void SetDataSourceComponent(std::string component);
@@ -61,7 +145,12 @@ namespace odbcabstraction {
     inline void Clear() {
       error_records_.clear();
       warning_records_.clear();
+      error_occurrences_.clear();
+      warning_occurrences_.clear();
       owned_records_.clear();
+      first_aggregated_error_ = 0;
+      first_aggregated_warning_ = 0;
+      ClearRecordPosition();
     }
 
     std::string GetMessageText(uint32_t record_index) const;
@@ -73,6 +162,25 @@ namespace odbcabstraction {
       return GetRecordAtIndex(record_index)->native_error_;
     }
 
+    const RecordOccurrences &GetRecordOccurrences(uint32_t record_index) const {
+      if (record_index < error_occurrences_.size()) {
+        return error_occurrences_[record_index];
+      }
+      return warning_occurrences_[record_index - error_occurrences_.size()];
+    }
+
+    /// \brief Value of SQL_DIAG_ROW_NUMBER: the rowset row of the first occurrence of
+    /// the record, or NO_ROW_NUMBER.
+    int64_t GetRowNumber(uint32_t record_index) const {
+      return GetRecordOccurrences(record_index).first_row_number_;
+    }
+
+    /// \brief Value of SQL_DIAG_COLUMN_NUMBER: the column of the first occurrence of
+    /// the record, or NO_COLUMN_NUMBER.
+    int32_t GetColumnNumber(uint32_t record_index) const {
+      return GetRecordOccurrences(record_index).first_column_number_;
+    }
+
     inline size_t GetRecordCount() const {
       return error_records_.size() + warning_records_.size();
     }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <odbcabstraction/exceptions.h>
+#include <odbcabstraction/cpu_dispatch.h>
 #include <cassert>
 #include <codecvt>
 #include <cstring>
@@ -61,8 +62,23 @@ inline size_t wcsstrlen(const void *wcs_string) {
 
 }
 
+inline size_t AsciiToWcs(const char *ascii_string, size_t length, char16_t *result) {
+  return GetCpuKernels().ascii_to_utf16(ascii_string, length, result);
+}
+
+inline size_t AsciiToWcs(const char *ascii_string, size_t length, char32_t *result) {
+  return GetCpuKernels().ascii_to_utf32(ascii_string, length, result);
+}
+
 template<typename CHAR_TYPE>
 inline void Utf8ToWcs(const char *utf8_string, size_t length, std::vector<uint8_t> *result) {
+  // Most values are plain ASCII, which widens one code unit per byte without going
+  // through the codecvt facet.
+  result->resize(length * sizeof(CHAR_TYPE));
+  if (AsciiToWcs(utf8_string, length, reinterpret_cast<CHAR_TYPE *>(result->data())) == length) {
+    return;
+  }
+
   thread_local std::wstring_convert<std::codecvt_utf8<CHAR_TYPE>, CHAR_TYPE> converter;
   auto string = converter.from_bytes(utf8_string, utf8_string + length);
 
@@ -117,5 +133,33 @@ inline void WcsToUtf8(const void *wcs_string, std::vector<uint8_t> *result) {
   return WcsToUtf8(wcs_string, wcsstrlen(wcs_string), result);
 }
 
+/// \brief Converts SQLWCHAR text supplied in pieces to UTF-8.
+///
+/// Pieces may end in the middle of a code unit or of a UTF-16 surrogate pair, the
+/// incomplete character being carried over to the next piece.
+class WcsToUtf8Converter {
+public:
+  /// \brief Converts the next length bytes of text, replacing the contents of result.
+  /// Throws a DriverException if the text isn't valid UTF-16 or UTF-32.
+  void Convert(const void *wcs_piece, size_t length_in_bytes, std::vector<uint8_t> *result);
+
+  /// \brief Returns true if the pieces so far end with an incomplete character.
+  bool HasPendingCharacter() const {
+    return pending_size_ > 0 || high_surrogate_ != 0;
+  }
+
+  void Reset() {
+    pending_size_ = 0;
+    high_surrogate_ = 0;
+  }
+
+private:
+  uint8_t pending_[sizeof(char32_t)];
+  size_t pending_size_ = 0;
+  char16_t high_surrogate_ = 0;
+
+  void ConvertCodeUnit(char32_t code_unit, std::vector<uint8_t> *result);
+};
+
 }
 }
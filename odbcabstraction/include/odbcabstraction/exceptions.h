@@ -55,5 +55,14 @@ public:
       int32_t native_error = ODBCErrorCodes_INDICATOR_NEEDED);
 };
 
+/// \brief Error when a value doesn't fit in the C type it is retrieved as.
+/// Accessors report it on the row when a row status array is given.
+class NumericValueOutOfRangeException : public DriverException {
+public:
+  explicit NumericValueOutOfRangeException(
+      std::string message = "Numeric value out of range", std::string sql_state = "22003",
+      int32_t native_error = ODBCErrorCodes_GENERAL_ERROR);
+};
+
 } // namespace odbcabstraction
 } // namespace driver
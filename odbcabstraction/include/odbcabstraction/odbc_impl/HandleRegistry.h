@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ODBC
+{
+/**
+ * @brief Owns the child handles allocated on a parent handle.
+ *
+ * Each handle stores its own position in the registry (see ODBCHandle), so removing a
+ * handle is O(1): the last handle is moved into the freed slot. Handles are therefore
+ * not kept in allocation order.
+ */
+template <typename T>
+class HandleRegistry {
+  public:
+    typedef typename std::vector<std::shared_ptr<T> >::const_iterator const_iterator;
+
+    void add(std::shared_ptr<T> handle) {
+      handle->m_registryIndex = m_handles.size();
+      m_handles.push_back(std::move(handle));
+    }
+
+    /**
+     * @brief Removes a handle from the registry.
+     * @return the removed handle, or null if it wasn't registered here.
+     */
+    std::shared_ptr<T> remove(T* handle) {
+      const size_t index = handle->m_registryIndex;
+      if (index >= m_handles.size() || m_handles[index].get() != handle) {
+        return nullptr;
+      }
+
+      std::shared_ptr<T> removed = std::move(m_handles[index]);
+      if (index != m_handles.size() - 1) {
+        m_handles[index] = std::move(m_handles.back());
+        m_handles[index]->m_registryIndex = index;
+      }
+      m_handles.pop_back();
+      return removed;
+    }
+
+    void clear() {
+      m_handles.clear();
+    }
+
+    bool empty() const {
+      return m_handles.empty();
+    }
+
+    size_t size() const {
+      return m_handles.size();
+    }
+
+    const_iterator begin() const {
+      return m_handles.begin();
+    }
+
+    const_iterator end() const {
+      return m_handles.end();
+    }
+
+  private:
+    std::vector<std::shared_ptr<T> > m_handles;
+};
+
+}
@@ -6,12 +6,16 @@
 
 #pragma once
 
+#include <odbcabstraction/odbc_impl/HandleRegistry.h>
 #include <odbcabstraction/odbc_impl/ODBCHandle.h>
 
 #include <sql.h>
+#include <functional>
+#include <future>
 #include <memory>
 #include <vector>
 #include <map>
+#include <odbcabstraction/connection_pool.h>
 #include <odbcabstraction/spi/connection.h>
 
 namespace ODBC
@@ -41,11 +45,26 @@ class ODBCConnection : public ODBCHandle<ODBCConnection> {
     void connect(std::string dsn, const driver::odbcabstraction::Connection::ConnPropertyMap &properties,
                        std::vector<std::string> &missing_properties);
 
+    /**
+     * @brief Asynchronous forms of connect and disconnect, for ODBC 3.8 asynchronous
+     * connection functions.
+     *
+     * While SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE is on, the first call starts the operation
+     * on a background thread and returns SQL_STILL_EXECUTING. Calling the same function
+     * again polls it, returning SQL_STILL_EXECUTING until it completes and then its result.
+     * Other functions fail with HY010 while it runs. With the attribute off, the operation
+     * runs inline.
+     */
+    SQLRETURN connectAsync(std::string dsn, const driver::odbcabstraction::Connection::ConnPropertyMap &properties,
+                           std::vector<std::string> &missing_properties);
+    SQLRETURN disconnectAsync();
+
     void GetInfo(SQLUSMALLINT infoType, SQLPOINTER value, SQLSMALLINT bufferLength, SQLSMALLINT* outputLength, bool isUnicode);
     void SetConnectAttr(SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER stringLength, bool isUnicode);
     void GetConnectAttr(SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER bufferLength, SQLINTEGER* outputLength, bool isUnicode);
 
-    ~ODBCConnection() = default;
+    // Waits for a pending asynchronous operation, which refers to this connection.
+    ~ODBCConnection();
 
     inline ODBCStatement& GetTrackingStatement() {
       return *m_attributeTrackingStatement;
@@ -56,10 +75,12 @@ class ODBCConnection : public ODBCHandle<ODBCConnection> {
     void releaseConnection();
 
     std::shared_ptr<ODBCStatement> createStatement();
+    // Closes the cursor and releases the statement, or keeps it for reuse.
     void dropStatement(ODBCStatement* statement);
 
     std::shared_ptr<ODBCDescriptor> createDescriptor();
-    void dropDescriptor(ODBCDescriptor* descriptor);
+    // Returns the released descriptor, which is destroyed once the result goes out of scope.
+    std::shared_ptr<ODBCDescriptor> dropDescriptor(ODBCDescriptor* descriptor);
 
     inline bool IsOdbc2Connection() const {
       return m_is2xConnection;
@@ -76,11 +97,39 @@ class ODBCConnection : public ODBCHandle<ODBCConnection> {
     // set through the connection handle. These attributes get copied to new ODBC statements
     // when they are allocated.
     std::shared_ptr<ODBCStatement> m_attributeTrackingStatement;
-    std::vector<std::shared_ptr<ODBCStatement> > m_statements;
-    std::vector<std::shared_ptr<ODBCDescriptor> > m_descriptors;
+    HandleRegistry<ODBCStatement> m_statements;
+    HandleRegistry<ODBCDescriptor> m_descriptors;
+    // Freed statements kept for reuse by createStatement, already reset.
+    std::vector<std::shared_ptr<ODBCStatement> > m_freeStatements;
     std::string m_dsn;
+    // Set while connected through a pool, which gets the SPI connection back on disconnect.
+    std::shared_ptr<driver::odbcabstraction::ConnectionPool> m_pool;
+    std::string m_poolKey;
+    driver::odbcabstraction::ConnectionPool::Clock::time_point m_connectedAt;
+    // Reported by GetDiagnostics while an asynchronous operation runs.
+    driver::odbcabstraction::Diagnostics m_asyncDiagnostics;
     const bool m_is2xConnection;
     bool m_isConnected;
+
+    enum AsyncFunction {
+      AsyncFunction_NONE,
+      AsyncFunction_CONNECT,
+      AsyncFunction_DISCONNECT,
+    };
+
+    bool m_asyncEnabled;
+    AsyncFunction m_asyncFunction;
+    std::future<void> m_asyncResult;
+    std::vector<std::string> m_asyncMissingProperties;
+
+    // Run on the background thread for asynchronous calls.
+    void doConnect(std::string dsn, const driver::odbcabstraction::Connection::ConnPropertyMap &properties,
+                   std::vector<std::string> &missing_properties);
+    void doDisconnect();
+
+    SQLRETURN runAsync(AsyncFunction function, std::function<void()> operation);
+    // Throws HY010 while an asynchronous function other than allowed is executing.
+    void throwIfAsyncExecuting(AsyncFunction allowed = AsyncFunction_NONE) const;
 };
 
 }
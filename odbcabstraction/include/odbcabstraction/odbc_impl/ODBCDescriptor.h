@@ -27,6 +27,9 @@ namespace ODBC {
 
 namespace ODBC
 {
+  // Driver-specific descriptor fields, starting at SQL_DRIVER_DESCRIPTOR_BASE.
+  constexpr SQLSMALLINT SQL_DESC_ARROW_IPC_SCHEMA = 0x4000; // Binary, read-only, IRD only
+
   struct DescriptorRecord {
     std::string m_baseColumnName;
     std::string m_baseTableName;
@@ -39,6 +42,7 @@ namespace ODBC
     std::string m_schemaName;
     std::string m_tableName;
     std::string m_typeName;
+    std::string m_arrowIpcSchema;
     SQLPOINTER m_dataPtr = NULL;
     SQLLEN* m_indicatorPtr = NULL;
     SQLLEN m_displaySize = 0;
@@ -94,6 +98,16 @@ namespace ODBC
       void DetachFromStatement(ODBCStatement* statement, bool isApd);
       void ReleaseDescriptor();
 
+      /**
+       * @brief Restores the records and header fields of a newly allocated descriptor.
+       */
+      void Reset();
+
+      /**
+       * @brief Drops all records, keeping the header fields.
+       */
+      void ClearRecords();
+
       void PopulateFromResultSetMetadata(driver::odbcabstraction::ResultSetMetadata* rsmd);
 
       const std::vector<DescriptorRecord>& GetRecords() const;
@@ -6,14 +6,19 @@
 
 #pragma once
 
+#include <odbcabstraction/odbc_impl/HandleRegistry.h>
 #include <odbcabstraction/odbc_impl/ODBCHandle.h>
 
 #include <sql.h>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace driver {
 namespace odbcabstraction {
+  class Connection;
+  class ConnectionPool;
   class Driver;
 }
 }
@@ -35,16 +40,25 @@ class ODBCEnvironment : public ODBCHandle<ODBCEnvironment> {
     void setODBCVersion(SQLINTEGER version);
     SQLINTEGER getConnectionPooling() const;
     void setConnectionPooling(SQLINTEGER pooling);
+    /// @return the pool selected by SQL_ATTR_CONNECTION_POOLING, or null when pooling is off.
+    std::shared_ptr<driver::odbcabstraction::ConnectionPool> getConnectionPool();
+    std::shared_ptr<driver::odbcabstraction::Connection> CreateSpiConnection();
     std::shared_ptr<ODBCConnection> CreateConnection();
     void DropConnection(ODBCConnection* conn);
+    /// Runs task on the driver's shared threads.
+    void SubmitTask(std::function<void()> task);
     ~ODBCEnvironment() = default;
 
   private:
-    std::vector<std::shared_ptr<ODBCConnection> > m_connections;
+    HandleRegistry<ODBCConnection> m_connections;
     std::shared_ptr<driver::odbcabstraction::Driver> m_driver;
     std::unique_ptr<driver::odbcabstraction::Diagnostics> m_diagnostics;
     SQLINTEGER m_version;
     SQLINTEGER m_connectionPooling;
+    // Pool used for SQL_CP_ONE_PER_HENV, created on first use. Guarded by
+    // m_connectionPoolMutex since asynchronous connects resolve it on their own thread.
+    std::shared_ptr<driver::odbcabstraction::ConnectionPool> m_connectionPool;
+    std::mutex m_connectionPoolMutex;
 };
 
 }
@@ -18,6 +18,9 @@
  */
 namespace ODBC {
 
+template <typename T>
+class HandleRegistry;
+
 template <typename Derived>
 class ODBCHandle {
 
@@ -79,6 +82,11 @@ public:
   }
 
 private:
+  template <typename T>
+  friend class HandleRegistry;
+
   std::mutex mtx_;
+  // Position of this handle in the HandleRegistry of its parent.
+  size_t m_registryIndex = 0;
 };
 }
@@ -8,15 +8,18 @@
 
 #include <odbcabstraction/odbc_impl/ODBCHandle.h>
 
+#include <odbcabstraction/encoding.h>
 #include <odbcabstraction/platform.h>
 #include <sql.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace driver {
 namespace odbcabstraction {
   class Statement;
   class ResultSet;
+  class ParameterWriter;
 }
 }
 
@@ -25,11 +28,22 @@ namespace ODBC {
   class ODBCDescriptor;
 }
 
+namespace ODBC
+{
+// Driver-specific statement attributes, starting at SQL_DRIVER_STMT_ATTR_BASE.
+// They map to the driver-specific attributes of the SPI Statement.
+constexpr SQLINTEGER SQL_ATTR_ARROW_EXPORT_PATH = 0x4000;           // String
+constexpr SQLINTEGER SQL_ATTR_ARROW_EXPORT_FORMAT = 0x4001;         // SQLULEN, ExportFormat
+constexpr SQLINTEGER SQL_ATTR_ARROW_EXPORT_COMPRESSION = 0x4002;    // SQLULEN, ExportCompression
+constexpr SQLINTEGER SQL_ATTR_ARROW_EXPORT_ROW_GROUP_SIZE = 0x4003; // SQLULEN
+constexpr SQLINTEGER SQL_ATTR_ARROW_EXPORT_ROW_COUNT = 0x4004;      // SQLULEN, read-only
+constexpr SQLINTEGER SQL_ATTR_ARROW_PARAMETER_STREAM = 0x4005;      // ArrowArrayStream*
+constexpr SQLINTEGER SQL_ATTR_ARROW_MERGE_SORT_KEYS = 0x4006;       // String
+constexpr SQLINTEGER SQL_ATTR_ARROW_PRIORITY = 0x4007;              // SQLULEN, StreamPriority
+
 /**
  * @brief An abstraction over an ODBC connection handle. This also wraps an SPI Connection.
  */
-namespace ODBC
-{
 class ODBCStatement : public ODBCHandle<ODBCStatement> {
   public:
     ODBCStatement(const ODBCStatement&) = delete;
@@ -48,9 +62,43 @@ class ODBCStatement : public ODBCHandle<ODBCStatement> {
 
     void CopyAttributesFromConnection(ODBCConnection& connection);
     void Prepare(const std::string& query);
-    void ExecutePrepared();
+
+    /**
+     * @brief Binds an input parameter of the prepared statement. Character and binary
+     * values are supported, and may be supplied at execution time through SQLPutData.
+     */
+    void BindParameter(SQLUSMALLINT parameterNumber, SQLSMALLINT inputOutputType, SQLSMALLINT valueType,
+                       SQLSMALLINT parameterType, SQLULEN columnSize, SQLSMALLINT decimalDigits,
+                       SQLPOINTER parameterValuePtr, SQLLEN bufferLength, SQLLEN* strLenOrIndPtr);
+
+    /**
+     * @brief Executes the prepared statement with the bound parameters.
+     * @return SQL_NEED_DATA if parameters are to be supplied through ParamData and
+     * PutData before the statement runs, SQL_SUCCESS otherwise.
+     */
+    SQLRETURN ExecutePrepared();
+
+    /**
+     * @brief Completes the data-at-execution parameter being supplied and moves to
+     * the next one, running the statement once all of them have been supplied.
+     * @param valuePtr set to the ParameterValuePtr the next parameter was bound with.
+     * @return SQL_NEED_DATA while parameters remain, SQL_SUCCESS once executed.
+     */
+    SQLRETURN ParamData(SQLPOINTER* valuePtr);
+
+    /**
+     * @brief Appends a piece of the value of the current data-at-execution parameter.
+     * Wide character pieces are transcoded to UTF-8 as they arrive.
+     */
+    void PutData(SQLPOINTER dataPtr, SQLLEN strLenOrInd);
     void ExecuteDirect(const std::string& query);
 
+    /**
+     * @brief Moves to the next result of a batch, closing the current cursor.
+     * @return false if there are no more results.
+     */
+    bool MoreResults();
+
     /**
      * @brief Returns true if the number of rows fetch was greater than zero.
      */
@@ -89,6 +137,13 @@ class ODBCStatement : public ODBCHandle<ODBCStatement> {
      */
     void releaseStatement();
 
+    /**
+     * @brief Restores the state of a newly allocated statement so that the connection
+     * can hand it out again.
+     * @return false if the SPI statement can't be reset.
+     */
+    bool Reset();
+
     void GetTables(const std::string* catalog, const std::string* schema, const std::string* table, const std::string* tableType);
     void GetColumns(const std::string* catalog, const std::string* schema, const std::string* table, const std::string* column);
     void GetTypeInfo(SQLSMALLINT dataType);
@@ -111,5 +166,24 @@ class ODBCStatement : public ODBCHandle<ODBCStatement> {
     SQLULEN m_rowsetSize; // Used by SQLExtendedFetch instead of the ARD array size.
     bool m_isPrepared;
     bool m_hasReachedEndOfResult;
+
+    // Parameters awaiting their value through PutData, as zero-based indexes, and the
+    // number of them handed to the application by ParamData so far.
+    std::vector<size_t> m_dataAtExecParameters;
+    size_t m_dataAtExecPosition;
+    driver::odbcabstraction::ParameterWriter* m_parameterWriter;
+    driver::odbcabstraction::WcsToUtf8Converter m_wcsConverter;
+    std::vector<uint8_t> m_utf8Buffer;
+
+    /**
+     * @brief Writes the values of the bound parameters, deferring data-at-execution
+     * ones.
+     * @return true if some parameters are supplied at execution time.
+     */
+    bool WriteParameters();
+    void WriteParameterData(size_t index, SQLSMALLINT cType, const void* data, SQLLEN length);
+    void FinishParameterData();
+    void ExecuteWithParameters();
+    void ClearDataAtExec();
 };
 }
@@ -83,6 +83,14 @@ public:
   /// \brief Gets the diagnostics for this connection.
   /// \return the diagnostics
   virtual Diagnostics& GetDiagnostics() = 0;
+
+  /// \brief Restores the state the connection had right after Connect() so that it
+  /// can be pooled and handed to a later Connect() with the same properties.
+  /// \return false if the connection can't be reused.
+  virtual bool Reset() { return false; }
+
+  /// \brief Checks that the server still accepts requests on this connection.
+  virtual bool IsAlive() { return false; }
 };
 
 } // namespace odbcabstraction
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #include <odbcabstraction/types.h>
@@ -38,6 +39,10 @@ public:
 
   /// \brief Register a log to be used by the system.
   virtual void RegisterLog() = 0;
+
+  /// \brief Runs a task on the threads the driver shares between its connections.
+  /// Used for asynchronous connection functions, which may block for a while.
+  virtual void SubmitTask(std::function<void()> task) = 0;
 };
 
 } // namespace odbcabstraction
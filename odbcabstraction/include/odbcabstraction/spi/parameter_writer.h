@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2020-2022 Dremio Corporation
+ *
+ * See "LICENSE" for license information.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace driver {
+namespace odbcabstraction {
+
+/// \brief Types parameter values are sent to the data source as.
+enum ParameterType {
+  ParameterType_STRING,  // UTF-8 text.
+  ParameterType_BINARY
+};
+
+/// \brief Receives the values of one parameter set of a prepared statement.
+///
+/// Values may be written in several pieces as the application supplies them, so
+/// that a large value is copied once, into the buffer it is sent from.
+class ParameterWriter {
+public:
+  virtual ~ParameterWriter() = default;
+
+  /// \brief Appends data to the value of a parameter, starting the value on the
+  /// first call.
+  /// \param index the zero-based index of the parameter.
+  virtual void Append(size_t index, const void *data, size_t length) = 0;
+
+  /// \brief Sets the value of a parameter to null.
+  /// \param index the zero-based index of the parameter.
+  virtual void SetNull(size_t index) = 0;
+};
+
+} // namespace odbcabstraction
+} // namespace driver
@@ -169,6 +169,12 @@ public:
   /// \param column_position[in] the position of the column, starting from 1.
   /// \return if column has a fixed precision and non zero scale.
   virtual bool IsFixedPrecScale(int column_position) = 0;
+
+  /// \brief It returns the Arrow IPC schema message of a column whose values are
+  ///        returned as Arrow IPC messages, which consumers prepend to each value.
+  /// \param column_position[in] the position of the column, starting from 1.
+  /// \return the serialized schema message, or an empty string for other columns.
+  virtual std::string GetArrowIpcSchema(int column_position) = 0;
 };
 
 } // namespace odbcabstraction
@@ -6,9 +6,13 @@
 
 #pragma once
 
+#include <odbcabstraction/exceptions.h>
+#include <odbcabstraction/spi/parameter_writer.h>
+
 #include <boost/optional.hpp>
 #include <boost/variant.hpp>
 #include <map>
+#include <string>
 #include <vector>
 
 namespace driver {
@@ -35,9 +39,26 @@ public:
     METADATA_ID,    // size_t - Modifies catalog function arguments to be identifiers. SQL_TRUE or SQL_FALSE.
     NOSCAN,         // size_t - Indicates that the driver does not scan for escape sequences. Default to SQL_NOSCAN_OFF
     QUERY_TIMEOUT,  // size_t - The time to wait in seconds for queries to execute. 0 to have no timeout.
+    EXPORT_PATH,           // std::string - Local file the result of Execute() is written to instead of
+                           // being returned as a result set. Empty to fetch normally.
+    EXPORT_FORMAT,         // size_t - ExportFormat of the file written to EXPORT_PATH.
+    EXPORT_COMPRESSION,    // size_t - ExportCompression codec of the file written to EXPORT_PATH.
+    EXPORT_ROW_GROUP_SIZE, // size_t - Maximum rows per Parquet row group. 0 to use the writer default.
+    EXPORT_ROW_COUNT,      // size_t - Read-only. Rows written to EXPORT_PATH by the last execution.
+    PARAMETER_STREAM,      // void* - ArrowArrayStream whose batches are bound as parameter sets by
+                           // the next ExecutePrepared(). The stream is consumed and released by the
+                           // execution, after which the attribute is reset to nullptr. A stream
+                           // that is replaced, reset or left when the statement is destroyed is
+                           // released without being executed.
+    MERGE_SORT_KEYS,       // std::string - Keys every endpoint of a result is sorted by, as
+                           // "column [ASC|DESC] [NULLS FIRST|NULLS LAST], ...". When set, rows of
+                           // multi-endpoint results are merged into global order. Empty to disable.
+    PRIORITY,              // size_t - StreamPriority the result streams are scheduled with.
+    ROW_ARRAY_SIZE,        // size_t - Rows the application fetches per call, used to classify
+                           // StreamPriority_AUTO statements.
   };
 
-  typedef boost::variant<size_t> Attribute;
+  typedef boost::variant<size_t, std::string, void *> Attribute;
 
   /// \brief Set a statement attribute (may be called at any time)
   ///
@@ -75,6 +96,16 @@ public:
   ///         false if it is an update count or there are no results.
   virtual bool ExecutePrepared() = 0;
 
+  /// \brief Starts the parameter set bound on the next call to ExecutePrepared.
+  /// Parameters that receive no value are bound as empty values.
+  ///
+  /// \param types The type of each parameter of the prepared statement.
+  /// \return a writer for the values, owned by the statement and valid until
+  ///         ExecutePrepared or Prepare is called.
+  virtual ParameterWriter &BeginParameters(const std::vector<ParameterType> &types) {
+    throw DriverException("Parameters are not supported", "HYC00");
+  }
+
   /// \brief Execute the statement if it is prepared or not.
   /// \param query The SQL query to execute.
   /// \returns true if the first result is a ResultSet object;
@@ -89,6 +120,13 @@ public:
   /// returned.
   virtual long GetUpdateCount() = 0;
 
+  /// \brief Moves to the next result of a statement that produced several, closing
+  /// the current one.
+  /// \param has_result_set set to true if the next result is a ResultSet object and
+  ///        to false if it is an update count.
+  /// \return false if there are no more results.
+  virtual bool NextResult(bool *has_result_set) { return false; }
+
   /// \brief Returns the list of table, catalog, or schema names, and table
   /// types, stored in a specific data source. The driver returns the
   /// information as a result set.
@@ -173,6 +211,11 @@ public:
 
   /// \brief Cancels the processing of this statement.
   virtual void Cancel() = 0;
+
+  /// \brief Closes any result set and prepared statement and restores the default
+  /// attributes, so that the statement can be reused as if newly created.
+  /// \return false if the statement can't be reused.
+  virtual bool Reset() { return false; }
 };
 
 } // namespace odbcabstraction
@@ -94,7 +94,10 @@ enum CDataType {
   CDataType_UBIGINT = ((-5) + (-22)),
   CDataType_BINARY = (-2),
   CDataType_NUMERIC = 2,
+  CDataType_GUID = (-11),
   CDataType_DEFAULT = 99,
+  // Driver-specific types, starting at SQL_DRIVER_C_TYPE_BASE.
+  CDataType_STRING_VIEW = 0x4000, // Binds STRING_VIEW_STRUCT, see below.
 };
 
 enum Nullability {
@@ -116,6 +119,27 @@ enum Updatability {
   UPDATABILITY_READWRITE_UNKNOWN = 2,
 };
 
+/// \brief File formats accepted by Statement::EXPORT_FORMAT.
+enum ExportFormat {
+  ExportFormat_ARROW_IPC = 0,
+  ExportFormat_PARQUET = 1,
+};
+
+/// \brief Codecs accepted by Statement::EXPORT_COMPRESSION.
+enum ExportCompression {
+  ExportCompression_NONE = 0,
+  ExportCompression_LZ4 = 1,
+  ExportCompression_ZSTD = 2,
+  ExportCompression_SNAPPY = 3, // Parquet only.
+};
+
+/// \brief Scheduling classes accepted by Statement::PRIORITY.
+enum StreamPriority {
+  StreamPriority_AUTO = 0,        // Classified from the row array size and result estimates.
+  StreamPriority_INTERACTIVE = 1,
+  StreamPriority_BULK = 2,
+};
+
 constexpr ssize_t NULL_DATA = -1;
 constexpr ssize_t NO_TOTAL = -4;
 constexpr ssize_t ALL_TYPES = 0;
@@ -156,6 +180,23 @@ typedef struct tagNUMERIC_STRUCT {
   uint8_t val[16]; //[e], [f]
 } NUMERIC_STRUCT;
 
+/// \brief Same layout as SQLGUID: the first three fields hold the big-endian leading
+/// bytes of an RFC 4122 UUID in native byte order, data4 holds the rest as is.
+typedef struct tagGUID_STRUCT {
+  uint32_t data1;
+  uint16_t data2;
+  uint16_t data3;
+  uint8_t data4[8];
+} GUID_STRUCT;
+
+/// \brief Cell written for CDataType_STRING_VIEW: the bytes of a string or binary value
+/// inside the driver's Arrow buffers, without a NUL terminator. The pointer stays valid
+/// until the next fetch, SQLCloseCursor or SQLFreeStmt on the statement.
+typedef struct tagSTRING_VIEW_STRUCT {
+  const uint8_t *data;
+  int64_t length;
+} STRING_VIEW_STRUCT;
+
 enum RowStatus: uint16_t {
   RowStatus_SUCCESS = 0,  // Same as SQL_ROW_SUCCESS
   RowStatus_SUCCESS_WITH_INFO = 6,  // Same as SQL_ROW_SUCCESS_WITH_INFO
@@ -167,6 +208,8 @@ struct MetadataSettings {
   boost::optional<int32_t> string_column_length_{boost::none};
   size_t chunk_buffer_capacity_;
   bool use_wide_char_;
+  bool complex_types_as_arrow_ipc_;
+  bool batch_statements_{false};
 };
 
 } // namespace odbcabstraction
@@ -13,14 +13,15 @@
 #include <odbcinst.h>
 #include <sql.h>
 #include <sqlext.h>
+#include <chrono>
 #include <iterator>
 #include <memory>
 #include <odbcabstraction/spi/connection.h>
+#include <odbcabstraction/connection_string.h>
 #include <odbcabstraction/exceptions.h>
 #include <odbcabstraction/spi/statement.h>
 #include <boost/algorithm/string.hpp>
 #include <utility>
-#include <boost/xpressive/xpressive.hpp>
 
 using namespace ODBC;
 using namespace driver::odbcabstraction;
@@ -29,12 +30,8 @@ using driver::odbcabstraction::DriverException;
 
 namespace
 {
-  // Key-value pairs separated by semi-colon.
-  // Note that the value can be wrapped in curly braces to escape other significant characters
-  // such as semi-colons and equals signs.
-  // NOTE: This can be optimized to be built statically.
-  const boost::xpressive::sregex CONNECTION_STR_REGEX(boost::xpressive::sregex::compile(
-    "([^=;]+)=({.+}|[^=;]+|[^;])"));
+// Freed statements kept per connection for reuse.
+const size_t MAX_FREE_STATEMENTS = 16;
 
 // Load properties from the given DSN. The properties loaded do _not_ overwrite existing
 // entries in the properties.
@@ -77,6 +74,20 @@ void loadPropertiesFromDSN(const std::string& dsn, Connection::ConnPropertyMap&
   }
 }
 
+// Applies the attributes an application set on the connection before connecting to
+// the pooled connection replacing it. CONNECTION_DEAD is state, not a setting.
+void copyConnectionAttributes(Connection& from, Connection& to) {
+  const Connection::AttributeId attributes[] = {
+    Connection::ACCESS_MODE, Connection::CONNECTION_TIMEOUT, Connection::CURRENT_CATALOG,
+    Connection::LOGIN_TIMEOUT, Connection::PACKET_SIZE};
+  for (const auto attribute : attributes) {
+    const boost::optional<Connection::Attribute> value = from.GetAttribute(attribute);
+    if (value) {
+      to.SetAttribute(attribute, *value);
+    }
+  }
+}
+
 }
 
 // Public =========================================================================================
@@ -84,13 +95,29 @@ ODBCConnection::ODBCConnection(ODBCEnvironment& environment,
   std::shared_ptr<Connection> spiConnection) :
   m_environment(environment),
   m_spiConnection(std::move(spiConnection)),
+  m_asyncDiagnostics(m_spiConnection->GetDiagnostics().GetVendor(),
+                      m_spiConnection->GetDiagnostics().GetDataSourceComponent(),
+                      m_spiConnection->GetDiagnostics().GetOdbcVersion()),
   m_is2xConnection(environment.getODBCVersion() == SQL_OV_ODBC2),
-  m_isConnected(false)
+  m_isConnected(false),
+  m_asyncEnabled(false),
+  m_asyncFunction(AsyncFunction_NONE)
 {
 
 }
 
+ODBCConnection::~ODBCConnection() {
+  if (m_asyncResult.valid()) {
+    m_asyncResult.wait();
+  }
+}
+
 Diagnostics &ODBCConnection::GetDiagnostics_Impl() {
+  // The background operation may be replacing the SPI connection or adding to its
+  // diagnostics, so polls report through their own diagnostics until it completes.
+  if (m_asyncFunction != AsyncFunction_NONE) {
+    return m_asyncDiagnostics;
+  }
   return m_spiConnection->GetDiagnostics();
 }
 
@@ -105,13 +132,35 @@ const std::string& ODBCConnection::GetDSN() const {
 
 void ODBCConnection::connect(std::string dsn, const Connection::ConnPropertyMap &properties,
   std::vector<std::string> &missing_properties)
+{
+  throwIfAsyncExecuting();
+  doConnect(std::move(dsn), properties, missing_properties);
+}
+
+void ODBCConnection::doConnect(std::string dsn, const Connection::ConnPropertyMap &properties,
+  std::vector<std::string> &missing_properties)
 {
   if (m_isConnected) {
     throw DriverException("Already connected.", "HY010");
   }
 
   m_dsn = std::move(dsn);
-  m_spiConnection->Connect(properties, missing_properties);
+  std::shared_ptr<ConnectionPool> pool = m_environment.getConnectionPool();
+  std::shared_ptr<Connection> pooled;
+  if (pool) {
+    m_poolKey = ConnectionPool::MakeKey(m_dsn, properties,
+                                        m_spiConnection->GetDiagnostics().GetOdbcVersion());
+    pooled = pool->Acquire(m_poolKey, &m_connectedAt);
+  }
+
+  if (pooled) {
+    copyConnectionAttributes(*m_spiConnection, *pooled);
+    m_spiConnection = std::move(pooled);
+  } else {
+    m_spiConnection->Connect(properties, missing_properties);
+    m_connectedAt = ConnectionPool::Clock::now();
+  }
+  m_pool = std::move(pool);
   m_isConnected = true;
   std::shared_ptr<Statement> spiStatement = m_spiConnection->CreateStatement();
   m_attributeTrackingStatement = std::make_shared<ODBCStatement>(*this, spiStatement);
@@ -119,14 +168,15 @@ void ODBCConnection::connect(std::string dsn, const Connection::ConnPropertyMap
 
 void ODBCConnection::GetInfo(SQLUSMALLINT infoType, SQLPOINTER value, SQLSMALLINT bufferLength, SQLSMALLINT* outputLength, bool isUnicode)
 {
-  
+  throwIfAsyncExecuting();
+
   switch (infoType) {
     case SQL_ACTIVE_ENVIRONMENTS:
       GetAttribute(static_cast<SQLUSMALLINT>(0), value, bufferLength, outputLength);
       break;
     #ifdef SQL_ASYNC_DBC_FUNCTIONS
     case SQL_ASYNC_DBC_FUNCTIONS:
-      GetAttribute(static_cast<SQLUINTEGER>(SQL_ASYNC_DBC_NOT_CAPABLE), value, bufferLength, outputLength);
+      GetAttribute(static_cast<SQLUINTEGER>(SQL_ASYNC_DBC_CAPABLE), value, bufferLength, outputLength);
       break;
     #endif
     case SQL_ASYNC_MODE:
@@ -137,12 +187,6 @@ void ODBCConnection::GetInfo(SQLUSMALLINT infoType, SQLPOINTER value, SQLSMALLIN
       GetAttribute(static_cast<SQLUINTEGER>(SQL_ASYNC_NOTIFICATION_NOT_CAPABLE), value, bufferLength, outputLength);
       break;
     #endif
-    case SQL_BATCH_ROW_COUNT:
-      GetAttribute(static_cast<SQLUINTEGER>(0), value, bufferLength, outputLength);
-      break;
-    case SQL_BATCH_SUPPORT:
-      GetAttribute(static_cast<SQLUINTEGER>(0), value, bufferLength, outputLength);
-      break;
     case SQL_DATA_SOURCE_NAME:
       GetStringAttribute(isUnicode, m_dsn, true, value, bufferLength, outputLength, GetDiagnostics());
       break;
@@ -280,6 +324,8 @@ void ODBCConnection::GetInfo(SQLUSMALLINT infoType, SQLPOINTER value, SQLSMALLIN
     }
 
     // Driver-level 32-bit integer properties.
+    case SQL_BATCH_ROW_COUNT:
+    case SQL_BATCH_SUPPORT:
     case SQL_GETDATA_EXTENSIONS:
     case SQL_INFO_SCHEMA_VIEWS:
     case SQL_CURSOR_SENSITIVITY:
@@ -424,6 +470,9 @@ void ODBCConnection::GetInfo(SQLUSMALLINT infoType, SQLPOINTER value, SQLSMALLIN
 }
 
 void ODBCConnection::SetConnectAttr(SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER stringLength, bool isUnicode) {
+  // Attributes are applied without server round trips, so SQLSetConnectAttr completes
+  // synchronously even when asynchronous connection functions are enabled.
+  throwIfAsyncExecuting();
   uint32_t attributeToWrite = 0;
   bool successfully_written = false;
   switch (attribute) {
@@ -434,7 +483,12 @@ void ODBCConnection::SetConnectAttr(SQLINTEGER attribute, SQLPOINTER value, SQLI
 #endif
 #ifdef SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE
   case SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE:
-    throw DriverException("Optional feature not supported.", "HYC00");
+    SetAttribute(value, attributeToWrite);
+    if (attributeToWrite != SQL_ASYNC_DBC_ENABLE_ON && attributeToWrite != SQL_ASYNC_DBC_ENABLE_OFF) {
+      throw DriverException("Invalid attribute value", "HY024");
+    }
+    m_asyncEnabled = attributeToWrite == SQL_ASYNC_DBC_ENABLE_ON;
+    return;
 #endif
 #ifdef SQL_ATTR_ASYNC_PCALLBACK
   case SQL_ATTR_ASYNC_DBC_PCALLBACK:
@@ -534,6 +588,7 @@ void ODBCConnection::SetConnectAttr(SQLINTEGER attribute, SQLPOINTER value, SQLI
 void ODBCConnection::GetConnectAttr(SQLINTEGER attribute, SQLPOINTER value,
                                     SQLINTEGER bufferLength,
                                     SQLINTEGER *outputLength, bool isUnicode) {
+  throwIfAsyncExecuting();
   using driver::odbcabstraction::Connection;
   boost::optional<Connection::Attribute> spiAttribute;
 
@@ -546,7 +601,8 @@ void ODBCConnection::GetConnectAttr(SQLINTEGER attribute, SQLPOINTER value,
 #endif
 #ifdef SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE
   case SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE:
-    GetAttribute(static_cast<SQLUINTEGER>(SQL_ASYNC_DBC_ENABLE_OFF), value, bufferLength, outputLength);
+    GetAttribute(static_cast<SQLUINTEGER>(m_asyncEnabled ? SQL_ASYNC_DBC_ENABLE_ON : SQL_ASYNC_DBC_ENABLE_OFF),
+                 value, bufferLength, outputLength);
     return;
 #endif
 #ifdef SQL_ATTR_ASYNC_PCALLBACK
@@ -632,94 +688,151 @@ void ODBCConnection::GetConnectAttr(SQLINTEGER attribute, SQLPOINTER value,
 }
 
 void ODBCConnection::disconnect() {
+  throwIfAsyncExecuting();
+  doDisconnect();
+}
+
+void ODBCConnection::doDisconnect() {
   if (m_isConnected) {
     // Ensure that all statements (and corresponding SPI statements) get cleaned
     // up before terminating the SPI connection in case they need to be de-allocated in
     // the reverse of the allocation order.
     m_statements.clear();
-    m_spiConnection->Close();
+    m_freeStatements.clear();
+    // Explicit descriptors report through the connection's diagnostics, so a connection
+    // they still refer to is closed rather than handed to another handle.
+    if (m_pool && m_descriptors.empty()) {
+      m_pool->Release(m_poolKey, std::move(m_spiConnection), m_connectedAt);
+      m_spiConnection = m_environment.CreateSpiConnection();
+    } else {
+      m_spiConnection->Close();
+    }
+    m_pool.reset();
     m_isConnected = false;
   }
 }
 
+SQLRETURN ODBCConnection::connectAsync(std::string dsn, const Connection::ConnPropertyMap &properties,
+  std::vector<std::string> &missing_properties)
+{
+  // A pending disconnect makes this call fail without touching the missing properties.
+  throwIfAsyncExecuting(AsyncFunction_CONNECT);
+
+  SQLRETURN rc;
+  try {
+    rc = runAsync(AsyncFunction_CONNECT, [this, dsn, properties]() {
+      m_asyncMissingProperties.clear();
+      doConnect(dsn, properties, m_asyncMissingProperties);
+    });
+  } catch (...) {
+    missing_properties = std::move(m_asyncMissingProperties);
+    throw;
+  }
+
+  if (rc != SQL_STILL_EXECUTING) {
+    missing_properties = std::move(m_asyncMissingProperties);
+  }
+  return rc;
+}
+
+SQLRETURN ODBCConnection::disconnectAsync() {
+  return runAsync(AsyncFunction_DISCONNECT, [this]() { doDisconnect(); });
+}
+
 void ODBCConnection::releaseConnection() {
+  throwIfAsyncExecuting();
   disconnect();
   m_environment.DropConnection(this);
 }
 
 std::shared_ptr<ODBCStatement> ODBCConnection::createStatement() {
-  std::shared_ptr<Statement> spiStatement = m_spiConnection->CreateStatement();
-  std::shared_ptr<ODBCStatement> statement = std::make_shared<ODBCStatement>(*this, spiStatement);
-  m_statements.push_back(statement);
+  throwIfAsyncExecuting();
+  std::shared_ptr<ODBCStatement> statement;
+  if (!m_freeStatements.empty()) {
+    statement = std::move(m_freeStatements.back());
+    m_freeStatements.pop_back();
+  } else {
+    std::shared_ptr<Statement> spiStatement = m_spiConnection->CreateStatement();
+    statement = std::make_shared<ODBCStatement>(*this, spiStatement);
+  }
+  m_statements.add(statement);
   statement->CopyAttributesFromConnection(*this);
   return statement;
 }
 
 void ODBCConnection::dropStatement(ODBCStatement* stmt) {
-    auto it = std::find_if(m_statements.begin(), m_statements.end(), 
-      [&stmt] (const std::shared_ptr<ODBCStatement>& statement) { return statement.get() == stmt; });
-    if (m_statements.end() != it) {
-        m_statements.erase(it);
-    }
+  // An asynchronous disconnect frees the statements on its own thread.
+  throwIfAsyncExecuting();
+  stmt->closeCursor(true);
+  std::shared_ptr<ODBCStatement> statement = m_statements.remove(stmt);
+  // Applications allocating a statement per query get the same one back, reset,
+  // instead of reallocating it along with its SPI statement and descriptors.
+  if (statement && m_freeStatements.size() < MAX_FREE_STATEMENTS && statement->Reset()) {
+    m_freeStatements.push_back(std::move(statement));
+  }
 }
 
 std::shared_ptr<ODBCDescriptor> ODBCConnection::createDescriptor() {
+  throwIfAsyncExecuting();
   std::shared_ptr<ODBCDescriptor> desc = std::make_shared<ODBCDescriptor>(
       m_spiConnection->GetDiagnostics(), this, nullptr, true, true, false);
-  m_descriptors.push_back(desc);
+  m_descriptors.add(desc);
   return desc;
 }
 
-void ODBCConnection::dropDescriptor(ODBCDescriptor* desc) {
-    auto it = std::find_if(m_descriptors.begin(), m_descriptors.end(), 
-      [&desc] (const std::shared_ptr<ODBCDescriptor>& descriptor) { return descriptor.get() == desc; });
-    if (m_descriptors.end() != it) {
-        m_descriptors.erase(it);
+std::shared_ptr<ODBCDescriptor> ODBCConnection::dropDescriptor(ODBCDescriptor* desc) {
+  throwIfAsyncExecuting();
+  return m_descriptors.remove(desc);
+}
+
+// Private ========================================================================================
+SQLRETURN ODBCConnection::runAsync(AsyncFunction function, std::function<void()> operation) {
+  // Calling the same function again polls it; any other function is a sequence error.
+  throwIfAsyncExecuting(function);
+  if (m_asyncFunction != AsyncFunction_NONE) {
+    if (m_asyncResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      return SQL_STILL_EXECUTING;
     }
+    m_asyncFunction = AsyncFunction_NONE;
+    m_asyncResult.get();
+    return SQL_SUCCESS;
+  }
+
+  if (!m_asyncEnabled) {
+    operation();
+    return SQL_SUCCESS;
+  }
+  // Run on the driver's shared threads rather than a thread per call.
+  auto task = std::make_shared<std::packaged_task<void()>>(std::move(operation));
+  m_asyncResult = task->get_future();
+  m_environment.SubmitTask([task]() { (*task)(); });
+  m_asyncFunction = function;
+  return SQL_STILL_EXECUTING;
+}
+
+void ODBCConnection::throwIfAsyncExecuting(AsyncFunction allowed) const {
+  if (m_asyncFunction != AsyncFunction_NONE && m_asyncFunction != allowed) {
+    throw DriverException("Function sequence error", "HY010");
+  }
 }
 
 // Public Static ===================================================================================
 std::string ODBCConnection::getPropertiesFromConnString(const std::string& connStr,
   Connection::ConnPropertyMap &properties)
 {
-  const int groups[] = { 1, 2 }; // CONNECTION_STR_REGEX has two groups. key: 1, value: 2
-  boost::xpressive::sregex_token_iterator regexIter(connStr.begin(), connStr.end(), 
-    CONNECTION_STR_REGEX, groups), end;
-  
-  bool isDsnFirst = false;
-  bool isDriverFirst = false;
-  std::string dsn;
-  for (auto it = regexIter; end != regexIter; ++regexIter) {
-    std::string key = *regexIter;
-    std::string value = *++regexIter;
-
-    // If the DSN shows up before driver key, load settings from the DSN.
-    // Only load values from the DSN once regardless of how many times the DSN
-    // key shows up.
-    if (boost::iequals(key, "DSN")) {
-      if (!isDriverFirst) {
-        if (!isDsnFirst) {
-          isDsnFirst = true;
-          loadPropertiesFromDSN(value, properties);
-          dsn.swap(value);
-        }
-      }
-      continue;
-    } else if (boost::iequals(key, "Driver")) {
-      if (!isDsnFirst) {
-        isDriverFirst = true;
-      }
-      continue;
-    }
+  ConnectionStringCache &cache = ConnectionStringCache::GetInstance();
+  const std::shared_ptr<const ConnectionString> parsed = cache.Parse(connStr);
 
-    // Strip wrapping curly braces.
-    if (value.size() >= 2 && value[0] == '{' && value[value.size() - 1] == '}') {
-      value = value.substr(1, value.size() - 2);
-    }
+  // Overwrite the existing values. Later copies of a key take precedence,
+  // including over entries in the DSN.
+  for (const auto &attribute : parsed->attributes) {
+    properties[attribute.first] = attribute.second;
+  }
 
-    // Overwrite the existing value. Later copies of the key take precedence,
-    // including over entries in the DSN.
-    properties[key] = std::move(value);
+  if (!parsed->dsn.empty()) {
+    const std::shared_ptr<const PropertyMap> dsnProperties =
+      cache.GetDsnProperties(parsed->dsn, loadPropertiesFromDSN);
+    properties.insert(dsnProperties->begin(), dsnProperties->end());
   }
-  return dsn;
+  return parsed->dsn;
 }
@@ -162,6 +162,7 @@ void ODBCDescriptor::SetField(SQLSMALLINT recordNumber, SQLSMALLINT fieldIdentif
     case SQL_DESC_UNNAMED:
     case SQL_DESC_UNSIGNED:
     case SQL_DESC_UPDATABLE:
+    case SQL_DESC_ARROW_IPC_SCHEMA:
       throw DriverException("Cannot modify read-only field.", "HY092");
     case SQL_DESC_CONCISE_TYPE:
       SetAttribute(value, record.m_conciseType);
@@ -323,6 +324,9 @@ void ODBCDescriptor::GetField(SQLSMALLINT recordNumber, SQLSMALLINT fieldIdentif
     case SQL_DESC_TYPE_NAME:
       GetAttributeUTF8(record.m_typeName, value, bufferLength, outputLength, GetDiagnostics());
       break;
+    case SQL_DESC_ARROW_IPC_SCHEMA:
+      GetAttributeUTF8(record.m_arrowIpcSchema, value, bufferLength, outputLength, GetDiagnostics());
+      break;
 
     case SQL_DESC_DATA_PTR:
       GetAttribute(record.m_dataPtr, value, bufferLength, outputLength);
@@ -424,6 +428,13 @@ void ODBCDescriptor::DetachFromStatement(ODBCStatement* statement, bool isApd) {
 }
 
 void ODBCDescriptor::ReleaseDescriptor() {
+  // Dropped first so the connection can reject the call before any statement changes.
+  // Holding the dropped handle keeps this descriptor alive until the end of the call.
+  std::shared_ptr<ODBCDescriptor> self;
+  if (m_owningConnection) {
+    self = m_owningConnection->dropDescriptor(this);
+  }
+
   for (ODBCStatement* stmt : m_registeredOnStatementsAsApd) {
     stmt->RevertAppDescriptor(true);
   }
@@ -431,10 +442,24 @@ void ODBCDescriptor::ReleaseDescriptor() {
   for (ODBCStatement* stmt : m_registeredOnStatementsAsArd) {
     stmt->RevertAppDescriptor(false);
   }
+}
 
-  if (m_owningConnection) {
-    m_owningConnection->dropDescriptor(this);
-  }
+void ODBCDescriptor::Reset() {
+  m_diagnostics.Clear();
+  m_records.clear();
+  m_arrayStatusPtr = nullptr;
+  m_bindOffsetPtr = nullptr;
+  m_rowsProccessedPtr = nullptr;
+  m_arraySize = 1;
+  m_bindType = SQL_BIND_BY_COLUMN;
+  m_highestOneBasedBoundRecord = 0;
+  m_hasBindingsChanged = true;
+}
+
+void ODBCDescriptor::ClearRecords() {
+  m_records.clear();
+  m_highestOneBasedBoundRecord = 0;
+  m_hasBindingsChanged = true;
 }
 
 void ODBCDescriptor::PopulateFromResultSetMetadata(ResultSetMetadata* rsmd) {
@@ -454,6 +479,7 @@ void ODBCDescriptor::PopulateFromResultSetMetadata(ResultSetMetadata* rsmd) {
     m_records[i].m_schemaName = rsmd->GetSchemaName(oneBasedIndex);
     m_records[i].m_tableName = rsmd->GetTableName(oneBasedIndex);
     m_records[i].m_typeName = rsmd->GetTypeName(oneBasedIndex);
+    m_records[i].m_arrowIpcSchema = rsmd->GetArrowIpcSchema(oneBasedIndex);
     m_records[i].m_conciseType = GetSqlTypeForODBCVersion(rsmd->GetConciseType(oneBasedIndex), m_is2xConnection);
     m_records[i].m_dataPtr = nullptr;
     m_records[i].m_indicatorPtr = nullptr;
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <utility>
 #include <sqlext.h>
+#include <odbcabstraction/connection_pool.h>
 #include <odbcabstraction/spi/driver.h>
 #include <odbcabstraction/spi/connection.h>
 #include <odbcabstraction/types.h>
@@ -53,17 +54,37 @@ void ODBCEnvironment::setConnectionPooling(SQLINTEGER connectionPooling) {
   m_connectionPooling = connectionPooling;
 }
 
+std::shared_ptr<ConnectionPool> ODBCEnvironment::getConnectionPool() {
+  switch (m_connectionPooling) {
+    case SQL_CP_ONE_PER_DRIVER:
+      return ConnectionPool::GetDriverPool();
+    case SQL_CP_ONE_PER_HENV: {
+      const std::lock_guard<std::mutex> lock(m_connectionPoolMutex);
+      if (!m_connectionPool) {
+        m_connectionPool = std::make_shared<ConnectionPool>();
+      }
+      return m_connectionPool;
+    }
+    default:
+      return nullptr;
+  }
+}
+
+std::shared_ptr<Connection> ODBCEnvironment::CreateSpiConnection() {
+  return m_driver->CreateConnection(m_version == SQL_OV_ODBC2 ? V_2 : V_3);
+}
+
 std::shared_ptr<ODBCConnection> ODBCEnvironment::CreateConnection() {
-  std::shared_ptr<Connection> spiConnection = m_driver->CreateConnection(m_version == SQL_OV_ODBC2 ? V_2 : V_3);
+  std::shared_ptr<Connection> spiConnection = CreateSpiConnection();
   std::shared_ptr<ODBCConnection> newConn = std::make_shared<ODBCConnection>(*this, spiConnection);
-  m_connections.push_back(newConn);
+  m_connections.add(newConn);
   return newConn;
 }
 
 void ODBCEnvironment::DropConnection(ODBCConnection* conn) {
-    auto it = std::find_if(m_connections.begin(), m_connections.end(), 
-      [&conn] (const std::shared_ptr<ODBCConnection>& connection) { return connection.get() == conn; });
-    if (m_connections.end() != it) {
-        m_connections.erase(it);
-    }
+  m_connections.remove(conn);
+}
+
+void ODBCEnvironment::SubmitTask(std::function<void()> task) {
+  m_driver->SubmitTask(std::move(task));
 }
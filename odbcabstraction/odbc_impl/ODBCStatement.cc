@@ -13,6 +13,7 @@
 #include <sql.h>
 #include <sqlext.h>
 #include <sqltypes.h>
+#include <odbcabstraction/spi/parameter_writer.h>
 #include <odbcabstraction/spi/statement.h>
 #include <odbcabstraction/exceptions.h>
 #include <odbcabstraction/spi/result_set.h>
@@ -68,6 +69,9 @@ namespace {
       case SQL_C_NUMERIC:
         return sizeof(SQL_NUMERIC_STRUCT);
 
+      case SQL_C_GUID:
+        return sizeof(SQLGUID);
+
       case SQL_C_DATE:
       case SQL_C_TYPE_DATE:
         return sizeof(SQL_DATE_STRUCT);
@@ -94,6 +98,9 @@ namespace {
       case SQL_C_INTERVAL_YEAR_TO_MONTH:
       case SQL_C_INTERVAL_MONTH:
         return sizeof(SQL_INTERVAL_STRUCT);
+
+      case CDataType_STRING_VIEW:
+        return sizeof(STRING_VIEW_STRUCT);
       default:
         return record.m_length;
     }
@@ -185,6 +192,39 @@ namespace {
       target.SetAttribute(attributeId, *optionalValue);
     }
   }
+
+  ParameterType GetParameterType(SQLSMALLINT sqlType) {
+    switch (sqlType) {
+      case SQL_CHAR:
+      case SQL_VARCHAR:
+      case SQL_LONGVARCHAR:
+      case SQL_WCHAR:
+      case SQL_WVARCHAR:
+      case SQL_WLONGVARCHAR:
+        return ParameterType_STRING;
+      case SQL_BINARY:
+      case SQL_VARBINARY:
+      case SQL_LONGVARBINARY:
+        return ParameterType_BINARY;
+      default:
+        throw DriverException("Unsupported parameter SQL type: " + std::to_string(sqlType), "HYC00");
+    }
+  }
+
+  SQLSMALLINT GetDefaultCType(SQLSMALLINT sqlType) {
+    switch (sqlType) {
+      case SQL_WCHAR:
+      case SQL_WVARCHAR:
+      case SQL_WLONGVARCHAR:
+        return SQL_C_WCHAR;
+      case SQL_BINARY:
+      case SQL_VARBINARY:
+      case SQL_LONGVARBINARY:
+        return SQL_C_BINARY;
+      default:
+        return SQL_C_CHAR;
+    }
+  }
 }
 
 // Public =========================================================================================
@@ -197,13 +237,15 @@ ODBCStatement::ODBCStatement(ODBCConnection& connection,
   m_builtInApd(std::make_shared<ODBCDescriptor>(m_spiStatement->GetDiagnostics(), nullptr, this, true, true, connection.IsOdbc2Connection())),
   m_ipd(std::make_shared<ODBCDescriptor>(m_spiStatement->GetDiagnostics(), nullptr, this, false, true, connection.IsOdbc2Connection())),
   m_ird(std::make_shared<ODBCDescriptor>(m_spiStatement->GetDiagnostics(), nullptr, this, false, false, connection.IsOdbc2Connection())),
-  m_currentArd(m_builtInApd.get()),
+  m_currentArd(m_builtInArd.get()),
   m_currentApd(m_builtInApd.get()),
   m_rowNumber(0),
   m_maxRows(0),
   m_rowsetSize(1),
   m_isPrepared(false),
-  m_hasReachedEndOfResult(false) {
+  m_hasReachedEndOfResult(false),
+  m_dataAtExecPosition(0),
+  m_parameterWriter(nullptr) {
 }
 
 ODBCConnection &ODBCStatement::GetConnection() {
@@ -243,6 +285,7 @@ bool ODBCStatement::isPrepared() const {
 }
 
 void ODBCStatement::Prepare(const std::string& query) {
+  ClearDataAtExec();
   boost::optional<std::shared_ptr<ResultSetMetadata> > metadata = m_spiStatement->Prepare(query);
 
   if (metadata) {
@@ -251,11 +294,164 @@ void ODBCStatement::Prepare(const std::string& query) {
   m_isPrepared = true;
 }
 
-void ODBCStatement::ExecutePrepared() {
-  if (!m_isPrepared) {
+void ODBCStatement::BindParameter(SQLUSMALLINT parameterNumber, SQLSMALLINT inputOutputType,
+                                  SQLSMALLINT valueType, SQLSMALLINT parameterType, SQLULEN columnSize,
+                                  SQLSMALLINT decimalDigits, SQLPOINTER parameterValuePtr,
+                                  SQLLEN bufferLength, SQLLEN* strLenOrIndPtr) {
+  if (parameterNumber == 0) {
+    throw DriverException("Invalid descriptor index", "07009");
+  }
+  if (inputOutputType != SQL_PARAM_INPUT) {
+    throw DriverException("Only input parameters are supported", "HYC00");
+  }
+  GetParameterType(parameterType);
+  if (valueType == SQL_C_DEFAULT) {
+    valueType = GetDefaultCType(parameterType);
+  } else if (valueType != SQL_C_CHAR && valueType != SQL_C_WCHAR && valueType != SQL_C_BINARY) {
+    throw DriverException("Unsupported parameter C data type: " + std::to_string(valueType), "HYC00");
+  }
+
+  m_currentApd->BindCol(parameterNumber, valueType, parameterValuePtr, bufferLength, strLenOrIndPtr);
+
+  std::vector<DescriptorRecord>& ipdRecords = m_ipd->GetRecords();
+  if (ipdRecords.size() < parameterNumber) {
+    ipdRecords.resize(parameterNumber);
+  }
+  DescriptorRecord& ipdRecord = ipdRecords[parameterNumber - 1];
+  ipdRecord.m_type = parameterType;
+  ipdRecord.m_conciseType = parameterType;
+  ipdRecord.m_paramType = inputOutputType;
+  ipdRecord.m_length = columnSize;
+  ipdRecord.m_scale = decimalDigits;
+}
+
+SQLRETURN ODBCStatement::ExecutePrepared() {
+  if (!m_isPrepared || !m_dataAtExecParameters.empty()) {
+    throw DriverException("Function sequence error", "HY010");
+  }
+
+  try {
+    if (WriteParameters()) {
+      return SQL_NEED_DATA;
+    }
+  } catch (...) {
+    ClearDataAtExec();
+    throw;
+  }
+  ExecuteWithParameters();
+  return SQL_SUCCESS;
+}
+
+SQLRETURN ODBCStatement::ParamData(SQLPOINTER* valuePtr) {
+  if (m_dataAtExecParameters.empty()) {
     throw DriverException("Function sequence error", "HY010");
   }
 
+  try {
+    if (m_dataAtExecPosition > 0) {
+      FinishParameterData();
+    }
+    if (m_dataAtExecPosition < m_dataAtExecParameters.size()) {
+      const size_t index = m_dataAtExecParameters[m_dataAtExecPosition++];
+      m_wcsConverter.Reset();
+      if (valuePtr) {
+        *valuePtr = m_currentApd->GetRecords()[index].m_dataPtr;
+      }
+      return SQL_NEED_DATA;
+    }
+  } catch (...) {
+    ClearDataAtExec();
+    throw;
+  }
+
+  // Every value was supplied, so the parameter set is complete.
+  ExecuteWithParameters();
+  return SQL_SUCCESS;
+}
+
+void ODBCStatement::PutData(SQLPOINTER dataPtr, SQLLEN strLenOrInd) {
+  if (m_dataAtExecPosition == 0) {
+    throw DriverException("Function sequence error", "HY010");
+  }
+
+  const size_t index = m_dataAtExecParameters[m_dataAtExecPosition - 1];
+  if (strLenOrInd == SQL_NULL_DATA) {
+    m_parameterWriter->SetNull(index);
+    return;
+  }
+  if (!dataPtr && strLenOrInd != 0) {
+    throw DriverException("Invalid use of null pointer", "HY009");
+  }
+  if (strLenOrInd < 0 && strLenOrInd != SQL_NTS) {
+    throw DriverException("Invalid string or buffer length", "HY090");
+  }
+  WriteParameterData(index, m_currentApd->GetRecords()[index].m_type, dataPtr, strLenOrInd);
+}
+
+bool ODBCStatement::WriteParameters() {
+  const std::vector<DescriptorRecord>& apdRecords = m_currentApd->GetRecords();
+  const std::vector<DescriptorRecord>& ipdRecords = m_ipd->GetRecords();
+  m_parameterWriter = nullptr;
+  if (apdRecords.empty()) {
+    return false;
+  }
+  if (m_currentApd->GetArraySize() != 1) {
+    throw DriverException("Arrays of parameters are not supported", "HYC00");
+  }
+
+  std::vector<ParameterType> types;
+  for (size_t i = 0; i < apdRecords.size(); ++i) {
+    if (i >= ipdRecords.size() || (!apdRecords[i].m_isBound && !apdRecords[i].m_indicatorPtr)) {
+      throw DriverException("Parameter " + std::to_string(i + 1) + " is not bound", "07002");
+    }
+    types.push_back(GetParameterType(ipdRecords[i].m_conciseType));
+  }
+  m_parameterWriter = &m_spiStatement->BeginParameters(types);
+
+  const SQLULEN offset = m_currentApd->GetBindOffset();
+  for (size_t i = 0; i < apdRecords.size(); ++i) {
+    const DescriptorRecord& record = apdRecords[i];
+    const SQLLEN* indicator = record.m_indicatorPtr
+        ? reinterpret_cast<const SQLLEN*>(reinterpret_cast<const uint8_t*>(record.m_indicatorPtr) + offset)
+        : nullptr;
+    if (indicator && *indicator == SQL_NULL_DATA) {
+      m_parameterWriter->SetNull(i);
+    } else if (indicator && (*indicator == SQL_DATA_AT_EXEC || *indicator <= SQL_LEN_DATA_AT_EXEC_OFFSET)) {
+      m_dataAtExecParameters.push_back(i);
+    } else if (!record.m_dataPtr) {
+      throw DriverException("Invalid use of null pointer", "HY009");
+    } else {
+      m_wcsConverter.Reset();
+      WriteParameterData(i, record.m_type, static_cast<const uint8_t*>(record.m_dataPtr) + offset,
+                         indicator ? *indicator : SQL_NTS);
+      FinishParameterData();
+    }
+  }
+
+  m_dataAtExecPosition = 0;
+  return !m_dataAtExecParameters.empty();
+}
+
+void ODBCStatement::WriteParameterData(size_t index, SQLSMALLINT cType, const void* data, SQLLEN length) {
+  if (cType == SQL_C_WCHAR) {
+    const size_t lengthInBytes = length == SQL_NTS ? wcsstrlen(data) * GetSqlWCharSize() : length;
+    m_wcsConverter.Convert(data, lengthInBytes, &m_utf8Buffer);
+    m_parameterWriter->Append(index, m_utf8Buffer.data(), m_utf8Buffer.size());
+  } else {
+    const size_t lengthInBytes = length == SQL_NTS ? strlen(static_cast<const char*>(data)) : length;
+    m_parameterWriter->Append(index, data, lengthInBytes);
+  }
+}
+
+void ODBCStatement::FinishParameterData() {
+  if (m_wcsConverter.HasPendingCharacter()) {
+    throw DriverException("Wide character parameter data ends in an incomplete character", "22018");
+  }
+}
+
+void ODBCStatement::ExecuteWithParameters() {
+  ClearDataAtExec();
+  m_spiStatement->SetAttribute(Statement::ROW_ARRAY_SIZE, static_cast<size_t>(m_currentArd->GetArraySize()));
   if (m_spiStatement->ExecutePrepared()) {
     m_currenResult = m_spiStatement->GetResultSet();
     m_ird->PopulateFromResultSetMetadata(m_spiStatement->GetResultSet()->GetMetadata().get());
@@ -263,7 +459,19 @@ void ODBCStatement::ExecutePrepared() {
   }
 }
 
+void ODBCStatement::ClearDataAtExec() {
+  m_dataAtExecParameters.clear();
+  m_dataAtExecPosition = 0;
+  m_parameterWriter = nullptr;
+  m_wcsConverter.Reset();
+  std::vector<uint8_t>().swap(m_utf8Buffer);
+}
+
 void ODBCStatement::ExecuteDirect(const std::string& query) {
+  if (!m_dataAtExecParameters.empty()) {
+    throw DriverException("Function sequence error", "HY010");
+  }
+  m_spiStatement->SetAttribute(Statement::ROW_ARRAY_SIZE, static_cast<size_t>(m_currentArd->GetArraySize()));
   if (m_spiStatement->Execute(query)) {
     m_currenResult = m_spiStatement->GetResultSet();
     m_ird->PopulateFromResultSetMetadata(m_currenResult->GetMetadata().get());
@@ -274,6 +482,24 @@ void ODBCStatement::ExecuteDirect(const std::string& query) {
   m_isPrepared = false;
 }
 
+bool ODBCStatement::MoreResults() {
+  closeCursor(true);
+
+  bool hasResultSet = false;
+  if (!m_spiStatement->NextResult(&hasResultSet)) {
+    return false;
+  }
+
+  if (hasResultSet) {
+    m_currenResult = m_spiStatement->GetResultSet();
+    m_ird->PopulateFromResultSetMetadata(m_currenResult->GetMetadata().get());
+  } else {
+    // An update count has no columns to describe.
+    m_ird->ClearRecords();
+  }
+  return true;
+}
+
 bool ODBCStatement::Fetch(size_t rows) {
   if (m_hasReachedEndOfResult) {
     m_ird->SetRowsProcessed(0);
@@ -446,6 +672,44 @@ void ODBCStatement::GetStmtAttr(SQLINTEGER statementAttribute,
     case SQL_ATTR_QUERY_TIMEOUT:
       spiAttribute = m_spiStatement->GetAttribute(Statement::QUERY_TIMEOUT);
       break;
+    case SQL_ATTR_ARROW_EXPORT_FORMAT:
+      spiAttribute = m_spiStatement->GetAttribute(Statement::EXPORT_FORMAT);
+      break;
+    case SQL_ATTR_ARROW_EXPORT_COMPRESSION:
+      spiAttribute = m_spiStatement->GetAttribute(Statement::EXPORT_COMPRESSION);
+      break;
+    case SQL_ATTR_ARROW_EXPORT_ROW_GROUP_SIZE:
+      spiAttribute = m_spiStatement->GetAttribute(Statement::EXPORT_ROW_GROUP_SIZE);
+      break;
+    case SQL_ATTR_ARROW_EXPORT_ROW_COUNT:
+      spiAttribute = m_spiStatement->GetAttribute(Statement::EXPORT_ROW_COUNT);
+      break;
+    case SQL_ATTR_ARROW_PRIORITY:
+      spiAttribute = m_spiStatement->GetAttribute(Statement::PRIORITY);
+      break;
+
+    case SQL_ATTR_ARROW_PARAMETER_STREAM: {
+      spiAttribute = m_spiStatement->GetAttribute(Statement::PARAMETER_STREAM);
+      if (!spiAttribute) {
+        throw DriverException("Optional feature not supported.", "HYC00");
+      }
+      GetAttribute(static_cast<SQLPOINTER>(boost::get<void *>(*spiAttribute)), output, bufferSize, strLenPtr);
+      return;
+    }
+
+    // Driver-specific string attributes.
+    case SQL_ATTR_ARROW_EXPORT_PATH:
+    case SQL_ATTR_ARROW_MERGE_SORT_KEYS: {
+      spiAttribute = m_spiStatement->GetAttribute(statementAttribute == SQL_ATTR_ARROW_EXPORT_PATH
+                                                  ? Statement::EXPORT_PATH
+                                                  : Statement::MERGE_SORT_KEYS);
+      if (!spiAttribute) {
+        throw DriverException("Optional feature not supported.", "HYC00");
+      }
+      GetStringAttribute(isUnicode, boost::get<std::string>(*spiAttribute), true,
+                         output, bufferSize, strLenPtr, GetDiagnostics());
+      return;
+    }
     default:
       throw DriverException("Invalid statement attribute: " + std::to_string(statementAttribute), "HY092");
   }
@@ -604,6 +868,43 @@ void ODBCStatement::SetStmtAttr(SQLINTEGER statementAttribute, SQLPOINTER value,
       SetAttribute(value, attributeToWrite);
       successfully_written = m_spiStatement->SetAttribute(Statement::QUERY_TIMEOUT, attributeToWrite);
       break;
+    case SQL_ATTR_ARROW_EXPORT_FORMAT:
+      SetAttribute(value, attributeToWrite);
+      successfully_written = m_spiStatement->SetAttribute(Statement::EXPORT_FORMAT, attributeToWrite);
+      break;
+    case SQL_ATTR_ARROW_EXPORT_COMPRESSION:
+      SetAttribute(value, attributeToWrite);
+      successfully_written = m_spiStatement->SetAttribute(Statement::EXPORT_COMPRESSION, attributeToWrite);
+      break;
+    case SQL_ATTR_ARROW_EXPORT_ROW_GROUP_SIZE:
+      SetAttribute(value, attributeToWrite);
+      successfully_written = m_spiStatement->SetAttribute(Statement::EXPORT_ROW_GROUP_SIZE, attributeToWrite);
+      break;
+    case SQL_ATTR_ARROW_EXPORT_ROW_COUNT:
+      throw DriverException("Cannot set read-only attribute", "HY092");
+    case SQL_ATTR_ARROW_PRIORITY:
+      SetAttribute(value, attributeToWrite);
+      successfully_written = m_spiStatement->SetAttribute(Statement::PRIORITY, attributeToWrite);
+      break;
+    case SQL_ATTR_ARROW_PARAMETER_STREAM:
+      successfully_written = m_spiStatement->SetAttribute(Statement::PARAMETER_STREAM, static_cast<void *>(value));
+      break;
+    case SQL_ATTR_ARROW_EXPORT_PATH:
+    case SQL_ATTR_ARROW_MERGE_SORT_KEYS: {
+      std::string text;
+      if (value != nullptr) {
+        if (isUnicode) {
+          SetAttributeSQLWCHAR(value, bufferSize, text);
+        } else {
+          SetAttributeUTF8(value, bufferSize, text);
+        }
+      }
+      successfully_written = m_spiStatement->SetAttribute(statementAttribute == SQL_ATTR_ARROW_EXPORT_PATH
+                                                          ? Statement::EXPORT_PATH
+                                                          : Statement::MERGE_SORT_KEYS,
+                                                          text);
+      break;
+    }
     default:
         throw DriverException("Invalid attribute: " + std::to_string(attributeToWrite), "HY092");
   }
@@ -677,10 +978,37 @@ bool ODBCStatement::GetData(SQLSMALLINT recordNumber, SQLSMALLINT cType, SQLPOIN
 }
 
 void ODBCStatement::releaseStatement() {
-  closeCursor(true);
   m_connection.dropStatement(this);
 }
 
+bool ODBCStatement::Reset() {
+  closeCursor(true);
+  if (!m_spiStatement->Reset()) {
+    return false;
+  }
+
+  if (m_currentArd != m_builtInArd.get()) {
+    m_currentArd->DetachFromStatement(this, false);
+  }
+  if (m_currentApd != m_builtInApd.get()) {
+    m_currentApd->DetachFromStatement(this, true);
+  }
+  m_builtInArd->Reset();
+  m_builtInApd->Reset();
+  m_ipd->Reset();
+  m_ird->Reset();
+  m_currentArd = m_builtInArd.get();
+  m_currentApd = m_builtInApd.get();
+
+  m_rowNumber = 0;
+  m_maxRows = 0;
+  m_rowsetSize = 1;
+  m_isPrepared = false;
+  m_hasReachedEndOfResult = false;
+  ClearDataAtExec();
+  return true;
+}
+
 void ODBCStatement::GetTables(const std::string* catalog, const std::string* schema, const std::string* table, const std::string* tableType) {
   closeCursor(true);
   if (m_connection.IsOdbc2Connection()) {
@@ -724,5 +1052,7 @@ void ODBCStatement::GetTypeInfo(SQLSMALLINT dataType) {
 }
 
 void ODBCStatement::Cancel() {
+  // Cancelling while values are being supplied abandons the execution.
+  ClearDataAtExec();
   m_spiStatement->Cancel();
 }